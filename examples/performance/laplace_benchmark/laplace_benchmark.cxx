@@ -0,0 +1,78 @@
+/*
+ * Time all the available Laplacian implementations on the same
+ * problem, and check them against a reference implementation
+ *
+ */
+
+#include <bout.hxx>
+#include <bout/invert/laplace_benchmark.hxx>
+#include <boutcomm.hxx>
+#include <field_factory.hxx>
+#include <invert_laplace.hxx>
+
+#include <fstream>
+#include <sstream>
+
+int main(int argc, char** argv) {
+  BoutInitialise(argc, argv);
+
+  auto& options = Options::root()["laplace_benchmark"];
+
+  const bool coefs_3d =
+      options["coefs_3d"]
+          .doc("Pass the coefficients as Field3D, rather than their DC parts")
+          .withDefault(false);
+
+  FieldFactory factory(mesh);
+  const Field3D rhs = factory.create3D(
+      options["rhs"].doc("Right-hand side").withDefault(std::string{"sin(3*z)"}));
+  const Field3D a =
+      factory.create3D(options["a"].doc("Coefficient A").withDefault(std::string{"0"}));
+  const Field3D c =
+      factory.create3D(options["c"].doc("Coefficient C").withDefault(std::string{"1"}));
+  const Field3D d =
+      factory.create3D(options["d"].doc("Coefficient D").withDefault(std::string{"1"}));
+
+  LaplaceBenchmark benchmark(Options::getRoot()->getSection("laplace"));
+  benchmark.setNeeds3DCoefs(coefs_3d);
+
+  const auto results = benchmark.run(
+      [&](Laplacian& lap) {
+        if (coefs_3d) {
+          lap.setCoefA(a);
+          lap.setCoefC(c);
+          lap.setCoefD(d);
+        } else {
+          lap.setCoefA(DC(a));
+          lap.setCoefC(DC(c));
+          lap.setCoefD(DC(d));
+        }
+      },
+      rhs, zeroFrom(rhs));
+
+  std::stringstream table;
+  LaplaceBenchmark::print(results, table);
+  output << "\n" << table.str();
+  output << "Fastest: " << LaplaceBenchmark::fastest(results) << "\n";
+
+  // Append to a file, so runs on different numbers of processors can
+  // be compared
+  if (BoutComm::rank() == 0) {
+    const std::string filename =
+        Options::root()["datadir"].withDefault<std::string>("data")
+        + "/laplace_benchmark.csv";
+    const bool is_new = not std::ifstream(filename).good();
+    std::ofstream csv(filename, std::ios::app);
+    if (is_new) {
+      csv << "nprocs,nxpe,nype,type,valid,first_time,solve_time,error\n";
+    }
+    for (const auto& result : results) {
+      csv << BoutComm::size() << "," << mesh->getNXPE() << "," << mesh->getNYPE() << ","
+          << result.type << "," << result.valid << "," << result.first_time << ","
+          << result.solve_time << "," << result.error << "\n";
+    }
+  }
+
+  BoutFinalise();
+  return 0;
+}
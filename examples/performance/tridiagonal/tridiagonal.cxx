@@ -0,0 +1,118 @@
+/*
+ * Test performance of the batched tridiagonal solver in CyclicReduce
+ *
+ * Solves nsys independent complex tridiagonal systems, as LaplaceCyclic
+ * does with one system per (kz, y). On one processor this is compared
+ * against solving each system in turn with tridag().
+ */
+
+#include <bout.hxx>
+#include <cyclic_reduction.hxx>
+#include <dcomplex.hxx>
+#include <lapack_routines.hxx>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using SteadyClock = std::chrono::time_point<std::chrono::steady_clock>;
+using Duration = std::chrono::duration<double>;
+using namespace std::chrono;
+
+#define TEST_BLOCK(NAME, ...)                                                            \
+  {                                                                                      \
+    __VA_ARGS__                                                                          \
+    names.push_back(NAME);                                                               \
+    SteadyClock start = steady_clock::now();                                             \
+    for (int repetitionIndex = 0; repetitionIndex < NUM_LOOPS; repetitionIndex++) {      \
+      __VA_ARGS__;                                                                       \
+    }                                                                                    \
+    times.push_back(steady_clock::now() - start);                                        \
+  }
+
+int main(int argc, char** argv) {
+  BoutInitialise(argc, argv);
+  std::vector<std::string> names;
+  std::vector<Duration> times;
+
+  auto& options = Options::root()["tridiagonal"];
+  const int NUM_LOOPS = options["NUM_LOOPS"].withDefault(100);
+  const int n = options["n"].withDefault(64);       // Rows per processor
+  const int nsys = options["nsys"].withDefault(4096); // Number of systems
+
+  ConditionalOutput time_output{Output::getInstance()};
+  time_output.enable(true);
+
+  int mype, npe;
+  MPI_Comm_rank(BoutComm::get(), &mype);
+  MPI_Comm_size(BoutComm::get(), &npe);
+
+  Matrix<dcomplex> a(nsys, n), b(nsys, n), c(nsys, n), rhs(nsys, n);
+  for (int s = 0; s < nsys; s++) {
+    for (int i = 0; i < n; i++) {
+      a(s, i) = dcomplex(randomu(), randomu());
+      b(s, i) = dcomplex(4. + randomu(), randomu()); // Diagonally dominant
+      c(s, i) = dcomplex(randomu(), randomu());
+      rhs(s, i) = dcomplex(randomu() - 0.5, randomu() - 0.5);
+    }
+  }
+  if (mype == 0) {
+    for (int s = 0; s < nsys; s++) {
+      a(s, 0) = 0.0;
+    }
+  }
+  if (mype == npe - 1) {
+    for (int s = 0; s < nsys; s++) {
+      c(s, n - 1) = 0.0;
+    }
+  }
+
+  CyclicReduce<dcomplex> cr(BoutComm::get(), n);
+  Matrix<dcomplex> xbatch(nsys, n);
+
+  TEST_BLOCK("CyclicReduce (batched)",
+    cr.setCoefs(a, b, c);
+    cr.solve(rhs, xbatch);
+  );
+
+  BoutReal maxerr = 0.0;
+  if (npe == 1) {
+    // Reference: one system at a time
+    Matrix<dcomplex> xserial(nsys, n);
+    TEST_BLOCK("tridag (one system at a time)",
+      BOUT_OMP(parallel for)
+      for (int s = 0; s < nsys; s++) {
+        tridag(&a(s, 0), &b(s, 0), &c(s, 0), &rhs(s, 0), &xserial(s, 0), n);
+      }
+    );
+
+    for (int s = 0; s < nsys; s++) {
+      for (int i = 0; i < n; i++) {
+        maxerr = std::max(maxerr, std::abs(xbatch(s, i) - xserial(s, i)));
+      }
+    }
+  }
+
+  // Report
+  std::size_t width = 0;
+  for (const auto& name : names) {
+    width = std::max(width, name.size());
+  }
+  width += 5;
+  time_output << std::setw(width) << "Case name"
+              << "\t"
+              << "Time per solve (s)"
+              << "\n";
+  for (std::size_t i = 0; i < names.size(); i++) {
+    time_output << std::setw(width) << names[i] << "\t" << times[i].count() / NUM_LOOPS
+                << "\n";
+  }
+  if (npe == 1) {
+    time_output << "Maximum difference between methods: " << maxerr << "\n";
+  }
+
+  BoutFinalise();
+  return 0;
+}
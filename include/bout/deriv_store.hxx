@@ -229,6 +229,13 @@ struct DerivativeStore {
                        method.meta.key);
   };
 
+  /// Name of the method used when the method is DIFF_DEFAULT
+  std::string getDefaultMethod(DIRECTION direction, STAGGER stagger = STAGGER::None,
+                               DERIV derivType = DERIV::Standard) const {
+    AUTO_TRACE();
+    return defaultMethods.at(getKey(direction, stagger, toString(derivType)));
+  }
+
   /// Routines to return a specific differential operator. Note we
   /// have to have a separate routine for different methods as they
   /// have different return types. As such we choose to use a
@@ -0,0 +1,87 @@
+/**************************************************************************
+ * Performance monitoring for iterative solvers
+ *
+ **************************************************************************
+ * Copyright 2020 BOUT++ contributors
+ *
+ * Contact: Ben Dudson, bd512@york.ac.uk
+ *
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+#ifndef __ITERATION_MONITOR_H__
+#define __ITERATION_MONITOR_H__
+
+#include "bout_types.hxx"
+#include "bout/monitor.hxx"
+
+#include <string>
+
+class Datafile;
+class Solver;
+
+/// Running average of the number of iterations an iterative solver
+/// takes in each output timestep.
+///
+/// Nothing is recorded until save() has been called. The average is
+/// then written to the output file every output step, after which the
+/// monitor resets it
+class IterationMonitor : public Monitor {
+public:
+  /// Add "<name>_average_iterations" to \p output_file and start
+  /// recording. The monitor is added to the back of the \p solver
+  /// queue, so the values are reset after being saved
+  void save(Datafile& output_file, Solver& solver, const std::string& name);
+
+  /// Has save() been called?
+  bool isEnabled() const { return enabled; }
+
+  /// Record that a solve took \p iterations iterations
+  void record(int iterations) {
+    if (!enabled) {
+      return;
+    }
+    ++n_calls;
+    average_iterations = BoutReal(n_calls - 1) / BoutReal(n_calls) * average_iterations
+                         + BoutReal(iterations) / BoutReal(n_calls);
+  }
+
+  /// Average over the solves recorded so far in this output timestep
+  BoutReal getAverageIterations() const { return average_iterations; }
+
+  int call(Solver*, BoutReal, int, int) override {
+    output_average_iterations = average_iterations;
+    n_calls = 0;
+    average_iterations = 0.;
+    return 0;
+  }
+
+private:
+  bool enabled{false};
+
+  /// Running average of the iterations in this output timestep
+  BoutReal average_iterations{0.};
+
+  /// Final value of average_iterations, since output is written after
+  /// all the monitors have been called
+  BoutReal output_average_iterations{0.};
+
+  /// Number of solves in this output timestep
+  int n_calls{0};
+};
+
+#endif // __ITERATION_MONITOR_H__
@@ -0,0 +1,119 @@
+/**************************************************************************
+ * Timing and checking all the Laplacian implementations on one problem
+ *
+ **************************************************************************
+ * Copyright 2020 BOUT++ contributors
+ *
+ * Contact: Ben Dudson, bd512@york.ac.uk
+ *
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+#ifndef __LAPLACE_BENCHMARK_H__
+#define __LAPLACE_BENCHMARK_H__
+
+#include "bout_types.hxx"
+#include "field3d.hxx"
+#include "fieldperp.hxx"
+#include "invert_laplace.hxx"
+#include "options.hxx"
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Mesh;
+
+/// Runs each available Laplacian implementation on the same problem,
+/// timing the solves and comparing the solutions with a reference
+/// implementation.
+///
+/// Options are read from the section passed to the constructor:
+///
+///     benchmark_types      Comma-separated list of types to try.
+///                          Default is all those available
+///     benchmark_reference  Type whose solution the others must match
+///     benchmark_tolerance  Maximum difference from the reference,
+///                          relative to its maximum value
+///     benchmark_repeats    Number of timed solves after the first
+///     benchmark_coefs_change  Set the coefficients again before each
+///                          timed solve, so that solvers which cache
+///                          factorisations are timed as if the
+///                          coefficients evolve in time. Default true
+///
+/// Every implementation is created with a copy of the values set by
+/// the user in that section, so the same solver settings apply to all
+/// of them. All processors must call run() together
+class LaplaceBenchmark {
+public:
+  /// Result for one implementation
+  struct Result {
+    std::string type;
+    bool valid{false};       ///< Ran, and agreed with the reference
+    std::string reason;      ///< Why the implementation is not valid
+    BoutReal first_time{0.}; ///< Time of the first solve, including setup [s]
+    BoutReal solve_time{0.}; ///< Average time of the later solves [s]
+    BoutReal error{0.};      ///< Difference from the reference
+  };
+
+  /// Sets the coefficients and flags of a solver
+  using Setup = std::function<void(Laplacian&)>;
+
+  /// Creates a solver from an options section. Laplacian::create by default
+  using Creator = std::function<Laplacian*(Options*, CELL_LOC, Mesh*)>;
+
+  LaplaceBenchmark(Options* options = nullptr, CELL_LOC loc = CELL_CENTRE,
+                   Mesh* mesh_in = nullptr);
+
+  /// Only accept implementations which use Field3D coefficients. The
+  /// default reference is then "naulin" rather than "cyclic"
+  void setNeeds3DCoefs(bool needs) { needs_3d_coefs = needs; }
+
+  /// Use \p create_in to make the solvers, rather than Laplacian::create
+  void setCreator(Creator create_in) { create = std::move(create_in); }
+
+  /// Solve A x = \p b with each implementation, after calling \p setup
+  /// on it. \p x0 is the initial guess, and sets boundary values if
+  /// the flags ask for them
+  std::vector<Result> run(const Setup& setup, const Field3D& b, const Field3D& x0);
+  std::vector<Result> run(const Setup& setup, const FieldPerp& b, const FieldPerp& x0);
+
+  /// The valid type with the smallest solve_time. Empty if there is none
+  static std::string fastest(const std::vector<Result>& results);
+
+  /// Print a table of \p results
+  static void print(const std::vector<Result>& results, std::ostream& out);
+
+  /// Copy of the values in \p options which were set by the user,
+  /// rather than from defaults. Different implementations can then
+  /// set their own defaults
+  static Options userOptions(const Options& options);
+
+private:
+  Options* options;
+  CELL_LOC location;
+  Mesh* localmesh;
+  bool needs_3d_coefs{false};
+  Creator create;
+
+  template <typename T>
+  std::vector<Result> runAll(const Setup& setup, const T& b, const T& x0);
+};
+
+#endif // __LAPLACE_BENCHMARK_H__
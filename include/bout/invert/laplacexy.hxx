@@ -72,6 +72,10 @@ public:
 #include "datafile.hxx"
 #include <cyclic_reduction.hxx>
 #include "utils.hxx"
+#include "bout/invert/iteration_monitor.hxx"
+#include "bout/invert/solution_history.hxx"
+
+#include <vector>
 
 class LaplaceXY {
 public:
@@ -100,6 +104,9 @@ public:
    *        and contain valid data.
    * x0   - Initial guess at the solution. If this is unallocated
    *        then an initial guess of zero will be used.
+   *        If initial_guess_history > 0, the interior guess is
+   *        extrapolated from previous solutions when there are any;
+   *        x0 still sets the boundary values.
    * 
    * Returns
    * =======
@@ -140,6 +147,49 @@ private:
   Matrix<BoutReal> acoef, bcoef, ccoef, xvals, bvals;
   std::unique_ptr<CyclicReduce<BoutReal>> cr; ///< Tridiagonal solver
 
+  // Geometric multigrid preconditioner (pctype = "bout_mg")
+  bool use_multigrid{false};
+  int mg_max_levels{1};    ///< Maximum number of levels, including the finest
+  int mg_smooth{1};        ///< Relaxation sweeps before and after each coarse correction
+  int mg_coarse_procs{1};  ///< Processors which solve the coarsest level
+  Matrix<BoutReal> ymcoef, ypcoef; ///< Y couplings of the operator
+
+  /// One level of the multigrid hierarchy. Each level has about half
+  /// the X and Y points of the one above, on the same processors
+  struct MultigridLevel {
+    int nx, ny; ///< Number of X and Y points on this processor
+    /// 5-point stencil at each (y, x). Point (j, i) is stored in
+    /// Field2Ds at (xstart + i, ystart + j)
+    Matrix<BoutReal> xm, c, xp, ym, yp;
+    /// Point on the next level of each X and Y point
+    std::vector<int> xcoarse, ycoarse;
+    /// Tridiagonal solvers for the even and odd X lines
+    std::unique_ptr<CyclicReduce<BoutReal>> lines[2];
+  };
+  std::vector<MultigridLevel> mg_levels;
+
+  // The coarsest level is assembled into a PETSc matrix, which is
+  // gathered onto mg_coarse_procs processors and solved directly
+  Mat mg_coarse_mat;        ///< Coarsest level operator
+  Vec mg_coarse_x, mg_coarse_b; ///< Coarsest level solution and RHS
+  KSP mg_coarse_ksp;        ///< Direct solver for the coarsest level
+  Field2D mg_coarse_index;  ///< Global row of each coarsest level point (as BoutReal)
+
+  /// Build the multigrid levels from the stencil set in setCoefs
+  void setupMultigrid();
+  /// Solve the coarsest level exactly. \p u must be zero on entry
+  void mgCoarseSolve(Field2D& u, const Field2D& f);
+  /// Zebra X-line relaxation of level \p l
+  void mgRelax(int l, Field2D& u, const Field2D& f, int sweeps);
+  /// One V-cycle on level \p l and below
+  void mgCycle(int l, Field2D& u, const Field2D& f);
+  /// Communicate the guard cells of level \p l values in \p u
+  void mgCommunicate(int l, Field2D& u);
+  /// X index of point \p i of level \p l, including the guard cells
+  int mgX(int l, int i) const;
+  /// Y index of line \p j of level \p l, including the guard cells
+  int mgY(int l, int j) const;
+
   // Use finite volume or finite difference discretization
   bool finite_volume{true};
 
@@ -153,6 +203,9 @@ private:
 
   // Location of the rhs and solution
   CELL_LOC location;
+
+  /// Previous solutions, extrapolated to give the initial guess
+  SolutionHistory<Field2D> history;
   
   /*!
    * Number of grid points on this processor
@@ -177,41 +230,8 @@ private:
   int globalIndex(int x, int y);  
   Field2D indexXY; ///< Global index (integer stored as BoutReal)
 
-  // Save performance information?
-  bool save_performance = false;
-
-  // Running average of number of iterations taken for solve in each output timestep
-  BoutReal average_iterations = 0.;
-
-  // Variable to store the final result of average_iterations, since output is
-  // written after all other monitors have been called, and average_iterations
-  // must be reset in the monitor
-  BoutReal output_average_iterations = 0.;
-
-  // Running total of number of calls to the solver in each output timestep
-  int n_calls = 0;
-
-  // Monitor class used to reset performance-monitoring variables for a new
-  // output timestep
-  friend class LaplaceXYMonitor;
-  class LaplaceXYMonitor : public Monitor {
-  public:
-    LaplaceXYMonitor(LaplaceXY& owner) : laplacexy(owner) {}
-
-    int call(Solver*, BoutReal, int, int) {
-      laplacexy.output_average_iterations = laplacexy.average_iterations;
-
-      laplacexy.n_calls = 0;
-      laplacexy.average_iterations = 0.;
-
-      return 0;
-    }
-  private:
-    // LaplaceXY object that this monitor belongs to
-    LaplaceXY& laplacexy;
-  };
-
-  LaplaceXYMonitor monitor;
+  /// Iterations per solve, saved if savePerformance is called
+  IterationMonitor performance;
 };
 
 #endif // BOUT_HAS_PETSC
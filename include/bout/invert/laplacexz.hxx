@@ -34,6 +34,7 @@
 #include <options.hxx>
 #include <field3d.hxx>
 #include <bout/mesh.hxx>
+#include <bout/invert/iteration_monitor.hxx>
 #include <unused.hxx>
 
 class LaplaceXZ {
@@ -50,6 +51,13 @@ public:
 
   static LaplaceXZ *create(Mesh *m = nullptr, Options *opt = nullptr, const CELL_LOC loc = CELL_CENTRE);
 
+  /// Save the average number of iterations per solve in each output
+  /// timestep as "<name>_average_iterations". Only iterative solvers
+  /// record their iterations
+  void savePerformance(Datafile& output_file, Solver& solver, const std::string& name) {
+    performance.save(output_file, solver, name);
+  }
+
 protected:
   static const int INVERT_DC_GRAD  = 1;
   static const int INVERT_AC_GRAD  = 2;  // Use zero neumann (NOTE: AC is a misnomer)
@@ -57,6 +65,7 @@ protected:
   static const int INVERT_RHS      = 32; // Set boundary to b value
   Mesh* localmesh;   ///< The mesh this operates on, provides metrics and communication
   CELL_LOC location;
+  IterationMonitor performance; ///< Iteration counts of iterative solvers
 private:
 
 };
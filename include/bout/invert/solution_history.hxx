@@ -0,0 +1,105 @@
+/**************************************************************************
+ * Initial guesses for iterative solvers, extrapolated from previous
+ * solutions
+ *
+ **************************************************************************
+ * Copyright 2020 BOUT++ contributors
+ *
+ * Contact: Ben Dudson, bd512@york.ac.uk
+ *
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+#ifndef __SOLUTION_HISTORY_H__
+#define __SOLUTION_HISTORY_H__
+
+#include "bout_types.hxx"
+#include "bout/assert.hxx"
+#include "field.hxx"
+
+#include <deque>
+
+/// Keeps the last few solutions of a repeated solve, and extrapolates
+/// them to give an initial guess for the next one.
+///
+/// Solutions are assumed to be equally spaced (e.g. one per call of
+/// the RHS function), so the guess is the polynomial through the
+/// stored solutions, evaluated one step on:
+///
+///     1 solution:  x_n
+///     2 solutions: 2 x_n - x_{n-1}
+///     3 solutions: 3 x_n - 3 x_{n-1} + x_{n-2}
+///
+/// \tparam T  A field type (Field2D, Field3D or FieldPerp)
+template <typename T>
+class SolutionHistory {
+public:
+  /// @param[in] depth  Maximum number of solutions kept. Zero
+  ///                   disables the history
+  explicit SolutionHistory(int depth = 0) : depth(depth) { ASSERT0(depth >= 0); }
+
+  /// Maximum number of solutions kept
+  int getDepth() const { return depth; }
+  /// Number of solutions currently stored
+  int size() const { return static_cast<int>(solutions.size()); }
+  bool empty() const { return solutions.empty(); }
+
+  /// Forget all stored solutions
+  void clear() { solutions.clear(); }
+
+  /// Add the latest solution, discarding the oldest if more than
+  /// depth are stored. A copy is kept, so \p solution can be
+  /// modified afterwards
+  void push(const T& solution) {
+    if (depth == 0) {
+      return;
+    }
+    solutions.push_back(copy(solution));
+    while (size() > depth) {
+      solutions.pop_front();
+    }
+  }
+
+  /// Extrapolate the stored solutions one step forward. There must
+  /// be at least one stored solution
+  T extrapolate() const {
+    ASSERT1(!empty());
+    const int n = size();
+    T result = coefficient(n, 0) * solutions[0];
+    for (int i = 1; i < n; ++i) {
+      result += coefficient(n, i) * solutions[i];
+    }
+    return result;
+  }
+
+  /// Weight of solution \p i (oldest first) when extrapolating \p n
+  /// equally spaced solutions: (-1)^(n-1-i) * binomial(n, i)
+  static BoutReal coefficient(int n, int i) {
+    ASSERT2(i >= 0 && i < n);
+    BoutReal binomial = 1.0;
+    for (int k = 1; k <= i; ++k) {
+      binomial = binomial * (n - i + k) / k;
+    }
+    return ((n - 1 - i) % 2 == 0) ? binomial : -binomial;
+  }
+
+private:
+  int depth;
+  std::deque<T> solutions; ///< Oldest first
+};
+
+#endif // __SOLUTION_HISTORY_H__
@@ -1,5 +1,6 @@
 /**************************************************************************
- * Invert arbitrary linear global operation using PETSc.
+ * Invert arbitrary linear global operation using PETSc, or a built-in
+ * Krylov solver when PETSc is not available.
  *
  **************************************************************************
  * Copyright 2018 D. Dickinson
@@ -33,8 +34,6 @@ class InvertableOperator;
 #ifndef __INVERTABLE_OPERATOR_H__
 #define __INVERTABLE_OPERATOR_H__
 
-#ifdef BOUT_HAS_PETSC
-
 #include "bout/traits.hxx"
 #include <bout/mesh.hxx>
 #include <bout/sys/timer.hxx>
@@ -45,17 +44,29 @@ class InvertableOperator;
 #include <options.hxx>
 #include <output.hxx>
 
+#ifdef BOUT_HAS_PETSC
+
 #include <petscksp.h>
 
 #include <bout/petsclib.hxx>
 
+#else
+
+#include <unused.hxx>
+#include <utils.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
 #endif
 
 namespace bout {
 namespace inversion {
 
-#ifdef BOUT_HAS_PETSC
-
 /// No-op function to use as a default -- may wish to remove once testing phase complete
 template <typename T>
 T identity(const T& in) {
@@ -63,6 +74,111 @@ T identity(const T& in) {
   return in;
 };
 
+/// Add the RGN_WITHBNDRIES region for fields of type T to the mesh, if it
+/// isn't there already. Requires RGN_NOBNDRY to be defined.
+template <typename T>
+void addRegionWithBoundaries(Mesh* localmesh) {
+  if (std::is_same<Field3D, T>::value) {
+    if (not localmesh->hasRegion3D("RGN_WITHBNDRIES")) {
+      // This avoids all guard cells and corners but includes boundaries
+      // Note we probably don't want to include periodic boundaries as these
+      // are essentially just duplicate points so should be careful here (particularly
+      // in y)
+      // to only include unique points
+      Region<Ind3D> nocorner3D = localmesh->getRegion3D("RGN_NOBNDRY");
+      if (!localmesh->periodicX) {
+        if (localmesh->firstX())
+          nocorner3D += Region<Ind3D>(0, localmesh->xstart - 1, localmesh->ystart,
+                                      localmesh->yend, 0, localmesh->LocalNz - 1,
+                                      localmesh->LocalNy, localmesh->LocalNz,
+                                      localmesh->maxregionblocksize);
+        if (localmesh->lastX())
+          nocorner3D += Region<Ind3D>(
+              localmesh->LocalNx - localmesh->xstart, localmesh->LocalNx - 1,
+              localmesh->ystart, localmesh->yend, 0, localmesh->LocalNz - 1,
+              localmesh->LocalNy, localmesh->LocalNz, localmesh->maxregionblocksize);
+      }
+      if (localmesh->firstY() or localmesh->lastY()) {
+        for (int ix = localmesh->xstart; ix <= localmesh->xend; ix++) {
+          if (not localmesh->periodicY(ix)) {
+            if (localmesh->firstY())
+              nocorner3D +=
+                  Region<Ind3D>(ix, ix, 0, localmesh->ystart - 1, 0,
+                                localmesh->LocalNz - 1, localmesh->LocalNy,
+                                localmesh->LocalNz, localmesh->maxregionblocksize);
+            if (localmesh->lastY())
+              nocorner3D += Region<Ind3D>(
+                  ix, ix, localmesh->LocalNy - localmesh->ystart,
+                  localmesh->LocalNy - 1, 0, localmesh->LocalNz - 1, localmesh->LocalNy,
+                  localmesh->LocalNz, localmesh->maxregionblocksize);
+          }
+        }
+      }
+
+      nocorner3D.unique();
+      localmesh->addRegion3D("RGN_WITHBNDRIES", nocorner3D);
+    }
+
+  } else if (std::is_same<Field2D, T>::value) {
+    if (not localmesh->hasRegion2D("RGN_WITHBNDRIES")) {
+      // This avoids all guard cells and corners but includes boundaries
+      Region<Ind2D> nocorner2D = localmesh->getRegion2D("RGN_NOBNDRY");
+      if (!localmesh->periodicX) {
+        if (localmesh->firstX())
+          nocorner2D += Region<Ind2D>(0, localmesh->xstart - 1, localmesh->ystart,
+                                      localmesh->yend, 0, 0, localmesh->LocalNy, 1,
+                                      localmesh->maxregionblocksize);
+        if (localmesh->lastX())
+          nocorner2D +=
+              Region<Ind2D>(localmesh->LocalNx - localmesh->xstart,
+                            localmesh->LocalNx - 1, localmesh->ystart, localmesh->yend,
+                            0, 0, localmesh->LocalNy, 1, localmesh->maxregionblocksize);
+      }
+      if (localmesh->firstY() or localmesh->lastY()) {
+        for (int ix = localmesh->xstart; ix <= localmesh->xend; ix++) {
+          if (not localmesh->periodicY(ix)) {
+            if (localmesh->firstY())
+              nocorner2D +=
+                  Region<Ind2D>(ix, ix, 0, localmesh->ystart - 1, 0, 0,
+                                localmesh->LocalNy, 1, localmesh->maxregionblocksize);
+            if (localmesh->lastY())
+              nocorner2D +=
+                  Region<Ind2D>(ix, ix, localmesh->LocalNy - localmesh->ystart,
+                                localmesh->LocalNy - 1, 0, 0, localmesh->LocalNy, 1,
+                                localmesh->maxregionblocksize);
+          }
+        }
+      }
+      nocorner2D.unique();
+      localmesh->addRegion2D("RGN_WITHBNDRIES", nocorner2D);
+    }
+
+  } else if (std::is_same<FieldPerp, T>::value) {
+    if (not localmesh->hasRegionPerp("RGN_WITHBNDRIES")) {
+      // This avoids all guard cells and corners but includes boundaries
+      Region<IndPerp> nocornerPerp = localmesh->getRegionPerp("RGN_NOBNDRY");
+      if (!localmesh->periodicX) {
+        if (localmesh->firstX())
+          nocornerPerp +=
+              Region<IndPerp>(0, localmesh->xstart - 1, 0, 0, 0, localmesh->LocalNz - 1,
+                              1, localmesh->LocalNz, localmesh->maxregionblocksize);
+        if (localmesh->lastX())
+          nocornerPerp +=
+              Region<IndPerp>(localmesh->LocalNx - localmesh->xstart,
+                              localmesh->LocalNx - 1, 0, 0, 0, localmesh->LocalNz - 1,
+                              1, localmesh->LocalNz, localmesh->maxregionblocksize);
+      }
+      nocornerPerp.unique();
+      localmesh->addRegionPerp("RGN_WITHBNDRIES", nocornerPerp);
+    }
+
+  } else {
+    throw BoutException("Invalid template type provided to InvertableOperator");
+  }
+}
+
+#ifdef BOUT_HAS_PETSC
+
 /// Pack a PetscVec from a Field<T>
 template <typename T>
 PetscErrorCode fieldToPetscVec(const T& in, Vec out) {
@@ -195,104 +311,7 @@ public:
           "already been setup.");
     }
 
-    // Add the RGN_WITHBNDRIES region to the mesh. Requires RGN_NOBNDRY to be defined.
-    if (std::is_same<Field3D, T>::value) {
-      if (not localmesh->hasRegion3D("RGN_WITHBNDRIES")) {
-        // This avoids all guard cells and corners but includes boundaries
-        // Note we probably don't want to include periodic boundaries as these
-        // are essentially just duplicate points so should be careful here (particularly
-        // in y)
-        // to only include unique points
-        Region<Ind3D> nocorner3D = localmesh->getRegion3D("RGN_NOBNDRY");
-        if (!localmesh->periodicX) {
-          if (localmesh->firstX())
-            nocorner3D += Region<Ind3D>(0, localmesh->xstart - 1, localmesh->ystart,
-                                        localmesh->yend, 0, localmesh->LocalNz - 1,
-                                        localmesh->LocalNy, localmesh->LocalNz,
-                                        localmesh->maxregionblocksize);
-          if (localmesh->lastX())
-            nocorner3D += Region<Ind3D>(
-                localmesh->LocalNx - localmesh->xstart, localmesh->LocalNx - 1,
-                localmesh->ystart, localmesh->yend, 0, localmesh->LocalNz - 1,
-                localmesh->LocalNy, localmesh->LocalNz, localmesh->maxregionblocksize);
-        }
-        if (localmesh->firstY() or localmesh->lastY()) {
-          for (int ix = localmesh->xstart; ix <= localmesh->xend; ix++) {
-            if (not localmesh->periodicY(ix)) {
-              if (localmesh->firstY())
-                nocorner3D +=
-                    Region<Ind3D>(ix, ix, 0, localmesh->ystart - 1, 0,
-                                  localmesh->LocalNz - 1, localmesh->LocalNy,
-                                  localmesh->LocalNz, localmesh->maxregionblocksize);
-              if (localmesh->lastY())
-                nocorner3D += Region<Ind3D>(
-                    ix, ix, localmesh->LocalNy - localmesh->ystart,
-                    localmesh->LocalNy - 1, 0, localmesh->LocalNz - 1, localmesh->LocalNy,
-                    localmesh->LocalNz, localmesh->maxregionblocksize);
-            }
-          }
-        }
-
-        nocorner3D.unique();
-        localmesh->addRegion3D("RGN_WITHBNDRIES", nocorner3D);
-      }
-
-    } else if (std::is_same<Field2D, T>::value) {
-      if (not localmesh->hasRegion2D("RGN_WITHBNDRIES")) {
-        // This avoids all guard cells and corners but includes boundaries
-        Region<Ind2D> nocorner2D = localmesh->getRegion2D("RGN_NOBNDRY");
-        if (!localmesh->periodicX) {
-          if (localmesh->firstX())
-            nocorner2D += Region<Ind2D>(0, localmesh->xstart - 1, localmesh->ystart,
-                                        localmesh->yend, 0, 0, localmesh->LocalNy, 1,
-                                        localmesh->maxregionblocksize);
-          if (localmesh->lastX())
-            nocorner2D +=
-                Region<Ind2D>(localmesh->LocalNx - localmesh->xstart,
-                              localmesh->LocalNx - 1, localmesh->ystart, localmesh->yend,
-                              0, 0, localmesh->LocalNy, 1, localmesh->maxregionblocksize);
-        }
-        if (localmesh->firstY() or localmesh->lastY()) {
-          for (int ix = localmesh->xstart; ix <= localmesh->xend; ix++) {
-            if (not localmesh->periodicY(ix)) {
-              if (localmesh->firstY())
-                nocorner2D +=
-                    Region<Ind2D>(ix, ix, 0, localmesh->ystart - 1, 0, 0,
-                                  localmesh->LocalNy, 1, localmesh->maxregionblocksize);
-              if (localmesh->lastY())
-                nocorner2D +=
-                    Region<Ind2D>(ix, ix, localmesh->LocalNy - localmesh->ystart,
-                                  localmesh->LocalNy - 1, 0, 0, localmesh->LocalNy, 1,
-                                  localmesh->maxregionblocksize);
-            }
-          }
-        }
-        nocorner2D.unique();
-        localmesh->addRegion2D("RGN_WITHBNDRIES", nocorner2D);
-      }
-
-    } else if (std::is_same<FieldPerp, T>::value) {
-      if (not localmesh->hasRegionPerp("RGN_WITHBNDRIES")) {
-        // This avoids all guard cells and corners but includes boundaries
-        Region<IndPerp> nocornerPerp = localmesh->getRegionPerp("RGN_NOBNDRY");
-        if (!localmesh->periodicX) {
-          if (localmesh->firstX())
-            nocornerPerp +=
-                Region<IndPerp>(0, localmesh->xstart - 1, 0, 0, 0, localmesh->LocalNz - 1,
-                                1, localmesh->LocalNz, localmesh->maxregionblocksize);
-          if (localmesh->lastX())
-            nocornerPerp +=
-                Region<IndPerp>(localmesh->LocalNx - localmesh->xstart,
-                                localmesh->LocalNx - 1, 0, 0, 0, localmesh->LocalNz - 1,
-                                1, localmesh->LocalNz, localmesh->maxregionblocksize);
-        }
-        nocornerPerp.unique();
-        localmesh->addRegionPerp("RGN_WITHBNDRIES", nocornerPerp);
-      }
-
-    } else {
-      throw BoutException("Invalid template type provided to InvertableOperator");
-    }
+    addRegionWithBoundaries<T>(localmesh);
 
     // Hacky way to determine the local size for now
     PetscInt nlocal = 0;
@@ -557,9 +576,471 @@ private:
 
 #else
 
+/// Class to define an invertable operator. Without PETSc, A.x = b is
+/// solved with a built-in matrix-free Krylov method: restarted GMRES
+/// (the default), BiCGStab or CG, chosen with the "ksptype" option.
+///
+/// The interface is the same as the PETSc version, except that the
+/// preconditioner function should approximate the *inverse* of the
+/// operator, and is applied as a right preconditioner. No
+/// preconditioner is used unless one is set with
+/// setPreconditionerFunction.
+///
+/// Inner products are summed over the RGN_WITHBNDRIES region on all
+/// processors. Those needed in each iteration are fused into a single
+/// MPI_Allreduce where the method allows: one per iteration for GMRES
+/// (classical Gram-Schmidt) and CG (Chronopoulos-Gear form), and two for
+/// BiCGStab. Convergence is always confirmed with the true residual
 template <typename T>
 class InvertableOperator {
+  static_assert(
+      bout::utils::is_Field<T>::value,
+      "InvertableOperator must be templated with one of FieldPerp, Field2D or Field3D");
+
 public:
+  /// What type of field does the operator take?
+  using data_type = T;
+
+  /// The signature of the functor that applies the operator.
+  using function_signature = std::function<T(const T&)>;
+
+  InvertableOperator(const function_signature& func = identity<T>,
+                     Options* optIn = nullptr, Mesh* localmeshIn = nullptr)
+      : operatorFunction(func),
+        opt(optIn == nullptr ? Options::getRoot()->getSection("invertableOperator")
+                             : optIn),
+        localmesh(localmeshIn == nullptr ? bout::globals::mesh : localmeshIn) {
+    AUTO_TRACE();
+  };
+
+  /// Allow the user to override the existing function.
+  /// alsoSetPreconditioner is only for compatibility with the PETSc
+  /// version: here the preconditioner approximates the inverse, so the
+  /// operator itself would not be a sensible choice
+  void setOperatorFunction(const function_signature& func,
+                           bool UNUSED(alsoSetPreconditioner) = true) {
+    TRACE("InvertableOperator<T>::setOperatorFunction");
+    operatorFunction = func;
+  }
+
+  /// Set a function which approximates the inverse of the operator
+  void setPreconditionerFunction(const function_signature& func) {
+    TRACE("InvertableOperator<T>::setPreconditionerFunction");
+    preconditionerFunction = func;
+    usePreconditioner = true;
+  }
+
+  /// Provide a way to apply the operator to a Field
+  T operator()(const T& input) {
+    TRACE("InvertableOperator<T>::operator()");
+    return operatorFunction(input);
+  }
+
+  /// Provide a synonym for applying the operator to a Field
+  T apply(const T& input) {
+    AUTO_TRACE();
+    return operator()(input);
+  }
+
+  /// Reads the solver options. Returns zero, to match the PetscErrorCode
+  /// returned by the PETSc version
+  int setup() {
+    TRACE("InvertableOperator<T>::setup");
+
+    Timer timer("invertable_operator_setup");
+    if (doneSetup) {
+      throw BoutException(
+          "Trying to call setup on an InvertableOperator instance that has "
+          "already been setup.");
+    }
+
+    addRegionWithBoundaries<T>(localmesh);
+
+    const auto ksptype = (*opt)["ksptype"]
+                             .doc("Krylov method: gmres, bicgstab or cg. CG requires a "
+                                  "symmetric positive definite operator")
+                             .withDefault(std::string{"gmres"});
+    if (ksptype == "gmres") {
+      method = Method::gmres;
+    } else if (ksptype == "bicgstab") {
+      method = Method::bicgstab;
+    } else if (ksptype == "cg") {
+      method = Method::cg;
+    } else {
+      throw BoutException("InvertableOperator: unknown ksptype '%s'. Valid choices are "
+                          "gmres, bicgstab and cg",
+                          ksptype.c_str());
+    }
+    method_name = ksptype;
+
+    rtol = (*opt)["rtol"].doc("Relative tolerance on the residual").withDefault(1e-5);
+    atol = (*opt)["atol"].doc("Absolute tolerance on the residual").withDefault(1e-50);
+    maxits = (*opt)["maxits"].doc("Maximum number of iterations").withDefault(10000);
+    restart = (*opt)["gmres_restart"]
+                  .doc("Number of GMRES iterations between restarts")
+                  .withDefault(30);
+    if (maxits < 1 or restart < 1) {
+      throw BoutException("InvertableOperator: maxits (%d) and gmres_restart (%d) must "
+                          "be positive",
+                          maxits, restart);
+    }
+
+    doneSetup = true;
+
+    return 0;
+  };
+
+  /// Solve A.x = b, starting from \p guess
+  T invert(const T& rhsField, const T& guess) {
+    AUTO_TRACE();
+    lastSolution = restrictToRegion(guess);
+    return invert(rhsField);
+  }
+
+  /// Triggers the solve of A.x = b for x, where b = rhs. As in the
+  /// PETSc version, the previous solution is used as the initial guess
+  T invert(const T& rhsField) {
+    TRACE("InvertableOperator<T>::invert");
+    Timer timer("invertable_operator_invert");
+
+    if (!doneSetup) {
+      throw BoutException("Trying to call invert on an InvertableOperator instance that "
+                          "has not been setup.");
+    }
+
+    ASSERT2(localmesh == rhsField.getMesh());
+
+    const T b = restrictToRegion(rhsField);
+
+    T x = zeroFrom(b);
+    if (lastSolution.isAllocated()) {
+      BOUT_FOR(i, x.getRegion(region_name)) { x[i] = lastSolution[i]; }
+    }
+
+    const BoutReal bnorm = std::sqrt(globalDots({{&b, &b}})[0]);
+    const BoutReal target = std::max(rtol * bnorm, atol);
+
+    int iterations = 0;
+    switch (method) {
+    case Method::gmres:
+      iterations = solveGMRES(b, x, target);
+      break;
+    case Method::bicgstab:
+      iterations = solveBiCGStab(b, x, target);
+      break;
+    case Method::cg:
+      iterations = solveCG(b, x, target);
+      break;
+    }
+
+    output_debug << "InvertableOperator: " << method_name << " converged in "
+                 << iterations << " iterations" << endl;
+
+    lastSolution = copy(x);
+    return x;
+  };
+
+  /// With checks enabled provides a convience routine to check that
+  /// applying the registered function on the calculated inverse gives
+  /// back the initial values.
+  bool verify(const T& rhsIn, BoutReal tol = 1.0e-5) {
+    TRACE("InvertableOperator<T>::verify");
+
+    T result = invert(rhsIn);
+    localmesh->communicate(result);
+    const T applied = operator()(result);
+    const BoutReal maxDiff = max(abs(applied - rhsIn), true);
+    if (maxDiff >= tol) {
+      output_debug << "Maximum difference in verify is " << maxDiff << endl;
+      output_debug << "Max rhs is " << max(abs(rhsIn), true) << endl;
+      output_debug << "Max applied is " << max(abs(applied), true) << endl;
+      output_debug << "Max result is " << max(abs(result), true) << endl;
+    };
+    return maxDiff < tol;
+  };
+
+  /// Reports the time spent in various parts of InvertableOperator. Note
+  /// that as the Timer "labels" are not unique to an instance the time
+  /// reported is summed across all different instances.
+  static void reportTime() {
+    TRACE("InvertableOperator<T>::reportTime");
+    BoutReal time_setup = Timer::resetTime("invertable_operator_setup");
+    BoutReal time_invert = Timer::resetTime("invertable_operator_invert");
+    BoutReal time_operate = Timer::resetTime("invertable_operator_operate");
+    BoutReal time_reduce = Timer::resetTime("invertable_operator_reduce");
+    output_warn << "InvertableOperator timing :: Setup " << time_setup;
+    output_warn << " , Invert(operation, reduction) " << time_invert << "(";
+    output_warn << time_operate << ", ";
+    output_warn << time_reduce << "). Total : " << time_setup + time_invert << endl;
+  };
+
+private:
+  enum class Method { gmres, bicgstab, cg };
+
+  /// The function that represents the operator that we wish to invert
+  function_signature operatorFunction = identity<T>;
+
+  /// Approximate inverse of the operator, used if usePreconditioner is set
+  function_signature preconditionerFunction = identity<T>;
+  bool usePreconditioner = false;
+
+  Options* opt = nullptr;
+  Mesh* localmesh = nullptr; //< To ensure we can create T on the right mesh
+  bool doneSetup = false;
+
+  Method method = Method::gmres;
+  std::string method_name;
+  BoutReal rtol, atol; ///< Relative and absolute tolerances on the residual
+  int maxits;          ///< Maximum number of iterations
+  int restart;         ///< GMRES restart length
+
+  /// Solution of the last solve, used as the next initial guess
+  T lastSolution;
+
+  /// Points which are solved for
+  const std::string region_name{"RGN_WITHBNDRIES"};
+
+  /// Copy of \p in which is zero outside the solve region
+  T restrictToRegion(const T& in) const {
+    T result = zeroFrom(in);
+    BOUT_FOR(i, in.getRegion(region_name)) { result[i] = in[i]; }
+    return result;
+  }
+
+  /// Apply \p func to the solve region of \p in. As in the PETSc
+  /// version, the input is communicated first so that \p func can use
+  /// guard cells. The result is zero outside the solve region
+  T applyFunction(const function_signature& func, const T& in) const {
+    Timer timer("invertable_operator_operate");
+    T tmp = restrictToRegion(in);
+    localmesh->communicate(tmp);
+    return restrictToRegion(func(tmp));
+  }
+
+  T applyOperator(const T& in) const { return applyFunction(operatorFunction, in); }
+
+  T applyPreconditioner(const T& in) const {
+    return usePreconditioner ? applyFunction(preconditionerFunction, in) : in;
+  }
+
+  /// Inner products of each pair of fields, summed over the solve
+  /// region on all processors with a single MPI_Allreduce
+  std::vector<BoutReal>
+  globalDots(const std::vector<std::pair<const T*, const T*>>& pairs) const {
+    Timer timer("invertable_operator_reduce");
+
+    std::vector<BoutReal> local(pairs.size()), global(pairs.size());
+    for (std::size_t n = 0; n < pairs.size(); ++n) {
+      const T& a = *pairs[n].first;
+      const T& b = *pairs[n].second;
+      BoutReal sum = 0.0;
+      BOUT_FOR_OMP(i, a.getRegion(region_name), parallel for reduction(+:sum)) {
+        sum += a[i] * b[i];
+      }
+      local[n] = sum;
+    }
+
+    MPI_Allreduce(local.data(), global.data(), static_cast<int>(pairs.size()),
+                  MPI_DOUBLE, MPI_SUM, BoutComm::get());
+    return global;
+  }
+
+  void checkIterations(int iterations, BoutReal residual, BoutReal target) const {
+    if (iterations >= maxits) {
+      throw BoutException("InvertableOperator: %s did not converge in %d iterations. "
+                          "Residual %e, target %e",
+                          method_name.c_str(), iterations, residual, target);
+    }
+  }
+
+  /// Restarted GMRES with right preconditioning. The Arnoldi vectors
+  /// are orthogonalised with classical Gram-Schmidt, so the projections
+  /// and the norm of each new vector take a single reduction; a second
+  /// pass is made only if cancellation makes the norm inaccurate
+  int solveGMRES(const T& b, T& x, BoutReal target) {
+    std::vector<T> basis(restart + 1);
+    Matrix<BoutReal> hessenberg(restart + 1, restart);
+    std::vector<BoutReal> cs(restart), sn(restart), g(restart + 1);
+
+    int iterations = 0;
+    while (true) {
+      T r = b - applyOperator(x);
+      const BoutReal beta = std::sqrt(globalDots({{&r, &r}})[0]);
+      if (beta <= target) {
+        return iterations;
+      }
+      checkIterations(iterations, beta, target);
+
+      basis[0] = r / beta;
+      std::fill(g.begin(), g.end(), 0.0);
+      g[0] = beta;
+
+      int k = 0;
+      while (k < restart and iterations < maxits) {
+        T w = applyOperator(applyPreconditioner(basis[k]));
+
+        std::vector<std::pair<const T*, const T*>> pairs;
+        for (int j = 0; j <= k; ++j) {
+          pairs.emplace_back(&basis[j], &w);
+        }
+        pairs.emplace_back(&w, &w);
+
+        auto dots = globalDots(pairs);
+        BoutReal wnorm2 = dots[k + 1];
+        const BoutReal wnorm2_initial = wnorm2;
+        for (int j = 0; j <= k; ++j) {
+          hessenberg(j, k) = dots[j];
+          w -= dots[j] * basis[j];
+          wnorm2 -= SQ(dots[j]);
+        }
+
+        if (wnorm2 < 0.5 * wnorm2_initial) {
+          // Lost more than ~30% of the norm: reorthogonalise
+          dots = globalDots(pairs);
+          wnorm2 = dots[k + 1];
+          for (int j = 0; j <= k; ++j) {
+            hessenberg(j, k) += dots[j];
+            w -= dots[j] * basis[j];
+            wnorm2 -= SQ(dots[j]);
+          }
+        }
+        const BoutReal wnorm = std::sqrt(std::max(wnorm2, 0.0));
+        ++iterations;
+
+        // Reduce the Hessenberg matrix to upper triangular with Givens rotations
+        for (int j = 0; j < k; ++j) {
+          const BoutReal temp = cs[j] * hessenberg(j, k) + sn[j] * hessenberg(j + 1, k);
+          hessenberg(j + 1, k) = -sn[j] * hessenberg(j, k) + cs[j] * hessenberg(j + 1, k);
+          hessenberg(j, k) = temp;
+        }
+        const BoutReal denominator = std::hypot(hessenberg(k, k), wnorm);
+        if (denominator == 0.0) {
+          throw BoutException("InvertableOperator: GMRES breakdown, operator is singular");
+        }
+        cs[k] = hessenberg(k, k) / denominator;
+        sn[k] = wnorm / denominator;
+        hessenberg(k, k) = denominator;
+        g[k + 1] = -sn[k] * g[k];
+        g[k] = cs[k] * g[k];
+        ++k;
+
+        if (std::abs(g[k]) <= target or wnorm == 0.0) {
+          break;
+        }
+        basis[k] = w / wnorm;
+      }
+
+      // Back substitution for the coefficients of the basis vectors
+      std::vector<BoutReal> y(k);
+      for (int i = k - 1; i >= 0; --i) {
+        y[i] = g[i];
+        for (int j = i + 1; j < k; ++j) {
+          y[i] -= hessenberg(i, j) * y[j];
+        }
+        y[i] /= hessenberg(i, i);
+      }
+      T update = y[0] * basis[0];
+      for (int j = 1; j < k; ++j) {
+        update += y[j] * basis[j];
+      }
+      x += applyPreconditioner(update);
+    }
+  }
+
+  /// Right preconditioned BiCGStab. The residual norm and the next
+  /// rho are found from inner products with s and t, so that each
+  /// iteration needs two reductions
+  int solveBiCGStab(const T& b, T& x, BoutReal target) {
+    int iterations = 0;
+    while (true) {
+      T r = b - applyOperator(x);
+      const T rhat = copy(r);
+      BoutReal rnorm2 = globalDots({{&r, &r}})[0];
+      if (std::sqrt(rnorm2) <= target) {
+        return iterations;
+      }
+      BoutReal rho = rnorm2;
+      T p = copy(r);
+
+      while (true) {
+        checkIterations(iterations, std::sqrt(rnorm2), target);
+
+        const T phat = applyPreconditioner(p);
+        const T v = applyOperator(phat);
+        const BoutReal rhat_v = globalDots({{&rhat, &v}})[0];
+        if (rhat_v == 0.0) {
+          throw BoutException("InvertableOperator: BiCGStab breakdown");
+        }
+        const BoutReal alpha = rho / rhat_v;
+
+        const T s = r - alpha * v;
+        const T shat = applyPreconditioner(s);
+        const T t = applyOperator(shat);
+        const auto dots =
+            globalDots({{&t, &s}, {&t, &t}, {&s, &s}, {&rhat, &s}, {&rhat, &t}});
+        ++iterations;
+
+        const BoutReal omega = dots[1] > 0.0 ? dots[0] / dots[1] : 0.0;
+        x += alpha * phat + omega * shat;
+        r = s - omega * t;
+        rnorm2 = std::max(dots[2] - 2. * omega * dots[0] + SQ(omega) * dots[1], 0.0);
+        if (std::sqrt(rnorm2) <= target) {
+          // Check the true residual
+          break;
+        }
+
+        const BoutReal rho_next = dots[3] - omega * dots[4];
+        if (omega == 0.0 or rho_next == 0.0) {
+          throw BoutException("InvertableOperator: BiCGStab breakdown");
+        }
+        const BoutReal beta = (rho_next / rho) * (alpha / omega);
+        p = r + beta * (p - omega * v);
+        rho = rho_next;
+      }
+    }
+  }
+
+  /// Preconditioned CG in the Chronopoulos-Gear form, which needs one
+  /// reduction per iteration. The operator and preconditioner must both
+  /// be symmetric positive definite
+  int solveCG(const T& b, T& x, BoutReal target) {
+    int iterations = 0;
+    while (true) {
+      T r = b - applyOperator(x);
+      T u = applyPreconditioner(r);
+      T w = applyOperator(u);
+      auto dots = globalDots({{&r, &u}, {&w, &u}, {&r, &r}});
+      if (std::sqrt(dots[2]) <= target) {
+        return iterations;
+      }
+
+      BoutReal gamma = dots[0];
+      BoutReal alpha = gamma / dots[1];
+      T p = u;
+      T s = w;
+
+      while (std::sqrt(dots[2]) > target) {
+        checkIterations(iterations, std::sqrt(dots[2]), target);
+        if (!(alpha > 0.0)) {
+          throw BoutException("InvertableOperator: CG requires a symmetric positive "
+                              "definite operator and preconditioner");
+        }
+        x += alpha * p;
+        r -= alpha * s;
+        u = applyPreconditioner(r);
+        w = applyOperator(u);
+        dots = globalDots({{&r, &u}, {&w, &u}, {&r, &r}});
+        ++iterations;
+
+        const BoutReal gamma_next = dots[0];
+        const BoutReal beta = gamma_next / gamma;
+        alpha = gamma_next / (dots[1] - beta * gamma_next / alpha);
+        gamma = gamma_next;
+        p = u + beta * p;
+        s = w + beta * s;
+      }
+    }
+  }
 };
 
 #endif // PETSC
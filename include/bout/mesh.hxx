@@ -945,6 +945,17 @@ protected:
   /// Set whether to call calcParallelSlices on all communicated fields (true) or not (false)
   bool calcParallelSlices_on_communicate{true};
 
+  /// If calcParallelSlices_on_communicate, only calculate the parallel
+  /// slices when they are first used (true), rather than straight away
+  /// (false). Lazy slices are calculated one field at a time, so are
+  /// never grouped by calcParallelSlicesGroup
+  bool lazy_parallel_slices{false};
+
+  /// If the parallel slices are not lazy, and at least this many
+  /// fields are communicated together, calculate their parallel
+  /// slices with ParallelTransform::calcParallelSlicesGroup
+  int parallel_slices_group_size{4};
+
   /// Read a 1D array of integers
   const std::vector<int> readInts(const std::string &name, int n);
   
@@ -7,9 +7,12 @@
 #define __PARALLELTRANSFORM_H__
 
 #include "bout_types.hxx"
+#include "bout/bout_enum_class.hxx"
 #include "field3d.hxx"
 #include "unused.hxx"
 
+#include <vector>
+
 class Mesh;
 
 /*!
@@ -28,6 +31,15 @@ public:
   /// Given a 3D field, calculate and set the Y up down fields
   virtual void calcParallelSlices(Field3D &f) = 0;
 
+  /// Calculate the Y up down fields of all of \p fields, which use
+  /// this transform. Transforms which can share work between fields
+  /// should override this
+  virtual void calcParallelSlicesGroup(const std::vector<Field3D*>& fields) {
+    for (auto* f : fields) {
+      calcParallelSlices(*f);
+    }
+  }
+
   [[deprecated("Please use ParallelTransform::calcParallelSlices instead")]]
   void calcYupYdown(Field3D& f) {
     calcParallelSlices(f);
@@ -74,6 +86,30 @@ public:
     return fromFieldAligned(f, toString(region));
   }
 
+  /// Convert all of \p fields into field-aligned coordinates.
+  /// Transforms which can share work between fields should override this
+  virtual std::vector<Field3D> toFieldAlignedGroup(const std::vector<Field3D>& fields,
+                                                   const std::string& region = "RGN_ALL") {
+    std::vector<Field3D> result;
+    result.reserve(fields.size());
+    for (const auto& f : fields) {
+      result.push_back(toFieldAligned(f, region));
+    }
+    return result;
+  }
+
+  /// Convert all of \p fields back from field-aligned coordinates
+  virtual std::vector<Field3D>
+  fromFieldAlignedGroup(const std::vector<Field3D>& fields,
+                        const std::string& region = "RGN_ALL") {
+    std::vector<Field3D> result;
+    result.reserve(fields.size());
+    for (const auto& f : fields) {
+      result.push_back(fromFieldAligned(f, region));
+    }
+    return result;
+  }
+
   virtual bool canToFromFieldAligned() = 0;
 
   /// Output variables used by a ParallelTransform instance to the dump files
@@ -151,18 +187,26 @@ protected:
   void checkInputGrid() override;
 };
 
+/// How ShiftedMetric shifts fields in Z: exactly, with FFTs, or by
+/// local interpolation, using stencils of 4 (cubic) or 6 (quintic) points
+BOUT_ENUM_CLASS(ZShiftMethod, fft, lagrange4pt, lagrange6pt, hermitespline);
+
 /*!
  * Shifted metric method
  * Each Y location is shifted in Z with respect to its neighbours
  * so that the grid is orthogonal in X-Z, but requires interpolation
  * to calculate the values of points along field-lines.
  *
- * In this implementation the interpolation is done using FFTs in Z
+ * By default the interpolation is done using FFTs in Z. For
+ * well-resolved fields, local interpolation with precomputed stencils
+ * can be cheaper, but it is not exact: shifting to field-aligned and
+ * back does not return the original field
  */
 class ShiftedMetric : public ParallelTransform {
 public:
   ShiftedMetric() = delete;
-  ShiftedMetric(Mesh& mesh, CELL_LOC location, Field2D zShift, BoutReal zlength_in);
+  ShiftedMetric(Mesh& mesh, CELL_LOC location, Field2D zShift, BoutReal zlength_in,
+                ZShiftMethod method = ZShiftMethod::fft);
 
   /*!
    * Calculates the yup() and ydown() fields of f
@@ -191,6 +235,12 @@ public:
   const FieldPerp fromFieldAligned(const FieldPerp& f,
                                    const std::string& region = "RGN_ALL") override;
 
+  /// Shift all the fields together, reading each phase once
+  std::vector<Field3D> toFieldAlignedGroup(const std::vector<Field3D>& fields,
+                                           const std::string& region = "RGN_ALL") override;
+  std::vector<Field3D> fromFieldAlignedGroup(const std::vector<Field3D>& fields,
+                                             const std::string& region = "RGN_ALL") override;
+
   bool canToFromFieldAligned() override { return true; }
 
   /// Save zShift to the output
@@ -218,8 +268,25 @@ private:
   /// Length of the z-domain in radians
   BoutReal zlength{0.};
 
+  /// How to shift in Z
+  ZShiftMethod method{ZShiftMethod::fft};
+
   int nmodes;
 
+  /// Number of points in the interpolation stencils, 0 for FFTs
+  int stencil_width{0};
+
+  /// Interpolation stencils for shifting each (x, y) column in Z.
+  /// Point z of the result is the sum over n < stencil_width of
+  /// weights(x, y, n) * f(x, y, (z + start(x, y) + n) % nz)
+  struct ShiftStencil {
+    Matrix<int> start;
+    Tensor<BoutReal> weights;
+  };
+
+  ShiftStencil toAlignedStencil;   ///< Stencils for shifting to field-aligned
+  ShiftStencil fromAlignedStencil; ///< Stencils for shifting from field-aligned
+
   Tensor<dcomplex> toAlignedPhs;   ///< Cache of phase shifts for transforming from X-Z
                                    /// orthogonal coordinates to field-aligned coordinates
   Tensor<dcomplex> fromAlignedPhs; ///< Cache of phase shifts for transforming from
@@ -229,6 +296,7 @@ private:
   /// Helper POD for parallel slice phase shifts
   struct ParallelSlicePhase {
     Tensor<dcomplex> phase_shift;
+    ShiftStencil stencil;
     int y_offset;
   };
 
@@ -288,6 +356,38 @@ private:
                          const YDirectionType y_direction_out,
                          const std::string& region = "RGN_NOX") const;
 
+  /*!
+   * Shift all of \p fields by the phase \p phs in Z
+   *
+   * The columns in each contiguous block of \p region are Fourier
+   * transformed together, and the phases of each column are read
+   * once and applied to all the fields
+   */
+  std::vector<Field3D> shiftZ(const std::vector<Field3D>& fields,
+                              const Tensor<dcomplex>& phs,
+                              const YDirectionType y_direction_out,
+                              const std::string& region = "RGN_NOX") const;
+
+  /*!
+   * Shift a 3D field, all of \p fields or a FieldPerp \p f in Z by
+   * interpolating with \p stencil, without FFTs
+   */
+  const Field3D shiftZ(const Field3D& f, const ShiftStencil& stencil,
+                       const YDirectionType y_direction_out,
+                       const std::string& region = "RGN_NOX") const;
+  std::vector<Field3D> shiftZ(const std::vector<Field3D>& fields,
+                              const ShiftStencil& stencil,
+                              const YDirectionType y_direction_out,
+                              const std::string& region = "RGN_NOX") const;
+  const FieldPerp shiftZ(const FieldPerp& f, const ShiftStencil& stencil,
+                         const YDirectionType y_direction_out,
+                         const std::string& region = "RGN_NOX") const;
+
+  /// Empty copies of \p fields to shift into, or copies if there is
+  /// only one point in Z, with Y direction \p y_direction_out
+  std::vector<Field3D> emptyShifted(const std::vector<Field3D>& fields,
+                                    const YDirectionType y_direction_out) const;
+
   /*!
    * Shift a given 1D array, assumed to be in Z, by the given \p zangle
    *
@@ -298,20 +398,14 @@ private:
    */
   void shiftZ(const BoutReal* in, int len, BoutReal zangle, BoutReal* out) const;
 
-  /*!
-   * Shift a given 1D array, assumed to be in Z, by the given \p zangle
-   *
-   * @param[in] in  A 1D array of length mesh.LocalNz
-   * @param[in] phs Phase shift, assumed to have length (mesh.LocalNz/2 + 1) i.e. the
-   * number of modes
-   * @param[out] out  A 1D array of length mesh.LocalNz, already allocated
-   */
-  void shiftZ(const BoutReal* in, const dcomplex* phs, BoutReal* out) const;
-
-  /// Calculate and store the phases for to/from field aligned and for
-  /// the parallel slices using zShift
+  /// Calculate and store the phases, or the interpolation stencils,
+  /// for to/from field aligned and for the parallel slices using zShift
   void cachePhases();
 
+  /// Set the stencil at (\p x, \p y) to interpolate each point of a
+  /// column at a position \p shift further along in Z
+  void setStencil(ShiftStencil& stencil, int x, int y, BoutReal shift) const;
+
   /// Shift a 3D field \p f in Z to all the parallel slices in \p phases
   ///
   /// @param[in] f      The field to shift
@@ -319,6 +413,13 @@ private:
   /// @return The shifted parallel slices
   std::vector<Field3D> shiftZ(const Field3D& f,
                               const std::vector<ParallelSlicePhase>& phases) const;
+
+  /// Shift a 3D field \p f in Z to all the parallel slices in \p
+  /// phases, storing the slice for phases[i] in \p results[i], which
+  /// must be allocated. The columns of \p f are each Fourier
+  /// transformed once, in batches, and reused for every slice
+  void shiftZ(const Field3D& f, const std::vector<ParallelSlicePhase>& phases,
+              const std::vector<Field3D*>& results) const;
 };
 
 #endif // __PARALLELTRANSFORM_H__
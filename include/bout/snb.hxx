@@ -34,6 +34,10 @@ public:
                    .doc("Maximum energy group to consider (multiple of eT)")
                    .withDefault(beta_max);
     ngroups = options["ngroups"].doc("Number of energy groups").withDefault(ngroups);
+    batch_groups = options["batch_groups"]
+                       .doc("Solve for all energy groups together, sharing communication. "
+                            "Needs memory for all groups at once")
+                       .withDefault(batch_groups);
   }
 
   ~HeatFluxSNB() = default;
@@ -64,6 +68,7 @@ private:
   BoutReal r{2};           ///< Electron-electron mean free path scaling factor
   BoutReal beta_max{10.0}; ///< Maximum energy group to consider (multiple of eT)
   int ngroups{40};         ///< Number of energy groups
+  bool batch_groups{false}; ///< Solve all groups in one batched inversion?
 
   /// Indefinite integral of beta^4 * exp(-beta)
   /// with constant set to zero
@@ -75,6 +80,19 @@ private:
   BoutReal groupWeight(BoutReal beta_min, BoutReal beta_max) {
     return (1. / 24) * (int_beta4_exp(beta_max) - int_beta4_exp(beta_min));
   }
+
+  /// An energy group, and the parallel inversion which gives its H_g
+  struct EnergyGroup {
+    BoutReal weight;             ///< Weight of this group
+    Field3D lambda_g_ee;         ///< Electron-electron mean free path
+    InvertPar::Coefficients coefs; ///< Coefficients for invertpar
+  };
+
+  /// Set up the energy group from \p beta_min to \p beta, given the
+  /// scaled thermal mean free paths
+  EnergyGroup energyGroup(BoutReal beta_min, BoutReal beta,
+                          const Field3D& lambda_ee_Tprime,
+                          const Field3D& lambda_ei_Tprime, Coordinates* coord);
 };
 
 } // namespace bout
@@ -66,6 +66,11 @@ public:
 
   /// Create a string representation of the generator, for debugging output
   virtual std::string str() const { return std::string("?"); }
+
+  /// Might the generated values change with t? Generators with
+  /// arguments should ask their arguments. Generators which can't
+  /// tell are assumed to change
+  virtual bool isTimeDependent() const { return true; }
 };
 
 /*!
@@ -166,6 +171,9 @@ public:
     return std::string("(") + lhs->str() + std::string(1, op) + rhs->str()
            + std::string(")");
   }
+  bool isTimeDependent() const override {
+    return lhs->isTimeDependent() or rhs->isTimeDependent();
+  }
 
 private:
   FieldGeneratorPtr lhs, rhs;
@@ -190,6 +198,7 @@ public:
     ss << value;
     return ss.str();
   }
+  bool isTimeDependent() const override { return false; }
 
 private:
   double value;
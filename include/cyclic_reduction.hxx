@@ -54,6 +54,8 @@
 
 #include "bout/openmpwrap.hxx"
 
+#include <algorithm>
+
 template <class T> class CyclicReduce {
 public:
   CyclicReduce() = default;
@@ -72,10 +74,13 @@ public:
     int np, myp;
     MPI_Comm_size(c, &np);
     MPI_Comm_rank(c, &myp);
-    if ((size != N) || (np != nprocs) || (myp != myproc))
+    if ((size != N) || (np != nprocs) || (myp != myproc)) {
       Nsys = 0; // Need to re-size
+      Nif = 0;
+    }
     N = size;
     periodic = false;
+    factorised = false;
     nprocs = np;
     myproc = myp;
   }
@@ -84,7 +89,11 @@ public:
 
   /// Specify that the tridiagonal system is periodic
   /// By default not periodic
-  void setPeriodic(bool p = true) { periodic = p; }
+  void setPeriodic(bool p = true) {
+    if (p != periodic)
+      factorised = false;
+    periodic = p;
+  }
 
   void setCoefs(const Array<T> &a, const Array<T> &b, const Array<T> &c) {
     ASSERT2(a.size() == b.size());
@@ -111,6 +120,11 @@ public:
   ///                where N is set in the constructor or setup
   /// @param[in] b   Diagonal values. Should have size [nsys][N]
   /// @param[in] c   Right diagonal. Should have size [nsys][N]
+  ///
+  /// The systems are factorised here, so that any number of calls to
+  /// solve() with different RHS can follow without repeating the
+  /// elimination of the coefficients. Each call to solve() may also
+  /// pass several RHS for every system
   void setCoefs(const Matrix<T>& a, const Matrix<T>& b, const Matrix<T>& c) {
     TRACE("CyclicReduce::setCoefs");
 
@@ -119,16 +133,27 @@ public:
     // Make sure correct memory arrays allocated
     allocMemory(nprocs, nsys, N);
 
-    // Fill coefficient array
+    // Fill coefficient array. Systems are interleaved in blocks of
+    // batch_width, so unused lanes of the last block are set to the
+    // identity to avoid zero pivots
+    coefs.ensureUnique();
     BOUT_OMP(parallel for)
-    for (int j = 0; j < Nsys; j++) {
+    for (int j = 0; j < nblocks * batch_width; j++) {
       for (int i = 0; i < N; i++) {
-        coefs(j, 4 * i) = a(j, i);
-        coefs(j, 4 * i + 1) = b(j, i);
-        coefs(j, 4 * i + 2) = c(j, i);
-        // 4*i + 3 will contain RHS
+        if (j < Nsys) {
+          coef(j, i, 0) = a(j, i);
+          coef(j, i, 1) = b(j, i);
+          coef(j, i, 2) = c(j, i);
+        } else {
+          coef(j, i, 0) = 0.0;
+          coef(j, i, 1) = 1.0;
+          coef(j, i, 2) = 0.0;
+        }
       }
     }
+
+    // Factorise now, so that later solves only sweep the RHS
+    factorise();
   }
 
   /// Solve a set of tridiagonal systems
@@ -160,43 +185,67 @@ public:
 
   /// Solve a set of tridiagonal systems
   ///
+  /// The number of rows in \p rhs can be any multiple of the number
+  /// of systems passed to setCoefs: row r * nsys + j is solved with
+  /// the matrix of system j, reusing its factorisation. All the RHS
+  /// are solved together, sharing one set of messages.
+  ///
   /// @param[in] rhs Matrix storing Values of the rhs for each system
   /// @param[out] x  Matrix storing the result for each system
   void solve(const Matrix<T> &rhs, Matrix<T> &x) {
     TRACE("CyclicReduce::solve");
-    ASSERT2(static_cast<int>(std::get<0>(rhs.shape())) == Nsys);
-    ASSERT2(static_cast<int>(std::get<0>(x.shape())) == Nsys);
+    ASSERT2(std::get<0>(rhs.shape()) == std::get<0>(x.shape()));
     ASSERT2(static_cast<int>(std::get<1>(rhs.shape())) == N);
     ASSERT2(static_cast<int>(std::get<1>(x.shape())) == N);
 
     // Multiple RHS
     int nrhs = std::get<0>(rhs.shape());
 
-    if (nrhs != Nsys)
-      throw BoutException("Sorry, can't yet handle nrhs != nsys");
+    if ((Nsys == 0) || (nrhs % Nsys != 0)) {
+      throw BoutException("CyclicReduce::solve: number of RHS (%d) is not a multiple "
+                          "of the number of systems (%d)",
+                          nrhs, Nsys);
+    }
+    allocRHS(nrhs);
 
-    // Insert RHS into coefs array. Ordered to allow efficient partitioning
-    // for MPI send/receives
+    // Insert RHS into rhsb array, with the same interleaving as coefs.
+    // Padding lanes have zero RHS
+    rhsb.ensureUnique();
     BOUT_OMP(parallel for)
-    for (int j = 0; j < Nsys; j++) {
-      for (int i = 0; i < N; i++) {
-        coefs(j, 4 * i + 3) = rhs(j, i);
+    for (int rb = 0; rb < nrhsblocks; rb++) {
+      const int r = rb / nblocks;
+      const int j0 = (rb % nblocks) * batch_width;
+      for (int l = 0; l < batch_width; l++) {
+        for (int i = 0; i < N; i++) {
+          rhsb(rb, i * batch_width + l) =
+              (j0 + l < Nsys) ? rhs(r * Nsys + j0 + l, i) : 0.0;
+        }
       }
     }
 
+    // Coefficients are factorised in setCoefs, but may need redoing
+    // if the periodicity has been changed since
+    ensureFactorised();
+
+    if ((nprocs == 1) && !periodic) {
+      // Nothing to communicate, so solve directly
+      thomasLocal(x);
+      return;
+    }
+
     ///////////////////////////////////////
     // Reduce local part of the matrix to interface equations
-    reduce(Nsys, N, coefs, myif);
+    reduceLocal();
 
     ///////////////////////////////////////
     // Gather all interface equations onto single processor
     // NOTE: Need to replace with divide-and-conquer at some point
     //
-    // There are Nsys sets of equations to gather, and nprocs processors
+    // There are Nif sets of equations to gather, and nprocs processors
     // which can be used. Each processor therefore sends interface equations
     // to several different processors for gathering
     //
-    // e.g. 3 processors (nproc=3), 4 sets of equations (Nsys=4):
+    // e.g. 3 processors (nproc=3), 4 sets of equations (Nif=4):
     //
     // PE 0: [1a 2a 3a 4a]  PE 1: [1b 2b 3b 4b]  PE 2: [1c 2c 3c 4c]
     //
@@ -207,8 +256,8 @@ public:
     //
     // Here PE 0 would have myns=2, PE 1 and 2 would have myns=1
 
-    int ns = Nsys / nprocs;      // Number of systems to assign to all processors
-    int nsextra = Nsys % nprocs; // Number of processors with 1 extra
+    int ns = Nif / nprocs;      // Number of systems to assign to all processors
+    int nsextra = Nif % nprocs; // Number of processors with 1 extra
 
     auto* req = new MPI_Request[nprocs];
 
@@ -427,7 +476,7 @@ public:
 
     ///////////////////////////////////////
     // Solve local equations
-    back_solve(Nsys, N, coefs, x1, xn, x);
+    backSolveLocal(x);
     delete[] req;
   }
 
@@ -437,13 +486,30 @@ private:
 
   int N{0};    ///< Total size of the problem
   int Nsys{0}; ///< Number of independent systems to solve
+  int Nif{0};  ///< Number of interface systems: Nsys times the number of RHS per system
   int myns;    ///< Number of systems for interface solve on this processor
   int sys0;    ///< Starting system index for interface solve
 
   bool periodic{false}; ///< Is the domain periodic?
 
-  Matrix<T> coefs; ///< Starting coefficients, rhs [Nsys, {3*coef,rhs}*N]
-  Matrix<T> myif;  ///< Interface equations for this processor
+  /// Number of systems interleaved in each block of coefs. Within a
+  /// block the systems are the fastest varying index, so the local
+  /// elimination is vectorised across systems
+  static constexpr int batch_width = 8;
+  int nblocks{0}; ///< Number of blocks of batch_width systems
+
+  Matrix<T> coefs; ///< Starting coefficients [nblocks, N*{a,b,c}*batch_width]
+  Matrix<T> factors; ///< RHS-independent elimination factors [nblocks, N*4*batch_width]
+  bool factorised{false};       ///< Do the factors match the coefficients?
+  bool factorised_local{false}; ///< Were the factors made for the serial Thomas solve?
+  Matrix<T> ifcoefs; ///< Interface equation coefficients from factorise [Nsys, 8]
+
+  /// RHS, interleaved like coefs. Block r * nblocks + b contains the
+  /// RHS r of the systems in block b [nrhsblocks, N*batch_width]
+  Matrix<T> rhsb;
+  int nrhsblocks{0}; ///< Number of blocks in rhsb
+
+  Matrix<T> myif;  ///< Interface equations for this processor [Nif, 8]
 
   Matrix<T> recvbuffer; ///< Buffer for receiving from other processors
   Matrix<T> ifcs;       ///< Coefficients for interface solve
@@ -464,9 +530,29 @@ private:
     Nsys = nsys;
     N = n;
 
+    nblocks = (Nsys + batch_width - 1) / batch_width;
+    coefs.reallocate(nblocks, 3 * N * batch_width);
+    factors.reallocate(nblocks, 4 * N * batch_width);
+    ifcoefs.reallocate(Nsys, 8);
+
+    // Interface arrays depend on the number of RHS
+    Nif = 0;
+    nrhsblocks = 0;
+  }
+
+  /// Allocate the RHS and interface memory arrays
+  /// @param[in] nrhs  Total number of RHS, a multiple of Nsys
+  void allocRHS(int nrhs) {
+    if (nrhs == Nif)
+      return; // No need to allocate memory
+
+    Nif = nrhs;
+    nrhsblocks = (nrhs / Nsys) * nblocks;
+    rhsb.reallocate(nrhsblocks, N * batch_width);
+
     // Work out how many systems are going to be solved on this processor
-    int ns = nsys / nprocs;      // Number of systems to assign to all processors
-    int nsextra = nsys % nprocs; // Number of processors with 1 extra
+    int ns = Nif / nprocs;      // Number of systems to assign to all processors
+    int nsextra = Nif % nprocs; // Number of processors with 1 extra
 
     myns = ns;          // Number of systems to gather onto this processor
     sys0 = ns * myproc; // Starting system number
@@ -477,8 +563,7 @@ private:
       sys0 += nsextra;
     }
 
-    coefs.reallocate(Nsys, 4 * N);
-    myif.reallocate(Nsys, 8);
+    myif.reallocate(Nif, 8);
 
     // Note: The recvbuffer is used to receive data in both stages of the solve:
     //  1. In the gather step, this processor will receive myns interface equations
@@ -501,8 +586,314 @@ private:
     // Each system to be solved on this processor has two interface equations from each
     // processor
 
-    x1.reallocate(Nsys);
-    xn.reallocate(Nsys);
+    x1.reallocate(Nif);
+    xn.reallocate(Nif);
+  }
+
+  /// Coefficient \p k (a, b, c) of row \p i of system \p j in coefs
+  T& coef(int j, int i, int k) {
+    return coefs(j / batch_width, (3 * i + k) * batch_width + j % batch_width);
+  }
+
+  /// Factor \p f of row \p i in block \p blk of factors
+  T& factor(int blk, int i, int f) { return factors(blk, (4 * i + f) * batch_width); }
+
+  /// Factorise the local systems in coefs, storing the parts of the
+  /// elimination which don't depend on the RHS. Repeated solves with
+  /// the same coefficients then only need to sweep the RHS.
+  ///
+  /// Without communication the factors are the Thomas algorithm
+  /// (gam, 1/bet) in slots 0 and 1. Otherwise slots 0 and 1 contain
+  /// the Thomas factors of the interior rows for the back-solve, slot
+  /// 2 the multipliers for the upper interface equation and slot 3
+  /// those for the lower interface equation. The interface equation
+  /// coefficients are stored in ifcoefs, and only the RHS of the
+  /// interface equations are calculated in each solve.
+  void factorise() {
+    factors.ensureUnique();
+    ifcoefs.ensureUnique();
+
+    const bool local = (nprocs == 1) && !periodic;
+
+    // Exceptions can't leave the parallel region, so zero pivots are
+    // counted and the exception thrown afterwards
+    int zero_pivots = 0;
+
+    BOUT_OMP(parallel for reduction(+:zero_pivots))
+    for (int blk = 0; blk < nblocks; blk++) {
+      const T* co = &coefs(blk, 0);
+
+      if (local) {
+        T* ibet0 = &factor(blk, 0, 1);
+        T bet[batch_width];
+        for (int l = 0; l < batch_width; l++) {
+          bet[l] = co[batch_width + l]; // b[0]
+          zero_pivots += isZeroPivot(bet[l]);
+          ibet0[l] = 1.0 / bet[l];
+        }
+        for (int i = 1; i < N; i++) {
+          const T* ai = co + 3 * i * batch_width;
+          const T* bi = ai + batch_width;
+          const T* ci_1 = co + (3 * (i - 1) + 2) * batch_width;
+          T* gi = &factor(blk, i, 0);
+          T* ibi = &factor(blk, i, 1);
+          for (int l = 0; l < batch_width; l++) {
+            gi[l] = ci_1[l] / bet[l];
+            bet[l] = bi[l] - ai[l] * gi[l];
+            zero_pivots += isZeroPivot(bet[l]);
+            ibi[l] = 1.0 / bet[l];
+          }
+        }
+        continue;
+      }
+
+      T up[3][batch_width], lo[3][batch_width];
+
+      // Upper interface equation, starting from row N-2
+      for (int k = 0; k < 3; k++) {
+        for (int l = 0; l < batch_width; l++) {
+          up[k][l] = co[(3 * (N - 2) + k) * batch_width + l];
+        }
+      }
+      for (int i = N - 3; i >= 0; i--) {
+        const T* ai = co + 3 * i * batch_width;
+        const T* bi = ai + batch_width;
+        const T* ci = bi + batch_width;
+        T* beta = &factor(blk, i, 2);
+        for (int l = 0; l < batch_width; l++) {
+          zero_pivots += isZeroPivot(up[1][l]);
+          beta[l] = ci[l] / up[1][l];
+          up[1][l] = bi[l] - beta[l] * up[0][l];
+          up[0][l] = ai[l];
+          up[2][l] *= -beta[l];
+        }
+      }
+
+      // Lower interface equation, starting from row 1
+      for (int k = 0; k < 3; k++) {
+        for (int l = 0; l < batch_width; l++) {
+          lo[k][l] = co[(3 + k) * batch_width + l];
+        }
+      }
+      for (int i = 2; i < N; i++) {
+        const T* ai = co + 3 * i * batch_width;
+        const T* bi = ai + batch_width;
+        const T* ci = bi + batch_width;
+        T* alpha = &factor(blk, i, 3);
+        for (int l = 0; l < batch_width; l++) {
+          zero_pivots += isZeroPivot(lo[1][l]);
+          alpha[l] = ai[l] / lo[1][l];
+          lo[0][l] *= -alpha[l];
+          lo[1][l] = bi[l] - alpha[l] * lo[2][l];
+          lo[2][l] = ci[l];
+        }
+      }
+
+      const int j0 = blk * batch_width;
+      const int nlanes = std::min(batch_width, Nsys - j0);
+      for (int l = 0; l < nlanes; l++) {
+        zero_pivots += isZeroPivot(up[1][l]) + isZeroPivot(lo[1][l]);
+        for (int k = 0; k < 3; k++) {
+          ifcoefs(j0 + l, k) = up[k][l];
+          ifcoefs(j0 + l, 4 + k) = lo[k][l];
+        }
+      }
+
+      // Thomas factors of interior rows 1..N-2, given x_0 and x_{N-1}
+      {
+        T* g1 = &factor(blk, 1, 0);
+        for (int l = 0; l < batch_width; l++) {
+          g1[l] = 0.0;
+        }
+      }
+      for (int i = 1; i < N - 1; i++) {
+        const T* ai = co + 3 * i * batch_width;
+        const T* bi = ai + batch_width;
+        const T* ci = bi + batch_width;
+        const T* gi = &factor(blk, i, 0);
+        T* ibi = &factor(blk, i, 1);
+        T* gi1 = &factor(blk, i + 1, 0);
+        for (int l = 0; l < batch_width; l++) {
+          const T bet = bi[l] - ai[l] * gi[l];
+          zero_pivots += isZeroPivot(bet);
+          ibi[l] = 1.0 / bet;
+          gi1[l] = ci[l] * ibi[l];
+        }
+      }
+    }
+
+    if (zero_pivots > 0) {
+      throw BoutException("Zero pivot in CyclicReduce::factorise");
+    }
+
+    factorised = true;
+    factorised_local = local;
+  }
+
+  /// Is \p pivot too small to divide by? Also true for NaN
+  static int isZeroPivot(T pivot) { return !(std::abs(pivot) >= 1e-10) ? 1 : 0; }
+
+  /// Make sure that the factors match the current coefficients and
+  /// the path (local or distributed) taken by solve
+  void ensureFactorised() {
+    const bool local = (nprocs == 1) && !periodic;
+    if (!factorised || (factorised_local != local)) {
+      factorise();
+    }
+  }
+
+  /// Solve the local systems with the Thomas algorithm, when there
+  /// are no other processors and the systems are not periodic.
+  /// Each block of batch_width systems is solved together, with the
+  /// inner loops over (contiguous) systems so they can be vectorised
+  void thomasLocal(Matrix<T>& xa) {
+    xa.ensureUnique();
+
+    BOUT_OMP(parallel for)
+    for (int rb = 0; rb < nrhsblocks; rb++) {
+      const int blk = rb % nblocks;
+      const T* co = &coefs(blk, 0);
+      const T* rr = &rhsb(rb, 0);
+      // Thread-local array, interleaved [row][lane]
+      Array<T> xb(N * batch_width);
+
+      {
+        const T* ibet0 = &factor(blk, 0, 1);
+        for (int l = 0; l < batch_width; l++) {
+          xb[l] = rr[l] * ibet0[l];
+        }
+      }
+      for (int i = 1; i < N; i++) {
+        const T* ai = co + 3 * i * batch_width;
+        const T* ri = rr + i * batch_width;
+        const T* ibi = &factor(blk, i, 1);
+        T* xi = &xb[i * batch_width];
+        const T* xi_1 = &xb[(i - 1) * batch_width];
+        for (int l = 0; l < batch_width; l++) {
+          xi[l] = (ri[l] - ai[l] * xi_1[l]) * ibi[l];
+        }
+      }
+      for (int i = N - 2; i >= 0; i--) {
+        T* xi = &xb[i * batch_width];
+        const T* xi1 = &xb[(i + 1) * batch_width];
+        const T* gi1 = &factor(blk, i + 1, 0);
+        for (int l = 0; l < batch_width; l++) {
+          xi[l] -= gi1[l] * xi1[l];
+        }
+      }
+
+      // Copy out the systems which aren't padding
+      const int j0 = blk * batch_width;
+      const int nlanes = std::min(batch_width, Nsys - j0);
+      const int row0 = (rb / nblocks) * Nsys + j0;
+      for (int l = 0; l < nlanes; l++) {
+        for (int i = 0; i < N; i++) {
+          xa(row0 + l, i) = xb[i * batch_width + l];
+        }
+      }
+    }
+  }
+
+  /// Calculate the interface equations for each RHS in rhsb, putting
+  /// the result in myif. This is the same algorithm as reduce(), but
+  /// vectorised across each block of systems and using the
+  /// coefficients and multipliers calculated in factorise()
+  void reduceLocal() {
+    myif.ensureUnique();
+
+    BOUT_OMP(parallel for)
+    for (int rb = 0; rb < nrhsblocks; rb++) {
+      const int blk = rb % nblocks;
+      const T* rr = &rhsb(rb, 0);
+      T up[batch_width], lo[batch_width];
+
+      // Upper interface equation, starting from row N-2
+      for (int l = 0; l < batch_width; l++) {
+        up[l] = rr[(N - 2) * batch_width + l];
+      }
+      for (int i = N - 3; i >= 0; i--) {
+        const T* ri = rr + i * batch_width;
+        const T* beta = &factor(blk, i, 2);
+        for (int l = 0; l < batch_width; l++) {
+          up[l] = ri[l] - beta[l] * up[l];
+        }
+      }
+
+      // Lower interface equation, starting from row 1
+      for (int l = 0; l < batch_width; l++) {
+        lo[l] = rr[batch_width + l];
+      }
+      for (int i = 2; i < N; i++) {
+        const T* ri = rr + i * batch_width;
+        const T* alpha = &factor(blk, i, 3);
+        for (int l = 0; l < batch_width; l++) {
+          lo[l] = ri[l] - alpha[l] * lo[l];
+        }
+      }
+
+      const int j0 = blk * batch_width;
+      const int nlanes = std::min(batch_width, Nsys - j0);
+      const int row0 = (rb / nblocks) * Nsys + j0;
+      for (int l = 0; l < nlanes; l++) {
+        for (int k = 0; k < 3; k++) {
+          myif(row0 + l, k) = ifcoefs(j0 + l, k);
+          myif(row0 + l, 4 + k) = ifcoefs(j0 + l, 4 + k);
+        }
+        myif(row0 + l, 3) = up[l];
+        myif(row0 + l, 7) = lo[l];
+      }
+    }
+  }
+
+  /// Back-solve the local systems for each RHS in rhsb from the
+  /// interface values (x1, xn). Same algorithm as back_solve(),
+  /// vectorised across each block of systems and using the factors
+  /// from factorise()
+  void backSolveLocal(Matrix<T>& xa) {
+    xa.ensureUnique();
+
+    BOUT_OMP(parallel for)
+    for (int rb = 0; rb < nrhsblocks; rb++) {
+      const int blk = rb % nblocks;
+      const T* co = &coefs(blk, 0);
+      const T* rr = &rhsb(rb, 0);
+      const int j0 = blk * batch_width;
+      const int nlanes = std::min(batch_width, Nsys - j0);
+      const int row0 = (rb / nblocks) * Nsys + j0;
+
+      // Thread-local array, interleaved [row][lane]
+      Array<T> xb(N * batch_width);
+
+      for (int l = 0; l < batch_width; l++) {
+        // Padding lanes are the identity with zero rhs
+        xb[l] = (l < nlanes) ? x1[row0 + l] : 0.0;
+        xb[(N - 1) * batch_width + l] = (l < nlanes) ? xn[row0 + l] : 0.0;
+      }
+      for (int i = 1; i < N - 1; i++) {
+        const T* ai = co + 3 * i * batch_width;
+        const T* ri = rr + i * batch_width;
+        const T* ibi = &factor(blk, i, 1);
+        T* xi = &xb[i * batch_width];
+        const T* xi_1 = &xb[(i - 1) * batch_width];
+        for (int l = 0; l < batch_width; l++) {
+          xi[l] = (ri[l] - ai[l] * xi_1[l]) * ibi[l];
+        }
+      }
+      for (int i = N - 2; i > 0; i--) {
+        T* xi = &xb[i * batch_width];
+        const T* xi1 = &xb[(i + 1) * batch_width];
+        const T* gi1 = &factor(blk, i + 1, 0);
+        for (int l = 0; l < batch_width; l++) {
+          xi[l] -= gi1[l] * xi1[l];
+        }
+      }
+
+      for (int l = 0; l < nlanes; l++) {
+        for (int i = 0; i < N; i++) {
+          xa(row0 + l, i) = xb[i * batch_width + l];
+        }
+      }
+    }
   }
 
   /// Calculate interface equations
@@ -619,4 +1010,7 @@ private:
   }
 };
 
+template <class T>
+constexpr int CyclicReduce<T>::batch_width;
+
 #endif // __CYCLIC_REDUCE_H__
@@ -73,6 +73,28 @@ void rfft(const BoutReal *in, int length, dcomplex *out);
  */
 void irfft(const dcomplex *in, int length, BoutReal *out);
 
+/*!
+ * Batched version of rfft: transforms \p howmany signals at once,
+ * using a single FFTW plan
+ *
+ * \param[in] in      \p howmany signals of \p length points, one after another
+ * \param[in] length  Number of points in each signal
+ * \param[in] howmany Number of signals
+ * \param[out] out    \p howmany sets of (length/2 + 1) modes, one after another,
+ *                    normalised in the same way as rfft
+ */
+void rfft(const BoutReal *in, int length, int howmany, dcomplex *out);
+
+/*!
+ * Batched version of irfft: inverse transforms \p howmany signals at once
+ *
+ * \param[in] in      \p howmany sets of (length/2 + 1) modes, one after another
+ * \param[in] length  Number of points in each output signal
+ * \param[in] howmany Number of signals
+ * \param[out] out    \p howmany signals of \p length points, one after another
+ */
+void irfft(const dcomplex *in, int length, int howmany, BoutReal *out);
+
 /*!
  * Discrete Sine Transform
  *
@@ -42,6 +42,8 @@ class Mesh;  // #include "bout/mesh.hxx"
 
 #include "utils.hxx"
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
 
@@ -257,9 +259,83 @@ class Field3D : public Field, public FieldData {
     clearParallelSlices();
   }
 
-  /// Check if this field has yup and ydown fields
+  /*!
+   * Clear the parallel slices, and calculate them with the parallel
+   * transform the first time yup(), ydown() or ynext() is next used
+   *
+   * This is what Mesh::communicate does when mesh:lazy_parallel_slices
+   * is true, so fields only used in perpendicular operators never pay
+   * for the parallel transform. Writing to the whole field (assignment,
+   * compound assignment, clearParallelSlices) cancels the pending
+   * calculation. A copy of the data is kept, and the slices are
+   * calculated from it, so they are the same as calcParallelSlices
+   * would give now: changes made to individual points since, for
+   * example by boundary conditions, are not included
+   */
+  void invalidateParallelSlices();
+
+  /// Are the parallel slices waiting to be calculated on first use?
+  bool parallelSlicesPending() const {
+    return parallel_slices_pending.load(std::memory_order_acquire);
+  }
+
+  /// Set whether Mesh::communicate should calculate (or mark as pending)
+  /// the parallel slices of this field. Fields only used in
+  /// perpendicular operators can opt out with false
+  Field3D& setParallelSlicesOnCommunicate(bool calc) {
+    parallel_slices_on_communicate = calc;
+    return *this;
+  }
+  bool parallelSlicesOnCommunicate() const { return parallel_slices_on_communicate; }
+
+  /// Set whether toFieldAligned should keep the field-aligned copy of
+  /// this field, and return it again until the field is changed.
+  /// Useful for fields like phi which go through several parallel
+  /// operators in one RHS.
+  ///
+  /// The cache also keeps a copy of the data it was calculated from,
+  /// and is only used while the field still has that data, so any
+  /// write is noticed without a check in the element accessors. This
+  /// costs the memory of two fields, and a comparison and a copy for
+  /// each call which uses the cache. toFieldAligned returns a copy of
+  /// the cached field, so writing to the result doesn't change the
+  /// cache.
+  ///
+  /// The cache is dropped by writing to the whole field (assignment,
+  /// compound assignment, allocate), by communication and by applying
+  /// boundary conditions. The copy constructor copies the setting and
+  /// the cache. Assignment keeps the setting of the field assigned to,
+  /// and only shares the cache if that is set
+  Field3D& setCacheFieldAligned(bool cache) {
+    cache_field_aligned = cache;
+    if (not cache) {
+      clearFieldAlignedCache();
+    }
+    return *this;
+  }
+  bool cacheFieldAligned() const { return cache_field_aligned; }
+
+  /// Discard the cached field-aligned copy, if any
+  void clearFieldAlignedCache() { field_aligned_cache.reset(); }
+
+  /// Number of calls to toFieldAligned which used a cached copy (hits)
+  /// or calculated and cached one (misses), for all fields. Only read
+  /// or reset these outside OpenMP parallel regions
+  struct FieldAlignedCacheStats {
+    int hits{0};
+    int misses{0};
+  };
+  static const FieldAlignedCacheStats& fieldAlignedCacheStats() {
+    return field_aligned_cache_stats;
+  }
+  static void resetFieldAlignedCacheStats() { field_aligned_cache_stats = {}; }
+
+  friend Field3D toFieldAligned(const Field3D& f, const std::string& region);
+
+  /// Check if this field has yup and ydown fields, or will calculate
+  /// them on first use
   bool hasParallelSlices() const {
-    return !yup_fields.empty() and !ydown_fields.empty();
+    return parallelSlicesPending() or (!yup_fields.empty() and !ydown_fields.empty());
   }
 
   [[deprecated("Please use Field3D::hasParallelSlices instead")]]
@@ -270,23 +346,27 @@ class Field3D : public Field, public FieldData {
   /// Check if this field has yup and ydown fields
   /// Return reference to yup field
   Field3D &yup(std::vector<Field3D>::size_type index = 0) {
+    ensureParallelSlices();
     ASSERT2(index < yup_fields.size());
     return yup_fields[index];
   }
   /// Return const reference to yup field
   const Field3D &yup(std::vector<Field3D>::size_type index = 0) const {
+    ensureParallelSlices();
     ASSERT2(index < yup_fields.size());
     return yup_fields[index];
   }
 
   /// Return reference to ydown field
   Field3D &ydown(std::vector<Field3D>::size_type index = 0) {
+    ensureParallelSlices();
     ASSERT2(index < ydown_fields.size());
     return ydown_fields[index];
   }
 
   /// Return const reference to ydown field
   const Field3D &ydown(std::vector<Field3D>::size_type index = 0) const {
+    ensureParallelSlices();
     ASSERT2(index < ydown_fields.size());
     return ydown_fields[index];
   }
@@ -506,6 +586,15 @@ class Field3D : public Field, public FieldData {
     swap(first.deriv, second.deriv);
     swap(first.yup_fields, second.yup_fields);
     swap(first.ydown_fields, second.ydown_fields);
+    // std::atomic can't be swapped
+    const bool pending = first.parallelSlicesPending();
+    first.parallel_slices_pending.store(second.parallelSlicesPending(),
+                                        std::memory_order_release);
+    second.parallel_slices_pending.store(pending, std::memory_order_release);
+    swap(first.parallel_slices_source, second.parallel_slices_source);
+    swap(first.parallel_slices_on_communicate, second.parallel_slices_on_communicate);
+    swap(first.cache_field_aligned, second.cache_field_aligned);
+    swap(first.field_aligned_cache, second.field_aligned_cache);
     swap(first.bndry_op, second.bndry_op);
     swap(first.boundaryIsCopy, second.boundaryIsCopy);
     swap(first.boundaryIsSet, second.boundaryIsSet);
@@ -526,8 +615,39 @@ private:
   /// Time derivative (may be nullptr)
   Field3D *deriv{nullptr};
 
-  /// Fields containing values along Y
-  std::vector<Field3D> yup_fields{}, ydown_fields{};
+  /// Fields containing values along Y. Mutable so that pending slices
+  /// can be calculated on first use through a const reference
+  mutable std::vector<Field3D> yup_fields{}, ydown_fields{};
+
+  /// Should the parallel slices be calculated on first use? Atomic
+  /// because threads check it without a lock, and must then see the
+  /// slices which were calculated before it was cleared
+  mutable std::atomic<bool> parallel_slices_pending{false};
+
+  /// Copy of the data when the slices were made pending, which they
+  /// are calculated from
+  mutable Array<BoutReal> parallel_slices_source;
+
+  /// Should Mesh::communicate calculate the parallel slices?
+  bool parallel_slices_on_communicate{true};
+
+  /// Should toFieldAligned cache its result?
+  bool cache_field_aligned{false};
+
+  /// The field-aligned copy of this field, and the region it was
+  /// calculated in. Mutable so that it can be set through a const reference
+  struct FieldAlignedCache;
+  mutable std::shared_ptr<const FieldAlignedCache> field_aligned_cache;
+
+  static FieldAlignedCacheStats field_aligned_cache_stats;
+
+  /// Calculate the parallel slices if they are pending
+  void ensureParallelSlices() const {
+    if (parallelSlicesPending()) {
+      calcPendingParallelSlices();
+    }
+  }
+  void calcPendingParallelSlices() const;
 };
 
 // Non-member overloaded operators
@@ -675,6 +795,30 @@ inline void shiftZ(Field3D &var, BoutReal zangle, REGION rgn) {
   return shiftZ(var, zangle, toString(rgn));
 }
 
+/// Convert \p f to field-aligned coordinates. If \p f caches its
+/// field-aligned copy (see Field3D::setCacheFieldAligned) and the
+/// cached copy covers \p region, returns that instead
+///
+/// @param[in] f       The field to convert
+/// @param[in] region  The region to calculate the result over
+Field3D toFieldAligned(const Field3D& f, const std::string& region = "RGN_ALL");
+
+/// Convert all of \p fields, which must share a mesh and location, to
+/// field-aligned coordinates together. Cheaper than converting them one
+/// at a time for transforms which can share the work, e.g. ShiftedMetric
+///
+/// @param[in] fields  The fields to convert
+/// @param[in] region  The region to calculate the result over
+std::vector<Field3D> toFieldAligned(const std::vector<Field3D>& fields,
+                                    const std::string& region = "RGN_ALL");
+
+/// Convert all of \p fields back from field-aligned coordinates together
+///
+/// @param[in] fields  The fields to convert
+/// @param[in] region  The region to calculate the result over
+std::vector<Field3D> fromFieldAligned(const std::vector<Field3D>& fields,
+                                      const std::string& region = "RGN_ALL");
+
 /// Average in the Z direction
 ///
 /// @param[in] f     Variable to average
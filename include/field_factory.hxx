@@ -154,6 +154,7 @@ public:
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> UNUSED(args)) override {
     return get();
   }
+  bool isTimeDependent() const override { return false; }
   /// Singeton
   static FieldGeneratorPtr get() {
     static FieldGeneratorPtr instance = std::make_shared<FieldNull>();
@@ -28,11 +28,16 @@
 
 #include "bout/traits.hxx"
 #include "bout_types.hxx"
+#include "boutexception.hxx"
 #include "field3d.hxx"
 #include "mask.hxx"
 #include "stencils.hxx"
+#include "unused.hxx"
 #include "utils.hxx"
 
+#include <iosfwd>
+#include <vector>
+
 /// Perform interpolation between centre -> shifted or vice-versa
 /*!
   Interpolate using 4th-order staggered formula
@@ -227,6 +232,42 @@ const Field3D interpolate(const Field2D &f, const Field3D &delta_x);
 
 ////////////////////////////////////////
 
+/// A linear interpolation, folded into a sparse matrix from the values
+/// of a field (including guard cells) to the interpolated values
+///
+/// Stored in ELLPACK format: every interpolated point has the same
+/// number of weights, so applying the matrix is a single loop with no
+/// temporary fields
+class InterpolationMatrix {
+public:
+  InterpolationMatrix() = default;
+  /// Every row will have \p width weights
+  explicit InterpolationMatrix(int width) : width(width) {}
+
+  /// Add a row which sets the point with flat index \p index to the
+  /// sum of \p weights times the values at flat indices \p columns.
+  /// Both arrays must have getWidth() elements
+  void addRow(int index, const int* columns, const BoutReal* weights);
+
+  /// Interpolate \p f. Points without a row are not set
+  Field3D apply(const Field3D& f) const;
+  /// Interpolate all of \p fields, reading each row once
+  std::vector<Field3D> apply(const std::vector<const Field3D*>& fields) const;
+
+  /// Number of weights in each row
+  int getWidth() const { return width; }
+  /// Number of interpolated points
+  int size() const { return static_cast<int>(rows.size()); }
+
+private:
+  int width{0};
+  /// Flat index of the interpolated point for each row
+  std::vector<int> rows;
+  /// Flat indices of the points in each row, width per row
+  std::vector<int> columns;
+  std::vector<BoutReal> weights;
+};
+
 class Interpolation {
 protected:
   Mesh* localmesh{nullptr};
@@ -254,11 +295,49 @@ public:
   virtual Field3D interpolate(const Field3D &f, const Field3D &delta_x,
                               const Field3D &delta_z, const BoutMask &mask) = 0;
 
+  /// Interpolate all of \p fields with the current weights.
+  /// Implementations can override this to read the weights once for
+  /// all the fields
+  virtual std::vector<Field3D>
+  interpolateFields(const std::vector<const Field3D*>& fields) const {
+    std::vector<Field3D> result;
+    result.reserve(fields.size());
+    for (const auto* f : fields) {
+      result.push_back(interpolate(*f));
+    }
+    return result;
+  }
+
+  /// Fold the interpolation with the current weights into a sparse
+  /// matrix. Only linear interpolations can do this
+  virtual InterpolationMatrix getMatrix() const {
+    throw BoutException("This interpolation method cannot be converted to a matrix");
+  }
+
+  /// Write the indices and weights calculated by calcWeights to
+  /// \p out, so they can be read back by readWeights rather than
+  /// recalculated. The mask is not included
+  virtual void writeWeights(std::ostream& UNUSED(out)) const {
+    throw BoutException("This interpolation method cannot write its weights");
+  }
+  /// Read indices and weights written by writeWeights on the same mesh
+  virtual void readWeights(std::istream& UNUSED(in)) {
+    throw BoutException("This interpolation method cannot read its weights");
+  }
+
   void setMask(const BoutMask &mask) { skip_mask = mask; }
 
   // Interpolate using the field at (x,y+y_offset,z), rather than (x,y,z)
   int y_offset;
   void setYOffset(int offset) { y_offset = offset; }
+
+protected:
+  /// Binary copies of the data in \p indices and \p weights, for
+  /// implementing writeWeights and readWeights
+  static void writeData(std::ostream& out, const std::vector<const Tensor<int>*>& indices,
+                        const std::vector<const Field3D*>& weights);
+  static void readData(std::istream& in, const std::vector<Tensor<int>*>& indices,
+                       const std::vector<Field3D*>& weights);
 };
 
 class HermiteSpline : public Interpolation {
@@ -308,6 +387,22 @@ public:
                       const Field3D &delta_z) override;
   Field3D interpolate(const Field3D &f, const Field3D &delta_x, const Field3D &delta_z,
                       const BoutMask &mask) override;
+
+  std::vector<Field3D>
+  interpolateFields(const std::vector<const Field3D*>& fields) const override;
+
+  /// The derivatives are folded in using the default DDX and DDZ
+  /// methods, which must be C2 or C4
+  InterpolationMatrix getMatrix() const override;
+
+  void writeWeights(std::ostream& out) const override {
+    writeData(out, {&i_corner, &k_corner},
+              {&h00_x, &h01_x, &h10_x, &h11_x, &h00_z, &h01_z, &h10_z, &h11_z});
+  }
+  void readWeights(std::istream& in) override {
+    readData(in, {&i_corner, &k_corner},
+             {&h00_x, &h01_x, &h10_x, &h11_x, &h00_z, &h01_z, &h10_z, &h11_z});
+  }
 };
 
 
@@ -336,6 +431,18 @@ public:
   /// This function is called by the other interpolate functions
   /// in the base class HermiteSpline.
   Field3D interpolate(const Field3D &f) const override;
+
+  /// Interpolate each field separately, as HermiteSpline's version
+  /// isn't monotonic
+  std::vector<Field3D>
+  interpolateFields(const std::vector<const Field3D*>& fields) const override {
+    return Interpolation::interpolateFields(fields);
+  }
+
+  /// Not linear, so cannot be converted to a matrix
+  InterpolationMatrix getMatrix() const override {
+    throw BoutException("MonotonicHermiteSpline cannot be converted to a matrix");
+  }
 };
 
 class Lagrange4pt : public Interpolation {
@@ -369,6 +476,13 @@ public:
   BoutReal lagrange_4pt(BoutReal v2m, BoutReal vm, BoutReal vp, BoutReal v2p,
                         BoutReal offset) const;
   BoutReal lagrange_4pt(const BoutReal v[], BoutReal offset) const;
+
+  void writeWeights(std::ostream& out) const override {
+    writeData(out, {&i_corner, &k_corner}, {&t_x, &t_z});
+  }
+  void readWeights(std::istream& in) override {
+    readData(in, {&i_corner, &k_corner}, {&t_x, &t_z});
+  }
 };
 
 class Bilinear : public Interpolation {
@@ -399,6 +513,13 @@ public:
                       const Field3D &delta_z) override;
   Field3D interpolate(const Field3D &f, const Field3D &delta_x, const Field3D &delta_z,
                       const BoutMask &mask) override;
+
+  void writeWeights(std::ostream& out) const override {
+    writeData(out, {&i_corner, &k_corner}, {&w0, &w1, &w2, &w3});
+  }
+  void readWeights(std::istream& in) override {
+    readData(in, {&i_corner, &k_corner}, {&w0, &w1, &w2, &w3});
+  }
 };
 
 #endif // __INTERP_H__
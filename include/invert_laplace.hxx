@@ -46,6 +46,14 @@ class Laplacian;
 
 #include "dcomplex.hxx"
 #include "options.hxx"
+#include "bout/invert/iteration_monitor.hxx"
+#include "bout/invert/solution_history.hxx"
+
+#include <map>
+#include <vector>
+
+class Datafile;
+class Solver;
 
 // Inversion flags for each boundary
 /// Zero-gradient for DC (constant in Z) component. Default is zero value
@@ -180,9 +188,18 @@ public:
     setCoefEz(f);
   }
   
-  virtual void setGlobalFlags(int f) { global_flags = f; }
-  virtual void setInnerBoundaryFlags(int f) { inner_boundary_flags = f; }
-  virtual void setOuterBoundaryFlags(int f) { outer_boundary_flags = f; }
+  virtual void setGlobalFlags(int f) {
+    global_flags = f;
+    coefficientsChanged();
+  }
+  virtual void setInnerBoundaryFlags(int f) {
+    inner_boundary_flags = f;
+    coefficientsChanged();
+  }
+  virtual void setOuterBoundaryFlags(int f) {
+    outer_boundary_flags = f;
+    coefficientsChanged();
+  }
 
   [[gnu::deprecated("Please use setGlobalFlags, setInnerBoundaryFlags and "
       "setOuterBoundaryFlags methods instead")]]
@@ -199,6 +216,15 @@ public:
   virtual Field3D solve(const Field3D &b, const Field3D &x0);
   virtual Field2D solve(const Field2D &b, const Field2D &x0);
 
+  /// Solve for several right-hand sides with the same coefficients
+  /// and flags, for example when inverting the same operator for
+  /// several fields in a row. Implementations may batch the fields
+  /// to share communication and factorisations; by default each one
+  /// is solved in turn
+  virtual std::vector<Field3D> solve(const std::vector<Field3D> &b);
+  virtual std::vector<Field3D> solve(const std::vector<Field3D> &b,
+                                     const std::vector<Field3D> &x0);
+
   /// Coefficients in tridiagonal inversion
   void tridagCoefs(int jx, int jy, int jz, dcomplex &a, dcomplex &b, dcomplex &c,
                    const Field2D *ccoef = nullptr, const Field2D *d = nullptr,
@@ -213,6 +239,12 @@ public:
   static Laplacian* defaultInstance(); ///< Return pointer to global singleton
   
   static void cleanup(); ///< Frees all memory
+
+  /// Save the average number of iterations per solve in each output
+  /// timestep as "<name>_average_iterations". Only iterative solvers
+  /// record their iterations
+  virtual void savePerformance(Datafile& output_file, Solver& solver,
+                               const std::string& name);
 protected:
   bool async_send; ///< If true, use asyncronous send in parallel algorithms
   
@@ -229,6 +261,40 @@ protected:
   int inner_boundary_flags; ///< Flags to set inner boundary condition
   int outer_boundary_flags; ///< Flags to set outer boundary condition
 
+  /// If true, solvers may keep factorised matrices between solves
+  /// and reuse them while the coefficients are unchanged
+  bool cache_factorisation;
+
+  /// Incremented whenever the coefficients or flags change. Solvers
+  /// which cache factorisations compare this against the version
+  /// used to build them
+  int coef_version{0};
+
+  /// Mark any cached factorisations as out of date. Should be called
+  /// by implementations whenever a coefficient is set
+  void coefficientsChanged() { ++coef_version; }
+
+  /// Is a factorisation built at version \p version still valid?
+  bool factorisationValid(int version) const {
+    return cache_factorisation && (version == coef_version);
+  }
+
+  /// Number of previous solutions extrapolated to give the initial
+  /// guess for iterative solvers. Zero uses the x0 passed to solve()
+  int initial_guess_history;
+
+  /// Initial guess for the interior of the solve at the y index of
+  /// \p x0: extrapolated from previous solutions at that index if
+  /// there are any, otherwise \p x0 itself. Boundary conditions
+  /// should still be taken from \p x0
+  FieldPerp initialGuess(const FieldPerp& x0);
+
+  /// Store a solution for use in later initial guesses
+  void storeSolution(const FieldPerp& x);
+
+  /// Iteration counts of iterative solvers
+  IterationMonitor performance;
+
   void tridagCoefs(int jx, int jy, BoutReal kwave, dcomplex &a, dcomplex &b, dcomplex &c,
                    const Field2D *ccoef = nullptr, const Field2D *d = nullptr,
                    CELL_LOC loc = CELL_DEFAULT) {
@@ -258,6 +324,12 @@ protected:
                     const Field2D *a, const Field2D *c1coef, const Field2D *c2coef,
                     const Field2D *d,
                     bool includeguards=true);
+
+  /// Apply the boundary conditions to the RHS only. Used with cached
+  /// factorisations, where tridagMatrix is not called for every solve
+  void tridagMatrixRHS(dcomplex *bk, int flags, int inner_boundary_flags,
+                       int outer_boundary_flags, bool includeguards = true);
+
   CELL_LOC location;   ///< staggered grid location of this solver
   Mesh* localmesh;     ///< Mesh object for this solver
   Coordinates* coords; ///< Coordinates object, so we only have to call
@@ -265,6 +337,9 @@ protected:
 private:
   /// Singleton instance
   static Laplacian *instance;
+
+  /// Previous solutions at each y index, used by initialGuess()
+  std::map<int, SolutionHistory<FieldPerp>> solution_history;
 };
 
 ////////////////////////////////////////////
@@ -36,6 +36,8 @@
 #include "options.hxx"
 #include "unused.hxx"
 
+#include <vector>
+
 // Parderiv implementations
 #define PARDERIVCYCLIC "cyclic"
 
@@ -95,6 +97,23 @@ public:
    */
   virtual const Field3D solve(const Field2D &f, const Field2D &UNUSED(start)) {return solve(f);}
   virtual const Field3D solve(const Field3D &f, const Field3D &UNUSED(start)) {return solve(f);}
+
+  /// Coefficients of one of several systems solved together
+  struct Coefficients {
+    Field2D A{0.0}, B{0.0}, C{0.0}, D{0.0}, E{0.0};
+  };
+
+  /*!
+   * Solve several systems, each with its own right hand side f[i]
+   * and coefficients coefs[i]. Implementations may solve these
+   * together, for example to share communication.
+   *
+   * The default implementation sets the coefficients and solves each
+   * system in turn, so afterwards the coefficients are those of the
+   * last system
+   */
+  virtual std::vector<Field3D> solve(const std::vector<Field3D> &f,
+                                     const std::vector<Coefficients> &coefs);
   
   /*!
    * Set the constant coefficient A
@@ -52,5 +52,40 @@ void cyclic_tridag(dcomplex *a, dcomplex *b, dcomplex *c, dcomplex *r, dcomplex
 /// Complex band matrix solver
 void cband_solve(Matrix<dcomplex> &a, int n, int m1, int m2, Array<dcomplex> &b);
 
+/* Factorised solvers
+ *
+ * These split the tridiagonal and band solvers above into an LU
+ * factorisation, which only depends on the matrix, and a solve for
+ * each RHS, so that the factorisation can be reused while the
+ * matrix is unchanged.
+ */
+
+/// LU factorisation of a complex tridiagonal matrix, in the same format as
+/// tridag. \p lu must have length 4*n and \p ipiv length n
+void tridagFactorise(const dcomplex *a, const dcomplex *b, const dcomplex *c,
+                     dcomplex *lu, int *ipiv, int n);
+/// Solve a tridiagonal system using factors from tridagFactorise
+void tridagSolveFactorised(const dcomplex *lu, const int *ipiv, const dcomplex *r,
+                           dcomplex *u, int n);
+
+/// LU factorisation of a complex band matrix, in the same format as
+/// cband_solve. \p lu must have length (2*m1 + m2 + 1)*n and \p ipiv length n
+void cbandFactorise(const Matrix<dcomplex> &a, int n, int m1, int m2, dcomplex *lu,
+                    int *ipiv);
+/// Solve a band system using factors from cbandFactorise. The solution
+/// replaces the RHS in \p b
+void cbandSolveFactorised(const dcomplex *lu, const int *ipiv, int n, int m1, int m2,
+                          Array<dcomplex> &b);
+
+/// LU factorisation in place of a real single precision band matrix with
+/// \p kl sub- and \p ku super-diagonals, in LAPACK band storage: element
+/// (i, j) is ab[kl + ku + i - j + j * (2*kl + ku + 1)], and the first kl
+/// rows hold the fill-in. \p ipiv must have length n
+void sbandFactorise(float *ab, int n, int kl, int ku, int *ipiv);
+/// Solve a band system using factors from sbandFactorise. The solution
+/// replaces the RHS in \p x
+void sbandSolveFactorised(const float *ab, const int *ipiv, int n, int kl, int ku,
+                          float *x);
+
 #endif // __LAPACK_ROUTINES_H__
 
@@ -72,6 +72,14 @@ public:
     TRACE("BoutMask::operator()(%d, %d, %d)", jx, jy, jz);
     return mask(jx, jy, jz);
   }
+
+  /// Access by flat index, e.g. inside BOUT_FOR loops
+  inline bool& operator[](const Ind3D& i) { return mask.getData()[i.ind]; }
+  inline const bool& operator[](const Ind3D& i) const { return mask.getData()[i.ind]; }
+
+  /// The underlying data, e.g. for writing to file
+  Tensor<bool>& getData() { return mask; }
+  const Tensor<bool>& getData() const { return mask; }
 };
 
 #endif //__MASK_H__
@@ -8,6 +8,7 @@
 #include "unused.hxx"
 
 #include <utility>
+#include <vector>
 
 //////////////////////////////////////////////////
 // Base class
@@ -62,6 +63,17 @@ protected:
   BoutReal getValue(int x, int y, int z, BoutReal t);
   BoutReal getValue(const BoundaryRegionPar &bndry, BoutReal t);
 
+  /// Boundary values at all the points of bndry, at time \p t.
+  /// Generated values are at the intersections with the boundary if
+  /// \p at_intersection, otherwise at the grid points. Values which
+  /// don't change in time are only calculated on the first call
+  const std::vector<BoutReal>& getValues(BoutReal t, bool at_intersection = true);
+
+private:
+  /// Values from the last call to getValues
+  std::vector<BoutReal> values;
+  /// Can the values be reused by later calls to getValues?
+  bool values_fixed{false};
 };
 
 //////////////////////////////////////////////////
@@ -11,37 +11,28 @@
  *
  */
 class BoundaryRegionPar : public BoundaryRegionBase {
-
-  struct IndexPoint {
-    int jx;
-    int jy;
-    int jz;
-  };
-
-  struct RealPoint {
-    BoutReal s_x;
-    BoutReal s_y;
-    BoutReal s_z;
-  };
-
-  struct Indices {
-    // Indices of the boundary point
-    IndexPoint index;
-    // Intersection with boundary in index space
-    RealPoint intersection;
-    // Distance to intersection
-    BoutReal length;
-    // Angle between field line and boundary
-    BoutReal angle;
+public:
+  /// The points in the boundary, as a structure of arrays so that
+  /// boundary conditions can loop over them with contiguous accesses
+  struct Points {
+    /// Indices of the boundary points
+    std::vector<int> x, y, z;
+    /// Intersections with the boundary in index space
+    std::vector<BoutReal> s_x, s_y, s_z;
+    /// Distances to the intersections
+    std::vector<BoutReal> length;
+    /// Angles between the field lines and the boundary
+    std::vector<BoutReal> angle;
   };
 
-  using IndicesVec = std::vector<Indices>;
-  using IndicesIter = IndicesVec::iterator;
-
-  /// Vector of points in the boundary
-  IndicesVec bndry_points;
+private:
+  /// Points in the boundary
+  Points bndry_points;
   /// Current position in the boundary points
-  IndicesIter bndry_position;
+  std::size_t bndry_position{0};
+
+  /// Set the public members to the point at bndry_position
+  void setPosition();
 
 public:
   BoundaryRegionPar(const std::string &name, int dir, Mesh* passmesh) :
@@ -60,6 +51,12 @@ public:
   void next() override;
   bool isDone() override;
 
+  /// All the points in the boundary
+  const Points& points() const { return bndry_points; }
+
+  /// Number of points in the boundary
+  int size() const { return bndry_points.x.size(); }
+
   /// Index of the point in the boundary
   int x, y, z;
   BoutReal s_x, s_y, s_z;
@@ -28,6 +28,7 @@
 #include <boutcomm.hxx>
 #include <globals.hxx>
 
+#include <algorithm>
 #include <cmath>
 
 #include <field3d.hxx>
@@ -42,6 +43,7 @@
 #include <msg_stack.hxx>
 #include <bout/constants.hxx>
 #include <bout/assert.hxx>
+#include <bout/openmpwrap.hxx>
 
 /// Constructor
 Field3D::Field3D(Mesh* localmesh, CELL_LOC location_in,
@@ -72,6 +74,10 @@ Field3D::Field3D(const Field3D& f) : Field(f), data(f.data) {
 
   location = f.location;
   fieldCoordinates = f.fieldCoordinates;
+
+  // The data is shared, so the cached field-aligned copy is still valid
+  cache_field_aligned = f.cache_field_aligned;
+  field_aligned_cache = f.field_aligned_cache;
 }
 
 Field3D::Field3D(const Field2D& f) : Field(f) {
@@ -106,6 +112,17 @@ Field3D::Field3D(Array<BoutReal> data_in, Mesh* localmesh, CELL_LOC datalocation
 
 Field3D::~Field3D() { delete deriv; }
 
+Field3D::FieldAlignedCacheStats Field3D::field_aligned_cache_stats;
+
+struct Field3D::FieldAlignedCache {
+  /// The field-aligned copy
+  Field3D aligned;
+  /// The region the copy was calculated in
+  std::string region;
+  /// The data of the field the copy was calculated from
+  Array<BoutReal> source;
+};
+
 Field3D& Field3D::allocate() {
   if(data.empty()) {
     if(!fieldmesh) {
@@ -123,6 +140,9 @@ Field3D& Field3D::allocate() {
   } else
     data.ensureUnique();
 
+  // The data is about to be changed
+  clearFieldAlignedCache();
+
   return *this;
 }
 
@@ -143,6 +163,10 @@ void Field3D::splitParallelSlices() {
   }
 #endif
 
+  // The caller is setting the slices itself
+  parallel_slices_pending.store(false, std::memory_order_release);
+  parallel_slices_source = Array<BoutReal>{};
+
   if (!yup_fields.empty()) {
     return;
   }
@@ -165,6 +189,9 @@ void Field3D::clearParallelSlices() {
   }
 #endif
 
+  parallel_slices_pending.store(false, std::memory_order_release);
+  parallel_slices_source = Array<BoutReal>{};
+
   if (yup_fields.empty() && ydown_fields.empty()) {
     return;
   }
@@ -173,6 +200,38 @@ void Field3D::clearParallelSlices() {
   ydown_fields.clear();
 }
 
+void Field3D::invalidateParallelSlices() {
+  clearParallelSlices();
+  // A copy, since the data may be written to before the slices are used
+  parallel_slices_source = data;
+  parallel_slices_source.ensureUnique();
+  parallel_slices_pending.store(true, std::memory_order_release);
+}
+
+void Field3D::calcPendingParallelSlices() const {
+  // May be called from inside a parallel loop, e.g. by the stencils,
+  // so only one thread does the calculation
+  BOUT_OMP(critical(Field3D_calcPendingParallelSlices))
+  {
+    if (parallelSlicesPending()) {
+      TRACE("Field3D::calcPendingParallelSlices");
+
+      // Calculate the slices of a copy with the data kept when they
+      // were made pending, so that other threads see
+      // parallel_slices_pending until they are ready
+      Field3D f{*this};
+      f.data = parallel_slices_source;
+      f.calcParallelSlices();
+
+      yup_fields = std::move(f.yup_fields);
+      ydown_fields = std::move(f.ydown_fields);
+      parallel_slices_source = Array<BoutReal>{};
+      // Release, so threads which then see false also see the slices
+      parallel_slices_pending.store(false, std::memory_order_release);
+    }
+  }
+}
+
 const Field3D& Field3D::ynext(int dir) const {
 #if CHECK > 0
   // Asked for more than yguards
@@ -263,6 +322,13 @@ Field3D & Field3D::operator=(const Field3D &rhs) {
 
   data = rhs.data;
 
+  // Keep this field's setting, and share the cache if it is set
+  if (cache_field_aligned) {
+    field_aligned_cache = rhs.field_aligned_cache;
+  } else {
+    clearFieldAlignedCache();
+  }
+
   return *this;
 }
 
@@ -343,6 +409,7 @@ void Field3D::applyBoundary(bool init) {
 #endif
 
   checkData(*this);
+  clearFieldAlignedCache();
 
   if (background != nullptr) {
     // Apply boundary to the total of this and background
@@ -368,6 +435,7 @@ void Field3D::applyBoundary(BoutReal t) {
 #endif
 
   checkData(*this);
+  clearFieldAlignedCache();
 
   if (background != nullptr) {
     // Apply boundary to the total of this and background
@@ -387,6 +455,7 @@ void Field3D::applyBoundary(const std::string &condition) {
   TRACE("Field3D::applyBoundary(condition)");
   
   checkData(*this);
+  clearFieldAlignedCache();
 
   if (background != nullptr) {
     // Apply boundary to the total of this and background
@@ -413,6 +482,7 @@ void Field3D::applyBoundary(const std::string &condition) {
 void Field3D::applyBoundary(const std::string &region, const std::string &condition) {
   TRACE("Field3D::applyBoundary(string, string)");
   checkData(*this);
+  clearFieldAlignedCache();
 
   /// Get the boundary factory (singleton)
   BoundaryFactory *bfact = BoundaryFactory::getInstance();
@@ -801,6 +871,59 @@ void checkData(const Field3D &f, const std::string& region) {
 }
 #endif
 
+Field3D toFieldAligned(const Field3D& f, const std::string& region) {
+  auto& transform = f.getCoordinates()->getParallelTransform();
+  if (not f.cache_field_aligned) {
+    return transform.toFieldAligned(f, region);
+  }
+
+  ASSERT2(f.getDirectionY() == YDirectionType::Standard);
+
+  auto& stats = Field3D::field_aligned_cache_stats;
+
+  // The cache is mutable, so load and store it atomically in case
+  // several threads use f
+  const auto cache = std::atomic_load(&f.field_aligned_cache);
+  if (cache != nullptr and (cache->region == region or cache->region == "RGN_ALL")
+      and (f.data.size() == cache->source.size())
+      and std::equal(std::begin(f.data), std::end(f.data), std::begin(cache->source))) {
+    BOUT_OMP(atomic)
+    ++stats.hits;
+    // A copy, so that the result can be written to
+    return copy(cache->aligned);
+  }
+
+  auto new_cache = std::make_shared<Field3D::FieldAlignedCache>();
+  new_cache->aligned = transform.toFieldAligned(f, region);
+  new_cache->region = region;
+  new_cache->source = f.data;
+  new_cache->source.ensureUnique();
+
+  BOUT_OMP(atomic)
+  ++stats.misses;
+  std::atomic_store(&f.field_aligned_cache,
+                    std::shared_ptr<const Field3D::FieldAlignedCache>(new_cache));
+  return copy(new_cache->aligned);
+}
+
+std::vector<Field3D> toFieldAligned(const std::vector<Field3D>& fields,
+                                    const std::string& region) {
+  if (fields.empty()) {
+    return {};
+  }
+  return fields[0].getCoordinates()->getParallelTransform().toFieldAlignedGroup(fields,
+                                                                                region);
+}
+
+std::vector<Field3D> fromFieldAligned(const std::vector<Field3D>& fields,
+                                      const std::string& region) {
+  if (fields.empty()) {
+    return {};
+  }
+  return fields[0].getCoordinates()->getParallelTransform().fromFieldAlignedGroup(
+      fields, region);
+}
+
 Field2D DC(const Field3D &f, const std::string& rgn) {
   TRACE("DC(Field3D)");
 
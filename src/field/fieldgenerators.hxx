@@ -11,6 +11,7 @@
 #include <field_factory.hxx>
 #include <unused.hxx>
 
+#include <algorithm>
 #include <cmath>
 
 //////////////////////////////////////////////////////////
@@ -43,6 +44,7 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
   std::string str() const override {
     return std::string("sin(") + gen->str() + std::string(")");
   }
@@ -58,6 +60,7 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
 
   std::string str() const override {
     return std::string("cos(") + gen->str() + std::string(")");
@@ -84,6 +87,7 @@ public:
   BoutReal generate(double x, double y, double z, double t) override {
     return Op(gen->generate(x, y, z, t));
   }
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
   std::string str() const override {
     return std::string("func(") + gen->str() + std::string(")");
   }
@@ -109,6 +113,9 @@ public:
   BoutReal generate(double x, double y, double z, double t) override {
     return Op(A->generate(x, y, z, t), B->generate(x, y, z, t));
   }
+  bool isTimeDependent() const override {
+    return A->isTimeDependent() or B->isTimeDependent();
+  }
   std::string str() const override {
     return std::string("cos(") + A->str() + "," + B->str() + std::string(")");
   }
@@ -136,6 +143,9 @@ public:
       return atan(A->generate(x, y, z, t));
     return atan2(A->generate(x, y, z, t), B->generate(x, y, z, t));
   }
+  bool isTimeDependent() const override {
+    return A->isTimeDependent() or (B != nullptr and B->isTimeDependent());
+  }
 
 private:
   FieldGeneratorPtr A, B;
@@ -148,6 +158,7 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
 
 private:
   FieldGeneratorPtr gen;
@@ -160,6 +171,7 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
 
 private:
   FieldGeneratorPtr gen;
@@ -172,6 +184,7 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
 
 private:
   FieldGeneratorPtr gen;
@@ -184,6 +197,9 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override {
+    return X->isTimeDependent() or s->isTimeDependent();
+  }
 
 private:
   FieldGeneratorPtr X, s;
@@ -196,6 +212,7 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
 
 private:
   FieldGeneratorPtr gen;
@@ -208,6 +225,7 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
 
 private:
   FieldGeneratorPtr gen;
@@ -220,6 +238,7 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
   std::string str() const override {
     return std::string("H(") + gen->str() + std::string(")");
   }
@@ -235,6 +254,7 @@ public:
 
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
 
 private:
   FieldGeneratorPtr gen;
@@ -261,6 +281,11 @@ public:
     }
     return result;
   }
+  bool isTimeDependent() const override {
+    return std::any_of(input.begin(), input.end(), [](const FieldGeneratorPtr& arg) {
+      return arg->isTimeDependent();
+    });
+  }
 
 private:
   std::list<FieldGeneratorPtr> input;
@@ -287,6 +312,11 @@ public:
     }
     return result;
   }
+  bool isTimeDependent() const override {
+    return std::any_of(input.begin(), input.end(), [](const FieldGeneratorPtr& arg) {
+      return arg->isTimeDependent();
+    });
+  }
 
 private:
   std::list<FieldGeneratorPtr> input;
@@ -310,6 +340,7 @@ public:
     }
     return static_cast<int>(val - 0.5);
   }
+  bool isTimeDependent() const override { return gen->isTimeDependent(); }
 
 private:
   FieldGeneratorPtr gen;
@@ -328,6 +359,7 @@ public:
       : mesh(m), arg(a), ball_n(n) {}
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return arg->isTimeDependent(); }
 
 private:
   Mesh* mesh;
@@ -344,6 +376,7 @@ public:
   FieldMixmode(FieldGeneratorPtr a = nullptr, BoutReal seed = 0.5);
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override { return arg->isTimeDependent(); }
 
 private:
   /// Generate a random number between 0 and 1 (exclusive)
@@ -368,6 +401,10 @@ public:
   // Clone containing the list of arguments
   FieldGeneratorPtr clone(const std::list<FieldGeneratorPtr> args) override;
   BoutReal generate(double x, double y, double z, double t) override;
+  bool isTimeDependent() const override {
+    return X->isTimeDependent() or width->isTimeDependent() or center->isTimeDependent()
+           or steepness->isTimeDependent();
+  }
 
 private:
   // The (x,y,z,t) field
@@ -32,6 +32,7 @@ Field3D& Field3D::operator*=(const Field3D& rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -72,6 +73,7 @@ Field3D& Field3D::operator/=(const Field3D& rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -112,6 +114,7 @@ Field3D& Field3D::operator+=(const Field3D& rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -152,6 +155,7 @@ Field3D& Field3D::operator-=(const Field3D& rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -197,6 +201,7 @@ Field3D& Field3D::operator*=(const Field2D& rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -248,6 +253,7 @@ Field3D& Field3D::operator/=(const Field2D& rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -299,6 +305,7 @@ Field3D& Field3D::operator+=(const Field2D& rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -349,6 +356,7 @@ Field3D& Field3D::operator-=(const Field2D& rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -470,6 +478,7 @@ Field3D& Field3D::operator*=(const BoutReal rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -507,6 +516,7 @@ Field3D& Field3D::operator/=(const BoutReal rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -544,6 +554,7 @@ Field3D& Field3D::operator+=(const BoutReal rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -580,6 +591,7 @@ Field3D& Field3D::operator-=(const BoutReal rhs) {
     // Delete existing parallel slices. We don't copy parallel slices, so any
     // that currently exist will be incorrect.
     clearParallelSlices();
+    clearFieldAlignedCache();
 
     checkData(*this);
     checkData(rhs);
@@ -35,7 +35,10 @@
 #include <bout/openmpwrap.hxx>
 
 #include <fftw3.h>
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <utility>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -375,6 +378,85 @@ void irfft(MAYBE_UNUSED(const dcomplex *in), MAYBE_UNUSED(int length), MAYBE_UNU
 }
 #endif
 
+// Batched transforms. The plans are shared between threads, since
+// fftw_execute_dft_* is thread safe; only making plans must be
+// serialised. FFTW_UNALIGNED lets the plans be applied to any arrays
+
+#ifdef BOUT_HAS_FFTW
+namespace {
+/// Plan for \p howmany transforms of \p length points, made on first use
+template <bool forward>
+fftw_plan batchedPlan(int length, int howmany) {
+  static std::map<std::pair<int, int>, fftw_plan> plans;
+
+  fftw_plan plan = nullptr;
+  BOUT_OMP(critical(fft_batched_plan)) {
+    auto it = plans.find({length, howmany});
+    if (it != plans.end()) {
+      plan = it->second;
+    } else {
+      fft_init();
+
+      const int nmodes = length / 2 + 1;
+      // Planning may overwrite the arrays, so use scratch ones
+      auto* real = static_cast<double*>(fftw_malloc(sizeof(double) * length * howmany));
+      auto* cmplx =
+          static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex) * nmodes * howmany));
+
+      const auto flags = get_measurement_flag(fft_measurement_flag) | FFTW_UNALIGNED;
+      if (forward) {
+        plan = fftw_plan_many_dft_r2c(1, &length, howmany, real, nullptr, 1, length,
+                                      cmplx, nullptr, 1, nmodes, flags);
+      } else {
+        plan = fftw_plan_many_dft_c2r(1, &length, howmany, cmplx, nullptr, 1, nmodes,
+                                      real, nullptr, 1, length, flags);
+      }
+      fftw_free(real);
+      fftw_free(cmplx);
+
+      plans[{length, howmany}] = plan;
+    }
+  }
+  return plan;
+}
+} // namespace
+#endif
+
+void rfft(MAYBE_UNUSED(const BoutReal *in), MAYBE_UNUSED(int length),
+          MAYBE_UNUSED(int howmany), MAYBE_UNUSED(dcomplex *out)) {
+#ifndef BOUT_HAS_FFTW
+  throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
+#else
+  static_assert(sizeof(dcomplex) == sizeof(fftw_complex),
+                "dcomplex must have the same layout as fftw_complex");
+
+  // r2c transforms do not modify their input
+  fftw_execute_dft_r2c(batchedPlan<true>(length, howmany), const_cast<BoutReal*>(in),
+                       reinterpret_cast<fftw_complex*>(out));
+
+  const BoutReal fac = 1.0 / static_cast<BoutReal>(length);
+  const int ntotal = (length / 2 + 1) * howmany;
+  for (int i = 0; i < ntotal; i++) {
+    out[i] *= fac; // Normalise
+  }
+#endif
+}
+
+void irfft(MAYBE_UNUSED(const dcomplex *in), MAYBE_UNUSED(int length),
+           MAYBE_UNUSED(int howmany), MAYBE_UNUSED(BoutReal *out)) {
+#ifndef BOUT_HAS_FFTW
+  throw BoutException("This instance of BOUT++ has been compiled without fftw support.");
+#else
+  // c2r transforms overwrite their input, so need a copy
+  const int ntotal = (length / 2 + 1) * howmany;
+  Array<dcomplex> work(ntotal);
+  std::copy(in, in + ntotal, std::begin(work));
+
+  fftw_execute_dft_c2r(batchedPlan<false>(length, howmany),
+                       reinterpret_cast<fftw_complex*>(std::begin(work)), out);
+#endif
+}
+
 //  Discrete sine transforms (B Shanahan)
 
 void DST(MAYBE_UNUSED(const BoutReal *in), MAYBE_UNUSED(int length), MAYBE_UNUSED(dcomplex *out)) {
@@ -0,0 +1,17 @@
+#include <bout/invert/iteration_monitor.hxx>
+
+#include <bout/solver.hxx>
+#include <datafile.hxx>
+
+void IterationMonitor::save(Datafile& output_file, Solver& solver,
+                            const std::string& name) {
+  if (enabled) {
+    // Already being saved
+    return;
+  }
+  enabled = true;
+
+  output_file.addRepeat(output_average_iterations, name + "_average_iterations");
+
+  solver.addMonitor(this, Solver::BACK);
+}
@@ -50,8 +50,25 @@ extern "C" {
   void dgtsv_(int *n, int *nrhs, BoutReal *dl, BoutReal *d, BoutReal *du, BoutReal *b, int *ldb, int *info); 
   /// Complex band solver
   void zgbsv_(int *n, int *kl, int *ku, int *nrhs, fcmplx *ab, int *ldab, int *ipiv, fcmplx *b, int *ldb, int *info);
+  /// Complex tridiagonal LU factorisation and solve
+  void zgttrf_(int *n, fcmplx *dl, fcmplx *d, fcmplx *du, fcmplx *du2, int *ipiv, int *info);
+  void zgttrs_(const char *trans, int *n, int *nrhs, fcmplx *dl, fcmplx *d, fcmplx *du,
+               fcmplx *du2, int *ipiv, fcmplx *b, int *ldb, int *info);
+  /// Complex band LU factorisation and solve
+  void zgbtrf_(int *m, int *n, int *kl, int *ku, fcmplx *ab, int *ldab, int *ipiv, int *info);
+  void zgbtrs_(const char *trans, int *n, int *kl, int *ku, int *nrhs, fcmplx *ab,
+               int *ldab, int *ipiv, fcmplx *b, int *ldb, int *info);
+  /// Single precision band LU factorisation and solve
+  void sgbtrf_(int *m, int *n, int *kl, int *ku, float *ab, int *ldab, int *ipiv, int *info);
+  void sgbtrs_(const char *trans, int *n, int *kl, int *ku, int *nrhs, float *ab,
+               int *ldab, int *ipiv, float *b, int *ldb, int *info);
 }
 
+// The factorised routines store their factors as dcomplex, and pass
+// them straight to LAPACK
+static_assert(sizeof(fcmplx) == sizeof(dcomplex),
+              "fcmplx and dcomplex must have the same layout");
+
 /// Use LAPACK routine ZGTSV
 int tridag(const dcomplex *a, const dcomplex *b, const dcomplex *c, const dcomplex *r, dcomplex *u, int n) {
   
@@ -256,6 +273,124 @@ void cband_solve(Matrix<dcomplex> &a, int n, int m1, int m2, Array<dcomplex> &b)
   }
 }
 
+/// Use LAPACK routine ZGTTRF
+///
+/// The factors are stored in \p lu as the four arrays (dl, d, du, du2)
+/// of length n used by LAPACK
+void tridagFactorise(const dcomplex *a, const dcomplex *b, const dcomplex *c,
+                     dcomplex *lu, int *ipiv, int n) {
+  dcomplex *dl = lu;
+  dcomplex *d = lu + n;
+  dcomplex *du = lu + 2 * n;
+  dcomplex *du2 = lu + 3 * n;
+
+  for (int i = 0; i < n; i++) {
+    d[i] = b[i];
+    if (i != (n - 1)) {
+      dl[i] = a[i + 1];
+      du[i] = c[i];
+    }
+  }
+
+  int info;
+  zgttrf_(&n, reinterpret_cast<fcmplx *>(dl), reinterpret_cast<fcmplx *>(d),
+          reinterpret_cast<fcmplx *>(du), reinterpret_cast<fcmplx *>(du2), ipiv, &info);
+
+  if (info != 0) {
+    throw BoutException("Problem in LAPACK ZGTTRF routine: info = %d\n", info);
+  }
+}
+
+/// Use LAPACK routine ZGTTRS
+void tridagSolveFactorised(const dcomplex *lu, const int *ipiv, const dcomplex *r,
+                           dcomplex *u, int n) {
+  // Factors are not modified by ZGTTRS
+  auto *dl = reinterpret_cast<fcmplx *>(const_cast<dcomplex *>(lu));
+
+  for (int i = 0; i < n; i++) {
+    u[i] = r[i];
+  }
+
+  int nrhs = 1;
+  int info;
+  zgttrs_("N", &n, &nrhs, dl, dl + n, dl + 2 * n, dl + 3 * n, const_cast<int *>(ipiv),
+          reinterpret_cast<fcmplx *>(u), &n, &info);
+
+  if (info != 0) {
+    throw BoutException("Problem in LAPACK ZGTTRS routine: info = %d\n", info);
+  }
+}
+
+/// Use LAPACK routine ZGBTRF. Matrix format is the same as cband_solve
+void cbandFactorise(const Matrix<dcomplex> &a, int n, int m1, int m2, dcomplex *lu,
+                    int *ipiv) {
+  int kl = m1;
+  int ku = m2;
+  int ldab = 2 * kl + ku + 1;
+
+  for (int i = 0; i < ldab * n; i++) {
+    lu[i] = 0.0;
+  }
+  for (int j = 0; j < n; j++) {
+    for (int i = 0; i <= (ku + kl); i++) {
+      if (((j - ku + i) >= 0) && ((j - ku + i) < n)) {
+        lu[j * ldab + kl + i] = a(j - ku + i, kl + ku - i);
+      }
+    }
+  }
+
+  int info;
+  zgbtrf_(&n, &n, &kl, &ku, reinterpret_cast<fcmplx *>(lu), &ldab, ipiv, &info);
+
+  if (info != 0) {
+    throw BoutException("Problem in LAPACK ZGBTRF routine: info = %d\n", info);
+  }
+}
+
+/// Use LAPACK routine ZGBTRS
+void cbandSolveFactorised(const dcomplex *lu, const int *ipiv, int n, int m1, int m2,
+                          Array<dcomplex> &b) {
+  int kl = m1;
+  int ku = m2;
+  int ldab = 2 * kl + ku + 1;
+  int nrhs = 1;
+  int info;
+
+  zgbtrs_("N", &n, &kl, &ku, &nrhs,
+          reinterpret_cast<fcmplx *>(const_cast<dcomplex *>(lu)), &ldab,
+          const_cast<int *>(ipiv), reinterpret_cast<fcmplx *>(b.begin()), &n, &info);
+
+  if (info != 0) {
+    throw BoutException("Problem in LAPACK ZGBTRS routine: info = %d\n", info);
+  }
+}
+
+/// Use LAPACK routine SGBTRF
+void sbandFactorise(float *ab, int n, int kl, int ku, int *ipiv) {
+  int ldab = 2 * kl + ku + 1;
+  int info;
+  sgbtrf_(&n, &n, &kl, &ku, ab, &ldab, ipiv, &info);
+
+  if (info != 0) {
+    throw BoutException("Problem in LAPACK SGBTRF routine: info = %d\n", info);
+  }
+}
+
+/// Use LAPACK routine SGBTRS
+void sbandSolveFactorised(const float *ab, const int *ipiv, int n, int kl, int ku,
+                          float *x) {
+  int ldab = 2 * kl + ku + 1;
+  int nrhs = 1;
+  int info;
+
+  sgbtrs_("N", &n, &kl, &ku, &nrhs, const_cast<float *>(ab), &ldab,
+          const_cast<int *>(ipiv), x, &n, &info);
+
+  if (info != 0) {
+    throw BoutException("Problem in LAPACK SGBTRS routine: info = %d\n", info);
+  }
+}
+
 #else
 // No LAPACK available. Routines throw exceptions
 
@@ -278,6 +413,30 @@ void cband_solve(Matrix<dcomplex>&, int, int, int, Array<dcomplex>&) {
   throw BoutException("cband_solve function not available. Compile BOUT++ with Lapack support.");
 }
 
+void tridagFactorise(const dcomplex*, const dcomplex*, const dcomplex*, dcomplex*, int*, int) {
+  throw BoutException("tridagFactorise function not available. Compile BOUT++ with Lapack support.");
+}
+
+void tridagSolveFactorised(const dcomplex*, const int*, const dcomplex*, dcomplex*, int) {
+  throw BoutException("tridagSolveFactorised function not available. Compile BOUT++ with Lapack support.");
+}
+
+void cbandFactorise(const Matrix<dcomplex>&, int, int, int, dcomplex*, int*) {
+  throw BoutException("cbandFactorise function not available. Compile BOUT++ with Lapack support.");
+}
+
+void cbandSolveFactorised(const dcomplex*, const int*, int, int, int, Array<dcomplex>&) {
+  throw BoutException("cbandSolveFactorised function not available. Compile BOUT++ with Lapack support.");
+}
+
+void sbandFactorise(float*, int, int, int, int*) {
+  throw BoutException("sbandFactorise function not available. Compile BOUT++ with Lapack support.");
+}
+
+void sbandSolveFactorised(const float*, const int*, int, int, int, float*) {
+  throw BoutException("sbandSolveFactorised function not available. Compile BOUT++ with Lapack support.");
+}
+
 #endif // LAPACK
 
 // Common functions
@@ -0,0 +1,238 @@
+#include "auto_laplace.hxx"
+
+#include <bout/mesh.hxx>
+#include <boutcomm.hxx>
+#include <boutexception.hxx>
+#include <msg_stack.hxx>
+#include <output.hxx>
+#include <utils.hxx>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+LaplaceAuto::LaplaceAuto(Options* opt, const CELL_LOC loc, Mesh* mesh_in)
+    : Laplacian(opt, loc, mesh_in),
+      opt(opt == nullptr ? Options::getRoot()->getSection("laplace") : opt),
+      create_solver(Laplacian::create) {
+
+  use_cache = (*this->opt)["auto_cache"]
+                  .doc("Read and write the chosen type in BOUT.laplace_auto in the "
+                       "data directory")
+                  .withDefault(true);
+  recalibrate = (*this->opt)["auto_recalibrate"]
+                    .doc("Time the implementations again, even if a choice is stored")
+                    .withDefault(false);
+}
+
+void LaplaceAuto::setGlobalFlags(int f) {
+  Laplacian::setGlobalFlags(f);
+  if (solver) {
+    solver->setGlobalFlags(f);
+  }
+}
+
+void LaplaceAuto::setInnerBoundaryFlags(int f) {
+  Laplacian::setInnerBoundaryFlags(f);
+  if (solver) {
+    solver->setInnerBoundaryFlags(f);
+  }
+}
+
+void LaplaceAuto::setOuterBoundaryFlags(int f) {
+  Laplacian::setOuterBoundaryFlags(f);
+  if (solver) {
+    solver->setOuterBoundaryFlags(f);
+  }
+}
+
+FieldPerp LaplaceAuto::solve(const FieldPerp& b) {
+  choose(b, zeroFrom(b));
+  return solver->solve(b);
+}
+
+FieldPerp LaplaceAuto::solve(const FieldPerp& b, const FieldPerp& x0) {
+  choose(b, x0);
+  return solver->solve(b, x0);
+}
+
+Field3D LaplaceAuto::solve(const Field3D& b) {
+  choose(b, zeroFrom(b));
+  return solver->solve(b);
+}
+
+Field3D LaplaceAuto::solve(const Field3D& b, const Field3D& x0) {
+  choose(b, x0);
+  return solver->solve(b, x0);
+}
+
+std::vector<Field3D> LaplaceAuto::solve(const std::vector<Field3D>& b) {
+  if (b.empty()) {
+    return {};
+  }
+  choose(b[0], zeroFrom(b[0]));
+  return solver->solve(b);
+}
+
+std::vector<Field3D> LaplaceAuto::solve(const std::vector<Field3D>& b,
+                                        const std::vector<Field3D>& x0) {
+  if (b.empty()) {
+    return {};
+  }
+  if (b.size() != x0.size()) {
+    throw BoutException("LaplaceAuto::solve: %d right-hand sides but %d initial guesses",
+                        static_cast<int>(b.size()), static_cast<int>(x0.size()));
+  }
+  choose(b[0], x0[0]);
+  return solver->solve(b, x0);
+}
+
+void LaplaceAuto::savePerformance(Datafile& output_file, Solver& solver_in,
+                                  const std::string& name) {
+  if (solver) {
+    solver->savePerformance(output_file, solver_in, name);
+    return;
+  }
+  performance_file = &output_file;
+  performance_solver = &solver_in;
+  performance_name = name;
+}
+
+void LaplaceAuto::setCoef(const std::string& name,
+                          const LaplaceBenchmark::Setup& setter) {
+  for (auto it = coefficients.begin(); it != coefficients.end(); ++it) {
+    if (it->first == name) {
+      coefficients.erase(it);
+      break;
+    }
+  }
+  coefficients.emplace_back(name, setter);
+
+  if (solver) {
+    setter(*solver);
+  }
+}
+
+void LaplaceAuto::applySettings(Laplacian& lap) const {
+  lap.setGlobalFlags(global_flags);
+  lap.setInnerBoundaryFlags(inner_boundary_flags);
+  lap.setOuterBoundaryFlags(outer_boundary_flags);
+  for (const auto& coefficient : coefficients) {
+    coefficient.second(lap);
+  }
+}
+
+template <typename T>
+void LaplaceAuto::choose(const T& b, const T& x0) {
+  if (solver) {
+    return;
+  }
+  TRACE("LaplaceAuto::choose");
+
+  if (use_cache and not recalibrate) {
+    type = readCache();
+  }
+
+  if (type.empty()) {
+    LaplaceBenchmark benchmark(opt, location, localmesh);
+    benchmark.setNeeds3DCoefs(uses_3d_coefs);
+    benchmark.setCreator(create_solver);
+    const auto results =
+        benchmark.run([this](Laplacian& lap) { applySettings(lap); }, b, x0);
+
+    std::stringstream table;
+    LaplaceBenchmark::print(results, table);
+    output_info << "LaplaceAuto calibration for " << cacheKey() << ":\n" << table.str();
+
+    type = LaplaceBenchmark::fastest(results);
+    if (type.empty()) {
+      throw BoutException("LaplaceAuto: no Laplacian implementation agreed with the "
+                          "reference solution");
+    }
+    if (use_cache) {
+      writeCache(type);
+    }
+  }
+  output_info << "LaplaceAuto: using " << type << " for " << cacheKey() << "\n";
+
+  solver_options = LaplaceBenchmark::userOptions(*opt);
+  solver_options["type"].force(type, "LaplaceAuto");
+  solver.reset(create_solver(&solver_options, location, localmesh));
+  applySettings(*solver);
+
+  if (performance_file != nullptr) {
+    solver->savePerformance(*performance_file, *performance_solver, performance_name);
+  }
+}
+
+std::string LaplaceAuto::cacheKey() const {
+  std::stringstream key;
+  key << opt->str() << ":" << toString(location) << ":" << localmesh->GlobalNx << "x"
+      << localmesh->GlobalNy << "x" << localmesh->GlobalNz << ":"
+      << localmesh->getNXPE() << "x" << localmesh->getNYPE();
+  return key.str();
+}
+
+std::string LaplaceAuto::cacheFile() const {
+  return Options::root()["datadir"].withDefault<std::string>("data")
+         + "/BOUT.laplace_auto";
+}
+
+namespace {
+/// Read "key = type" lines from \p filename
+std::map<std::string, std::string> readCacheEntries(const std::string& filename) {
+  std::map<std::string, std::string> entries;
+  std::ifstream file(filename);
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto separator = line.find(" = ");
+    if (separator != std::string::npos) {
+      entries[trim(line.substr(0, separator))] = trim(line.substr(separator + 3));
+    }
+  }
+  return entries;
+}
+} // namespace
+
+std::string LaplaceAuto::readCache() const {
+  // Read on one processor, so they all use the same choice
+  std::string result;
+  int rank;
+  MPI_Comm_rank(BoutComm::get(), &rank);
+  if (rank == 0) {
+    const auto entries = readCacheEntries(cacheFile());
+    const auto it = entries.find(cacheKey());
+    if (it != entries.end()) {
+      result = it->second;
+    }
+  }
+
+  int length = result.size();
+  MPI_Bcast(&length, 1, MPI_INT, 0, BoutComm::get());
+  result.resize(length);
+  MPI_Bcast(&result[0], length, MPI_CHAR, 0, BoutComm::get());
+  return result;
+}
+
+void LaplaceAuto::writeCache(const std::string& chosen) const {
+  int rank;
+  MPI_Comm_rank(BoutComm::get(), &rank);
+  if (rank != 0) {
+    return;
+  }
+
+  // Keep the choices for other problems
+  auto entries = readCacheEntries(cacheFile());
+  entries[cacheKey()] = chosen;
+
+  std::ofstream file(cacheFile());
+  if (!file) {
+    output_warn << "LaplaceAuto: could not write " << cacheFile() << "\n";
+    return;
+  }
+  file << "# Laplacian types chosen by 'type = auto', for each\n"
+       << "# section:location:grid size:processors. Delete to recalibrate\n";
+  for (const auto& entry : entries) {
+    file << entry.first << " = " << entry.second << "\n";
+  }
+}
@@ -0,0 +1,181 @@
+/**************************************************************************
+ * Chooses the fastest Laplacian implementation by timing them all
+ *
+ **************************************************************************
+ * Copyright 2020 BOUT++ contributors
+ *
+ * Contact: Ben Dudson, bd512@york.ac.uk
+ *
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+class LaplaceAuto;
+
+#ifndef __LAPLACE_AUTO_H__
+#define __LAPLACE_AUTO_H__
+
+#include <bout/invert/laplace_benchmark.hxx>
+#include <invert_laplace.hxx>
+#include <options.hxx>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Uses whichever Laplacian implementation is fastest for the problem.
+///
+/// On the first solve, every available implementation is run on that
+/// problem with LaplaceBenchmark, and the fastest one which agrees with
+/// the reference is used from then on. The choice is stored in
+/// BOUT.laplace_auto in the data directory, for each options section,
+/// location, grid size and processor decomposition, so later runs
+/// can skip the calibration
+class LaplaceAuto : public Laplacian {
+public:
+  LaplaceAuto(Options* opt = nullptr, const CELL_LOC loc = CELL_CENTRE,
+              Mesh* mesh_in = nullptr);
+  ~LaplaceAuto() = default;
+
+  using Laplacian::setCoefA;
+  void setCoefA(const Field2D& val) override {
+    setCoef("A", [val](Laplacian& lap) { lap.setCoefA(val); });
+  }
+  void setCoefA(const Field3D& val) override {
+    uses_3d_coefs = true;
+    setCoef("A", [val](Laplacian& lap) { lap.setCoefA(val); });
+  }
+  using Laplacian::setCoefC;
+  void setCoefC(const Field2D& val) override {
+    setCoef("C", [val](Laplacian& lap) { lap.setCoefC(val); });
+  }
+  void setCoefC(const Field3D& val) override {
+    uses_3d_coefs = true;
+    setCoef("C", [val](Laplacian& lap) { lap.setCoefC(val); });
+  }
+  using Laplacian::setCoefC1;
+  void setCoefC1(const Field2D& val) override {
+    setCoef("C1", [val](Laplacian& lap) { lap.setCoefC1(val); });
+  }
+  void setCoefC1(const Field3D& val) override {
+    uses_3d_coefs = true;
+    setCoef("C1", [val](Laplacian& lap) { lap.setCoefC1(val); });
+  }
+  using Laplacian::setCoefC2;
+  void setCoefC2(const Field2D& val) override {
+    setCoef("C2", [val](Laplacian& lap) { lap.setCoefC2(val); });
+  }
+  void setCoefC2(const Field3D& val) override {
+    uses_3d_coefs = true;
+    setCoef("C2", [val](Laplacian& lap) { lap.setCoefC2(val); });
+  }
+  using Laplacian::setCoefD;
+  void setCoefD(const Field2D& val) override {
+    setCoef("D", [val](Laplacian& lap) { lap.setCoefD(val); });
+  }
+  void setCoefD(const Field3D& val) override {
+    uses_3d_coefs = true;
+    setCoef("D", [val](Laplacian& lap) { lap.setCoefD(val); });
+  }
+  using Laplacian::setCoefEx;
+  void setCoefEx(const Field2D& val) override {
+    setCoef("Ex", [val](Laplacian& lap) { lap.setCoefEx(val); });
+  }
+  void setCoefEx(const Field3D& val) override {
+    uses_3d_coefs = true;
+    setCoef("Ex", [val](Laplacian& lap) { lap.setCoefEx(val); });
+  }
+  using Laplacian::setCoefEz;
+  void setCoefEz(const Field2D& val) override {
+    setCoef("Ez", [val](Laplacian& lap) { lap.setCoefEz(val); });
+  }
+  void setCoefEz(const Field3D& val) override {
+    uses_3d_coefs = true;
+    setCoef("Ez", [val](Laplacian& lap) { lap.setCoefEz(val); });
+  }
+
+  void setGlobalFlags(int f) override;
+  void setInnerBoundaryFlags(int f) override;
+  void setOuterBoundaryFlags(int f) override;
+
+  /// Before the calibration, whether any Field3D coefficients have been set
+  bool uses3DCoefs() const override {
+    return solver ? solver->uses3DCoefs() : uses_3d_coefs;
+  }
+
+  using Laplacian::solve;
+  FieldPerp solve(const FieldPerp& b) override;
+  FieldPerp solve(const FieldPerp& b, const FieldPerp& x0) override;
+  Field3D solve(const Field3D& b) override;
+  Field3D solve(const Field3D& b, const Field3D& x0) override;
+  std::vector<Field3D> solve(const std::vector<Field3D>& b) override;
+  std::vector<Field3D> solve(const std::vector<Field3D>& b,
+                             const std::vector<Field3D>& x0) override;
+
+  /// Passed on to the chosen implementation once there is one
+  void savePerformance(Datafile& output_file, Solver& solver,
+                       const std::string& name) override;
+
+  /// The chosen type. Empty before the first solve
+  std::string getType() const { return type; }
+
+  /// Use \p create_in to make the solvers, rather than Laplacian::create
+  void setCreator(LaplaceBenchmark::Creator create_in) {
+    create_solver = std::move(create_in);
+  }
+
+private:
+  Options* opt;
+
+  bool use_cache;   ///< Read and write the choice in BOUT.laplace_auto?
+  bool recalibrate; ///< Calibrate even if there is a stored choice?
+
+  bool uses_3d_coefs{false};
+
+  LaplaceBenchmark::Creator create_solver; ///< Makes the benchmarked and chosen solvers
+
+  /// Latest call setting each coefficient, in the order they were made
+  std::vector<std::pair<std::string, LaplaceBenchmark::Setup>> coefficients;
+
+  std::string type;                  ///< The chosen implementation
+  Options solver_options;            ///< Options of the chosen implementation
+  std::unique_ptr<Laplacian> solver; ///< The chosen implementation
+
+  /// Arguments of a call to savePerformance before there was a solver
+  Datafile* performance_file{nullptr};
+  Solver* performance_solver{nullptr};
+  std::string performance_name;
+
+  /// Record a coefficient, and pass it on if there is a solver
+  void setCoef(const std::string& name, const LaplaceBenchmark::Setup& setter);
+
+  /// Set the flags and coefficients of \p lap to match this solver
+  void applySettings(Laplacian& lap) const;
+
+  /// Choose the implementation, if not done already
+  template <typename T>
+  void choose(const T& b, const T& x0);
+
+  /// Identifies this problem in the cache file
+  std::string cacheKey() const;
+  std::string cacheFile() const;
+  /// Stored type for this problem. Empty if there is none
+  std::string readCache() const;
+  void writeCache(const std::string& chosen) const;
+};
+
+#endif // __LAPLACE_AUTO_H__
@@ -101,6 +101,9 @@ FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
   int jy = rhs.getIndex();  // Get the Y index
   x.setIndex(jy);
 
+  // Can the factorised matrices in cr be reused?
+  const bool cached = factorisationValid(cached_version) && (cached_jy == jy);
+
   // Get the width of the boundary
 
   // If the flags to assign that only one guard cell should be used is set
@@ -147,6 +150,12 @@ FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
         BoutReal kwave =
             kz * 2.0 * PI / (2. * zlen); // wave number is 1/[rad]; DST has extra 2.
 
+        if (cached) {
+          // Matrix already factorised, so only the RHS needs boundary conditions
+          tridagMatrixRHS(&bcmplx(kz, 0), global_flags, inner_boundary_flags,
+                          outer_boundary_flags, false);
+          continue;
+        }
         tridagMatrix(&a(kz, 0), &b(kz, 0), &c(kz, 0), &bcmplx(kz, 0), jy,
                      kz,    // wave number index
                      kwave, // kwave (inverse wave length)
@@ -157,7 +166,11 @@ FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
     }
 
     // Solve tridiagonal systems
-    cr->setCoefs(a, b, c);
+    if (!cached) {
+      cr->setCoefs(a, b, c);
+      cached_version = coef_version;
+      cached_jy = jy;
+    }
     cr->solve(bcmplx, xcmplx);
 
     // FFT back to real space
@@ -212,6 +225,12 @@ FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
       BOUT_OMP(for nowait)
       for (int kz = 0; kz < nmode; kz++) {
         BoutReal kwave = kz * 2.0 * PI / (coords->zlength()); // wave number is 1/[rad]
+        if (cached) {
+          // Matrix already factorised, so only the RHS needs boundary conditions
+          tridagMatrixRHS(&bcmplx(kz, 0), global_flags, inner_boundary_flags,
+                          outer_boundary_flags, false);
+          continue;
+        }
         tridagMatrix(&a(kz, 0), &b(kz, 0), &c(kz, 0), &bcmplx(kz, 0), jy,
                      kz,    // True for the component constant (DC) in Z
                      kwave, // Z wave number
@@ -222,7 +241,11 @@ FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
     }
 
     // Solve tridiagonal systems
-    cr->setCoefs(a, b, c);
+    if (!cached) {
+      cr->setCoefs(a, b, c);
+      cached_version = coef_version;
+      cached_jy = jy;
+    }
     cr->solve(bcmplx, xcmplx);
 
     // FFT back to real space
@@ -257,15 +280,33 @@ FieldPerp LaplaceCyclic::solve(const FieldPerp& rhs, const FieldPerp& x0) {
 }
 
 Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
-  TRACE("LaplaceCyclic::solve(Field3D, Field3D)");
+  return solve(std::vector<Field3D>{rhs}, std::vector<Field3D>{x0})[0];
+}
 
-  ASSERT1(rhs.getLocation() == location);
-  ASSERT1(x0.getLocation() == location);
-  ASSERT1(localmesh == rhs.getMesh() && localmesh == x0.getMesh());
+std::vector<Field3D> LaplaceCyclic::solve(const std::vector<Field3D>& rhs,
+                                          const std::vector<Field3D>& x0) {
+  TRACE("LaplaceCyclic::solve(vector<Field3D>, vector<Field3D>)");
 
-  Timer timer("invert");
+  if (rhs.size() != x0.size()) {
+    throw BoutException("LaplaceCyclic::solve: %d right-hand sides but %d initial guesses",
+                        static_cast<int>(rhs.size()), static_cast<int>(x0.size()));
+  }
+
+  const int nrhs = rhs.size(); // Number of fields to invert
+
+  std::vector<Field3D> x; // Result
+  x.reserve(nrhs);
+  for (int r = 0; r < nrhs; r++) {
+    ASSERT1(rhs[r].getLocation() == location);
+    ASSERT1(x0[r].getLocation() == location);
+    ASSERT1(localmesh == rhs[r].getMesh() && localmesh == x0[r].getMesh());
+    x.push_back(emptyFrom(rhs[r]));
+  }
+  if (nrhs == 0) {
+    return x;
+  }
 
-  Field3D x{emptyFrom(rhs)}; // Result
+  Timer timer("invert");
 
   // Get the width of the boundary
 
@@ -299,15 +340,57 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
   }
 
   const int ny = (ye - ys + 1); // Number of Y points
-  const int nsys = nmode * ny;  // Number of systems of equations to solve
+  const int nsys = nmode * ny;  // Number of systems of equations for each field
   const int nxny = nx * ny;     // Number of points in X-Y
 
-  auto a3D = Matrix<dcomplex>(nsys, nx);
-  auto b3D = Matrix<dcomplex>(nsys, nx);
-  auto c3D = Matrix<dcomplex>(nsys, nx);
+  // All fields are solved in one batch, so that the systems share one
+  // set of messages in the cyclic reduction. The RHS for field r are
+  // rows r*nsys to (r+1)*nsys - 1, all using the same nsys matrices
+  const int nbatch = nrhs * nsys;
+
+  // Can the factorised matrices in cr be reused?
+  const bool cached = factorisationValid(cached_version) && (cached_jy == CACHED_3D);
 
-  auto xcmplx3D = Matrix<dcomplex>(nsys, nx);
-  auto bcmplx3D = Matrix<dcomplex>(nsys, nx);
+  // Matrix coefficients, only needed if the factorisation is out of date
+  Matrix<dcomplex> a3D, b3D, c3D;
+  if (!cached) {
+    a3D.reallocate(nsys, nx);
+    b3D.reallocate(nsys, nx);
+    c3D.reallocate(nsys, nx);
+  }
+
+  auto xcmplx3D = Matrix<dcomplex>(nbatch, nx);
+  auto bcmplx3D = Matrix<dcomplex>(nbatch, nx);
+
+  /// Set boundary conditions on the RHS, and calculate the matrix
+  /// coefficients (from the first field's rows) if not cached
+  auto setMatrices = [&](int ind, BoutReal kwave) {
+    // ind = r * nsys + (iy - ys) * nmode + kz
+    if (cached || (ind >= nsys)) {
+      // Matrix already known, so only the RHS needs boundary conditions
+      tridagMatrixRHS(&bcmplx3D(ind, 0), global_flags, inner_boundary_flags,
+                      outer_boundary_flags, false);
+      return;
+    }
+    int iy = ys + ind / nmode;
+    int kz = ind % nmode;
+    tridagMatrix(&a3D(ind, 0), &b3D(ind, 0), &c3D(ind, 0), &bcmplx3D(ind, 0), iy,
+                 kz,    // wave number index
+                 kwave, // Z wave number
+                 global_flags, inner_boundary_flags, outer_boundary_flags, &Acoef,
+                 &C1coef, &C2coef, &Dcoef,
+                 false); // Don't include guard cells in arrays
+  };
+
+  /// Factorise the nsys systems, which are shared by all fields
+  auto factorise = [&]() {
+    if (cached) {
+      return;
+    }
+    cr->setCoefs(a3D, b3D, c3D);
+    cached_version = coef_version;
+    cached_jy = CACHED_3D;
+  };
 
   if (dst) {
     BOUT_OMP(parallel) {
@@ -315,12 +398,13 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
       auto k1d =
           Array<dcomplex>(localmesh->LocalNz); // ZFFT routine expects input of this length
 
-      // Loop over X and Y indices, including boundaries but not guard cells.
+      // Loop over fields, X and Y indices, including boundaries but not guard cells.
       // (unless periodic in x)
       BOUT_OMP(for)
-      for (int ind = 0; ind < nxny; ++ind) {
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
+      for (int ind = 0; ind < nrhs * nxny; ++ind) {
+        // ind = r*nxny + (ix - xs)*(ye - ys + 1) + (iy - ys)
+        int r = ind / nxny;
+        int ix = xs + (ind % nxny) / ny;
         int iy = ys + ind % ny;
 
         // Take DST in Z direction and put result in k1d
@@ -329,40 +413,32 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
             ((localmesh->LocalNx - ix - 1 < outbndry) && (outer_boundary_flags & INVERT_SET) &&
              localmesh->lastX())) {
           // Use the values in x0 in the boundary
-          DST(x0(ix, iy) + 1, localmesh->LocalNz - 2, std::begin(k1d));
+          DST(x0[r](ix, iy) + 1, localmesh->LocalNz - 2, std::begin(k1d));
         } else {
-          DST(rhs(ix, iy) + 1, localmesh->LocalNz - 2, std::begin(k1d));
+          DST(rhs[r](ix, iy) + 1, localmesh->LocalNz - 2, std::begin(k1d));
         }
 
         // Copy into array, transposing so kz is first index
         for (int kz = 0; kz < nmode; kz++) {
-          bcmplx3D((iy - ys) * nmode + kz, ix - xs) = k1d[kz];
+          bcmplx3D(r * nsys + (iy - ys) * nmode + kz, ix - xs) = k1d[kz];
         }
       }
 
       // Get elements of the tridiagonal matrix
       // including boundary conditions
       BOUT_OMP(for nowait)
-      for (int ind = 0; ind < nsys; ind++) {
-        // ind = (iy - ys) * nmode + kz
-        int iy = ys + ind / nmode;
+      for (int ind = 0; ind < nbatch; ind++) {
         int kz = ind % nmode;
-
         BoutReal zlen = coords->dz * (localmesh->LocalNz - 3);
         BoutReal kwave =
             kz * 2.0 * PI / (2. * zlen); // wave number is 1/[rad]; DST has extra 2.
 
-        tridagMatrix(&a3D(ind, 0), &b3D(ind, 0), &c3D(ind, 0), &bcmplx3D(ind, 0), iy,
-                     kz,    // wave number index
-                     kwave, // kwave (inverse wave length)
-                     global_flags, inner_boundary_flags, outer_boundary_flags, &Acoef,
-                     &C1coef, &C2coef, &Dcoef,
-                     false); // Don't include guard cells in arrays
+        setMatrices(ind, kwave);
       }
     }
 
     // Solve tridiagonal systems
-    cr->setCoefs(a3D, b3D, c3D);
+    factorise();
     cr->solve(bcmplx3D, xcmplx3D);
 
     // FFT back to real space
@@ -372,22 +448,23 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
           Array<dcomplex>(localmesh->LocalNz); // ZFFT routine expects input of this length
 
       BOUT_OMP(for nowait)
-      for (int ind = 0; ind < nxny; ++ind) { // Loop over X and Y
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
+      for (int ind = 0; ind < nrhs * nxny; ++ind) { // Loop over fields, X and Y
+        // ind = r*nxny + (ix - xs)*(ye - ys + 1) + (iy - ys)
+        int r = ind / nxny;
+        int ix = xs + (ind % nxny) / ny;
         int iy = ys + ind % ny;
 
         for (int kz = 0; kz < nmode; kz++) {
-          k1d[kz] = xcmplx3D((iy - ys) * nmode + kz, ix - xs);
+          k1d[kz] = xcmplx3D(r * nsys + (iy - ys) * nmode + kz, ix - xs);
         }
 
         for (int kz = nmode; kz < localmesh->LocalNz; kz++)
           k1d[kz] = 0.0; // Filtering out all higher harmonics
 
-        DST_rev(std::begin(k1d), localmesh->LocalNz - 2, &x(ix, iy, 1));
+        DST_rev(std::begin(k1d), localmesh->LocalNz - 2, &x[r](ix, iy, 1));
 
-        x(ix, iy, 0) = -x(ix, iy, 2);
-        x(ix, iy, localmesh->LocalNz - 1) = -x(ix, iy, localmesh->LocalNz - 3);
+        x[r](ix, iy, 0) = -x[r](ix, iy, 2);
+        x[r](ix, iy, localmesh->LocalNz - 1) = -x[r](ix, iy, localmesh->LocalNz - 3);
       }
     }
   } else {
@@ -396,13 +473,14 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
       auto k1d = Array<dcomplex>(localmesh->LocalNz / 2 +
                                  1); // ZFFT routine expects input of this length
 
-      // Loop over X and Y indices, including boundaries but not guard cells
+      // Loop over fields, X and Y indices, including boundaries but not guard cells
       // (unless periodic in x)
 
       BOUT_OMP(for)
-      for (int ind = 0; ind < nxny; ++ind) {
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
+      for (int ind = 0; ind < nrhs * nxny; ++ind) {
+        // ind = r*nxny + (ix - xs)*(ye - ys + 1) + (iy - ys)
+        int r = ind / nxny;
+        int ix = xs + (ind % nxny) / ny;
         int iy = ys + ind % ny;
 
         // Take FFT in Z direction, apply shift, and put result in k1d
@@ -411,36 +489,29 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
             ((localmesh->LocalNx - ix - 1 < outbndry) && (outer_boundary_flags & INVERT_SET) &&
              localmesh->lastX())) {
           // Use the values in x0 in the boundary
-          rfft(x0(ix, iy), localmesh->LocalNz, std::begin(k1d));
+          rfft(x0[r](ix, iy), localmesh->LocalNz, std::begin(k1d));
         } else {
-          rfft(rhs(ix, iy), localmesh->LocalNz, std::begin(k1d));
+          rfft(rhs[r](ix, iy), localmesh->LocalNz, std::begin(k1d));
         }
 
         // Copy into array, transposing so kz is first index
         for (int kz = 0; kz < nmode; kz++)
-          bcmplx3D((iy - ys) * nmode + kz, ix - xs) = k1d[kz];
+          bcmplx3D(r * nsys + (iy - ys) * nmode + kz, ix - xs) = k1d[kz];
       }
 
       // Get elements of the tridiagonal matrix
       // including boundary conditions
       BOUT_OMP(for nowait)
-      for (int ind = 0; ind < nsys; ind++) {
-        // ind = (iy - ys) * nmode + kz
-        int iy = ys + ind / nmode;
+      for (int ind = 0; ind < nbatch; ind++) {
         int kz = ind % nmode;
-
         BoutReal kwave = kz * 2.0 * PI / (coords->zlength()); // wave number is 1/[rad]
-        tridagMatrix(&a3D(ind, 0), &b3D(ind, 0), &c3D(ind, 0), &bcmplx3D(ind, 0), iy,
-                     kz,    // True for the component constant (DC) in Z
-                     kwave, // Z wave number
-                     global_flags, inner_boundary_flags, outer_boundary_flags, &Acoef,
-                     &C1coef, &C2coef, &Dcoef,
-                     false); // Don't include guard cells in arrays
+
+        setMatrices(ind, kwave);
       }
     }
 
     // Solve tridiagonal systems
-    cr->setCoefs(a3D, b3D, c3D);
+    factorise();
     cr->solve(bcmplx3D, xcmplx3D);
 
     // FFT back to real space
@@ -452,9 +523,10 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
       const bool zero_DC = global_flags & INVERT_ZERO_DC;
 
       BOUT_OMP(for nowait)
-      for (int ind = 0; ind < nxny; ++ind) { // Loop over X and Y
-        // ind = (ix - xs)*(ye - ys + 1) + (iy - ys)
-        int ix = xs + ind / ny;
+      for (int ind = 0; ind < nrhs * nxny; ++ind) { // Loop over fields, X and Y
+        // ind = r*nxny + (ix - xs)*(ye - ys + 1) + (iy - ys)
+        int r = ind / nxny;
+        int ix = xs + (ind % nxny) / ny;
         int iy = ys + ind % ny;
 
         if (zero_DC) {
@@ -462,17 +534,19 @@ Field3D LaplaceCyclic::solve(const Field3D& rhs, const Field3D& x0) {
         }
 
         for (int kz = zero_DC; kz < nmode; kz++)
-          k1d[kz] = xcmplx3D((iy - ys) * nmode + kz, ix - xs);
+          k1d[kz] = xcmplx3D(r * nsys + (iy - ys) * nmode + kz, ix - xs);
 
         for (int kz = nmode; kz < localmesh->LocalNz / 2 + 1; kz++)
           k1d[kz] = 0.0; // Filtering out all higher harmonics
 
-        irfft(std::begin(k1d), localmesh->LocalNz, x(ix, iy));
+        irfft(std::begin(k1d), localmesh->LocalNz, x[r](ix, iy));
       }
     }
   }
 
-  checkData(x);
+  for (const auto& field : x) {
+    checkData(field);
+  }
 
   return x;
 }
@@ -52,6 +52,7 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Acoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefC;
   void setCoefC(const Field2D &val) override {
@@ -63,18 +64,21 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C1coef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefC2;
   void setCoefC2(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C2coef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefD;
   void setCoefD(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Dcoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefEx;
   void setCoefEx(const Field2D &UNUSED(val)) override {
@@ -91,6 +95,12 @@ public:
 
   Field3D solve(const Field3D &b) override {return solve(b,b);}
   Field3D solve(const Field3D &b, const Field3D &x0) override;
+
+  /// All the fields are solved in one batch of tridiagonal systems,
+  /// so they share the communication in the cyclic reduction
+  std::vector<Field3D> solve(const std::vector<Field3D> &b) override {return solve(b,b);}
+  std::vector<Field3D> solve(const std::vector<Field3D> &b,
+                             const std::vector<Field3D> &x0) override;
 private:
   Field2D Acoef, C1coef, C2coef, Dcoef;
   
@@ -101,6 +111,11 @@ private:
   bool dst;
   
   CyclicReduce<dcomplex> *cr; ///< Tridiagonal solver
+
+  /// Value of cached_jy when cr holds the matrices for a Field3D solve
+  static constexpr int CACHED_3D = -1;
+  int cached_version{-1}; ///< Laplacian::coef_version when cr was factorised
+  int cached_jy{-2};      ///< Y index of the matrices in cr, or CACHED_3D
 };
 
 #endif // __SPT_H__
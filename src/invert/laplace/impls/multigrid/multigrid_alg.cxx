@@ -71,7 +71,7 @@ MultigridAlg::~MultigridAlg() {
   delete [] matmg;
 }
 
-void MultigridAlg::getSolution(BoutReal *x,BoutReal *b,int flag) {
+int MultigridAlg::getSolution(BoutReal *x,BoutReal *b,int flag,bool nonzero_guess) {
 
   // swap ghost cells of initial guess
   communications(x, mglevel-1);
@@ -80,9 +80,9 @@ void MultigridAlg::getSolution(BoutReal *x,BoutReal *b,int flag) {
 
   if(flag == 0) {
     //Solve exaclty
-    if(mglevel == 1) pGMRES(x,b,mglevel-1,1);
-    else if(mgplag == 1) pGMRES(x,b,mglevel-1,1);
-    else solveMG(x,b,mglevel-1);
+    if(mglevel == 1) return pGMRES(x,b,mglevel-1,1,nonzero_guess);
+    else if(mgplag == 1) return pGMRES(x,b,mglevel-1,1,nonzero_guess);
+    else return solveMG(x,b,mglevel-1,nonzero_guess);
   }
   else {
     cycleMG(mglevel-1,x,b);
@@ -103,6 +103,7 @@ BOUT_OMP(for)
       }
     }
   }
+  return flag;
 }
 
 
@@ -255,7 +256,8 @@ BOUT_OMP(for collapse(2))
   }
 }
 
-void MultigridAlg::pGMRES(BoutReal *sol,BoutReal *rhs,int level,int iplag) {
+int MultigridAlg::pGMRES(BoutReal *sol,BoutReal *rhs,int level,int iplag,
+                         bool nonzero_guess) {
   int it,etest = 1,MAXIT;
   BoutReal ini_e,error,a0,a1,rederr,perror;
   BoutReal **v;
@@ -273,9 +275,11 @@ void MultigridAlg::pGMRES(BoutReal *sol,BoutReal *rhs,int level,int iplag) {
   Array<BoutReal> q(ldim);
   Array<BoutReal> r(ldim);
 
+  if (!nonzero_guess) {
   BOUT_OMP(parallel default(shared))
 BOUT_OMP(for)
-  for(int i = 0;i<ldim;i++) sol[i] = 0.0;
+    for(int i = 0;i<ldim;i++) sol[i] = 0.0;
+  }
   int num = 0;
 
   ini_e = sqrt(vectorProd(level,rhs,rhs));
@@ -286,20 +290,33 @@ BOUT_OMP(for)
     if((pcheck == 1) && (rProcI == 0)) {
       output<<numP<<"Don't need to solve. E= "<<ini_e<<endl;
     }
+    if (nonzero_guess) {
+      // The solution is zero, whatever the guess was
+BOUT_OMP(parallel default(shared))
+BOUT_OMP(for)
+      for(int i = 0;i<ldim;i++) sol[i] = 0.0;
+    }
     // Clean up memory before returning from method
     for(int i=0;i<MAXGM+1;i++) {
       delete [] v[i];
     }
     delete [] v;
-    return;
+    return 0;
+  }
+  // Initial residual. Compared against ini_e = |rhs| as for a zero
+  // initial guess, so a good guess reduces the number of iterations
+  BoutReal *res = rhs;
+  if (nonzero_guess) {
+    residualVec(level, sol, rhs, std::begin(q));
+    res = std::begin(q);
   }
 BOUT_OMP(parallel default(shared))
 BOUT_OMP(for)
   for(int i = 0;i<ldim;i++) r[i] = 0.0;
   if (iplag == 0)
-    smoothings(level, std::begin(r), rhs);
+    smoothings(level, std::begin(r), res);
   else
-    cycleMG(level, std::begin(r), rhs);
+    cycleMG(level, std::begin(r), res);
   BOUT_OMP(parallel default(shared))
 BOUT_OMP(for)
   for(int i = 0;i < ldim;i++) v[0][i] = r[i];
@@ -453,6 +470,7 @@ BOUT_OMP(for)
     delete [] v[i];
   }
   delete [] v;
+  return num;
 }
 
 void MultigridAlg::setMultigridC(int UNUSED(plag)) {
@@ -704,14 +722,16 @@ void MultigridAlg::communications(BoutReal* x, int level) {
 }
 
 
-void MultigridAlg::solveMG(BoutReal *sol,BoutReal *rhs,int level) {
+int MultigridAlg::solveMG(BoutReal *sol,BoutReal *rhs,int level,bool nonzero_guess) {
   int m,MAXIT = 150;
   BoutReal ini_e,perror,error,rederr;
   int ldim = (lnx[level]+2)*(lnz[level]+2);
 
+  if (!nonzero_guess) {
 BOUT_OMP(parallel default(shared))
 BOUT_OMP(for)
-  for(int i = 0;i<ldim;i++) sol[i] = 0.0;
+    for(int i = 0;i<ldim;i++) sol[i] = 0.0;
+  }
 
   ini_e = vectorProd(level,rhs,rhs);
   if(ini_e < 0.0)
@@ -721,9 +741,15 @@ BOUT_OMP(for)
     printf("%d \n  In MGsolve ini = %24.18f\n",numP,ini_e);
   Array<BoutReal> y(ldim);
   Array<BoutReal> r(ldim);
+  if (nonzero_guess) {
+    // Start from the residual of the guess, but keep the tolerance
+    // relative to the RHS
+    residualVec(level, sol, rhs, std::begin(r));
+  } else {
   BOUT_OMP(parallel default(shared))
 BOUT_OMP(for)
-  for(int i = 0;i<ldim;i++) r[i] = rhs[i];
+    for(int i = 0;i<ldim;i++) r[i] = rhs[i];
+  }
 
   perror = ini_e;
   for(m=0;m<MAXIT;m++) {
@@ -752,4 +778,5 @@ BOUT_OMP(for)
     printf("The average error reduction of MG %d: %14.8f(%18.12f)\n",m+1,rederr,error);
     fflush(stdout);
   }
+  return m+1;
 }
@@ -231,14 +231,17 @@ BOUT_OMP(for collapse(2))
       }
     }
   } else {
-    // Read initial guess into local array, ignoring guard cells
+    // Read initial guess into local array, ignoring guard cells. The guess
+    // may be extrapolated from previous solutions; boundary values still
+    // come from x0
+    const FieldPerp guess = initialGuess(x0);
 BOUT_OMP(parallel default(shared) )
 BOUT_OMP(for collapse(2))
     for (int i=1; i<lxx+1; i++) {
       for (int k=1; k<lzz+1; k++) {
         int i2 = i-1+localmesh->xstart;
         int k2 = k-1;
-        x[i*lz2+k] = x0[i2][k2];
+        x[i*lz2+k] = guess[i2][k2];
       }
     }
   }
@@ -416,7 +419,13 @@ BOUT_OMP(for)
   mgcount++;
   if (pcheck > 0) t0 = MPI_Wtime();
 
-  kMG->getSolution(std::begin(x), std::begin(b), 0);
+  // Only start from a non-zero guess if it is extrapolated from previous
+  // solutions; otherwise x0 is used for boundary values only
+  const bool nonzero_guess =
+      (initial_guess_history > 0) && !(global_flags & INVERT_START_NEW);
+  int iterations =
+      kMG->getSolution(std::begin(x), std::begin(b), 0, nonzero_guess);
+  performance.record(iterations);
 
   if (pcheck > 0) {
     t1 = MPI_Wtime();
@@ -544,6 +553,8 @@ BOUT_OMP(for)
 
   checkData(result);
 
+  storeSolution(result);
+
   return result;
 }
 
@@ -50,7 +50,10 @@ public:
   virtual ~MultigridAlg();
 
   void setMultigridC(int );
-  void getSolution(BoutReal *,BoutReal *,int ); 
+  /// Solve for x given b. If \p nonzero_guess is true, an exact
+  /// solve (flag = 0) starts from the values in x rather than zero.
+  /// Returns the number of iterations of the outer solver
+  int getSolution(BoutReal *,BoutReal *,int, bool nonzero_guess = false);
 
   int mglevel,mgplag,cftype,mgsm,pcheck,xNP,zNP,rProcI;
   BoutReal rtol,atol,dtol,omega;
@@ -70,8 +73,8 @@ protected:
   void smoothings(int , BoutReal *, BoutReal *);
   void projection(int , BoutReal *, BoutReal *);
   void prolongation(int ,BoutReal *, BoutReal *);
-  void pGMRES(BoutReal *, BoutReal *, int , int);
-  void solveMG(BoutReal *, BoutReal *, int );
+  int pGMRES(BoutReal *, BoutReal *, int , int, bool nonzero_guess = false);
+  int solveMG(BoutReal *, BoutReal *, int, bool nonzero_guess = false);
   void multiAVec(int , BoutReal *, BoutReal *);
   void residualVec(int , BoutReal *, BoutReal *, BoutReal *);
   BoutReal vectorProd(int , BoutReal *, BoutReal *); 
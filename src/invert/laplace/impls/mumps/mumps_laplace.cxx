@@ -97,6 +97,14 @@ LaplaceMumps::LaplaceMumps(Options *opt, const CELL_LOC loc, Mesh *mesh_in = mes
   opts->get("fourth_order", fourth_order, false);
 //   opts->get("repeat_analysis", repeat_analysis, 100);
 
+  // MUMPS is a direct solver, so there is no preconditioner to keep.
+  // Factors are only reused while the coefficients are unchanged
+  if ((*opts)["reuse_preconditioner"].isSet()
+      and ((*opts)["reuse_preconditioner"].as<int>() > 0)) {
+    throw BoutException("LaplaceMumps: reuse_preconditioner is not supported by the "
+                        "direct MUMPS solver");
+  }
+
   sol.allocate();
   
   mumps_struc.comm_fortran = (MUMPS_INT) MPI_Comm_c2f(localmesh->getXcomm()); // MPI communicator for MUMPS, in fortran format
@@ -428,9 +436,10 @@ LaplaceMumps::LaplaceMumps(Options *opt, const CELL_LOC loc, Mesh *mesh_in = mes
   // output<<"nz="<<mumps_struc.nz<<" nz_loc="<<mumps_struc.nz_loc<<endl;
   // MPI_Barrier(BoutComm::get()); exit(13);
 
+  // The analysis only depends on the nonzero pattern, so is done once.
+  // Each solve then either refactorises or reuses the factors
   mumps_struc.job = MUMPS_JOB_ANALYSIS;
   dmumps_c( &mumps_struc );
-  mumps_struc.job = MUMPS_JOB_BOTH;
 }
 
 // const Field3D LaplaceMumps::solve(const Field3D &b, const Field3D &x0) {
@@ -613,7 +622,18 @@ FieldPerp LaplaceMumps::solve(const FieldPerp& b) {
 
 void LaplaceMumps::solve(BoutReal* rhs, int y) {
 
-{ Timer timer("mumpssetup");
+// The factors can be reused until the coefficients or Y index change
+const bool factorised = factorisationValid(factorised_version) && (factorised_y == y);
+if (factorised) {
+  mumps_struc.job = MUMPS_JOB_SOLUTION;
+} else {
+  mumps_struc.job = MUMPS_JOB_BOTH;
+  factorised_version = coef_version;
+  factorised_y = y;
+}
+mumps_struc.rhs = rhs;
+
+if (!factorised) { Timer timer("mumpssetup");
   int i = 0;
   
   Coordinates *coord = localmesh->coordinates(location);
@@ -847,8 +867,6 @@ void LaplaceMumps::solve(BoutReal* rhs, int y) {
       }
   
   if ( i!=mumps_struc.nz_loc ) throw BoutException("LaplaceMumps: matrix index error");
-  
-  mumps_struc.rhs = rhs;
 }
 { Timer timer("mumpssolve");
   // Solve the system
@@ -90,6 +90,7 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     A = val;
+    coefficientsChanged();
   }
   void setCoefC(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -97,42 +98,49 @@ public:
     C1 = val;
     C2 = val;
     issetC = true;
+    coefficientsChanged();
   }
   void setCoefC1(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C1 = val;
     issetC = true;
+    coefficientsChanged();
   }
   void setCoefC2(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C2 = val;
     issetC = true;
+    coefficientsChanged();
   }
   void setCoefD(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     D = val;
     issetD = true;
+    coefficientsChanged();
   }
   void setCoefEx(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Ex = val;
     issetE = true;
+    coefficientsChanged();
   }
   void setCoefEz(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Ez = val;
     issetE = true;
+    coefficientsChanged();
   }
 
   void setCoefA(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     A = val;
+    coefficientsChanged();
   }
   void setCoefC(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -140,36 +148,42 @@ public:
     C1 = val;
     C2 = val;
     issetC = true;
+    coefficientsChanged();
   }
   void setCoefC1(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C1 = val;
     issetC = true;
+    coefficientsChanged();
   }
   void setCoefC2(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C2 = val;
     issetC = true;
+    coefficientsChanged();
   }
   void setCoefD(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     D = val;
     issetD = true;
+    coefficientsChanged();
   }
   void setCoefEx(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Ex = val;
     issetE = true;
+    coefficientsChanged();
   }
   void setCoefEz(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Ez = val;
     issetE = true;
+    coefficientsChanged();
   }
   
   bool uses3DCoefs() const override { return true; }
@@ -192,6 +206,8 @@ private:
   bool issetE;
 //   int repeat_analysis; // Repeat analysis step after this many iterations
 //   int iteration_count; // Use this to count the number of iterations since last analysis
+  int factorised_version{-1}; ///< Coefficient version of the current factors
+  int factorised_y{-1};       ///< Y index of the current factors
   
   Array<BoutReal> rhs; // Array to collect rhs field onto host processor
 //   BoutReal* rhs_slice; // Array to pass xz-slice of rhs to solve
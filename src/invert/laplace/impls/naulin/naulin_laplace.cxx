@@ -134,8 +134,16 @@
  *                  * Stop: Function returns phiNext
  *          * if no
  *              * Stop: Function returns phiNext
+ *
+ * If anderson_depth > 0, step 2 uses Anderson acceleration instead of
+ * under-relaxation: the next rhs is the combination of the last
+ * anderson_depth+1 iterates b(phiCur) and their residuals that
+ * minimises the (linearised) residual, mixed with underrelax_factor.
+ * On divergence the stored iterates are discarded rather than
+ * underrelax_factor being reduced.
  */
 
+#include <boutcomm.hxx>
 #include <boutexception.hxx>
 #include <bout/mesh.hxx>
 #include <bout/coordinates.hxx>
@@ -146,9 +154,139 @@
 
 #include "naulin_laplace.hxx"
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <vector>
+
+namespace {
+/// Anderson acceleration of the fixed point iteration b -> G(b)
+///
+/// Keeps the differences between the last few iterates b_i and
+/// residuals f_i = G(b_i) - b_i. The next iterate is
+///
+///     b + beta*f - sum_i gamma_i (Delta b_i + beta*Delta f_i)
+///
+/// where gamma minimises |f - sum_i gamma_i Delta f_i| (Walker & Ni 2011)
+class AndersonMixing {
+public:
+  /// @param[in] depth   Number of differences kept
+  /// @param[in] beta    Mixing parameter, 1 for no damping
+  AndersonMixing(int depth, BoutReal beta) : depth(depth), beta(beta) {}
+
+  /// Next iterate, given the current iterate \p b and its residual \p f
+  Field3D next(const Field3D& b, const Field3D& f) {
+    if (have_previous) {
+      delta_b.push_back(b - b_previous);
+      delta_f.push_back(f - f_previous);
+      if (static_cast<int>(delta_f.size()) > depth) {
+        delta_b.pop_front();
+        delta_f.pop_front();
+      }
+    }
+    b_previous = b;
+    f_previous = f;
+    have_previous = true;
+
+    Field3D result = b + beta * f;
+    const std::vector<BoutReal> gamma = coefficients(f);
+    for (std::size_t i = 0; i < gamma.size(); ++i) {
+      result -= gamma[i] * (delta_b[i] + beta * delta_f[i]);
+    }
+    return result;
+  }
+
+  /// Forget the stored iterates, e.g. if the iteration starts to diverge
+  void restart() {
+    delta_b.clear();
+    delta_f.clear();
+    have_previous = false;
+  }
+
+private:
+  int depth;
+  BoutReal beta;
+
+  bool have_previous{false};
+  Field3D b_previous, f_previous;
+  std::deque<Field3D> delta_b, delta_f; ///< Oldest first
+
+  /// Solve the least-squares problem for gamma using the normal
+  /// equations. The inner products are summed over all processors in
+  /// one reduction. Returns no coefficients if the system is singular
+  std::vector<BoutReal> coefficients(const Field3D& f) const {
+    const int n = delta_f.size();
+    if (n == 0) {
+      return {};
+    }
+
+    // Upper triangle of (Delta f)^T (Delta f), then (Delta f)^T f
+    const int ngram = n * (n + 1) / 2;
+    std::vector<BoutReal> local(ngram + n, 0.0);
+    BOUT_FOR_SERIAL(ind, f.getRegion("RGN_NOBNDRY")) {
+      int k = 0;
+      for (int i = 0; i < n; ++i) {
+        for (int j = i; j < n; ++j) {
+          local[k++] += delta_f[i][ind] * delta_f[j][ind];
+        }
+      }
+      for (int i = 0; i < n; ++i) {
+        local[ngram + i] += delta_f[i][ind] * f[ind];
+      }
+    }
+    std::vector<BoutReal> sums(ngram + n);
+    MPI_Allreduce(local.data(), sums.data(), ngram + n, MPI_DOUBLE, MPI_SUM,
+                  BoutComm::get());
+
+    // Gaussian elimination with partial pivoting on the augmented matrix
+    std::vector<std::vector<BoutReal>> a(n, std::vector<BoutReal>(n + 1));
+    int k = 0;
+    for (int i = 0; i < n; ++i) {
+      for (int j = i; j < n; ++j) {
+        a[i][j] = a[j][i] = sums[k++];
+      }
+      a[i][n] = sums[ngram + i];
+    }
+    BoutReal scale = 0.0;
+    for (int i = 0; i < n; ++i) {
+      scale = std::max(scale, a[i][i]);
+    }
+    for (int col = 0; col < n; ++col) {
+      int pivot = col;
+      for (int row = col + 1; row < n; ++row) {
+        if (std::abs(a[row][col]) > std::abs(a[pivot][col])) {
+          pivot = row;
+        }
+      }
+      if (std::abs(a[pivot][col]) <= 1e-14 * scale) {
+        // Differences are (nearly) linearly dependent
+        return {};
+      }
+      std::swap(a[col], a[pivot]);
+      for (int row = col + 1; row < n; ++row) {
+        const BoutReal factor = a[row][col] / a[col][col];
+        for (int j = col; j <= n; ++j) {
+          a[row][j] -= factor * a[col][j];
+        }
+      }
+    }
+    std::vector<BoutReal> gamma(n);
+    for (int i = n - 1; i >= 0; --i) {
+      BoutReal sum = a[i][n];
+      for (int j = i + 1; j < n; ++j) {
+        sum -= a[i][j] * gamma[j];
+      }
+      gamma[i] = sum / a[i][i];
+    }
+    return gamma;
+  }
+};
+} // namespace
+
 LaplaceNaulin::LaplaceNaulin(Options *opt, const CELL_LOC loc, Mesh *mesh_in)
     : Laplacian(opt, loc, mesh_in), Acoef(0.0), C1coef(1.0), C2coef(0.0), Dcoef(1.0),
-      delp2solver(nullptr), naulinsolver_mean_its(0.), ncalls(0) {
+      delp2solver(nullptr), naulinsolver_mean_its(0.), ncalls(0),
+      history(initial_guess_history) {
 
   ASSERT1(opt != nullptr); // An Options pointer should always be passed in by LaplaceFactory
 
@@ -163,6 +301,11 @@ LaplaceNaulin::LaplaceNaulin(Options *opt, const CELL_LOC loc, Mesh *mesh_in)
   OPTION(opt, maxits, 100);
   OPTION(opt, initial_underrelax_factor, 1.);
   ASSERT0(initial_underrelax_factor > 0. and initial_underrelax_factor <= 1.);
+  OPTION(opt, anderson_depth, 0);
+  if (anderson_depth < 0) {
+    throw BoutException("LaplaceNaulin: anderson_depth must be >= 0, but got %d",
+                        anderson_depth);
+  }
   delp2solver = create(opt->getSection("delp2solver"), location, localmesh);
   std::string delp2type;
   opt->getSection("delp2solver")->get("type", delp2type, "cyclic");
@@ -236,9 +379,12 @@ Field3D LaplaceNaulin::solve(const Field3D& rhs, const Field3D& x0) {
   Field3D AOverD_AC = AOverD - AOverD_DC;
 
 
-  delp2solver->setCoefA(AOverD_DC);
-  delp2solver->setCoefC1(C1coefTimesD_DC);
-  delp2solver->setCoefC2(C2coef_DC);
+  if (delp2solver_version != coef_version) {
+    delp2solver->setCoefA(AOverD_DC);
+    delp2solver->setCoefC1(C1coefTimesD_DC);
+    delp2solver->setCoefC2(C2coef_DC);
+    delp2solver_version = coef_version;
+  }
 
   // Use this below to normalize error for relative error estimate
   BoutReal RMS_rhsOverD = sqrt(mean(SQ(rhsOverD), true, "RGN_NOBNDRY")); // use sqrt(mean(SQ)) to make sure we do not divide by zero at a point
@@ -273,11 +419,20 @@ Field3D LaplaceNaulin::solve(const Field3D& rhs, const Field3D& x0) {
     return std::make_pair(b, x);
   };
 
-  Field3D b = calc_b_guess(x0);
-  // Need to make a copy of x0 here to make sure we don't change x0
-  auto b_x_pair = calc_b_x_pair(b, x0);
+  // Start from an extrapolation of previous solutions if there are any. The
+  // boundary conditions are still taken from x0
+  Field3D x_start = x0;
+  if (!history.empty() && !(global_flags & INVERT_START_NEW)) {
+    x_start = history.extrapolate();
+  }
+
+  Field3D b = calc_b_guess(x_start);
+  // Need to make a copy of x_start here to make sure we don't change x0
+  auto b_x_pair = calc_b_x_pair(b, x_start);
   auto b_x_pair_old = b_x_pair;
 
+  AndersonMixing anderson(anderson_depth, underrelax_factor);
+
   while (true) {
     Field3D bnew = calc_b_guess(b_x_pair.second);
 
@@ -292,6 +447,17 @@ Field3D LaplaceNaulin::solve(const Field3D& rhs, const Field3D& x0) {
       throw BoutException("LaplaceNaulin error: Not converged within maxits=%i iterations.", maxits);
     }
 
+    if (anderson_depth > 0) {
+      if (error_abs > last_error) {
+        // Iteration seems to be diverging... start again from the current iterate
+        anderson.restart();
+      }
+      last_error = error_abs;
+      // Residual of the fixed point iteration is bnew - b = -error3D
+      b_x_pair = calc_b_x_pair(anderson.next(b_x_pair.first, -error3D), b_x_pair.second);
+      continue;
+    }
+
     while (error_abs > last_error) {
       // Iteration seems to be diverging... try underrelaxing and restart
       underrelax_factor *= .9;
@@ -328,9 +494,12 @@ Field3D LaplaceNaulin::solve(const Field3D& rhs, const Field3D& x0) {
                            + BoutReal(count))/BoutReal(ncalls);
   naulinsolver_mean_underrelax_counts = (naulinsolver_mean_underrelax_counts * BoutReal(ncalls - 1)
                                          + BoutReal(underrelax_count)) / BoutReal(ncalls);
+  performance.record(count);
 
   checkData(b_x_pair.second);
 
+  history.push(b_x_pair.second);
+
   return b_x_pair.second;
 }
 
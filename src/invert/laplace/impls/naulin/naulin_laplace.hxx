@@ -47,11 +47,13 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Acoef = val;
+    coefficientsChanged();
   }
   void setCoefA(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Acoef = val;
+    coefficientsChanged();
   }
   void setCoefC(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -69,31 +71,37 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C1coef = val;
+    coefficientsChanged();
   }
   void setCoefC1(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C1coef = val;
+    coefficientsChanged();
   }
   void setCoefC2(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C2coef = val;
+    coefficientsChanged();
   }
   void setCoefC2(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C2coef = val;
+    coefficientsChanged();
   }
   void setCoefD(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Dcoef = val;
+    coefficientsChanged();
   }
   void setCoefD(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Dcoef = val;
+    coefficientsChanged();
   }
   void setCoefEx(const Field2D &UNUSED(val)) override {
     throw BoutException("LaplaceNaulin does not have Ex coefficient");
@@ -130,6 +138,11 @@ private:
   /// Laplacian solver used to solve the equation with constant-in-z coefficients
   Laplacian* delp2solver;
 
+  /// The coef_version when the coefficients of delp2solver were last
+  /// set, so they are only set again (invalidating its cached
+  /// factorisations) when Naulin's own coefficients change
+  int delp2solver_version{-1};
+
   /// Solver tolerances
   BoutReal rtol, atol;
 
@@ -140,6 +153,10 @@ private:
   /// less than or equal to 1. Value of 1 means no underrelaxation
   BoutReal initial_underrelax_factor{1.};
 
+  /// Number of previous iterates used for Anderson acceleration. Zero
+  /// uses the plain (under-relaxed) fixed point iteration
+  int anderson_depth{0};
+
   /// Mean number of iterations taken by the solver
   BoutReal naulinsolver_mean_its;
 
@@ -149,6 +166,9 @@ private:
   /// Counter for the number of times the solver has been called
   int ncalls;
 
+  /// Previous solutions, extrapolated to give the starting guess
+  SolutionHistory<Field3D> history;
+
   /// Copy the boundary guard cells from the input 'initial guess' x0 into x.
   /// These may be used to set non-zero-value boundary conditions
   void copy_x_boundaries(Field3D &x, const Field3D &x0, Mesh *mesh);
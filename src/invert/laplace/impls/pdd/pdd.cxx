@@ -30,6 +30,8 @@
  **************************************************************************/
 
 #include <bout/constants.hxx>
+#include <bout/openmpwrap.hxx>
+#include <bout/sys/timer.hxx>
 #include <boutexception.hxx>
 #include <fft.hxx>
 #include <globals.hxx>
@@ -42,64 +44,96 @@ FieldPerp LaplacePDD::solve(const FieldPerp& b) {
   ASSERT1(localmesh == b.getMesh());
   ASSERT1(b.getLocation() == location);
 
-  PDD_data data;
+  // Data is kept between calls, so factorised matrices can be reused
+  PDD_data& data = getData(b.getIndex());
 
-  FieldPerp x{emptyFrom(b)};
+  std::vector<FieldPerp> x{emptyFrom(b)};
   
-  start(b, data);
+  start({b}, data);
   next(data);
   finish(data, x);
 
-  checkData(x);
+  checkData(x[0]);
   
-  return x;
+  return x[0];
 }
 
 Field3D LaplacePDD::solve(const Field3D& b) {
-  ASSERT1(localmesh == b.getMesh());
-  ASSERT1(b.getLocation() == location);
+  return solve(std::vector<Field3D>{b})[0];
+}
+
+std::vector<Field3D> LaplacePDD::solve(const std::vector<Field3D>& b) {
+  const int nrhs = b.size();
+
+  std::vector<Field3D> x;
+  x.reserve(nrhs);
+  for (const auto& field : b) {
+    ASSERT1(localmesh == field.getMesh());
+    ASSERT1(field.getLocation() == location);
+    x.push_back(emptyFrom(field));
+  }
+  if (nrhs == 0) {
+    return x;
+  }
 
-  Field3D x{emptyFrom(b)};
-  FieldPerp xperp(localmesh);
-  xperp.allocate();
-  
   int ys = localmesh->ystart, ye = localmesh->yend;
   if(localmesh->hasBndryLowerY())
     ys = 0; // Mesh contains a lower boundary
   if(localmesh->hasBndryUpperY())
     ye = localmesh->LocalNy-1; // Contains upper boundary
-  
+
+  /// Take the X-Z slices at \p jy of all the fields
+  auto slices = [&](int jy) {
+    std::vector<FieldPerp> bperp;
+    bperp.reserve(nrhs);
+    for (const auto& field : b) {
+      bperp.push_back(sliceXZ(field, jy));
+    }
+    return bperp;
+  };
+
+  std::vector<FieldPerp> xperp(nrhs, FieldPerp(localmesh));
+
+  // All fields are solved together, so each message carries the
+  // values for every field
   if(low_mem) {
-    // Solve one slice at a time
+    // Only two slices in progress at a time. The local elimination
+    // for slice jy+1 is done while the messages for slice jy are sent
+    start(slices(ys), getData(ys));
     for(int jy=ys; jy <= ye; jy++) {
-      x = solve(sliceXZ(b, jy));
+      if (jy < ye) {
+        start(slices(jy + 1), getData(jy + 1));
+      }
+      PDD_data& data = getData(jy);
+      next(data);
+      finish(data, xperp);
+      for (int r = 0; r < nrhs; r++) {
+        x[r] = xperp[r];
+      }
     }
   }else {
     // Overlap multiple inversions
 
-    static PDD_data *data = nullptr;
-
-    if (data == nullptr) {
-      data = new PDD_data[ye - ys + 1];
-      data -= ys; // Re-number indices to start at jstart
-    }
     /// PDD algorithm communicates twice, so done in 3 stages
       
     for(int jy=ys; jy <= ye; jy++)
-      start(sliceXZ(b,jy), data[jy]);
+      start(slices(jy), getData(jy));
     
     for(int jy=ys; jy <= ye; jy++)
-      next(data[jy]);
+      next(getData(jy));
     
     for(int jy=ys; jy <= ye; jy++) {
-      finish(data[jy], xperp);
-      x = xperp;
+      finish(getData(jy), xperp);
+      for (int r = 0; r < nrhs; r++) {
+        x[r] = xperp[r];
+      }
     }
   }
 
-  x.setLocation(b.getLocation()); 
-
-  checkData(x);
+  for (int r = 0; r < nrhs; r++) {
+    x[r].setLocation(b[r].getLocation());
+    checkData(x[r]);
+  }
 
   return x;
 }
@@ -114,17 +148,25 @@ Field3D LaplacePDD::solve(const Field3D& b) {
 /// balanced against communication time i.e. faster communications can
 /// allow less memory use.
 ///
-/// @param[in]    b  RHS values (Ax = b)
+/// @param[in]    b  RHS values (Ax = b) for each field, all at the same Y index
 /// @param[in] data  Internal data used for multiple calls in parallel mode
-void LaplacePDD::start(const FieldPerp &b, PDD_data &data) {
-  ASSERT1(localmesh == b.getMesh());
-  ASSERT1(b.getLocation() == location);
-
-  int ix, kz;
+void LaplacePDD::start(const std::vector<FieldPerp> &b, PDD_data &data) {
+  ASSERT1(!b.empty());
 
   int ncz = localmesh->LocalNz;
-
-  data.jy = b.getIndex();
+  const int nrhs = b.size();
+  const int ncomp = maxmode + 1; ///< Rows for each field
+
+  // Keep the factorised matrices? Not with low_mem, where the data
+  // isn't kept for each Y index
+  const bool factorise = cache_factorisation && !low_mem;
+
+  data.jy = b[0].getIndex();
+  for (const auto& field : b) {
+    ASSERT1(localmesh == field.getMesh());
+    ASSERT1(field.getLocation() == location);
+    ASSERT1(field.getIndex() == data.jy);
+  }
 
   if(localmesh->firstX() && localmesh->lastX())
     throw BoutException("Error: PDD method only works for NXPE > 1\n");
@@ -133,38 +175,66 @@ void LaplacePDD::start(const FieldPerp &b, PDD_data &data) {
       throw BoutException("LaplacePDD does not work with periodicity in the x direction (localmesh->PeriodicX == true). Change boundary conditions or use serial-tri or cyclic solver instead");
     }
 
-    if (data.bk.empty()) {
+    if (data.avec.empty()) {
       // Need to allocate working memory
 
-      // RHS vector
-      data.bk.reallocate(maxmode + 1, localmesh->LocalNx);
-
       // Matrix to be solved
-      data.avec.reallocate(maxmode + 1, localmesh->LocalNx);
-      data.bvec.reallocate(maxmode + 1, localmesh->LocalNx);
-      data.cvec.reallocate(maxmode + 1, localmesh->LocalNx);
+      data.avec.reallocate(ncomp, localmesh->LocalNx);
+      data.bvec.reallocate(ncomp, localmesh->LocalNx);
+      data.cvec.reallocate(ncomp, localmesh->LocalNx);
 
       // Working vectors
-      data.v.reallocate(maxmode + 1, localmesh->LocalNx);
-      data.w.reallocate(maxmode + 1, localmesh->LocalNx);
+      data.v.reallocate(ncomp, localmesh->LocalNx);
+      data.w.reallocate(ncomp, localmesh->LocalNx);
+
+      if (factorise) {
+        // LU factorisation of the matrix for each kz
+        data.lu.reallocate(ncomp, 4 * localmesh->LocalNx);
+        data.ipiv.reallocate(ncomp, localmesh->LocalNx);
+      }
+  }
+
+  if (data.nrhs != nrhs) {
+    // Memory for each field. Row r*ncomp + kz is mode kz of field r
+    data.nrhs = nrhs;
 
-      // Result
-      data.xk.reallocate(maxmode + 1, localmesh->LocalNx);
+    // RHS vector
+    data.bk.reallocate(nrhs * ncomp, localmesh->LocalNx);
 
-      // Communication buffers. Space for 2 complex values for each kz
-      data.snd.reallocate(4 * (maxmode + 1));
-      data.rcv.reallocate(4 * (maxmode + 1));
+    // Result
+    data.xk.reallocate(nrhs * ncomp, localmesh->LocalNx);
 
-      data.y2i.reallocate(maxmode + 1);
+    // Communication buffers. Space for 2 complex values (v0 and x0 of
+    // each field) for each kz
+    data.snd.reallocate(2 * (nrhs + 1) * ncomp);
+    data.rcv.reallocate(2 * (nrhs + 1) * ncomp);
+
+    data.y2i.reallocate(nrhs * ncomp);
+    data.y2ip1.reallocate(nrhs * ncomp);
   }
 
-  /// Take FFTs of data
-  Array<dcomplex> bk1d(ncz / 2 + 1); ///< 1D in Z for taking FFTs
+  // Can the matrices, their factorisation, and the v and w vectors
+  // (which only depend on the matrix) from the last solve be reused?
+  // With low_mem the data is shared between Y indices, so never
+  const bool cached = !low_mem && factorisationValid(data.coef_version);
 
-  for(ix=0; ix < localmesh->LocalNx; ix++) {
-    rfft(b[ix], ncz, std::begin(bk1d));
-    for(kz = 0; kz <= maxmode; kz++)
-      data.bk(kz, ix) = bk1d[kz];
+  // The send buffer is about to be overwritten
+  wait(data.send_request);
+
+  /// Take FFTs of data
+  const int nx_all = localmesh->LocalNx;
+  BOUT_OMP(parallel) {
+    Array<dcomplex> bk1d(ncz / 2 + 1); ///< 1D in Z for taking FFTs
+
+    BOUT_OMP(for)
+    for (int ind = 0; ind < nrhs * nx_all; ind++) {
+      const int r = ind / nx_all;
+      const int ix = ind % nx_all;
+      rfft(b[r][ix], ncz, std::begin(bk1d));
+      for (int kz = 0; kz <= maxmode; kz++) {
+        data.bk(r * ncomp + kz, ix) = bk1d[kz];
+      }
+    }
   }
 
   /// Create the matrices to be inverted (one for each z point)
@@ -172,182 +242,275 @@ void LaplacePDD::start(const FieldPerp &b, PDD_data &data) {
   BoutReal kwaveFactor = 2.0 * PI / coords->zlength();
 
   /// Set matrix elements
-  for (int kz = 0; kz <= maxmode; kz++) {
+  BOUT_OMP(parallel for)
+  for (int row = 0; row < nrhs * ncomp; row++) {
+    const int kz = row % ncomp;
+    if (cached || (row >= ncomp)) {
+      // Only the boundary values of the RHS need setting
+      tridagMatrixRHS(&data.bk(row, 0), global_flags, inner_boundary_flags,
+                      outer_boundary_flags);
+      continue;
+    }
     tridagMatrix(&data.avec(kz, 0), &data.bvec(kz, 0), &data.cvec(kz, 0), &data.bk(kz, 0),
-                 kz, kz * kwaveFactor, data.jy, global_flags, inner_boundary_flags,
+                 data.jy, kz, kz * kwaveFactor, global_flags, inner_boundary_flags,
                  outer_boundary_flags, &Acoef, &Ccoef, &Dcoef);
   }
 
-  Array<dcomplex> e(localmesh->LocalNx);
-  for (ix = 0; ix < localmesh->LocalNx; ix++)
-    e[ix] = 0.0; // Do we need this?
-
-  for(kz = 0; kz <= maxmode; kz++) {
-    // Start PDD algorithm
-
-    // Solve for xtilde, v and w (step 2)
-
-    dcomplex v0, x0; // Values to be sent to processor i-1
-
-    if(localmesh->firstX()) {
-      // Domain includes inner boundary
-      tridag(&data.avec(kz, 0), &data.bvec(kz, 0), &data.cvec(kz, 0), &data.bk(kz, 0),
-             &data.xk(kz, 0), localmesh->xend + 1);
-
-      // Add C (row m-1) from next processor
-
-      e[localmesh->xend] = data.cvec(kz, localmesh->xend);
-      tridag(&data.avec(kz, 0), &data.bvec(kz, 0), &data.cvec(kz, 0), std::begin(e),
-             &data.w(kz, 0), localmesh->xend + 1);
-
-    }else if(localmesh->lastX()) {
-      // Domain includes outer boundary
-      tridag(&data.avec(kz, localmesh->xstart), &data.bvec(kz, localmesh->xstart),
-             &data.cvec(kz, localmesh->xstart), &data.bk(kz, localmesh->xstart),
-             &data.xk(kz, localmesh->xstart), localmesh->xend - localmesh->xend + 1);
+  // Range of rows solved on this processor
+  int xs = localmesh->xstart;
+  int nx = localmesh->xend - localmesh->xstart + 1;
+  if (localmesh->firstX()) {
+    xs = 0;
+    nx = localmesh->xend + 1;
+  } else if (localmesh->lastX()) {
+    nx = localmesh->LocalNx - localmesh->xstart;
+  }
 
-      // Add A (row 0) from previous processor
-      e[0] = data.avec(kz, localmesh->xstart);
-      tridag(&data.avec(kz, localmesh->xstart), &data.bvec(kz, localmesh->xstart),
-             &data.cvec(kz, localmesh->xstart), std::begin(e), &data.v(kz, localmesh->xstart),
-             localmesh->xend + 1);
+  /// Solve the tridiagonal system for mode kz with RHS r
+  auto solveRows = [&](int kz, const dcomplex* r, dcomplex* u) {
+    if (factorise) {
+      tridagSolveFactorised(&data.lu(kz, 0), &data.ipiv(kz, 0), r, u, nx);
+    } else {
+      tridag(&data.avec(kz, xs), &data.bvec(kz, xs), &data.cvec(kz, xs), r, u, nx);
+    }
+  };
 
-      x0 = data.xk(kz, localmesh->xstart);
-      v0 = data.v(kz, localmesh->xstart);
+  // First row of the local domain, which holds the values sent to processor i-1
+  const int x0row = localmesh->firstX() ? 0 : localmesh->xstart;
 
-    }else {
-      // No boundaries
-      tridag(&data.avec(kz, localmesh->xstart), &data.bvec(kz, localmesh->xstart),
-             &data.cvec(kz, localmesh->xstart), &data.bk(kz, localmesh->xstart),
-             &data.xk(kz, localmesh->xstart), localmesh->xend - localmesh->xstart + 1);
+  // The modes are independent, so are shared between threads
+  BOUT_OMP(parallel) {
+    Array<dcomplex> e(localmesh->LocalNx);
+    for (int ix = 0; ix < localmesh->LocalNx; ix++)
+      e[ix] = 0.0;
 
-      // Add A (row 0) from previous processor
-      e[0] = data.avec(kz, localmesh->xstart);
-      tridag(&data.avec(kz, localmesh->xstart), &data.bvec(kz, localmesh->xstart),
-             &data.cvec(kz, localmesh->xstart), &e[localmesh->xstart], &data.v(kz, localmesh->xstart),
-             localmesh->xend - localmesh->xstart + 1);
-      e[0] = 0.0;
-      
-      // Add C (row m-1) from next processor
-      e[localmesh->xend] = data.cvec(kz, localmesh->xend);
-      tridag(&data.avec(kz, localmesh->xstart), &data.bvec(kz, localmesh->xstart),
-             &data.cvec(kz, localmesh->xstart), &e[localmesh->xstart], &data.v(kz, localmesh->xstart),
-             localmesh->xend - localmesh->xstart + 1);
-      e[localmesh->xend] = 0.0;
-    }
+    BOUT_OMP(for)
+    for(int kz = 0; kz <= maxmode; kz++) {
+      // Start PDD algorithm
+
+      if (factorise && !cached) {
+        tridagFactorise(&data.avec(kz, xs), &data.bvec(kz, xs), &data.cvec(kz, xs),
+                        &data.lu(kz, 0), &data.ipiv(kz, 0), nx);
+      }
+
+      // Solve for xtilde of each field, and v and w (step 2)
+      // v and w only depend on the matrix, so are kept if it hasn't changed
+
+      for (int r = 0; r < nrhs; r++) {
+        solveRows(kz, &data.bk(r * ncomp + kz, x0row), &data.xk(r * ncomp + kz, x0row));
+      }
+
+      if (!cached) {
+        if(localmesh->firstX()) {
+          // Domain includes inner boundary
+          // Add C (row m-1) from next processor
+          e[localmesh->xend] = data.cvec(kz, localmesh->xend);
+          solveRows(kz, std::begin(e), &data.w(kz, 0));
+
+        }else if(localmesh->lastX()) {
+          // Domain includes outer boundary
+          // Add A (row 0) from previous processor
+          e[0] = data.avec(kz, localmesh->xstart);
+          solveRows(kz, std::begin(e), &data.v(kz, localmesh->xstart));
+
+        }else {
+          // No boundaries
+          // Add A (row 0) from previous processor
+          e[localmesh->xstart] = data.avec(kz, localmesh->xstart);
+          solveRows(kz, &e[localmesh->xstart], &data.v(kz, localmesh->xstart));
+          e[localmesh->xstart] = 0.0;
+
+          // Add C (row m-1) from next processor
+          e[localmesh->xend] = data.cvec(kz, localmesh->xend);
+          solveRows(kz, &e[localmesh->xstart], &data.w(kz, localmesh->xstart));
+          e[localmesh->xend] = 0.0;
+        }
+      }
     
-    // Put values into communication buffers
-    data.snd[4*kz]   = x0.real();
-    data.snd[4*kz+1] = x0.imag();
-    data.snd[4*kz+2] = v0.real();
-    data.snd[4*kz+3] = v0.imag();
+      // Put values to be sent to processor i-1 into communication buffers:
+      // v0, followed by x0 for each field
+      dcomplex v0, x0;
+      if (!localmesh->firstX()) {
+        v0 = data.v(kz, localmesh->xstart);
+      }
+      data.snd[2 * kz] = v0.real();
+      data.snd[2 * kz + 1] = v0.imag();
+      for (int r = 0; r < nrhs; r++) {
+        if (!localmesh->firstX()) {
+          x0 = data.xk(r * ncomp + kz, localmesh->xstart);
+        }
+        data.snd[2 * ((r + 1) * ncomp + kz)] = x0.real();
+        data.snd[2 * ((r + 1) * ncomp + kz) + 1] = x0.imag();
+      }
+    }
   }
   
+  if (factorise) {
+    data.coef_version = coef_version;
+  }
+
   // Stage 3: Communicate x0, v0 from node i to i-1
   
   if(!localmesh->lastX()) {
     // All except the last processor expect to receive data
     // Post async receive
-    data.recv_handle =
-        localmesh->irecvXOut(std::begin(data.rcv), 4 * (maxmode + 1), PDD_COMM_XV);
+    receive(data, localmesh->getXProcIndex() + 1, 2 * (nrhs + 1) * ncomp, PDD_COMM_XV);
   }
 
   if(!localmesh->firstX()) {
-    // Send the data
-
-    localmesh->sendXIn(std::begin(data.snd), 4 * (maxmode + 1), PDD_COMM_XV);
+    // Send the data, without waiting for it to be received
+    send(data, localmesh->getXProcIndex() - 1, 2 * (nrhs + 1) * ncomp, PDD_COMM_XV);
   }
 }
 
 
 /// Middle part of the PDD algorithm
 void LaplacePDD::next(PDD_data &data) {
+  const int ncomp = maxmode + 1;
+
   // Wait for x0 and v0 to arrive from processor i+1
   
   if(!localmesh->lastX()) {
-    localmesh->wait(data.recv_handle);
+    wait(data.recv_request);
 
     /*! Now solving on all except the last processor
      * 
      * |    1       w^(i)_(m-1) | | y_{2i}   | = | x^(i)_{m-1} |
      * | v^(i+1)_0       1      | | y_{2i+1} |   | x^(i+1)_0   |
      *
-     * Only interested in the value of y_2i however
+     * y_2i is sent to processor i+1, and y_{2i+1} is kept to
+     * correct the solution here
      */
     
     for(int kz = 0; kz <= maxmode; kz++) {
-      dcomplex v0, x0;
-      
-      // Get x and v0 from processor
-      x0 = dcomplex(data.rcv[4*kz], data.rcv[4*kz+1]);
-      v0 = dcomplex(data.rcv[4*kz+2], data.rcv[4*kz+3]);
+      // Get v0 from processor
+      dcomplex v0 = dcomplex(data.rcv[2 * kz], data.rcv[2 * kz + 1]);
+      dcomplex wm = data.w(kz, localmesh->xend);
 
-      data.y2i[kz] = (data.xk(kz, localmesh->xend) - data.w(kz, localmesh->xend) * x0) /
-                     (1. - data.w(kz, localmesh->xend) * v0);
+      for (int r = 0; r < data.nrhs; r++) {
+        const int row = r * ncomp + kz;
+
+        // Get x0 of this field from processor
+        dcomplex x0 = dcomplex(data.rcv[2 * (ncomp + row)], data.rcv[2 * (ncomp + row) + 1]);
+
+        data.y2i[row] = (data.xk(row, localmesh->xend) - wm * x0) / (1. - wm * v0);
+        data.y2ip1[row] = x0 - v0 * data.y2i[row];
+      }
     }
   }
   
   if(!localmesh->firstX()) {
     // All except pe=0 receive values from i-1. Posting async receive
-    data.recv_handle =
-        localmesh->irecvXIn(std::begin(data.rcv), 2 * (maxmode + 1), PDD_COMM_Y);
+    receive(data, localmesh->getXProcIndex() - 1, 2 * data.nrhs * ncomp, PDD_COMM_Y);
   }
   
   if(!localmesh->lastX()) {
     // Send value to the (i+1)th processor
+    wait(data.send_request);
     
-    for(int kz = 0; kz <= maxmode; kz++) {
-      data.snd[2*kz]   = data.y2i[kz].real();
-      data.snd[2*kz+1] = data.y2i[kz].imag();
+    for(int row = 0; row < data.nrhs * ncomp; row++) {
+      data.snd[2*row]   = data.y2i[row].real();
+      data.snd[2*row+1] = data.y2i[row].imag();
     }
 
-    localmesh->sendXOut(std::begin(data.snd), 2 * (maxmode + 1), PDD_COMM_Y);
+    send(data, localmesh->getXProcIndex() + 1, 2 * data.nrhs * ncomp, PDD_COMM_Y);
   }
 }
 
 /// Last part of the PDD algorithm
-void LaplacePDD::finish(PDD_data &data, FieldPerp &x) {
-  ASSERT1(x.getLocation() == location);
-
-  int ix, kz;
+void LaplacePDD::finish(PDD_data &data, std::vector<FieldPerp> &x) {
+  ASSERT1(static_cast<int>(x.size()) == data.nrhs);
 
-  x.allocate();
-  x.setIndex(data.jy);
+  const int ncomp = maxmode + 1;
+  const int nrows = data.nrhs * ncomp;
   
   if(!localmesh->lastX()) {
-    for(kz = 0; kz <= maxmode; kz++) {
-      for(ix=0; ix < localmesh->LocalNx; ix++)
-        data.xk(kz, ix) -= data.w(kz, ix) * data.y2i[kz];
+    BOUT_OMP(parallel for)
+    for (int row = 0; row < nrows; row++) {
+      const int kz = row % ncomp;
+      for (int ix = 0; ix < localmesh->LocalNx; ix++)
+        data.xk(row, ix) -= data.w(kz, ix) * data.y2ip1[row];
     }
   }
 
   if(!localmesh->firstX()) {
-    localmesh->wait(data.recv_handle);
+    wait(data.recv_request);
   
-    for(kz = 0; kz <= maxmode; kz++) {
-      dcomplex y2m = dcomplex(data.rcv[2*kz], data.rcv[2*kz+1]);
+    BOUT_OMP(parallel for)
+    for (int row = 0; row < nrows; row++) {
+      const int kz = row % ncomp;
+      dcomplex y2m = dcomplex(data.rcv[2*row], data.rcv[2*row+1]);
       
-      for(ix=0; ix < localmesh->LocalNx; ix++)
-        data.xk(kz, ix) -= data.v(kz, ix) * y2m;
+      for (int ix = 0; ix < localmesh->LocalNx; ix++)
+        data.xk(row, ix) -= data.v(kz, ix) * y2m;
     }
   }
   
   // Have result in Fourier space. Convert back to BoutReal space
-  int ncz = localmesh->LocalNz;
+  const int ncz = localmesh->LocalNz;
+  const int nx_all = localmesh->LocalNx;
 
-  Array<dcomplex> xk1d(ncz / 2 + 1); ///< 1D in Z for taking FFTs
-  for (kz = maxmode; kz <= ncz / 2; kz++)
-    xk1d[kz] = 0.0;
+  for (int r = 0; r < data.nrhs; r++) {
+    ASSERT1(x[r].getLocation() == location);
+    x[r].allocate();
+    x[r].setIndex(data.jy);
+  }
 
-  for(ix=0; ix<localmesh->LocalNx; ix++){
-    
-    for(kz = 0; kz <= maxmode; kz++) {
-      xk1d[kz] = data.xk(kz, ix);
+  BOUT_OMP(parallel) {
+    Array<dcomplex> xk1d(ncz / 2 + 1); ///< 1D in Z for taking FFTs
+    for (int kz = maxmode; kz <= ncz / 2; kz++)
+      xk1d[kz] = 0.0;
+
+    BOUT_OMP(for)
+    for (int ind = 0; ind < data.nrhs * nx_all; ind++) {
+      const int r = ind / nx_all;
+      const int ix = ind % nx_all;
+
+      for (int kz = 0; kz <= maxmode; kz++) {
+        xk1d[kz] = data.xk(r * ncomp + kz, ix);
+      }
+
+      if(global_flags & INVERT_ZERO_DC)
+        xk1d[0] = 0.0;
+
+      irfft(std::begin(xk1d), ncz, x[r][ix]);
     }
+  }
+
+  // The send buffer is free for the next solve
+  wait(data.send_request);
+}
 
-    if(global_flags & INVERT_ZERO_DC)
-      xk1d[0] = 0.0;
+void LaplacePDD::receive(PDD_data &data, int xproc, int size, int tag) {
+  Timer timer("comms");
+  MPI_Irecv(std::begin(data.rcv), size, MPI_DOUBLE, xproc, tag, localmesh->getXcomm(),
+            &data.recv_request);
+}
 
-    irfft(std::begin(xk1d), ncz, x[ix]);
+void LaplacePDD::send(PDD_data &data, int xproc, int size, int tag) {
+  Timer timer("comms");
+  MPI_Isend(std::begin(data.snd), size, MPI_DOUBLE, xproc, tag, localmesh->getXcomm(),
+            &data.send_request);
+}
+
+void LaplacePDD::wait(MPI_Request &request) {
+  if (request != MPI_REQUEST_NULL) {
+    Timer timer("comms");
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+  }
+}
+
+LaplacePDD::PDD_data& LaplacePDD::getData(int jy) {
+  if (low_mem) {
+    // Only two Y indices are in progress at a time, so they take it
+    // in turns to use two sets of working memory
+    if (ydata.size() != 2) {
+      ydata.resize(2);
+    }
+    return ydata[jy % 2];
+  }
+  if (ydata.empty()) {
+    ydata.resize(localmesh->LocalNy);
   }
+  return ydata[jy];
 }
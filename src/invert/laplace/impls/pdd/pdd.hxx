@@ -38,6 +38,7 @@ class LaplacePDD;
 #include <invert_laplace.hxx>
 #include <options.hxx>
 #include <utils.hxx>
+#include <vector>
 
 class LaplacePDD : public Laplacian {
 public:
@@ -55,18 +56,21 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Acoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefC;
   void setCoefC(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Ccoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefD;
   void setCoefD(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Dcoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefEx;
   void setCoefEx(const Field2D &UNUSED(val)) override {
@@ -80,6 +84,14 @@ public:
   using Laplacian::solve;
   FieldPerp solve(const FieldPerp &b) override;
   Field3D solve(const Field3D &b) override;
+
+  /// All the fields are solved together, sharing the messages for
+  /// each Y index. Initial guesses are not used
+  std::vector<Field3D> solve(const std::vector<Field3D> &b) override;
+  std::vector<Field3D> solve(const std::vector<Field3D> &b,
+                             const std::vector<Field3D> &UNUSED(x0)) override {
+    return solve(b);
+  }
 private:
   Field2D Acoef, Ccoef, Dcoef;
   
@@ -88,7 +100,9 @@ private:
   
   /// Data structure for PDD algorithm
   struct PDD_data {
-    Matrix<dcomplex> bk;  ///< b vector in Fourier space
+    int nrhs{0}; ///< Number of fields being solved
+
+    Matrix<dcomplex> bk;  ///< b vector in Fourier space, for each field and kz
 
     Matrix<dcomplex> avec, bvec, cvec; ///< Diagonal bands of matrix
   
@@ -100,14 +114,38 @@ private:
     Array<BoutReal> snd; // send buffer
     Array<BoutReal> rcv; // receive buffer
   
-    comm_handle recv_handle;
+    MPI_Request recv_request{MPI_REQUEST_NULL}; ///< Non-blocking receive into rcv
+    MPI_Request send_request{MPI_REQUEST_NULL}; ///< Non-blocking send of snd
+
+    Array<dcomplex> y2i;   ///< Last value on this processor, for each field and kz
+    Array<dcomplex> y2ip1; ///< First value on the next processor
 
-    Array<dcomplex> y2i;
+    Matrix<dcomplex> lu; ///< LU factors of the matrix for each kz
+    Matrix<int> ipiv;    ///< Pivots for lu
+    int coef_version{-1}; ///< Laplacian::coef_version when matrices were calculated
   };
+
+  /// Data for each Y index, kept between solves so that the
+  /// factorised matrices can be reused. With low_mem there are only
+  /// two, used in turn, and nothing is reused between solves
+  std::vector<PDD_data> ydata;
+
+  /// Get the data for Y index \p jy, allocating if needed
+  PDD_data& getData(int jy);
   
-  void start(const FieldPerp &b, PDD_data &data);
+  /// The three stages of the algorithm. Each sends its messages
+  /// without waiting for them to be received, so the local work on
+  /// other Y indices can be done in the meantime
+  void start(const std::vector<FieldPerp> &b, PDD_data &data);
   void next(PDD_data &data);
-  void finish(PDD_data &data, FieldPerp &x);
+  void finish(PDD_data &data, std::vector<FieldPerp> &x);
+
+  /// Post a receive into data.rcv from the X processor \p xproc
+  void receive(PDD_data &data, int xproc, int size, int tag);
+  /// Send data.snd to the X processor \p xproc
+  void send(PDD_data &data, int xproc, int size, int tag);
+  /// Wait for a receive or send to complete
+  static void wait(MPI_Request &request);
 };
 
 #endif // __LAPLACE_PDD_H__
@@ -30,9 +30,13 @@
 #include <bout/mesh.hxx>
 #include <bout/sys/timer.hxx>
 #include <boutcomm.hxx>
+#include <lapack_routines.hxx>
 #include <bout/assert.hxx>
 #include <utils.hxx>
 
+#include <algorithm>
+#include <cmath>
+
 #define KSP_RICHARDSON "richardson"
 #define KSP_CHEBYSHEV   "chebyshev"
 #define KSP_CG          "cg"
@@ -58,6 +62,18 @@ static PetscErrorCode laplacePCapply(PC pc,Vec x,Vec y) {
   PetscFunctionReturn(s->precon(x, y));
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "laplaceSinglePCapply"
+static PetscErrorCode laplaceSinglePCapply(PC pc,Vec x,Vec y) {
+  int ierr;
+
+  // Get the context
+  LaplacePetsc *s;
+  ierr = PCShellGetContext(pc,(void**)&s);CHKERRQ(ierr);
+
+  PetscFunctionReturn(s->singlePrecisionPrecon(x, y));
+}
+
 LaplacePetsc::LaplacePetsc(Options *opt, const CELL_LOC loc, Mesh *mesh_in) :
   Laplacian(opt, loc, mesh_in),
   A(0.0), C1(1.0), C2(1.0), D(1.0), Ex(0.0), Ez(0.0),
@@ -310,6 +326,63 @@ LaplacePetsc::LaplacePetsc(Options *opt, const CELL_LOC loc, Mesh *mesh_in) :
     output << endl << "Using LU decompostion for direct solution of system" << endl << endl;
   }
 
+  mixed_precision =
+      (*opts)["mixed_precision"]
+          .doc("Precondition with a single precision LU factorisation of the local "
+               "rows, and recover the accuracy set by rtol and atol by iterative "
+               "refinement with double precision residuals")
+          .withDefault(false);
+  refine_inner_rtol = (*opts)["refine_inner_rtol"]
+                          .doc("Relative tolerance for each KSP solve when "
+                               "mixed_precision is used")
+                          .withDefault(1e-3);
+  refine_max_steps = (*opts)["refine_max_steps"]
+                         .doc("Maximum number of iterative refinement steps")
+                         .withDefault(20);
+  if (mixed_precision) {
+    if (direct or (pctype != "none")) {
+      throw BoutException("LaplacePetsc: mixed_precision sets its own preconditioner, "
+                          "so can't be used with direct = true or pctype = %s",
+                          pctype.c_str());
+    }
+    if (refine_inner_rtol <= 0.0 or refine_inner_rtol >= 1.0) {
+      throw BoutException("LaplacePetsc: refine_inner_rtol must be between 0 and 1, got %e",
+                          refine_inner_rtol);
+    }
+    if (refine_max_steps < 1) {
+      throw BoutException("LaplacePetsc: refine_max_steps must be >= 1, got %d",
+                          refine_max_steps);
+    }
+    single_work = Array<float>(localN);
+    VecDuplicate(xs, &refine_residual);
+    VecDuplicate(xs, &refine_correction);
+  }
+
+  reuse_preconditioner =
+      (*opts)["reuse_preconditioner"]
+          .doc("Number of solves to keep a preconditioner for while the matrix "
+               "changes. 0 rebuilds it for every new matrix")
+          .withDefault(0);
+  reuse_max_iteration_ratio =
+      (*opts)["reuse_max_iteration_ratio"]
+          .doc("Rebuild a kept preconditioner once a solve takes more than this "
+               "many times the iterations of the first solve with it")
+          .withDefault(2.0);
+  if (reuse_preconditioner < 0) {
+    throw BoutException("LaplacePetsc: reuse_preconditioner must be >= 0, got %d",
+                        reuse_preconditioner);
+  }
+  // A kept LU factorisation would solve the old matrix, not precondition
+  // the new one, so only allow this when the KSP iterates. With
+  // mixed_precision the refinement iterates instead
+  if ((reuse_preconditioner > 0)
+      and (direct or (pctype == PCLU) or (pctype == PCCHOLESKY)
+           or ((ksptype == KSPPREONLY) and not mixed_precision))) {
+    throw BoutException("LaplacePetsc: reuse_preconditioner can't be used with a direct "
+                        "solver (direct = true, pctype = lu or cholesky, or ksptype = "
+                        "preonly)");
+  }
+
   pcsolve = nullptr;
   if (pctype == PCSHELL) {
 
@@ -369,6 +442,26 @@ FieldPerp LaplacePetsc::solve(const FieldPerp& b, const FieldPerp& x0) {
   sol.setIndex(y);      // Initialize the solution field.
   sol = 0.;
 
+  // Initial guess for the interior. May be extrapolated from previous solutions,
+  // so boundary values are still taken from x0
+  const FieldPerp guess = initialGuess(x0);
+
+  if (factorisationValid(operator_version) && (operator_y == y)) {
+    // MatA is already set for this Y index, and the KSP keeps its
+    // preconditioner or factorisation, so only the RHS changes
+    FieldPerp start = copy(x0);
+    for (int x = localmesh->xstart; x <= localmesh->xend; x++) {
+      for (int z = 0; z < localmesh->LocalNz; z++) {
+        start[x][z] = guess[x][z];
+      }
+    }
+    std::vector<FieldPerp> result(1);
+    solveWithSameOperator({b}, {start}, result);
+    sol = result[0];
+    storeSolution(sol);
+    return sol;
+  }
+
   // Determine which row/columns of the matrix are locally owned
   MatGetOwnershipRange( MatA, &Istart, &Iend );
 
@@ -631,7 +724,7 @@ FieldPerp LaplacePetsc::solve(const FieldPerp& b, const FieldPerp& x0) {
           VecSetValues( bs, 1, &i, &val, INSERT_VALUES );
 
           // Set Components of Trial Solution Vector
-          val = x0[x][z];
+          val = guess[x][z];
           VecSetValues( xs, 1, &i, &val, INSERT_VALUES );
           i++;
         }
@@ -728,12 +821,35 @@ FieldPerp LaplacePetsc::solve(const FieldPerp& b, const FieldPerp& x0) {
   VecAssemblyBegin(xs);
   VecAssemblyEnd(xs);
 
+  // Keep the preconditioner from an earlier matrix while it is still
+  // effective. Otherwise it is rebuilt, reusing the symbolic
+  // factorisation if the nonzero pattern is unchanged
+  const bool reuse_pc = (reuse_preconditioner > 0) && (pc_age > 0)
+                        && (pc_age < reuse_preconditioner)
+                        && (last_iterations <= reuse_max_iteration_ratio * pc_iterations);
+  if (!reuse_pc) {
+    pc_age = 0;
+    if (mixed_precision) {
+      single_lu.factorise(MatA);
+    }
+  }
+
   // Configure Linear Solver
 #if PETSC_VERSION_GE(3,5,0)
+  // PETSc tracks the nonzero pattern of MatA itself
   KSPSetOperators( ksp,MatA,MatA);
 #else
-  KSPSetOperators( ksp,MatA,MatA,DIFFERENT_NONZERO_PATTERN );
+  if (reuse_pc) {
+    KSPSetOperators( ksp,MatA,MatA,SAME_PRECONDITIONER );
+  } else if ((pattern_inner_flags == inner_boundary_flags)
+             && (pattern_outer_flags == outer_boundary_flags)) {
+    KSPSetOperators( ksp,MatA,MatA,SAME_NONZERO_PATTERN );
+  } else {
+    KSPSetOperators( ksp,MatA,MatA,DIFFERENT_NONZERO_PATTERN );
+  }
 #endif
+  pattern_inner_flags = inner_boundary_flags;
+  pattern_outer_flags = outer_boundary_flags;
   PC pc; // The preconditioner option
 
   if(direct) { // If a direct solver has been chosen
@@ -756,17 +872,29 @@ FieldPerp LaplacePetsc::solve(const FieldPerp& b, const FieldPerp& x0) {
 #endif
     else if( ksptype == KSPGMRES )     KSPGMRESSetRestart( ksp, gmres_max_steps );
 
-    // Set the relative and absolute tolerances
-    KSPSetTolerances( ksp, rtol, atol, dtol, maxits );
-
-    // If the initial guess is not set to zero
-    if( !( global_flags & INVERT_START_NEW ) ) KSPSetInitialGuessNonzero( ksp, (PetscBool) true );
-
     // Get the preconditioner
     KSPGetPC(ksp,&pc);
 
-    // Set the type of the preconditioner
-    PCSetType(pc, pctype.c_str());
+    if (mixed_precision) {
+      // The KSP solves loosely for corrections, starting from zero. The
+      // outer refinement loop meets rtol and atol
+      KSPSetTolerances( ksp, refine_inner_rtol, 0.0, dtol, maxits );
+
+      // Preconditioned with the single precision factorisation
+      PCSetType(pc, PCSHELL);
+      PCShellSetApply(pc, laplaceSinglePCapply);
+      PCShellSetContext(pc, this);
+      KSPSetPCSide(ksp, PC_RIGHT);
+    } else {
+      // Set the relative and absolute tolerances
+      KSPSetTolerances( ksp, rtol, atol, dtol, maxits );
+
+      // If the initial guess is not set to zero
+      if( !( global_flags & INVERT_START_NEW ) ) KSPSetInitialGuessNonzero( ksp, (PetscBool) true );
+
+      // Set the type of the preconditioner
+      PCSetType(pc, pctype.c_str());
+    }
 
     // If pctype = user in BOUT.inp, it will be translated to PCSHELL upon
     // construction of the object
@@ -785,23 +913,20 @@ FieldPerp LaplacePetsc::solve(const FieldPerp& b, const FieldPerp& x0) {
 
     lib.setOptionsFromInputFile(ksp);
   }
-  }
 
-  // Call the actual solver
-  { Timer timer("petscsolve");
-    KSPSolve( ksp, bs, xs ); // Call the solver to solve the system
-  }
+#if PETSC_VERSION_GE(3,5,0)
+  // After setOptionsFromInputFile, which could otherwise override this
+  KSPSetReusePreconditioner(ksp, reuse_pc ? PETSC_TRUE : PETSC_FALSE);
+#endif
 
-  KSPConvergedReason reason;
-  KSPGetConvergedReason( ksp, &reason );
-  if (reason==-3) { // Too many iterations, might be fixed by taking smaller timestep
-    throw BoutIterationFail("petsc_laplace: too many iterations");
-  }
-  else if (reason<=0) {
-    output<<"KSPConvergedReason is "<<reason<<endl;
-    throw BoutException("petsc_laplace: inversion failed to converge.");
+  // The operator can now be reused for this Y index
+  operator_version = coef_version;
+  operator_y = y;
   }
 
+  // Call the actual solver
+  recordIterations(mixed_precision ? refinedSolve(bs, xs) : kspSolve(bs, xs));
+
   // Add data to FieldPerp Object
   i = Istart;
   // Set the inner boundary values
@@ -844,10 +969,278 @@ FieldPerp LaplacePetsc::solve(const FieldPerp& b, const FieldPerp& x0) {
 
   checkData(sol);
 
+  storeSolution(sol);
+
   // Return the solution
   return sol;
 }
 
+std::vector<Field3D> LaplacePetsc::solve(const std::vector<Field3D>& b,
+                                         const std::vector<Field3D>& x0) {
+  TRACE("LaplacePetsc::solve(vector<Field3D>, vector<Field3D>)");
+
+  if (b.size() != x0.size()) {
+    throw BoutException("LaplacePetsc::solve: %d right-hand sides but %d initial guesses",
+                        static_cast<int>(b.size()), static_cast<int>(x0.size()));
+  }
+
+  const int nrhs = b.size();
+
+  std::vector<Field3D> x;
+  x.reserve(nrhs);
+  for (int r = 0; r < nrhs; r++) {
+    ASSERT1(b[r].getLocation() == location);
+    ASSERT1(x0[r].getLocation() == location);
+    ASSERT1(localmesh == b[r].getMesh() && localmesh == x0[r].getMesh());
+    x.push_back(emptyFrom(b[r]));
+  }
+  if (nrhs == 0) {
+    return x;
+  }
+
+  Timer timer("invert");
+
+  int ys = localmesh->ystart, ye = localmesh->yend;
+  if(localmesh->hasBndryLowerY() && include_yguards)
+    ys = 0; // Mesh contains a lower boundary
+  if(localmesh->hasBndryUpperY() && include_yguards)
+    ye = localmesh->LocalNy-1; // Contains upper boundary
+
+  // Slices of the fields after the first
+  std::vector<FieldPerp> bperp(nrhs - 1), x0perp(nrhs - 1), xperp(nrhs - 1);
+
+  int status = 0;
+  try {
+    for(int jy=ys; jy <= ye; jy++) {
+      // The first field sets up the matrix and KSP for this Y index
+      x[0] = solve(sliceXZ(b[0], jy), sliceXZ(x0[0], jy));
+
+      for (int r = 1; r < nrhs; r++) {
+        bperp[r - 1] = sliceXZ(b[r], jy);
+        x0perp[r - 1] = sliceXZ(x0[r], jy);
+      }
+      solveWithSameOperator(bperp, x0perp, xperp);
+      for (int r = 1; r < nrhs; r++) {
+        x[r] = xperp[r - 1];
+      }
+    }
+  } catch (const BoutIterationFail&) {
+    status = 1;
+  }
+  BoutParallelThrowRhsFail(status, "Laplacian inversion took too many iterations.");
+
+  return x;
+}
+
+void LaplacePetsc::solveWithSameOperator(const std::vector<FieldPerp>& b,
+                                         const std::vector<FieldPerp>& x0,
+                                         std::vector<FieldPerp>& x) {
+  const int nrhs = b.size();
+  if (nrhs == 0) {
+    return;
+  }
+
+  for (int r = 0; r < nrhs; r++) {
+    x[r] = emptyFrom(b[r]);
+  }
+
+#if PETSC_VERSION_GE(3,14,0)
+  // Solve for all the right-hand sides together, as the columns of
+  // dense matrices. Iterative refinement needs the residual of each
+  // right-hand side, so then they are solved in turn
+  if (!mixed_precision) {
+    Mat B, X;
+    MatCreateDense(comm, localN, PETSC_DECIDE, size, nrhs, nullptr, &B);
+    MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &X);
+
+    PetscScalar *rhs, *guess;
+    MatDenseGetArray(B, &rhs);
+    MatDenseGetArray(X, &guess);
+    for (int r = 0; r < nrhs; r++) {
+      rhsToRows(b[r], x0[r], rhs + r * localN, guess + r * localN);
+    }
+    MatDenseRestoreArray(B, &rhs);
+    MatDenseRestoreArray(X, &guess);
+
+    { Timer timer("petscsolve");
+      KSPMatSolve(ksp, B, X);
+    }
+    recordIterations(convergedIterations());
+
+    const PetscScalar *result;
+    MatDenseGetArrayRead(X, &result);
+    for (int r = 0; r < nrhs; r++) {
+      rowsToField(result + r * localN, x[r]);
+    }
+    MatDenseRestoreArrayRead(X, &result);
+
+    MatDestroy(&B);
+    MatDestroy(&X);
+
+    for (int r = 0; r < nrhs; r++) {
+      checkData(x[r]);
+    }
+    return;
+  }
+#endif
+
+  // Solve for each right-hand side in turn. The preconditioner is
+  // still only set up once
+  for (int r = 0; r < nrhs; r++) {
+    PetscScalar *rhs, *guess;
+    VecGetArray(bs, &rhs);
+    VecGetArray(xs, &guess);
+    rhsToRows(b[r], x0[r], rhs, guess);
+    VecRestoreArray(bs, &rhs);
+    VecRestoreArray(xs, &guess);
+
+    recordIterations(mixed_precision ? refinedSolve(bs, xs) : kspSolve(bs, xs));
+
+    const PetscScalar *result;
+    VecGetArrayRead(xs, &result);
+    rowsToField(result, x[r]);
+    VecRestoreArrayRead(xs, &result);
+  }
+
+  for (int r = 0; r < nrhs; r++) {
+    checkData(x[r]);
+  }
+}
+
+int LaplacePetsc::kspSolve(Vec rhs, Vec x) {
+  { Timer timer("petscsolve");
+    KSPSolve( ksp, rhs, x ); // Call the solver to solve the system
+  }
+  return convergedIterations();
+}
+
+int LaplacePetsc::convergedIterations() {
+  KSPConvergedReason reason;
+  KSPGetConvergedReason( ksp, &reason );
+  if (reason==-3) { // Too many iterations, might be fixed by taking smaller timestep
+    throw BoutIterationFail("petsc_laplace: too many iterations");
+  }
+  else if (reason<=0) {
+    output<<"KSPConvergedReason is "<<reason<<endl;
+    throw BoutException("petsc_laplace: inversion failed to converge.");
+  }
+
+  int its;
+  KSPGetIterationNumber(ksp, &its);
+  return its;
+}
+
+int LaplacePetsc::refinedSolve(Vec rhs, Vec x) {
+  if (global_flags & INVERT_START_NEW) {
+    VecSet(x, 0.0);
+  }
+
+  PetscReal bnorm;
+  VecNorm(rhs, NORM_2, &bnorm);
+  const PetscReal target = std::max(rtol * bnorm, atol);
+
+  int its = 0;
+  for (int step = 0; ; step++) {
+    // Residual r = b - A x, in double precision
+    MatMult(MatA, x, refine_residual);
+    VecAYPX(refine_residual, -1.0, rhs);
+
+    PetscReal rnorm;
+    VecNorm(refine_residual, NORM_2, &rnorm);
+    if (rnorm <= target) {
+      refinement_performance.record(step);
+      return its;
+    }
+    if (step == refine_max_steps) {
+      throw BoutIterationFail("petsc_laplace: iterative refinement did not converge");
+    }
+
+    // Solve A d = r loosely with the single precision preconditioner,
+    // and correct x
+    VecSet(refine_correction, 0.0);
+    its += kspSolve(refine_residual, refine_correction);
+    VecAXPY(x, 1.0, refine_correction);
+  }
+}
+
+void LaplacePetsc::savePerformance(Datafile& output_file, Solver& solver,
+                                   const std::string& name) {
+  Laplacian::savePerformance(output_file, solver, name);
+  if (mixed_precision) {
+    refinement_performance.save(output_file, solver, name + "_refinement");
+  }
+}
+
+void LaplacePetsc::recordIterations(int its) {
+  if (!direct) {
+    performance.record(its);
+  }
+  // Counted for every solve with the preconditioner, including repeated
+  // solves with the same operator, so that a kept preconditioner is
+  // rebuilt once the iteration counts grow
+  if (pc_age == 0) {
+    pc_iterations = its;
+  }
+  last_iterations = its;
+  ++pc_age;
+}
+
+void LaplacePetsc::rhsToRows(const FieldPerp& b, const FieldPerp& x0, PetscScalar* rhs,
+                             PetscScalar* guess) {
+  ASSERT1(localmesh == b.getMesh() && localmesh == x0.getMesh());
+
+  int i = 0;
+  // Boundary rows, set using the boundary flags
+  auto boundaryRows = [&](int xstart, int xend, int boundary_flags) {
+    for (int x = xstart; x <= xend; x++) {
+      for (int z = 0; z < localmesh->LocalNz; z++) {
+        rhs[i] = 0.0;
+        if (boundary_flags & INVERT_RHS) {
+          rhs[i] = b[x][z];
+        } else if (boundary_flags & INVERT_SET) {
+          rhs[i] = x0[x][z];
+        }
+        guess[i] = x0[x][z];
+        i++;
+      }
+    }
+  };
+
+  if (localmesh->firstX()) {
+    boundaryRows(0, localmesh->xstart - 1, inner_boundary_flags);
+  }
+
+  for (int x = localmesh->xstart; x <= localmesh->xend; x++) {
+    for (int z = 0; z < localmesh->LocalNz; z++) {
+      rhs[i] = b[x][z];
+      guess[i] = x0[x][z];
+      i++;
+    }
+  }
+
+  if (localmesh->lastX()) {
+    boundaryRows(localmesh->xend + 1, localmesh->LocalNx - 1, outer_boundary_flags);
+  }
+  ASSERT1(i == localN);
+}
+
+void LaplacePetsc::rowsToField(const PetscScalar* values, FieldPerp& f) {
+  ASSERT1(localmesh == f.getMesh());
+
+  f.allocate();
+
+  const int xstart = localmesh->firstX() ? 0 : localmesh->xstart;
+  const int xend = localmesh->lastX() ? localmesh->LocalNx - 1 : localmesh->xend;
+
+  int i = 0;
+  for (int x = xstart; x <= xend; x++) {
+    for (int z = 0; z < localmesh->LocalNz; z++) {
+      f[x][z] = values[i++];
+    }
+  }
+  ASSERT1(i == localN);
+}
+
 /*!
  * Sets the elements of the matrix A, which is used to solve the problem Ax=b.
  *
@@ -1124,4 +1517,66 @@ int LaplacePetsc::precon(Vec x, Vec y) {
   return 0;
 }
 
+int LaplacePetsc::singlePrecisionPrecon(Vec x, Vec y) {
+  const PetscScalar* xvals;
+  VecGetArrayRead(x, &xvals);
+  std::copy(xvals, xvals + localN, std::begin(single_work));
+  VecRestoreArrayRead(x, &xvals);
+
+  single_lu.solve(std::begin(single_work));
+
+  PetscScalar* yvals;
+  VecGetArray(y, &yvals);
+  std::copy(std::begin(single_work), std::end(single_work), yvals);
+  VecRestoreArray(y, &yvals);
+  return 0;
+}
+
+void SinglePrecisionBandLU::factorise(Mat mat) {
+  PetscInt row_start, row_end;
+  MatGetOwnershipRange(mat, &row_start, &row_end);
+  n = row_end - row_start;
+
+  // The bandwidth of the local block, from its nonzero pattern
+  kl = ku = 0;
+  PetscInt ncols;
+  const PetscInt* cols;
+  const PetscScalar* vals;
+  for (PetscInt row = row_start; row < row_end; row++) {
+    MatGetRow(mat, row, &ncols, &cols, nullptr);
+    for (PetscInt k = 0; k < ncols; k++) {
+      if ((cols[k] >= row_start) && (cols[k] < row_end)) {
+        kl = std::max(kl, static_cast<int>(row - cols[k]));
+        ku = std::max(ku, static_cast<int>(cols[k] - row));
+      }
+    }
+    MatRestoreRow(mat, row, &ncols, &cols, nullptr);
+  }
+
+  ldab = 2 * kl + ku + 1;
+  if (ab.size() != ldab * n) {
+    ab = Array<float>(ldab * n);
+  }
+  if (ipiv.size() != n) {
+    ipiv = Array<int>(n);
+  }
+  std::fill(std::begin(ab), std::end(ab), 0.0f);
+
+  for (PetscInt row = row_start; row < row_end; row++) {
+    MatGetRow(mat, row, &ncols, &cols, &vals);
+    for (PetscInt k = 0; k < ncols; k++) {
+      if ((cols[k] >= row_start) && (cols[k] < row_end)) {
+        at(row - row_start, cols[k] - row_start) = static_cast<float>(vals[k]);
+      }
+    }
+    MatRestoreRow(mat, row, &ncols, &cols, &vals);
+  }
+
+  sbandFactorise(std::begin(ab), n, kl, ku, std::begin(ipiv));
+}
+
+void SinglePrecisionBandLU::solve(float* x) const {
+  sbandSolveFactorised(std::begin(ab), std::begin(ipiv), n, kl, ku, x);
+}
+
 #endif // BOUT_HAS_PETSC_3_3
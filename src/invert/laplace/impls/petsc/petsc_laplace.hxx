@@ -67,6 +67,35 @@ public:
 #include <invert_laplace.hxx>
 #include <bout/petsclib.hxx>
 #include <boutexception.hxx>
+#include <bout/array.hxx>
+
+/// LU factorisation with partial pivoting of the locally owned block
+/// of a PETSc matrix, stored and applied in single precision with
+/// LAPACK's band routines. The rows are numbered so that the block is
+/// banded, with a bandwidth of a few times the number of Z points
+class SinglePrecisionBandLU {
+public:
+  /// Factorise the block of \p mat with the rows and columns owned by
+  /// this processor. Throws if the block is singular, or if BOUT++ was
+  /// compiled without LAPACK
+  void factorise(Mat mat);
+
+  /// Solve with the factorised block. \p x is the right-hand side on
+  /// input, and the solution on output
+  void solve(float* x) const;
+
+private:
+  int n{0};         ///< Number of rows
+  int kl{0}, ku{0}; ///< Number of sub- and super-diagonals
+  int ldab{0};      ///< Leading dimension of ab, 2 * kl + ku + 1
+
+  /// Band storage as in LAPACK's sgbtrf, with room for the fill-in of
+  /// the row interchanges: element (i, j) is ab[kl + ku + i - j + j * ldab]
+  Array<float> ab;
+  Array<int> ipiv; ///< Row interchanged with each row
+
+  float& at(int i, int j) { return ab[kl + ku + i - j + j * ldab]; }
+};
 
 class LaplacePetsc : public Laplacian {
 public:
@@ -76,6 +105,10 @@ public:
     VecDestroy( &xs );
     VecDestroy( &bs );
     MatDestroy( &MatA );
+    if (mixed_precision) {
+      VecDestroy( &refine_residual );
+      VecDestroy( &refine_correction );
+    }
   }
 
   void setCoefA(const Field2D &val) override {
@@ -84,6 +117,7 @@ public:
     A = val;
     /*Acoefchanged = true;*/
     if(pcsolve) pcsolve->setCoefA(val);
+    coefficientsChanged();
   }
   void setCoefC(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -92,18 +126,21 @@ public:
     C2 = val;
     issetC = true; /*coefchanged = true;*/
     if(pcsolve) pcsolve->setCoefC(val);
+    coefficientsChanged();
   }
   void setCoefC1(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C1 = val;
     issetC = true;
+    coefficientsChanged();
   }
   void setCoefC2(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C2 = val;
     issetC = true;
+    coefficientsChanged();
   }
   void setCoefD(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -111,6 +148,7 @@ public:
     D = val;
     issetD = true; /*coefchanged = true;*/
     if(pcsolve) pcsolve->setCoefD(val);
+    coefficientsChanged();
   }
   void setCoefEx(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -118,6 +156,7 @@ public:
     Ex = val;
     issetE = true; /*coefchanged = true;*/
     if(pcsolve) pcsolve->setCoefEx(val);
+    coefficientsChanged();
   }
   void setCoefEz(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -125,6 +164,7 @@ public:
     Ez = val;
     issetE = true; /*coefchanged = true;*/
     if(pcsolve) pcsolve->setCoefEz(val);
+    coefficientsChanged();
   }
 
   void setCoefA(const Field3D &val) override {
@@ -133,6 +173,7 @@ public:
     A = val;
     /*Acoefchanged = true;*/
     if(pcsolve) pcsolve->setCoefA(val);
+    coefficientsChanged();
   }
   void setCoefC(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -141,18 +182,21 @@ public:
     C2 = val;
     issetC = true; /*coefchanged = true;*/
     if(pcsolve) pcsolve->setCoefC(val);
+    coefficientsChanged();
   }
   void setCoefC1(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C1 = val;
     issetC = true;
+    coefficientsChanged();
   }
   void setCoefC2(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C2 = val;
     issetC = true;
+    coefficientsChanged();
   }
   void setCoefD(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -160,6 +204,7 @@ public:
     D = val;
     issetD = true; /*coefchanged = true;*/
     if(pcsolve) pcsolve->setCoefD(val);
+    coefficientsChanged();
   }
   void setCoefEx(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -167,6 +212,7 @@ public:
     Ex = val;
     issetE = true; /*coefchanged = true;*/
     if(pcsolve) pcsolve->setCoefEx(val);
+    coefficientsChanged();
   }
   void setCoefEz(const Field3D &val) override {
     ASSERT1(val.getLocation() == location);
@@ -174,12 +220,28 @@ public:
     Ez = val;
     issetE = true; /*coefchanged = true;*/
     if(pcsolve) pcsolve->setCoefEz(val);
+    coefficientsChanged();
   }
 
+  bool uses3DCoefs() const override { return true; }
+
   FieldPerp solve(const FieldPerp &b) override;
   FieldPerp solve(const FieldPerp &b, const FieldPerp &x0) override;
 
+  /// The matrix for each Y index is assembled once, then used to
+  /// solve for all the fields (with KSPMatSolve if available)
+  std::vector<Field3D> solve(const std::vector<Field3D> &b) override { return solve(b, b); }
+  std::vector<Field3D> solve(const std::vector<Field3D> &b,
+                             const std::vector<Field3D> &x0) override;
+
+  /// Also saves "<name>_refinement_average_iterations", the average
+  /// number of refinement steps per solve, if mixed_precision is set
+  void savePerformance(Datafile& output_file, Solver& solver,
+                       const std::string& name) override;
+
   int precon(Vec x, Vec y); ///< Preconditioner function
+  /// Apply the single precision factorisation, if mixed_precision is set
+  int singlePrecisionPrecon(Vec x, Vec y);
 
 private:
   void Element(int i, int x, int z, int xshift, int zshift, PetscScalar ele, Mat &MatA );
@@ -192,10 +254,30 @@ private:
    * See LaplacePetsc::Coeffs for details an potential pit falls
    */
   Field3D A, C1, C2, D, Ex, Ez;
-// Metrics are not constant in y-direction, so matrix always changes as you loop over the grid
-// Hence using coefchanged switch to avoid recomputing the mmatrix is not a useful thing to do (unless maybe in a cylindrical machine, but not worth implementing just for that)
-//   bool coefchanged;           // Set to true when C, D, Ex or Ez coefficients are changed
-//   bool Acoefchanged;	      // Set to true when A coefficient is changed
+  // Metrics are not constant in y-direction, so the matrix changes as you
+  // loop over the grid. It is only kept while solving repeatedly for the
+  // same Y index, e.g. for a single FieldPerp or with one Y point per processor
+  int operator_version{-1}; ///< Coefficient version used to set MatA
+  int operator_y{-1};       ///< Y index used to set MatA
+  int pattern_inner_flags{-1}, pattern_outer_flags{-1}; ///< Flags of MatA's nonzero pattern
+
+  // Keeping the preconditioner for several matrices
+  int reuse_preconditioner;  ///< Maximum number of solves before rebuilding
+  BoutReal reuse_max_iteration_ratio; ///< Rebuild if iterations grow by more than this
+  int pc_age{0};             ///< Solves since the preconditioner was built
+  int pc_iterations{0};      ///< Iterations of the first solve with the preconditioner
+  int last_iterations{0};    ///< Iterations of the last solve
+
+  // Mixed precision: the KSP is preconditioned with a single precision
+  // factorisation and solves only loosely, and an outer loop refines
+  // the solution using residuals calculated in double precision
+  bool mixed_precision;        ///< Use mixed precision iterative refinement?
+  BoutReal refine_inner_rtol;  ///< Relative tolerance of each KSP solve
+  int refine_max_steps;        ///< Maximum number of refinement steps
+  SinglePrecisionBandLU single_lu; ///< Factorisation of the local block of MatA
+  Array<float> single_work;    ///< Single precision copy of a vector
+  Vec refine_residual, refine_correction; ///< Work vectors for refinement
+  IterationMonitor refinement_performance; ///< Refinement steps per solve
   bool issetD;
   bool issetC;
   bool issetE;
@@ -237,6 +319,29 @@ private:
   void vecToField(Vec x, FieldPerp &f);        // Copy a vector into a fieldperp
   void fieldToVec(const FieldPerp &f, Vec x);  // Copy a fieldperp into a vector
 
+  /// Solve for more right-hand sides with the operator set up by the
+  /// last call to solve(FieldPerp, FieldPerp)
+  void solveWithSameOperator(const std::vector<FieldPerp> &b,
+                             const std::vector<FieldPerp> &x0, std::vector<FieldPerp> &x);
+  /// Solve MatA x = rhs with the KSP, using x as the initial guess.
+  /// Throws if the solve fails, and returns the number of iterations
+  int kspSolve(Vec rhs, Vec x);
+  /// Check that the last KSP solve converged, and return its iterations
+  int convergedIterations();
+  /// Solve MatA x = rhs by iterative refinement, using x as the initial
+  /// guess. Returns the total number of KSP iterations
+  int refinedSolve(Vec rhs, Vec x);
+
+  /// Record the iterations of a solve, for the performance monitor
+  /// and for deciding when to rebuild a kept preconditioner
+  void recordIterations(int its);
+  /// RHS and initial guess for each local row, in matrix row order.
+  /// Boundary rows follow the boundary flags, as in solve(FieldPerp, FieldPerp)
+  void rhsToRows(const FieldPerp &b, const FieldPerp &x0, PetscScalar *rhs,
+                 PetscScalar *guess);
+  /// Copy the local rows of a solution into a fieldperp
+  void rowsToField(const PetscScalar *values, FieldPerp &f);
+
   #if CHECK > 0
     int implemented_flags;
     int implemented_boundary_flags;
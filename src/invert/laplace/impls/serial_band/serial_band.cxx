@@ -37,6 +37,8 @@
 
 #include <output.hxx>
 
+#include <algorithm>
+
 //#define SECONDORDER // Define to use 2nd order differencing
 
 LaplaceSerialBand::LaplaceSerialBand(Options *opt, const CELL_LOC loc, Mesh *mesh_in)
@@ -117,11 +119,24 @@ FieldPerp LaplaceSerialBand::solve(const FieldPerp& b, const FieldPerp& x0) {
     xend = localmesh->LocalNx-2;
   }
 
+  // Keep the LU factorisation of the band matrices for each Y index, so
+  // repeated solves with the same coefficients only back-substitute
+  const bool use_cache = cache_factorisation;
+  bool cached = false;
+  if(use_cache) {
+    if(cached_version.empty()) {
+      lu.reallocate(localmesh->LocalNy, maxmode + 1, 7 * localmesh->LocalNx);
+      ipiv.reallocate(localmesh->LocalNy, maxmode + 1, localmesh->LocalNx);
+      cached_version.reallocate(localmesh->LocalNy);
+      std::fill(std::begin(cached_version), std::end(cached_version), -1);
+    }
+    cached = factorisationValid(cached_version[jy]);
+  }
+
   for(int iz=0;iz<=maxmode;iz++) {
     // solve differential equation in x
     
-    BoutReal coef1=0.0, coef2=0.0, coef3=0.0, coef4=0.0, 
-      coef5=0.0, coef6=0.0, kwave;
+    BoutReal kwave;
     ///////// PERFORM INVERSION /////////
       
     // shift freqs according to FFT convention
@@ -131,295 +146,319 @@ FieldPerp LaplaceSerialBand::solve(const FieldPerp& b, const FieldPerp& x0) {
     for(int ix=0;ix<localmesh->LocalNx;ix++)
       bk1d[ix] = bk(ix, iz);
 
-    // Fill in interior points
+    // Boundary values in the RHS
+    for(int ix=0;ix<xbndry;ix++) {
+      if(!(inner_boundary_flags & (INVERT_RHS|INVERT_SET)))
+        bk1d[ix] = 0.0;
+      if(!(outer_boundary_flags & (INVERT_RHS|INVERT_SET)))
+        bk1d[ncx-ix] = 0.0;
+    }
 
-    for(int ix=xstart;ix<=xend;ix++) {
-#ifdef SECONDORDER 
-      // Use second-order differencing. Useful for testing the tridiagonal solver
-      // with different boundary conditions
-      dcomplex a,b,c;
-      tridagCoefs(ix, jy, iz, a, b, c, &Ccoef, &Dcoef);
-
-      A(ix, 0) = 0.;
-      A(ix, 1) = a;
-      A(ix, 2) = b + Acoef(ix, jy);
-      A(ix, 3) = c;
-      A(ix, 4) = 0.;
-#else
-      // Set coefficients
-      coef1 = coords->g11(ix,jy);  // X 2nd derivative
-      coef2 = coords->g33(ix,jy);  // Z 2nd derivative
-      coef3 = coords->g13(ix,jy);  // X-Z mixed derivatives
-      coef4 = 0.0;          // X 1st derivative
-      coef5 = 0.0;          // Z 1st derivative
-      coef6 = Acoef(ix,jy); // Constant
-
-      // Multiply Delp2 component by a factor
-      coef1 *= Dcoef(ix,jy);
-      coef2 *= Dcoef(ix,jy);
-      coef3 *= Dcoef(ix,jy);
-
-      if(all_terms) {
-        coef4 = coords->G1(ix,jy);
-        coef5 = coords->G3(ix,jy);
-      }
+    if(!cached)
+      setMatrix(jy, iz, kwave, xbndry, xstart, xend);
 
-      if(nonuniform) {
-        // non-uniform localmesh correction
-        if((ix != 0) && (ix != ncx))
-          coef4 += coords->g11(ix,jy)*( (1.0/coords->dx(ix+1,jy)) - (1.0/coords->dx(ix-1,jy)) )/(2.0*coords->dx(ix,jy));
+    // Perform inversion
+    if(use_cache) {
+      if(!cached) {
+        cbandFactorise(A, localmesh->LocalNx, 2, 2, &lu(jy, iz, 0), &ipiv(jy, iz, 0));
       }
+      cbandSolveFactorised(&lu(jy, iz, 0), &ipiv(jy, iz, 0), localmesh->LocalNx, 2, 2,
+                           bk1d);
+    }else
+      cband_solve(A, localmesh->LocalNx, 2, 2, bk1d);
 
-      // A first order derivative term (1/c)\nabla_perp c\cdot\nabla_\perp x
-    
-      if((ix > 1) && (ix < (localmesh->LocalNx-2)))
-        coef4 += coords->g11(ix,jy) * (Ccoef(ix-2,jy) - 8.*Ccoef(ix-1,jy) + 8.*Ccoef(ix+1,jy) - Ccoef(ix+2,jy)) / (12.*coords->dx(ix,jy)*(Ccoef(ix,jy)));
-
-      // Put into matrix
-      coef1 /= 12.* SQ(coords->dx(ix,jy));
-      coef2 *= SQ(kwave);
-      coef3 *= kwave / (12. * coords->dx(ix,jy));
-      coef4 /= 12. * coords->dx(ix,jy);
-      coef5 *= kwave;
-
-      A(ix, 0) = dcomplex(-coef1 + coef4, coef3);
-      A(ix, 1) = dcomplex(16. * coef1 - 8 * coef4, -8. * coef3);
-      A(ix, 2) = dcomplex(-30. * coef1 - coef2 + coef6, coef5);
-      A(ix, 3) = dcomplex(16. * coef1 + 8 * coef4, 8. * coef3);
-      A(ix, 4) = dcomplex(-coef1 - coef4, -coef3);
-#endif
+    if((global_flags & INVERT_KX_ZERO) && (iz == 0)) {
+      // Set the Kx = 0, n = 0 component to zero. For now just subtract
+      // Should do in the inversion e.g. Sherman-Morrison formula
+        
+      dcomplex offset(0.0);
+      for(int ix=0;ix<=ncx;ix++)
+        offset += bk1d[ix];
+      offset /= static_cast<BoutReal>(ncx + 1);
+      for(int ix=0;ix<=ncx;ix++)
+        bk1d[ix] -= offset;
     }
+      
+    // Fill xk
+    for (int ix=0; ix<=ncx; ix++)
+      xk(ix, iz) = bk1d[ix];
+  }
+  
+  if(use_cache)
+    cached_version[jy] = coef_version;
 
-    if(xbndry < 2) {
-      // Use 2nd order near edges
+  // Done inversion, transform back
 
-      int ix = 1;
+  for(int ix=0; ix<=ncx; ix++){
+    if(global_flags & INVERT_ZERO_DC)
+      xk(ix, 0) = 0.0;
 
-      coef1=coords->g11(ix,jy)/(SQ(coords->dx(ix,jy)));
-      coef2=coords->g33(ix,jy);
-      coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
-        
-      // Multiply Delp2 component by a factor
-      coef1 *= Dcoef(ix,jy);
-      coef2 *= Dcoef(ix,jy);
-      coef3 *= Dcoef(ix,jy);
+    irfft(&xk(ix, 0), ncz, x[ix]);
+  }
 
-      A(ix, 0) = 0.0; // Should never be used
-      A(ix, 1) = dcomplex(coef1, -coef3);
-      A(ix, 2) = dcomplex(-2.0 * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
-      A(ix, 3) = dcomplex(coef1, coef3);
-      A(ix, 4) = 0.0;
+  checkData(x);
 
-      ix = ncx-1;
+  return x;
+}
 
-      coef1=coords->g11(ix,jy)/(SQ(coords->dx(ix,jy)));
-      coef2=coords->g33(ix,jy);
-      coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
+void LaplaceSerialBand::setMatrix(int jy, int iz, BoutReal kwave, int xbndry, int xstart,
+                                  int xend) {
+  int ncx = localmesh->LocalNx-1;
+
+  BoutReal coef1=0.0, coef2=0.0, coef3=0.0, coef4=0.0, 
+    coef5=0.0, coef6=0.0;
+
+  // Fill in interior points
 
-      A(ix, 0) = 0.0;
-      A(ix, 1) = dcomplex(coef1, -coef3);
-      A(ix, 2) = dcomplex(-2.0 * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
-      A(ix, 3) = dcomplex(coef1, coef3);
-      A(ix, 4) = 0.0; // Should never be used
+  for(int ix=xstart;ix<=xend;ix++) {
+#ifdef SECONDORDER 
+    // Use second-order differencing. Useful for testing the tridiagonal solver
+    // with different boundary conditions
+    dcomplex a,b,c;
+    tridagCoefs(ix, jy, iz, a, b, c, &Ccoef, &Dcoef);
+
+    A(ix, 0) = 0.;
+    A(ix, 1) = a;
+    A(ix, 2) = b + Acoef(ix, jy);
+    A(ix, 3) = c;
+    A(ix, 4) = 0.;
+#else
+    // Set coefficients
+    coef1 = coords->g11(ix,jy);  // X 2nd derivative
+    coef2 = coords->g33(ix,jy);  // Z 2nd derivative
+    coef3 = coords->g13(ix,jy);  // X-Z mixed derivatives
+    coef4 = 0.0;          // X 1st derivative
+    coef5 = 0.0;          // Z 1st derivative
+    coef6 = Acoef(ix,jy); // Constant
+
+    // Multiply Delp2 component by a factor
+    coef1 *= Dcoef(ix,jy);
+    coef2 *= Dcoef(ix,jy);
+    coef3 *= Dcoef(ix,jy);
+
+    if(all_terms) {
+      coef4 = coords->G1(ix,jy);
+      coef5 = coords->G3(ix,jy);
     }
 
-    // Boundary conditions
+    if(nonuniform) {
+      // non-uniform localmesh correction
+      if((ix != 0) && (ix != ncx))
+        coef4 += coords->g11(ix,jy)*( (1.0/coords->dx(ix+1,jy)) - (1.0/coords->dx(ix-1,jy)) )/(2.0*coords->dx(ix,jy));
+    }
 
-    for(int ix=0;ix<xbndry;ix++) {
-      // Set zero-value. Change to zero-gradient if needed
+    // A first order derivative term (1/c)\nabla_perp c\cdot\nabla_\perp x
 
-      if(!(inner_boundary_flags & (INVERT_RHS|INVERT_SET)))
-        bk1d[ix] = 0.0;
-      if(!(outer_boundary_flags & (INVERT_RHS|INVERT_SET)))
-        bk1d[ncx-ix] = 0.0;
+    if((ix > 1) && (ix < (localmesh->LocalNx-2)))
+      coef4 += coords->g11(ix,jy) * (Ccoef(ix-2,jy) - 8.*Ccoef(ix-1,jy) + 8.*Ccoef(ix+1,jy) - Ccoef(ix+2,jy)) / (12.*coords->dx(ix,jy)*(Ccoef(ix,jy)));
 
-      A(ix, 0) = A(ix, 1) = A(ix, 3) = A(ix, 4) = 0.0;
-      A(ix, 2) = 1.0;
+    // Put into matrix
+    coef1 /= 12.* SQ(coords->dx(ix,jy));
+    coef2 *= SQ(kwave);
+    coef3 *= kwave / (12. * coords->dx(ix,jy));
+    coef4 /= 12. * coords->dx(ix,jy);
+    coef5 *= kwave;
 
-      A(ncx - ix, 0) = A(ncx - ix, 1) = A(ncx - ix, 3) = A(ncx - ix, 4) = 0.0;
-      A(ncx - ix, 2) = 1.0;
-    }
+    A(ix, 0) = dcomplex(-coef1 + coef4, coef3);
+    A(ix, 1) = dcomplex(16. * coef1 - 8 * coef4, -8. * coef3);
+    A(ix, 2) = dcomplex(-30. * coef1 - coef2 + coef6, coef5);
+    A(ix, 3) = dcomplex(16. * coef1 + 8 * coef4, 8. * coef3);
+    A(ix, 4) = dcomplex(-coef1 - coef4, -coef3);
+#endif
+  }
+
+  if(xbndry < 2) {
+    // Use 2nd order near edges
+
+    int ix = 1;
+
+    coef1=coords->g11(ix,jy)/(SQ(coords->dx(ix,jy)));
+    coef2=coords->g33(ix,jy);
+    coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
+    
+    // Multiply Delp2 component by a factor
+    coef1 *= Dcoef(ix,jy);
+    coef2 *= Dcoef(ix,jy);
+    coef3 *= Dcoef(ix,jy);
+
+    A(ix, 0) = 0.0; // Should never be used
+    A(ix, 1) = dcomplex(coef1, -coef3);
+    A(ix, 2) = dcomplex(-2.0 * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
+    A(ix, 3) = dcomplex(coef1, coef3);
+    A(ix, 4) = 0.0;
+
+    ix = ncx-1;
+
+    coef1=coords->g11(ix,jy)/(SQ(coords->dx(ix,jy)));
+    coef2=coords->g33(ix,jy);
+    coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
+
+    A(ix, 0) = 0.0;
+    A(ix, 1) = dcomplex(coef1, -coef3);
+    A(ix, 2) = dcomplex(-2.0 * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
+    A(ix, 3) = dcomplex(coef1, coef3);
+    A(ix, 4) = 0.0; // Should never be used
+  }
+
+  // Boundary conditions
 
-    if(iz == 0) {
-      // DC
+  for(int ix=0;ix<xbndry;ix++) {
+    // Set zero-value. Change to zero-gradient if needed
+
+    A(ix, 0) = A(ix, 1) = A(ix, 3) = A(ix, 4) = 0.0;
+    A(ix, 2) = 1.0;
+
+    A(ncx - ix, 0) = A(ncx - ix, 1) = A(ncx - ix, 3) = A(ncx - ix, 4) = 0.0;
+    A(ncx - ix, 2) = 1.0;
+  }
+
+  if(iz == 0) {
+    // DC
 	
-      // Inner boundary
-      if(inner_boundary_flags & (INVERT_DC_GRAD+INVERT_SET) || inner_boundary_flags & (INVERT_DC_GRAD+INVERT_RHS)) {
-        // Zero gradient at inner boundary. 2nd-order accurate
-        // Boundary at midpoint
-        for (int ix=0;ix<xbndry;ix++) {
-          A(ix, 0) = 0.;
-          A(ix, 1) = 0.;
-          A(ix, 2) = -.5 / sqrt(coords->g_11(ix, jy)) / coords->dx(ix, jy);
-          A(ix, 3) = .5 / sqrt(coords->g_11(ix, jy)) / coords->dx(ix, jy);
-          A(ix, 4) = 0.;
-        }
-        
+    // Inner boundary
+    if(inner_boundary_flags & (INVERT_DC_GRAD+INVERT_SET) || inner_boundary_flags & (INVERT_DC_GRAD+INVERT_RHS)) {
+      // Zero gradient at inner boundary. 2nd-order accurate
+      // Boundary at midpoint
+      for (int ix=0;ix<xbndry;ix++) {
+        A(ix, 0) = 0.;
+        A(ix, 1) = 0.;
+        A(ix, 2) = -.5 / sqrt(coords->g_11(ix, jy)) / coords->dx(ix, jy);
+        A(ix, 3) = .5 / sqrt(coords->g_11(ix, jy)) / coords->dx(ix, jy);
+        A(ix, 4) = 0.;
       }
-      else if(inner_boundary_flags & INVERT_DC_GRAD) {
-        // Zero gradient at inner boundary. 2nd-order accurate
-        // Boundary at midpoint
-        for (int ix=0;ix<xbndry;ix++) {
-          A(ix, 0) = 0.;
-          A(ix, 1) = 0.;
-          A(ix, 2) = -.5;
-          A(ix, 3) = .5;
-          A(ix, 4) = 0.;
-        }
-        
-      }
-      else if(inner_boundary_flags & INVERT_DC_GRADPAR) {
-        for (int ix=0;ix<xbndry;ix++) {
-          A(ix, 0) = 0.;
-          A(ix, 1) = 0.;
-          A(ix, 2) = -3. / sqrt(coords->g_22(ix, jy));
-          A(ix, 3) = 4. / sqrt(coords->g_22(ix + 1, jy));
-          A(ix, 4) = -1. / sqrt(coords->g_22(ix + 2, jy));
-        }
+    
+    }
+    else if(inner_boundary_flags & INVERT_DC_GRAD) {
+      // Zero gradient at inner boundary. 2nd-order accurate
+      // Boundary at midpoint
+      for (int ix=0;ix<xbndry;ix++) {
+        A(ix, 0) = 0.;
+        A(ix, 1) = 0.;
+        A(ix, 2) = -.5;
+        A(ix, 3) = .5;
+        A(ix, 4) = 0.;
       }
-      else if(inner_boundary_flags & INVERT_DC_GRADPARINV) {
-        for (int ix=0;ix<xbndry;ix++) {
-          A(ix, 0) = 0.;
-          A(ix, 1) = 0.;
-          A(ix, 2) = -3. * sqrt(coords->g_22(ix, jy));
-          A(ix, 3) = 4. * sqrt(coords->g_22(ix + 1, jy));
-          A(ix, 4) = -sqrt(coords->g_22(ix + 2, jy));
-        }
+    
+    }
+    else if(inner_boundary_flags & INVERT_DC_GRADPAR) {
+      for (int ix=0;ix<xbndry;ix++) {
+        A(ix, 0) = 0.;
+        A(ix, 1) = 0.;
+        A(ix, 2) = -3. / sqrt(coords->g_22(ix, jy));
+        A(ix, 3) = 4. / sqrt(coords->g_22(ix + 1, jy));
+        A(ix, 4) = -1. / sqrt(coords->g_22(ix + 2, jy));
       }
-      else if (inner_boundary_flags & INVERT_DC_LAP) {
-        for (int ix=0;ix<xbndry;ix++) {
-          A(ix, 0) = 0.;
-          A(ix, 1) = 0.;
-          A(ix, 2) = 1.;
-          A(ix, 3) = -2;
-          A(ix, 4) = 1.;
-        }
+    }
+    else if(inner_boundary_flags & INVERT_DC_GRADPARINV) {
+      for (int ix=0;ix<xbndry;ix++) {
+        A(ix, 0) = 0.;
+        A(ix, 1) = 0.;
+        A(ix, 2) = -3. * sqrt(coords->g_22(ix, jy));
+        A(ix, 3) = 4. * sqrt(coords->g_22(ix + 1, jy));
+        A(ix, 4) = -sqrt(coords->g_22(ix + 2, jy));
       }
-      
-      // Outer boundary
-      if(outer_boundary_flags & INVERT_DC_GRAD) {
-        // Zero gradient at outer boundary
-        for (int ix=0;ix<xbndry;ix++)
-          A(ncx - ix, 1) = -1.0;
+    }
+    else if (inner_boundary_flags & INVERT_DC_LAP) {
+      for (int ix=0;ix<xbndry;ix++) {
+        A(ix, 0) = 0.;
+        A(ix, 1) = 0.;
+        A(ix, 2) = 1.;
+        A(ix, 3) = -2;
+        A(ix, 4) = 1.;
       }
+    }
+  
+    // Outer boundary
+    if(outer_boundary_flags & INVERT_DC_GRAD) {
+      // Zero gradient at outer boundary
+      for (int ix=0;ix<xbndry;ix++)
+        A(ncx - ix, 1) = -1.0;
+    }
 	
-    }else {
-      // AC
+  }else {
+    // AC
 	
-      // Inner boundarySQ(kwave)*coef2
-      if(inner_boundary_flags & INVERT_AC_GRAD) {
-        // Zero gradient at inner boundary
-        for (int ix=0;ix<xbndry;ix++)
-          A(ix, 3) = -1.0;
-      }else if(inner_boundary_flags & INVERT_AC_LAP) {
-        // Enforce zero laplacian for 2nd and 4th-order
+    // Inner boundarySQ(kwave)*coef2
+    if(inner_boundary_flags & INVERT_AC_GRAD) {
+      // Zero gradient at inner boundary
+      for (int ix=0;ix<xbndry;ix++)
+        A(ix, 3) = -1.0;
+    }else if(inner_boundary_flags & INVERT_AC_LAP) {
+      // Enforce zero laplacian for 2nd and 4th-order
 	  
-        int ix = 1;
+      int ix = 1;
 	  
-        coef1=coords->g11(ix,jy)/(12.* SQ(coords->dx(ix,jy)));
+      coef1=coords->g11(ix,jy)/(12.* SQ(coords->dx(ix,jy)));
 	
-        coef2=coords->g33(ix,jy);
+      coef2=coords->g33(ix,jy);
 	
-        coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
-        
-        coef4 = Acoef(ix,jy);
+      coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
+    
+      coef4 = Acoef(ix,jy);
 	  
-        // Combine 4th order at 1 with 2nd order at 0
-        A(1, 0) = 0.0; // Not used
-        A(1, 1) = dcomplex(
-            (14. - SQ(coords->dx(0, jy) * kwave) * coords->g33(0, jy) / coords->g11(0, jy)) *
-                coef1,
-            -coef3);
-        A(1, 2) = dcomplex(-29. * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
-        A(1, 3) = dcomplex(16. * coef1, coef3);
-        A(1, 4) = dcomplex(-coef1, 0.0);
-
-        coef1=coords->g11(ix,jy)/(SQ(coords->dx(ix,jy)));
-        coef2=coords->g33(ix,jy);
-        coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
-
-        // Use 2nd order at 1
-        A(0, 0) = 0.0; // Should never be used
-        A(0, 1) = 0.0;
-        A(0, 2) = dcomplex(coef1, -coef3);
-        A(0, 3) = dcomplex(-2.0 * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
-        A(0, 4) = dcomplex(coef1, coef3);
-      }
+      // Combine 4th order at 1 with 2nd order at 0
+      A(1, 0) = 0.0; // Not used
+      A(1, 1) = dcomplex(
+          (14. - SQ(coords->dx(0, jy) * kwave) * coords->g33(0, jy) / coords->g11(0, jy)) *
+              coef1,
+          -coef3);
+      A(1, 2) = dcomplex(-29. * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
+      A(1, 3) = dcomplex(16. * coef1, coef3);
+      A(1, 4) = dcomplex(-coef1, 0.0);
+
+      coef1=coords->g11(ix,jy)/(SQ(coords->dx(ix,jy)));
+      coef2=coords->g33(ix,jy);
+      coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
+
+      // Use 2nd order at 1
+      A(0, 0) = 0.0; // Should never be used
+      A(0, 1) = 0.0;
+      A(0, 2) = dcomplex(coef1, -coef3);
+      A(0, 3) = dcomplex(-2.0 * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
+      A(0, 4) = dcomplex(coef1, coef3);
+    }
 	
-      // Outer boundary
-      if(outer_boundary_flags & INVERT_AC_GRAD) {
-        // Zero gradient at outer boundary
-        for (int ix=0;ix<xbndry;ix++)
-          A(ncx - ix, 1) = -1.0;
-      }else if(outer_boundary_flags & INVERT_AC_LAP) {
-        // Enforce zero laplacian for 2nd and 4th-order
-        // NOTE: Currently ignoring XZ term and coef4 assumed zero on boundary
-        // FIX THIS IF IT WORKS
-
-        int ix = ncx-1;
+    // Outer boundary
+    if(outer_boundary_flags & INVERT_AC_GRAD) {
+      // Zero gradient at outer boundary
+      for (int ix=0;ix<xbndry;ix++)
+        A(ncx - ix, 1) = -1.0;
+    }else if(outer_boundary_flags & INVERT_AC_LAP) {
+      // Enforce zero laplacian for 2nd and 4th-order
+      // NOTE: Currently ignoring XZ term and coef4 assumed zero on boundary
+      // FIX THIS IF IT WORKS
+
+      int ix = ncx-1;
 	  
-        coef1=coords->g11(ix,jy)/(12.* SQ(coords->dx(ix,jy)));
+      coef1=coords->g11(ix,jy)/(12.* SQ(coords->dx(ix,jy)));
 	
-        coef2=coords->g33(ix,jy);
+      coef2=coords->g33(ix,jy);
 	
-        coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
-        
-        coef4 = Acoef(ix,jy);
-	  
-        // Combine 4th order at ncx-1 with 2nd order at ncx
-        A(ix, 0) = dcomplex(-coef1, 0.0);
-        A(ix, 1) = dcomplex(16. * coef1, -coef3);
-        A(ix, 2) = dcomplex(-29. * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
-        A(ix, 3) = dcomplex(
-            (14. -
-             SQ(coords->dx(ncx, jy) * kwave) * coords->g33(ncx, jy) / coords->g11(ncx, jy)) *
-                coef1,
-            coef3);
-        A(ix, 4) = 0.0; // Not used
-
-        coef1=coords->g11(ix,jy)/(SQ(coords->dx(ix,jy)));
-        coef2=coords->g33(ix,jy);
-        coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
-
-        // Use 2nd order at ncx - 1
-        A(ncx, 0) = dcomplex(coef1, -coef3);
-        A(ncx, 1) = dcomplex(-2.0 * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
-        A(ncx, 2) = dcomplex(coef1, coef3);
-        A(ncx, 3) = 0.0; // Should never be used
-        A(ncx, 4) = 0.0;
-      }
-    }
+      coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
     
-    // Perform inversion
-    cband_solve(A, localmesh->LocalNx, 2, 2, bk1d);
-
-    if((global_flags & INVERT_KX_ZERO) && (iz == 0)) {
-      // Set the Kx = 0, n = 0 component to zero. For now just subtract
-      // Should do in the inversion e.g. Sherman-Morrison formula
-        
-      dcomplex offset(0.0);
-      for(int ix=0;ix<=ncx;ix++)
-        offset += bk1d[ix];
-      offset /= static_cast<BoutReal>(ncx + 1);
-      for(int ix=0;ix<=ncx;ix++)
-        bk1d[ix] -= offset;
-    }
-      
-    // Fill xk
-    for (int ix=0; ix<=ncx; ix++)
-      xk(ix, iz) = bk1d[ix];
-  }
-  
-  // Done inversion, transform back
+      coef4 = Acoef(ix,jy);
+	  
+      // Combine 4th order at ncx-1 with 2nd order at ncx
+      A(ix, 0) = dcomplex(-coef1, 0.0);
+      A(ix, 1) = dcomplex(16. * coef1, -coef3);
+      A(ix, 2) = dcomplex(-29. * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
+      A(ix, 3) = dcomplex(
+          (14. -
+           SQ(coords->dx(ncx, jy) * kwave) * coords->g33(ncx, jy) / coords->g11(ncx, jy)) *
+              coef1,
+          coef3);
+      A(ix, 4) = 0.0; // Not used
 
-  for(int ix=0; ix<=ncx; ix++){
-    if(global_flags & INVERT_ZERO_DC)
-      xk(ix, 0) = 0.0;
+      coef1=coords->g11(ix,jy)/(SQ(coords->dx(ix,jy)));
+      coef2=coords->g33(ix,jy);
+      coef3= kwave * coords->g13(ix,jy)/(2. * coords->dx(ix,jy));
 
-    irfft(&xk(ix, 0), ncz, x[ix]);
+      // Use 2nd order at ncx - 1
+      A(ncx, 0) = dcomplex(coef1, -coef3);
+      A(ncx, 1) = dcomplex(-2.0 * coef1 - SQ(kwave) * coef2 + coef4, 0.0);
+      A(ncx, 2) = dcomplex(coef1, coef3);
+      A(ncx, 3) = 0.0; // Should never be used
+      A(ncx, 4) = 0.0;
+    }
   }
-
-  checkData(x);
-
-  return x;
 }
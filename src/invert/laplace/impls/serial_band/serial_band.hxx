@@ -44,18 +44,21 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Acoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefC;
   void setCoefC(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Ccoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefD;
   void setCoefD(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Dcoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefEx;
   void setCoefEx(const Field2D &UNUSED(val)) override {
@@ -74,6 +77,15 @@ private:
   
   Matrix<dcomplex> bk, xk, A;
   Array<dcomplex> bk1d, xk1d;
+
+  /// LU factors of the band matrix for each Y index and Z mode,
+  /// [jy][kz][7*nx] (2*m1 + m2 + 1 = 7 rows of band storage)
+  Tensor<dcomplex> lu;
+  Tensor<int> ipiv;          ///< Pivots for lu, [jy][kz][nx]
+  Array<int> cached_version; ///< coef_version when lu was calculated, for each jy
+
+  /// Fill A with the band matrix for Y index \p jy and Z mode \p iz
+  void setMatrix(int jy, int iz, BoutReal kwave, int xbndry, int xstart, int xend);
 };
 
 #endif // __SERIAL_BAND_H__
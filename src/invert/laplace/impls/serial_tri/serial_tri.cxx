@@ -34,6 +34,7 @@
 #include <lapack_routines.hxx>
 #include <bout/constants.hxx>
 #include <bout/openmpwrap.hxx>
+#include <algorithm>
 #include <cmath>
 
 #include <output.hxx>
@@ -130,6 +131,21 @@ FieldPerp LaplaceSerialTri::solve(const FieldPerp& b, const FieldPerp& x0) {
   auto bvec = Array<dcomplex>(ncx);
   auto cvec = Array<dcomplex>(ncx);
 
+  // If the matrices are not periodic, keep the LU factorisation for each
+  // Y index, so that repeated solves with the same coefficients only need
+  // to back-substitute
+  const bool use_cache = cache_factorisation && !localmesh->periodicX;
+  bool cached = false;
+  if (use_cache) {
+    if (cached_version.empty()) {
+      lu.reallocate(localmesh->LocalNy, maxmode + 1, 4 * ncx);
+      ipiv.reallocate(localmesh->LocalNy, maxmode + 1, ncx);
+      cached_version.reallocate(localmesh->LocalNy);
+      std::fill(std::begin(cached_version), std::end(cached_version), -1);
+    }
+    cached = factorisationValid(cached_version[jy]);
+  }
+
   BOUT_OMP(parallel for)
   for (int ix = 0; ix < ncx; ix++) {
     /* This for loop will set the bk (initialized by the constructor)
@@ -176,17 +192,31 @@ FieldPerp LaplaceSerialTri::solve(const FieldPerp& b, const FieldPerp& x0) {
      * bvec - the main diagonal
      * cvec - the upper diagonal
     */
-    tridagMatrix(std::begin(avec), std::begin(bvec), std::begin(cvec), std::begin(bk1d),
-                 jy,
-                 // wave number index
-                 kz,
-                 // wave number (different from kz only if we are taking a part
-                 // of the z-domain [and not from 0 to 2*pi])
-                 kz * kwaveFactor, global_flags, inner_boundary_flags,
-                 outer_boundary_flags, &A, &C, &D);
+    if (cached) {
+      // Matrix already factorised, just set the boundary values in the RHS
+      tridagMatrixRHS(std::begin(bk1d), global_flags, inner_boundary_flags,
+                      outer_boundary_flags);
+    } else {
+      tridagMatrix(std::begin(avec), std::begin(bvec), std::begin(cvec), std::begin(bk1d),
+                   jy,
+                   // wave number index
+                   kz,
+                   // wave number (different from kz only if we are taking a part
+                   // of the z-domain [and not from 0 to 2*pi])
+                   kz * kwaveFactor, global_flags, inner_boundary_flags,
+                   outer_boundary_flags, &A, &C, &D);
+    }
 
     ///////// PERFORM INVERSION /////////
-    if (!localmesh->periodicX) {
+    if (use_cache) {
+      if (!cached) {
+        tridagFactorise(std::begin(avec), std::begin(bvec), std::begin(cvec),
+                        &lu(jy, kz, 0), &ipiv(jy, kz, 0), ncx);
+      }
+      tridagSolveFactorised(&lu(jy, kz, 0), &ipiv(jy, kz, 0), std::begin(bk1d),
+                            std::begin(xk1d), ncx);
+
+    } else if (!localmesh->periodicX) {
       // Call tridiagonal solver
       tridag(std::begin(avec), std::begin(bvec), std::begin(cvec), std::begin(bk1d),
              std::begin(xk1d), ncx);
@@ -222,6 +252,10 @@ FieldPerp LaplaceSerialTri::solve(const FieldPerp& b, const FieldPerp& x0) {
     }
   }
 
+  if (use_cache) {
+    cached_version[jy] = coef_version;
+  }
+
   // Done inversion, transform back
   for (int ix = 0; ix < ncx; ix++) {
 
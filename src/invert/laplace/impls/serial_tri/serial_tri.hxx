@@ -32,6 +32,7 @@ class LaplaceSerialTri;
 #include <invert_laplace.hxx>
 #include <dcomplex.hxx>
 #include <options.hxx>
+#include <utils.hxx>
 
 class LaplaceSerialTri : public Laplacian {
 public:
@@ -43,18 +44,21 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     A = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefC;
   void setCoefC(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     C = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefD;
   void setCoefD(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     D = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefEx;
   void setCoefEx(const Field2D &UNUSED(val)) override {
@@ -72,6 +76,12 @@ private:
   // The coefficents in
   // D*grad_perp^2(x) + (1/C)*(grad_perp(C))*grad_perp(x) + A*x = b
   Field2D A, C, D;
+
+  /// LU factors of the matrix for each Y index and Z mode, [jy][kz][4*nx].
+  /// Only used if x is not periodic
+  Tensor<dcomplex> lu;
+  Tensor<int> ipiv;            ///< Pivots for lu, [jy][kz][nx]
+  Array<int> cached_version;   ///< coef_version when lu was calculated, for each jy
 };
 
 #endif // __SERIAL_TRI_H__
@@ -201,16 +201,37 @@ Field3D LaplaceSPT::solve(const Field3D& b, const Field3D& x0) {
  * @param[in]  r    RHS vector
  * @param[in]  u    Result vector (Au = r)
  * @param[in]  n    Size of the matrix
- * @param[out] gam  Intermediate values used for backsolve stage
+ * @param[inout] gam  Intermediate values used for backsolve stage.
+ *                   Input if \p factorised is true, otherwise output
+ * @param[inout] ibet Inverse of the pivots. Input if \p factorised
+ *                    is true, otherwise output
  * @param[inout] bet
  * @param[inout] um
+ * @param[in] factorised  Are gam and ibet from a previous solve with
+ *                        the same coefficients?
  * @param[in] start
  */
 void LaplaceSPT::tridagForward(dcomplex *a, dcomplex *b, dcomplex *c,
                                 dcomplex *r, dcomplex *u, int n,
-                                dcomplex *gam,
-                                dcomplex &bet, dcomplex &um, bool start) {
+                                dcomplex *gam, dcomplex *ibet,
+                                dcomplex &bet, dcomplex &um, bool factorised,
+                                bool start) {
   int j;
+
+  if(factorised) {
+    // Only the RHS needs to be eliminated
+    if(start) {
+      u[0] = r[0] * ibet[0];
+    }else
+      u[0] = (r[0]-a[0]*um) * ibet[0];
+
+    for(j=1;j<n;j++)
+      u[j] = (r[j]-a[j]*u[j-1]) * ibet[j];
+
+    bet = 1.0 / ibet[n-1];
+    um = u[n-1];
+    return;
+  }
   
   if(start) {
     bet = b[0];
@@ -220,12 +241,14 @@ void LaplaceSPT::tridagForward(dcomplex *a, dcomplex *b, dcomplex *c,
     bet = b[0] - a[0]*gam[0];
     u[0] = (r[0]-a[0]*um)/bet;
   }
+  ibet[0] = 1.0 / bet;
   
   for(j=1;j<n;j++) {
     gam[j] = c[j-1]/bet;
     bet = b[j]-a[j]*gam[j];
     if(bet == 0.0)
       throw BoutException("Tridag: Zero pivot\n");
+    ibet[j] = 1.0 / bet;
     
     u[j] = (r[j]-a[j]*u[j-1])/bet;
   }
@@ -295,8 +318,21 @@ int LaplaceSPT::start(const FieldPerp &b, SPT_data &data) {
 
   BoutReal kwaveFactor = 2.0 * PI / coords->zlength();
 
+  // If the coefficients haven't changed since the last solve for this
+  // Y index, the matrix and its elimination factors can be reused
+  data.cached = factorisationValid(data.coef_version) && (data.coef_jy == data.jy);
+  if (cache_factorisation) {
+    data.coef_version = coef_version;
+    data.coef_jy = data.jy;
+  }
+
   /// Set matrix elements
   for (int kz = 0; kz <= maxmode; kz++) {
+    if (data.cached) {
+      tridagMatrixRHS(&data.bk(kz, 0), global_flags, inner_boundary_flags,
+                      outer_boundary_flags);
+      continue;
+    }
     tridagMatrix(&data.avec(kz, 0), &data.bvec(kz, 0), &data.cvec(kz, 0), &data.bk(kz, 0),
                  data.jy, kz, kz * kwaveFactor, global_flags, inner_boundary_flags,
                  outer_boundary_flags, &Acoef, &Ccoef, &Dcoef);
@@ -312,7 +348,7 @@ int LaplaceSPT::start(const FieldPerp &b, SPT_data &data) {
       // Start tridiagonal solve
       tridagForward(&data.avec(kz, 0), &data.bvec(kz, 0), &data.cvec(kz, 0),
                     &data.bk(kz, 0), &data.xk(kz, 0), localmesh->xend + 1, &data.gam(kz, 0),
-                    bet, u0, true);
+                    &data.ibet(kz, 0), bet, u0, data.cached, true);
       // Load intermediate values into buffers
       data.buffer[4*kz]     = bet.real();
       data.buffer[4*kz + 1] = bet.imag();
@@ -364,7 +400,8 @@ int LaplaceSPT::next(SPT_data &data) {
         tridagForward(&data.avec(kz, localmesh->xstart), &data.bvec(kz, localmesh->xstart),
                       &data.cvec(kz, localmesh->xstart), &data.bk(kz, localmesh->xstart),
                       &data.xk(kz, localmesh->xstart), localmesh->xend + 1,
-                      &data.gam(kz, localmesh->xstart), bet, u0);
+                      &data.gam(kz, localmesh->xstart), &data.ibet(kz, localmesh->xstart),
+                      bet, u0, data.cached);
 
         // Back-substitute
 	gp = 0.0;
@@ -388,7 +425,8 @@ int LaplaceSPT::next(SPT_data &data) {
         tridagForward(&data.avec(kz, localmesh->xstart), &data.bvec(kz, localmesh->xstart),
                       &data.cvec(kz, localmesh->xstart), &data.bk(kz, localmesh->xstart),
                       &data.xk(kz, localmesh->xstart), localmesh->xend - localmesh->xstart + 1,
-                      &data.gam(kz, localmesh->xstart), bet, u0);
+                      &data.gam(kz, localmesh->xstart), &data.ibet(kz, localmesh->xstart),
+                      bet, u0, data.cached);
         // Load intermediate values into buffers
 	data.buffer[4*kz]     = bet.real();
 	data.buffer[4*kz + 1] = bet.imag();
@@ -510,6 +548,7 @@ void LaplaceSPT::SPT_data::allocate(int mm, int nx) {
   xk.reallocate(mm, nx);
 
   gam.reallocate(mm, nx);
+  ibet.reallocate(mm, nx);
 
   // Matrix to be solved
   avec.reallocate(mm, nx);
@@ -74,18 +74,21 @@ public:
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Acoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefC;
   void setCoefC(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Ccoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefD;
   void setCoefD(const Field2D &val) override {
     ASSERT1(val.getLocation() == location);
     ASSERT1(localmesh == val.getMesh());
     Dcoef = val;
+    coefficientsChanged();
   }
   using Laplacian::setCoefEx;
   void setCoefEx(const Field2D &UNUSED(val)) override {
@@ -119,6 +122,11 @@ private:
     Matrix<dcomplex> xk;
 
     Matrix<dcomplex> gam;
+    Matrix<dcomplex> ibet; ///< Inverse of the pivots in the forward elimination
+
+    int coef_version{-1}; ///< Laplacian::coef_version when the matrix was set
+    int coef_jy{-1};      ///< Y index of the matrix
+    bool cached{false};   ///< Reusing the matrix and factors in this solve?
   
     Matrix<dcomplex> avec, bvec, cvec; ///< Diagonal bands of matrix
 
@@ -140,8 +148,9 @@ private:
 
   void tridagForward(dcomplex *a, dcomplex *b, dcomplex *c,
                       dcomplex *r, dcomplex *u, int n,
-                      dcomplex *gam,
-                      dcomplex &bet, dcomplex &um, bool start=false);
+                      dcomplex *gam, dcomplex *ibet,
+                      dcomplex &bet, dcomplex &um, bool factorised,
+                      bool start=false);
   void tridagBack(dcomplex *u, int n,
                    dcomplex *gam, dcomplex &gp, dcomplex &up);
   
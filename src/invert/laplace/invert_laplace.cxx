@@ -110,6 +110,21 @@ Laplacian::Laplacian(Options *options, const CELL_LOC loc, Mesh *mesh_in)
                         .withDefault(false);
 
   OPTION2(options, extra_yguards_lower, extra_yguards_upper, 0);
+
+  cache_factorisation =
+      (*options)["cache_factorisation"]
+          .doc("Reuse matrix factorisations while the coefficients are unchanged?")
+          .withDefault(true);
+
+  initial_guess_history =
+      (*options)["initial_guess_history"]
+          .doc("Number of previous solutions to extrapolate for the initial guess "
+               "of iterative solvers. 0 uses the guess passed to solve")
+          .withDefault(0);
+  if (initial_guess_history < 0) {
+    throw BoutException("Laplacian: initial_guess_history must be >= 0, got %d",
+                        initial_guess_history);
+  }
 }
 
 Laplacian* Laplacian::create(Options *opts, const CELL_LOC location, Mesh *mesh_in) {
@@ -136,6 +151,35 @@ void Laplacian::cleanup() {
   instance = nullptr;
 }
 
+void Laplacian::savePerformance(Datafile& output_file, Solver& solver,
+                                const std::string& name) {
+  performance.save(output_file, solver, name);
+}
+
+FieldPerp Laplacian::initialGuess(const FieldPerp& x0) {
+  if ((initial_guess_history == 0) || (global_flags & INVERT_START_NEW)) {
+    return x0;
+  }
+  auto it = solution_history.find(x0.getIndex());
+  if (it == solution_history.end() || it->second.empty()) {
+    return x0;
+  }
+  return it->second.extrapolate();
+}
+
+void Laplacian::storeSolution(const FieldPerp& x) {
+  if (initial_guess_history == 0) {
+    return;
+  }
+  auto it = solution_history.find(x.getIndex());
+  if (it == solution_history.end()) {
+    it = solution_history
+             .emplace(x.getIndex(), SolutionHistory<FieldPerp>(initial_guess_history))
+             .first;
+  }
+  it->second.push(x);
+}
+
 /**********************************************************************************
  *                                 Solve routines
  **********************************************************************************/
@@ -237,6 +281,29 @@ Field2D Laplacian::solve(const Field2D& b, const Field2D& x0) {
   return DC(f);
 }
 
+std::vector<Field3D> Laplacian::solve(const std::vector<Field3D>& b) {
+  std::vector<Field3D> x;
+  x.reserve(b.size());
+  for (const auto& field : b) {
+    x.push_back(solve(field));
+  }
+  return x;
+}
+
+std::vector<Field3D> Laplacian::solve(const std::vector<Field3D>& b,
+                                      const std::vector<Field3D>& x0) {
+  if (b.size() != x0.size()) {
+    throw BoutException("Laplacian::solve: %d right-hand sides but %d initial guesses",
+                        static_cast<int>(b.size()), static_cast<int>(x0.size()));
+  }
+  std::vector<Field3D> x;
+  x.reserve(b.size());
+  for (std::size_t i = 0; i < b.size(); ++i) {
+    x.push_back(solve(b[i], x0[i]));
+  }
+  return x;
+}
+
 /**********************************************************************************
  *                              MATRIX ELEMENTS
  **********************************************************************************/
@@ -466,13 +533,6 @@ void Laplacian::tridagMatrix(dcomplex *avec, dcomplex *bvec, dcomplex *cvec,
     if(localmesh->firstX()) {
       // INNER BOUNDARY ON THIS PROCESSOR
 
-      // If no user specified value is set on inner boundary, set the first
-      // element in b (in the equation AX=b) to 0
-      if(!(inner_boundary_flags & (INVERT_RHS | INVERT_SET))) {
-        for(int ix=0;ix<inbndry;ix++)
-          bk[ix] = 0.;
-      }
-
       // DC i.e. kz = 0 (the offset mode)
       if(kz == 0) {
 
@@ -629,14 +689,6 @@ void Laplacian::tridagMatrix(dcomplex *avec, dcomplex *bvec, dcomplex *cvec,
     if(localmesh->lastX()) {
       // OUTER BOUNDARY ON THIS PROCESSOR
 
-      // If no user specified value is set on outer boundary, set the last
-      // element in b (in the equation AX=b) to 0
-      if(!(outer_boundary_flags & (INVERT_RHS | INVERT_SET))) {
-        for (int ix=0;ix<outbndry;ix++) {
-          bk[ncx-ix] = 0.;
-        }
-      }
-
       // DC i.e. kz = 0 (the offset mode)
       if(kz==0) {
 
@@ -734,6 +786,63 @@ void Laplacian::tridagMatrix(dcomplex *avec, dcomplex *bvec, dcomplex *cvec,
       }
     }
   }
+
+  // Zero the boundary elements of the RHS, unless a user value is used
+  tridagMatrixRHS(bk, global_flags, inner_boundary_flags, outer_boundary_flags,
+                  includeguards);
+}
+
+/*!
+ * Apply the boundary conditions to the RHS vector b in Ax=b
+ *
+ * This is the part of tridagMatrix which depends on the right hand
+ * side rather than on the coefficients, so that solvers which reuse
+ * a factorised matrix can still apply the boundary conditions.
+ *
+ * \param[inout] bk      The b in Ax = b
+ * \param[in] global_flags          Global flags of the inversion
+ * \param[in] inner_boundary_flags  Flags used to set the inner boundary
+ * \param[in] outer_boundary_flags  Flags used to set the outer boundary
+ * \param[in] includeguards Whether or not the guard points in x are in bk
+ */
+void Laplacian::tridagMatrixRHS(dcomplex *bk, int global_flags, int inner_boundary_flags,
+                                int outer_boundary_flags, bool includeguards) {
+  if (localmesh->periodicX) {
+    return;
+  }
+
+  int xs = 0;
+  int xe = localmesh->LocalNx - 1;
+  if (!includeguards) {
+    if (!localmesh->firstX())
+      xs = localmesh->xstart;
+    if (!localmesh->lastX())
+      xe = localmesh->xend;
+  }
+  int ncx = xe - xs;
+
+  int inbndry = localmesh->xstart, outbndry = localmesh->xstart;
+  if ((global_flags & INVERT_BOTH_BNDRY_ONE) || (localmesh->xstart < 2)) {
+    inbndry = outbndry = 1;
+  }
+  if (inner_boundary_flags & INVERT_BNDRY_ONE)
+    inbndry = 1;
+  if (outer_boundary_flags & INVERT_BNDRY_ONE)
+    outbndry = 1;
+
+  // If no user specified value is set on inner boundary, set the first
+  // element in b (in the equation AX=b) to 0
+  if (localmesh->firstX() && !(inner_boundary_flags & (INVERT_RHS | INVERT_SET))) {
+    for (int ix = 0; ix < inbndry; ix++)
+      bk[ix] = 0.;
+  }
+
+  // If no user specified value is set on outer boundary, set the last
+  // element in b (in the equation AX=b) to 0
+  if (localmesh->lastX() && !(outer_boundary_flags & (INVERT_RHS | INVERT_SET))) {
+    for (int ix = 0; ix < outbndry; ix++)
+      bk[ncx - ix] = 0.;
+  }
 }
 
 /**********************************************************************************
@@ -888,4 +997,6 @@ void Laplacian::setFlags(int flags) {
     inner_boundary_flags += INVERT_DC_GRADPARINV;
   if (flags & 4194304)
     inner_boundary_flags += INVERT_IN_CYLINDER;
+
+  coefficientsChanged();
 }
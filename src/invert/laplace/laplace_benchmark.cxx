@@ -0,0 +1,222 @@
+#include <bout/invert/laplace_benchmark.hxx>
+
+#include <bout/mesh.hxx>
+#include <boutcomm.hxx>
+#include <boutexception.hxx>
+#include <globals.hxx>
+#include <utils.hxx>
+
+#include "laplacefactory.hxx"
+
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+
+namespace {
+/// Has any processor set \p failed?
+bool anyFailed(bool failed) {
+  int local = failed ? 1 : 0, global;
+  MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_MAX, BoutComm::get());
+  return global != 0;
+}
+
+/// Maximum of \p value over all processors
+BoutReal maxAllProcs(BoutReal value) {
+  BoutReal result;
+  MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_MAX, BoutComm::get());
+  return result;
+}
+} // namespace
+
+LaplaceBenchmark::LaplaceBenchmark(Options* options, CELL_LOC loc, Mesh* mesh_in)
+    : options(options == nullptr ? Options::getRoot()->getSection("laplace") : options),
+      location(loc), localmesh(mesh_in == nullptr ? bout::globals::mesh : mesh_in),
+      create(Laplacian::create) {}
+
+std::vector<LaplaceBenchmark::Result>
+LaplaceBenchmark::run(const Setup& setup, const Field3D& b, const Field3D& x0) {
+  return runAll(setup, b, x0);
+}
+
+std::vector<LaplaceBenchmark::Result>
+LaplaceBenchmark::run(const Setup& setup, const FieldPerp& b, const FieldPerp& x0) {
+  return runAll(setup, b, x0);
+}
+
+template <typename T>
+std::vector<LaplaceBenchmark::Result>
+LaplaceBenchmark::runAll(const Setup& setup, const T& b, const T& x0) {
+  TRACE("LaplaceBenchmark::run");
+
+  // The default depends on needs_3d_coefs, so can't use withDefault
+  const std::string default_reference = needs_3d_coefs ? "naulin" : "cyclic";
+  const std::string reference =
+      options->isSet("benchmark_reference")
+          ? lowercase((*options)["benchmark_reference"].as<std::string>())
+          : default_reference;
+  const BoutReal tolerance =
+      (*options)["benchmark_tolerance"]
+          .doc("Maximum difference from the reference solution, relative to its "
+               "maximum")
+          .withDefault(1e-3);
+  const int repeats = (*options)["benchmark_repeats"]
+                          .doc("Number of timed solves after the first")
+                          .withDefault(5);
+  const bool coefs_change =
+      (*options)["benchmark_coefs_change"]
+          .doc("Set the coefficients again before each timed solve, so solvers "
+               "which cache factorisations are timed as if the coefficients evolve")
+          .withDefault(true);
+  const std::string type_list =
+      (*options)["benchmark_types"]
+          .doc("Comma-separated Laplacian types to try. Empty for all available")
+          .withDefault(std::string{});
+
+  if (repeats < 1) {
+    throw BoutException("LaplaceBenchmark: benchmark_repeats must be >= 1, got %d",
+                        repeats);
+  }
+
+  // The reference goes first, so the others can be compared with it
+  std::vector<std::string> types{reference};
+  std::vector<std::string> candidates;
+  if (trim(type_list).empty()) {
+    candidates = LaplaceFactory::getInstance()->getTypes(localmesh);
+  } else {
+    for (const auto& type : strsplit(type_list, ',')) {
+      candidates.push_back(lowercase(trim(type)));
+    }
+  }
+  for (const auto& type : candidates) {
+    if (std::find(types.begin(), types.end(), type) == types.end()) {
+      types.push_back(type);
+    }
+  }
+
+  std::vector<Result> results;
+  T reference_solution;
+  BoutReal reference_max = 1.0;
+
+  for (const auto& type : types) {
+    Result result;
+    result.type = type;
+
+    // Each implementation sets its own defaults, and only the user's values are shared
+    Options solver_options = userOptions(*options);
+    solver_options["type"].force(type, "LaplaceBenchmark");
+
+    std::unique_ptr<Laplacian> solver;
+    T x;
+    bool failed = false;
+    try {
+      solver.reset(create(&solver_options, location, localmesh));
+      if (needs_3d_coefs and not solver->uses3DCoefs()) {
+        failed = true;
+        result.reason = "only uses the DC part of Field3D coefficients";
+      } else {
+        setup(*solver);
+      }
+    } catch (const BoutException& e) {
+      failed = true;
+      result.reason = e.what();
+    }
+
+    if (not anyFailed(failed)) {
+      try {
+        MPI_Barrier(BoutComm::get());
+        BoutReal start = MPI_Wtime();
+        x = solver->solve(b, x0);
+        result.first_time = maxAllProcs(MPI_Wtime() - start);
+
+        // Only the solves are timed, not setting the coefficients
+        BoutReal total = 0.0;
+        for (int i = 0; i < repeats; i++) {
+          if (coefs_change) {
+            setup(*solver);
+          }
+          MPI_Barrier(BoutComm::get());
+          start = MPI_Wtime();
+          x = solver->solve(b, x0);
+          total += MPI_Wtime() - start;
+        }
+        result.solve_time = maxAllProcs(total) / repeats;
+      } catch (const BoutException& e) {
+        // Can only recover if the exception was thrown on all processors
+        failed = true;
+        result.reason = e.what();
+      }
+      failed = anyFailed(failed);
+    } else {
+      failed = true;
+    }
+
+    if (failed and result.reason.empty()) {
+      result.reason = "failed on another processor";
+    }
+
+    if (type == reference) {
+      if (failed) {
+        throw BoutException("LaplaceBenchmark: reference type '%s' failed: %s",
+                            type.c_str(), result.reason.c_str());
+      }
+      reference_solution = x;
+      reference_max = max(abs(x), true);
+      if (reference_max == 0.0) {
+        reference_max = 1.0;
+      }
+    } else if (not failed) {
+      result.error = max(abs(x - reference_solution), true) / reference_max;
+      if (result.error > tolerance) {
+        failed = true;
+        result.reason = "differs from " + reference + " by more than benchmark_tolerance";
+      }
+    }
+    result.valid = not failed;
+
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+std::string LaplaceBenchmark::fastest(const std::vector<Result>& results) {
+  std::string best;
+  BoutReal best_time = 0.0;
+  for (const auto& result : results) {
+    if (result.valid and (best.empty() or result.solve_time < best_time)) {
+      best = result.type;
+      best_time = result.solve_time;
+    }
+  }
+  return best;
+}
+
+void LaplaceBenchmark::print(const std::vector<Result>& results, std::ostream& out) {
+  out << std::setw(12) << "Type" << std::setw(7) << "Valid" << std::setw(14)
+      << "First (s)" << std::setw(14) << "Per solve (s)" << std::setw(14) << "Rel. error"
+      << "  Notes\n";
+  for (const auto& result : results) {
+    out << std::setw(12) << result.type << std::setw(7) << (result.valid ? "yes" : "no");
+    if (result.first_time > 0.0) {
+      out << std::setw(14) << result.first_time << std::setw(14) << result.solve_time
+          << std::setw(14) << result.error;
+    } else {
+      out << std::setw(42) << "-";
+    }
+    out << "  " << result.reason << "\n";
+  }
+}
+
+Options LaplaceBenchmark::userOptions(const Options& options) {
+  Options result(nullptr, options.str());
+  for (const auto& child : options.getChildren()) {
+    if (child.second.isValue()) {
+      if (child.second.isSet()) {
+        result[child.first] = child.second;
+      }
+    } else {
+      result[child.first] = userOptions(child.second);
+    }
+  }
+  return result;
+}
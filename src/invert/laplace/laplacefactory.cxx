@@ -15,6 +15,7 @@
 #include "impls/shoot/shoot_laplace.hxx"
 #include "impls/multigrid/multigrid_laplace.hxx"
 #include "impls/naulin/naulin_laplace.hxx"
+#include "impls/auto/auto_laplace.hxx"
 
 #define LAPLACE_SPT  "spt"
 #define LAPLACE_PDD  "pdd"
@@ -26,6 +27,7 @@
 #define LAPLACE_SHOOT "shoot"
 #define LAPLACE_MULTIGRID "multigrid"
 #define LAPLACE_NAULIN "naulin"
+#define LAPLACE_AUTO "auto"
 
 LaplaceFactory *LaplaceFactory::instance = nullptr;
 
@@ -70,6 +72,8 @@ Laplacian* LaplaceFactory::createLaplacian(Options *options, const CELL_LOC loc,
       return new LaplaceMultigrid(options, loc, mesh_in);
     }else if(strcasecmp(type.c_str(), LAPLACE_NAULIN) == 0) {
       return new LaplaceNaulin(options, loc, mesh_in);
+    }else if(strcasecmp(type.c_str(), LAPLACE_AUTO) == 0) {
+      return new LaplaceAuto(options, loc, mesh_in);
     }else {
       throw BoutException("Unknown serial Laplacian solver type '%s'", type.c_str());
     }
@@ -94,8 +98,31 @@ Laplacian* LaplaceFactory::createLaplacian(Options *options, const CELL_LOC loc,
       return new LaplaceMultigrid(options, loc, mesh_in);
   }else if(strcasecmp(type.c_str(), LAPLACE_NAULIN) == 0) {
     return new LaplaceNaulin(options, loc, mesh_in);
+  }else if(strcasecmp(type.c_str(), LAPLACE_AUTO) == 0) {
+    return new LaplaceAuto(options, loc, mesh_in);
   }else {
     throw BoutException("Unknown parallel Laplacian solver type '%s'", type.c_str());
   }
 }
 
+std::vector<std::string> LaplaceFactory::getTypes(Mesh *mesh_in) const {
+  if (mesh_in == nullptr) {
+    mesh_in = bout::globals::mesh;
+  }
+
+  std::vector<std::string> types;
+  if (mesh_in->firstX() && mesh_in->lastX()) {
+    types = {LAPLACE_CYCLIC, LAPLACE_TRI, LAPLACE_BAND, LAPLACE_SPT, LAPLACE_SHOOT,
+             LAPLACE_MULTIGRID, LAPLACE_NAULIN};
+  } else {
+    types = {LAPLACE_CYCLIC, LAPLACE_PDD, LAPLACE_SPT, LAPLACE_SHOOT, LAPLACE_MULTIGRID,
+             LAPLACE_NAULIN};
+  }
+#ifdef BOUT_HAS_PETSC
+  types.push_back(LAPLACE_PETSC);
+#endif
+#ifdef BOUT_HAS_MUMPS
+  types.push_back(LAPLACE_MUMPS);
+#endif
+  return types;
+}
@@ -6,6 +6,9 @@ class LaplaceFactory;
 
 #include <invert_laplace.hxx>
 
+#include <string>
+#include <vector>
+
 class LaplaceFactory {
  public:
   /// Return a pointer to the only instance
@@ -14,6 +17,10 @@ class LaplaceFactory {
   Laplacian *createLaplacian(Options *options = nullptr, const CELL_LOC loc = CELL_CENTRE,
       Mesh *mesh_in = nullptr);
 
+  /// The types which can be used on \p mesh_in, not including "auto".
+  /// Types which need a library BOUT++ was built without are left out
+  std::vector<std::string> getTypes(Mesh *mesh_in = nullptr) const;
+
 private:
   LaplaceFactory() {} // Prevent instantiation of this class
   static LaplaceFactory* instance; ///< The only instance of this class (Singleton)
@@ -15,7 +15,9 @@
 
 #include <output.hxx>
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 #undef __FUNCT__
 #define __FUNCT__ "laplacePCapply"
@@ -33,7 +35,7 @@ int LaplaceXY::instance_count = 0;
 
 LaplaceXY::LaplaceXY(Mesh* m, Options* opt, const CELL_LOC loc)
     : lib(opt == nullptr ? &(Options::root()["laplacexy"]) : opt),
-      localmesh(m == nullptr ? bout::globals::mesh : m), location(loc), monitor(*this) {
+      localmesh(m == nullptr ? bout::globals::mesh : m), location(loc) {
   Timer timer("invert");
 
   instance_count++;
@@ -48,6 +50,17 @@ LaplaceXY::LaplaceXY(Mesh* m, Options* opt, const CELL_LOC loc)
       "Use finite volume rather than finite difference discretisation."
       ).withDefault(true);
 
+  const int initial_guess_history =
+      (*opt)["initial_guess_history"]
+          .doc("Number of previous solutions to extrapolate for the initial guess. "
+               "0 uses the guess passed to solve")
+          .withDefault(0);
+  if (initial_guess_history < 0) {
+    throw BoutException("LaplaceXY: initial_guess_history must be >= 0, got %d",
+                        initial_guess_history);
+  }
+  history = SolutionHistory<Field2D>(initial_guess_history);
+
   ///////////////////////////////////////////////////
   // Boundary condititions options
   if (localmesh->periodicY(localmesh->xstart)) {
@@ -152,6 +165,11 @@ LaplaceXY::LaplaceXY(Mesh* m, Options* opt, const CELL_LOC loc)
   acoef.reallocate(nsys, nloc);
   bcoef.reallocate(nsys, nloc);
   ccoef.reallocate(nsys, nloc);
+  ymcoef.reallocate(nsys, nloc);
+  ypcoef.reallocate(nsys, nloc);
+  // Only interior points are coupled in Y
+  ymcoef = 0.0;
+  ypcoef = 0.0;
   xvals.reallocate(nsys, nloc);
   bvals.reallocate(nsys, nloc);
 
@@ -533,11 +551,40 @@ LaplaceXY::LaplaceXY(Mesh* m, Options* opt, const CELL_LOC loc)
     
     KSPSetInitialGuessNonzero( ksp, (PetscBool) true );
     
+    use_multigrid = (pctype == "bout_mg");
+    if (use_multigrid) {
+      mg_max_levels = (*opt)["mg_max_levels"]
+                          .doc("Maximum number of multigrid levels, including the "
+                               "finest. Coarsening stops earlier when no processor "
+                               "can coarsen its points any more")
+                          .withDefault(20);
+      mg_smooth = (*opt)["mg_smooth"]
+                      .doc("Multigrid relaxation sweeps before and after each "
+                           "coarse grid correction")
+                      .withDefault(1);
+      if (mg_max_levels < 1) {
+        throw BoutException("LaplaceXY: mg_max_levels must be >= 1, got %d",
+                            mg_max_levels);
+      }
+      if (mg_smooth < 1) {
+        throw BoutException("LaplaceXY: mg_smooth must be >= 1, got %d", mg_smooth);
+      }
+      mg_coarse_procs = (*opt)["mg_coarse_procs"]
+                            .doc("Number of processors the coarsest multigrid level "
+                                 "is gathered onto and solved directly")
+                            .withDefault(1);
+      if (mg_coarse_procs < 1) {
+        throw BoutException("LaplaceXY: mg_coarse_procs must be >= 1, got %d",
+                            mg_coarse_procs);
+      }
+    }
+
     KSPGetPC(ksp,&pc);
-    PCSetType(pc, pctype.c_str());
+    // The multigrid preconditioner is applied through a shell
+    PCSetType(pc, use_multigrid ? PCSHELL : pctype.c_str());
 
-    if (pctype == "shell") {
-      // Using tridiagonal solver as preconditioner
+    if ((pctype == "shell") or use_multigrid) {
+      // Using tridiagonal solver or multigrid as preconditioner
       PCShellSetApply(pc,laplacePCapply);
       PCShellSetContext(pc,this);
       
@@ -643,6 +690,9 @@ void LaplaceXY::setCoefs(const Field2D &A, const Field2D &B) {
           val = -Acoef * J * g23 * g_23 / (g_22 * coords->J(x,y) * dy * coords->dy(x,y));
           ym = val;
           c -= val;
+
+          ymcoef(y - localmesh->ystart, x - xstart) = ym;
+          ypcoef(y - localmesh->ystart, x - xstart) = yp;
         }
 
         /////////////////////////////////////////////////
@@ -760,6 +810,10 @@ void LaplaceXY::setCoefs(const Field2D &A, const Field2D &B) {
           val = coords->g12(x, y)*dAdy/(2.*dx);
           xp += val;
           xm -= val;
+
+          // Cross terms are left out of the multigrid preconditioner
+          ymcoef(y - localmesh->ystart, x - xstart) = ym;
+          ypcoef(y - localmesh->ystart, x - xstart) = yp;
         }
 
         /////////////////////////////////////////////////
@@ -1112,6 +1166,10 @@ void LaplaceXY::setCoefs(const Field2D &A, const Field2D &B) {
   
   // Set coefficients for preconditioner
   cr->setCoefs(acoef, bcoef, ccoef);
+
+  if (use_multigrid) {
+    setupMultigrid();
+  }
 }
 
 LaplaceXY::~LaplaceXY() {
@@ -1126,6 +1184,15 @@ LaplaceXY::~LaplaceXY() {
   VecDestroy(&xs);
   VecDestroy(&bs);
   MatDestroy(&MatA);
+
+  if (!mg_levels.empty()) {
+    if (!is_finalised) {
+      KSPDestroy(&mg_coarse_ksp);
+    }
+    VecDestroy(&mg_coarse_x);
+    VecDestroy(&mg_coarse_b);
+    MatDestroy(&mg_coarse_mat);
+  }
 }
 
 const Field2D LaplaceXY::solve(const Field2D &rhs, const Field2D &x0) {
@@ -1136,13 +1203,16 @@ const Field2D LaplaceXY::solve(const Field2D &rhs, const Field2D &x0) {
   ASSERT1(rhs.getLocation() == location);
   ASSERT1(x0.getLocation() == location);
 
-  // Load initial guess x0 into xs and rhs into bs
+  // Load initial guess x0 into xs and rhs into bs. The interior guess may be
+  // extrapolated from previous solutions
+
+  const Field2D guess = history.empty() ? x0 : history.extrapolate();
 
   for(int x=localmesh->xstart;x<= localmesh->xend;x++) {
     for(int y=localmesh->ystart;y<=localmesh->yend;y++) {
       int ind = globalIndex(x,y);
       
-      PetscScalar val = x0(x,y);
+      PetscScalar val = guess(x,y);
       VecSetValues( xs, 1, &ind, &val, INSERT_VALUES );
       
       val = rhs(x,y);
@@ -1521,15 +1591,10 @@ const Field2D LaplaceXY::solve(const Field2D &rhs, const Field2D &x0) {
     throw BoutException("LaplaceXY failed to converge. Reason %d", reason);
   }
 
-  if (save_performance) {
-    // Update performance monitoring information
-    n_calls++;
-
+  if (performance.isEnabled()) {
     int iterations = 0;
     KSPGetIterationNumber(ksp, &iterations);
-
-    average_iterations = BoutReal(n_calls - 1)/BoutReal(n_calls)*average_iterations
-                         + BoutReal(iterations)/BoutReal(n_calls);
+    performance.record(iterations);
   }
   
   //////////////////////////
@@ -1588,6 +1653,8 @@ const Field2D LaplaceXY::solve(const Field2D &rhs, const Field2D &x0) {
     for(int y=localmesh->yend+1;y<localmesh->LocalNy;y++)
       result(it.ind, y) = val;
   }
+
+  history.push(result);
   
   return result;
 }
@@ -1642,8 +1709,24 @@ int LaplaceXY::precon(Vec input, Vec result) {
     }
   }
   
-  // Solve tridiagonal systems using CR solver
-  cr->solve(bvals, xvals);
+  if (use_multigrid) {
+    // Multigrid works on Field2D, so that the mesh communications can be used
+    Field2D rhs{0.0, localmesh}, sol{0.0, localmesh};
+    for (int x = xstart; x <= xend; x++) {
+      for (int y = localmesh->ystart; y <= localmesh->yend; y++) {
+        rhs(x, y) = bvals(y - localmesh->ystart, x - xstart);
+      }
+    }
+    mgCycle(0, sol, rhs);
+    for (int x = xstart; x <= xend; x++) {
+      for (int y = localmesh->ystart; y <= localmesh->yend; y++) {
+        xvals(y - localmesh->ystart, x - xstart) = sol(x, y);
+      }
+    }
+  } else {
+    // Solve tridiagonal systems using CR solver
+    cr->solve(bvals, xvals);
+  }
 
   // Save result xvals into y array
   ind = ind0;
@@ -1659,6 +1742,441 @@ int LaplaceXY::precon(Vec input, Vec result) {
   return 0;
 }
 
+///////////////////////////////////////////////////////////////
+// Geometric multigrid preconditioner
+//
+// Each level is coarsened in X and in Y on every processor, by
+// joining neighbouring points in pairs. When the number of points is
+// odd the last three points are joined, so the sizes needn't be
+// powers of 2. Coarsening in a direction stops at one Y point, or two
+// X points, which the X-line tridiagonal solvers need on each
+// processor. Coarse operators are Galerkin products with piecewise
+// constant interpolation. The smoother is zebra (red-black)
+// relaxation of X lines, which is exact for the X derivatives and so
+// robust to the strong X-Y anisotropy typical of tokamak grids.
+//
+// The coarsest level then has a few points on each processor, and
+// couples all of them. It is assembled into a PETSc matrix, which
+// PETSc's telescope preconditioner gathers onto a subcommunicator of
+// mg_coarse_procs processors (one by default) to be solved with LU.
+
+namespace {
+/// The size of the next level from \p n points in a direction, if
+/// these can be coarsened while keeping at least \p nmin points
+int mgCoarsenedSize(int n, int nmin) {
+  return (n / 2 >= nmin) ? n / 2 : n;
+}
+
+/// The point on the next level of each of \p n points, when the next
+/// level has \p ncoarse points. Points are joined in pairs, and the
+/// last coarse point takes three fine points if \p n is odd
+std::vector<int> mgCoarseMap(int n, int ncoarse) {
+  std::vector<int> map(n);
+  for (int k = 0; k < n; k++) {
+    map[k] = (ncoarse == n) ? k : std::min(k / 2, ncoarse - 1);
+  }
+  return map;
+}
+} // namespace
+
+void LaplaceXY::setupMultigrid() {
+  if (mg_levels.empty()) {
+    // The sizes only depend on the mesh, so are only set once
+    MPI_Comm comm = BoutComm::get();
+    int nx = nloc;
+    int ny = nsys;
+    while (true) {
+      MultigridLevel level;
+      level.nx = nx;
+      level.ny = ny;
+      level.xm.reallocate(ny, nx);
+      level.c.reallocate(ny, nx);
+      level.xp.reallocate(ny, nx);
+      level.ym.reallocate(ny, nx);
+      level.yp.reallocate(ny, nx);
+      for (int colour = 0; colour < 2; colour++) {
+        if ((ny + 1 - colour) / 2 > 0) {
+          level.lines[colour] =
+              bout::utils::make_unique<CyclicReduce<BoutReal>>(localmesh->getXcomm(), nx);
+        }
+      }
+
+      const int nx_coarse = mgCoarsenedSize(nx, 2);
+      const int ny_coarse = mgCoarsenedSize(ny, 1);
+      level.xcoarse = mgCoarseMap(nx, nx_coarse);
+      level.ycoarse = mgCoarseMap(ny, ny_coarse);
+      mg_levels.push_back(std::move(level));
+
+      // The levels are collective, so all processors have the same
+      // number. Those which can't be coarsened any more keep the same
+      // points on the remaining levels
+      int coarsened = ((nx_coarse < nx) or (ny_coarse < ny)) ? 1 : 0;
+      int any_coarsened;
+      MPI_Allreduce(&coarsened, &any_coarsened, 1, MPI_INT, MPI_MAX, comm);
+      if ((any_coarsened == 0)
+          or (static_cast<int>(mg_levels.size()) == mg_max_levels)) {
+        break;
+      }
+      nx = nx_coarse;
+      ny = ny_coarse;
+    }
+
+    // Number the coarsest level points globally. Points on this
+    // processor are ordered (x, y) with y fastest
+    const int lc = static_cast<int>(mg_levels.size()) - 1;
+    const MultigridLevel& coarse = mg_levels[lc];
+    const int ncoarse = coarse.nx * coarse.ny;
+
+    VecCreate(comm, &mg_coarse_b);
+    VecSetSizes(mg_coarse_b, ncoarse, PETSC_DETERMINE);
+    VecSetFromOptions(mg_coarse_b);
+    VecDuplicate(mg_coarse_b, &mg_coarse_x);
+
+    MatCreate(comm, &mg_coarse_mat);
+    MatSetSizes(mg_coarse_mat, ncoarse, ncoarse, PETSC_DETERMINE, PETSC_DETERMINE);
+    MatSetType(mg_coarse_mat, MATAIJ);
+    // 5-point stencil, with X and Y neighbours possibly on other processors
+    MatSeqAIJSetPreallocation(mg_coarse_mat, 5, nullptr);
+    MatMPIAIJSetPreallocation(mg_coarse_mat, 5, nullptr, 4, nullptr);
+
+    PetscInt Istart, Iend;
+    MatGetOwnershipRange(mg_coarse_mat, &Istart, &Iend);
+
+    mg_coarse_index = Field2D{-1.0, localmesh};
+    for (int i = 0; i < coarse.nx; i++) {
+      for (int j = 0; j < coarse.ny; j++) {
+        mg_coarse_index(mgX(lc, i), mgY(lc, j)) = Istart + i * coarse.ny + j;
+      }
+    }
+    // Guard cells give the rows of the neighbours, following the
+    // same topology as the relaxation
+    mgCommunicate(lc, mg_coarse_index);
+
+    KSPCreate(comm, &mg_coarse_ksp);
+    KSPSetType(mg_coarse_ksp, KSPPREONLY);
+    PC coarse_pc;
+    KSPGetPC(mg_coarse_ksp, &coarse_pc);
+#if PETSC_VERSION_GE(3,7,0)
+    // Gather the matrix onto mg_coarse_procs processors
+    int nprocs;
+    MPI_Comm_size(comm, &nprocs);
+    PCSetType(coarse_pc, PCTELESCOPE);
+    PCTelescopeSetReductionFactor(coarse_pc, std::max(nprocs / mg_coarse_procs, 1));
+#else
+    // Each processor gets a copy of the whole matrix, factorised with LU
+    PCSetType(coarse_pc, PCREDUNDANT);
+#endif
+  }
+
+  // Finest level
+  MultigridLevel& fine = mg_levels[0];
+  fine.xm = acoef;
+  fine.c = bcoef;
+  fine.xp = ccoef;
+  fine.ym = ymcoef;
+  fine.yp = ypcoef;
+  for (int j = 0; j < nsys; j++) {
+    for (int i = 0; i < nloc; i++) {
+      // Both discretisations put -(ym + yp) on the diagonal,
+      // which is not in bcoef
+      fine.c(j, i) -= ymcoef(j, i) + ypcoef(j, i);
+    }
+    // X boundary cells are only coupled into the domain
+    if (localmesh->firstX()) {
+      fine.xm(j, 0) = 0.0;
+    }
+    if (localmesh->lastX()) {
+      fine.xp(j, nloc - 1) = 0.0;
+    }
+  }
+
+  // Eliminate the Y boundary cells. free_o3 is treated as Neumann
+  const BoutReal reflect = (y_bndry == "dirichlet") ? -1.0 : 1.0;
+  for (RangeIterator it = localmesh->iterateBndryLowerY(); !it.isDone(); it++) {
+    const int i = it.ind - xstart;
+    fine.c(0, i) += reflect * fine.ym(0, i);
+    fine.ym(0, i) = 0.0;
+  }
+  for (RangeIterator it = localmesh->iterateBndryUpperY(); !it.isDone(); it++) {
+    const int i = it.ind - xstart;
+    fine.c(nsys - 1, i) += reflect * fine.yp(nsys - 1, i);
+    fine.yp(nsys - 1, i) = 0.0;
+  }
+
+  // Coarse levels. Couplings between fine points which are joined
+  // move onto the diagonal, and the others couple neighbouring coarse
+  // points. Points at the edge of a level are never joined with their
+  // neighbours on other processors
+  for (std::size_t l = 1; l < mg_levels.size(); l++) {
+    const MultigridLevel& f = mg_levels[l - 1];
+    MultigridLevel& c = mg_levels[l];
+    c.xm = 0.0;
+    c.c = 0.0;
+    c.xp = 0.0;
+    c.ym = 0.0;
+    c.yp = 0.0;
+    for (int j = 0; j < f.ny; j++) {
+      const int jc = f.ycoarse[j];
+      const bool joined_ym = (j > 0) and (f.ycoarse[j - 1] == jc);
+      const bool joined_yp = (j < f.ny - 1) and (f.ycoarse[j + 1] == jc);
+      for (int i = 0; i < f.nx; i++) {
+        const int ic = f.xcoarse[i];
+        const bool joined_xm = (i > 0) and (f.xcoarse[i - 1] == ic);
+        const bool joined_xp = (i < f.nx - 1) and (f.xcoarse[i + 1] == ic);
+
+        c.c(jc, ic) += f.c(j, i);
+        (joined_xm ? c.c : c.xm)(jc, ic) += f.xm(j, i);
+        (joined_xp ? c.c : c.xp)(jc, ic) += f.xp(j, i);
+        (joined_ym ? c.c : c.ym)(jc, ic) += f.ym(j, i);
+        (joined_yp ? c.c : c.yp)(jc, ic) += f.yp(j, i);
+      }
+    }
+  }
+
+  // Assemble the coarsest level. Neighbours outside the domain have
+  // zero coefficients and no row, and entries are added so that a
+  // neighbour which is the same point in both directions (a single
+  // periodic line) is counted twice
+  {
+    const int lc = static_cast<int>(mg_levels.size()) - 1;
+    const MultigridLevel& coarse = mg_levels[lc];
+    PetscBool assembled;
+    MatAssembled(mg_coarse_mat, &assembled);
+    if (assembled) {
+      // Coefficients have changed; the nonzero pattern stays the same
+      MatZeroEntries(mg_coarse_mat);
+    }
+    for (int i = 0; i < coarse.nx; i++) {
+      const int x = mgX(lc, i);
+      for (int j = 0; j < coarse.ny; j++) {
+        const int y = mgY(lc, j);
+        const PetscInt row = static_cast<PetscInt>(std::round(mg_coarse_index(x, y)));
+
+        PetscInt cols[5];
+        PetscScalar vals[5];
+        int n = 0;
+        auto addEntry = [&](int xn, int yn, BoutReal val) {
+          const int col = static_cast<int>(std::round(mg_coarse_index(xn, yn)));
+          if (col >= 0) {
+            cols[n] = col;
+            vals[n] = val;
+            n++;
+          }
+        };
+        addEntry(x, y, coarse.c(j, i));
+        if ((i > 0) or !localmesh->firstX()) {
+          addEntry(mgX(lc, i - 1), y, coarse.xm(j, i));
+        }
+        if ((i < coarse.nx - 1) or !localmesh->lastX()) {
+          addEntry(mgX(lc, i + 1), y, coarse.xp(j, i));
+        }
+        addEntry(x, mgY(lc, j - 1), coarse.ym(j, i));
+        addEntry(x, mgY(lc, j + 1), coarse.yp(j, i));
+
+        MatSetValues(mg_coarse_mat, 1, &row, n, cols, vals, ADD_VALUES);
+      }
+    }
+    MatAssemblyBegin(mg_coarse_mat, MAT_FINAL_ASSEMBLY);
+    MatAssemblyEnd(mg_coarse_mat, MAT_FINAL_ASSEMBLY);
+
+#if PETSC_VERSION_GE(3,5,0)
+    KSPSetOperators(mg_coarse_ksp, mg_coarse_mat, mg_coarse_mat);
+#else
+    KSPSetOperators(mg_coarse_ksp, mg_coarse_mat, mg_coarse_mat, SAME_NONZERO_PATTERN);
+#endif
+
+#if PETSC_VERSION_GE(3,7,0)
+    if (!assembled) {
+      // The solver on the subcommunicator is only created when the
+      // telescope is set up, and only on the processors which use it
+      KSPSetUp(mg_coarse_ksp);
+      PC coarse_pc;
+      KSPGetPC(mg_coarse_ksp, &coarse_pc);
+      KSP sub_ksp = nullptr;
+      PCTelescopeGetKSP(coarse_pc, &sub_ksp);
+      if (sub_ksp != nullptr) {
+        KSPSetType(sub_ksp, KSPPREONLY);
+        PC sub_pc;
+        KSPGetPC(sub_ksp, &sub_pc);
+        // Parallel LU needs an external package, so more than one
+        // processor each factorise a copy of the matrix
+        PCSetType(sub_pc, (mg_coarse_procs > 1) ? PCREDUNDANT : PCLU);
+      }
+    }
+#endif
+  }
+
+  // Tridiagonal systems for the even and odd X lines
+  for (auto& level : mg_levels) {
+    for (int colour = 0; colour < 2; colour++) {
+      if (!level.lines[colour]) {
+        continue;
+      }
+      const int nlines = (level.ny + 1 - colour) / 2;
+      Matrix<BoutReal> a(nlines, level.nx), b(nlines, level.nx), c(nlines, level.nx);
+      for (int k = 0; k < nlines; k++) {
+        const int j = 2 * k + colour;
+        for (int i = 0; i < level.nx; i++) {
+          a(k, i) = level.xm(j, i);
+          b(k, i) = level.c(j, i);
+          c(k, i) = level.xp(j, i);
+        }
+      }
+      level.lines[colour]->setCoefs(a, b, c);
+    }
+  }
+}
+
+int LaplaceXY::mgX(int l, int i) const {
+  // Point i is stored at xstart + i. Points on the neighbouring
+  // processors are in the X guard cells
+  if (i < 0) {
+    return xstart - 1;
+  }
+  if (i >= mg_levels[l].nx) {
+    return xend + 1;
+  }
+  return xstart + i;
+}
+
+int LaplaceXY::mgY(int l, int j) const {
+  // Line j is stored at ystart + j. Lines on the neighbouring
+  // processors are in the Y guard cells
+  if (j < 0) {
+    return localmesh->ystart - 1;
+  }
+  if (j >= mg_levels[l].ny) {
+    return localmesh->yend + 1;
+  }
+  return localmesh->ystart + j;
+}
+
+void LaplaceXY::mgCommunicate(int l, Field2D& u) {
+  const MultigridLevel& level = mg_levels[l];
+  // Coarse levels don't reach xend or yend, which are what is sent
+  // to the next processors in X and Y
+  if ((level.nx < nloc) and !localmesh->lastX()) {
+    for (int y = 0; y < localmesh->LocalNy; y++) {
+      u(xend, y) = u(xstart + level.nx - 1, y);
+    }
+  }
+  if (level.ny < nsys) {
+    for (int x = 0; x < localmesh->LocalNx; x++) {
+      u(x, localmesh->yend) = u(x, localmesh->ystart + level.ny - 1);
+    }
+  }
+  localmesh->communicate(u);
+}
+
+void LaplaceXY::mgRelax(int l, Field2D& u, const Field2D& f, int sweeps) {
+  const MultigridLevel& level = mg_levels[l];
+
+  for (int sweep = 0; sweep < sweeps; sweep++) {
+    for (int colour = 0; colour < 2; colour++) {
+      if (!level.lines[colour]) {
+        continue;
+      }
+      // Need the latest values of the other colour, including lines
+      // on neighbouring processors
+      mgCommunicate(l, u);
+
+      const int nlines = (level.ny + 1 - colour) / 2;
+      Matrix<BoutReal> rhs(nlines, level.nx), sol(nlines, level.nx);
+      for (int k = 0; k < nlines; k++) {
+        const int j = 2 * k + colour;
+        const int y = mgY(l, j);
+        const int ydown = mgY(l, j - 1);
+        const int yup = mgY(l, j + 1);
+        for (int i = 0; i < level.nx; i++) {
+          const int x = mgX(l, i);
+          rhs(k, i) = f(x, y) - level.ym(j, i) * u(x, ydown) - level.yp(j, i) * u(x, yup);
+        }
+      }
+
+      level.lines[colour]->solve(rhs, sol);
+
+      for (int k = 0; k < nlines; k++) {
+        const int y = mgY(l, 2 * k + colour);
+        for (int i = 0; i < level.nx; i++) {
+          u(mgX(l, i), y) = sol(k, i);
+        }
+      }
+    }
+  }
+}
+
+void LaplaceXY::mgCoarseSolve(Field2D& u, const Field2D& f) {
+  const int l = static_cast<int>(mg_levels.size()) - 1;
+  const MultigridLevel& coarse = mg_levels[l];
+
+  PetscScalar* vals;
+  VecGetArray(mg_coarse_b, &vals);
+  for (int i = 0; i < coarse.nx; i++) {
+    for (int j = 0; j < coarse.ny; j++) {
+      vals[i * coarse.ny + j] = f(mgX(l, i), mgY(l, j));
+    }
+  }
+  VecRestoreArray(mg_coarse_b, &vals);
+
+  KSPSolve(mg_coarse_ksp, mg_coarse_b, mg_coarse_x);
+
+  VecGetArray(mg_coarse_x, &vals);
+  for (int i = 0; i < coarse.nx; i++) {
+    for (int j = 0; j < coarse.ny; j++) {
+      u(mgX(l, i), mgY(l, j)) = vals[i * coarse.ny + j];
+    }
+  }
+  VecRestoreArray(mg_coarse_x, &vals);
+}
+
+void LaplaceXY::mgCycle(int l, Field2D& u, const Field2D& f) {
+  if (l == static_cast<int>(mg_levels.size()) - 1) {
+    // Coarsest level. u is always zero here, since each level starts
+    // from a zero correction
+    mgCoarseSolve(u, f);
+    return;
+  }
+
+  mgRelax(l, u, f, mg_smooth);
+
+  // Restrict the residual, summing the points which are joined
+  const MultigridLevel& level = mg_levels[l];
+  mgCommunicate(l, u);
+  Field2D fcoarse{0.0, localmesh};
+  for (int j = 0; j < level.ny; j++) {
+    const int y = mgY(l, j);
+    const int ydown = mgY(l, j - 1);
+    const int yup = mgY(l, j + 1);
+    const int ycoarse = mgY(l + 1, level.ycoarse[j]);
+    for (int i = 0; i < level.nx; i++) {
+      const int x = mgX(l, i);
+      BoutReal residual = f(x, y) - level.c(j, i) * u(x, y)
+                          - level.ym(j, i) * u(x, ydown) - level.yp(j, i) * u(x, yup);
+      if ((i > 0) or !localmesh->firstX()) {
+        residual -= level.xm(j, i) * u(mgX(l, i - 1), y);
+      }
+      if ((i < level.nx - 1) or !localmesh->lastX()) {
+        residual -= level.xp(j, i) * u(mgX(l, i + 1), y);
+      }
+      fcoarse(mgX(l + 1, level.xcoarse[i]), ycoarse) += residual;
+    }
+  }
+
+  Field2D ucoarse{0.0, localmesh};
+  mgCycle(l + 1, ucoarse, fcoarse);
+
+  // Interpolate the correction, constant over the joined points
+  for (int j = 0; j < level.ny; j++) {
+    const int y = mgY(l, j);
+    const int ycoarse = mgY(l + 1, level.ycoarse[j]);
+    for (int i = 0; i < level.nx; i++) {
+      u(mgX(l, i), y) += ucoarse(mgX(l + 1, level.xcoarse[i]), ycoarse);
+    }
+  }
+
+  mgRelax(l, u, f, mg_smooth);
+}
+
 ///////////////////////////////////////////////////////////////
 
 int LaplaceXY::localSize() {
@@ -1713,20 +2231,12 @@ int LaplaceXY::globalIndex(int x, int y) {
 
 void LaplaceXY::savePerformance(Datafile& output_file, Solver& solver,
                                 std::string name) {
-  // set flag so that performance monitoring values are calculated
-  save_performance = true;
-
-  // add values to be saved to the output
   if (name == "") {
     name = "laplacexy";
     if (my_id > 1) {
       name += std::to_string(my_id);
     }
   }
-  output_file.addRepeat(output_average_iterations, name + "_average_iterations");
-
-  // add monitor to reset counters/averages for new output timestep
-  // monitor added to back of queue, so that values are reset after being saved
-  solver.addMonitor(&monitor, Solver::BACK);
+  performance.save(output_file, solver, name);
 }
 #endif // BOUT_HAS_PETSC
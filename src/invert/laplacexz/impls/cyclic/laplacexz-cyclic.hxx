@@ -19,8 +19,9 @@ public:
 private:
   int xstart, xend;
   int nmode, nloc, nsys;
+  /// Coefficients and values for all Y slices and Z modes, with
+  /// row (y - ystart) * nmode + kz
   Matrix<dcomplex> acoef, bcoef, ccoef, xcmplx, rhscmplx;
-  Array<dcomplex> k1d, k1d_2;
   std::unique_ptr<CyclicReduce<dcomplex>> cr; ///< Tridiagonal solver
 
   int inner_boundary_flags; ///< Flags to set inner boundary condition
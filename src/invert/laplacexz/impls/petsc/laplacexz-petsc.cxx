@@ -129,6 +129,17 @@ LaplaceXZpetsc::LaplaceXZpetsc(Mesh *m, Options *opt, const CELL_LOC loc)
                     .withDefault(100);
   reuse_count = reuse_limit + 1; // So re-calculates first time
 
+  const int initial_guess_history =
+      (*opt)["initial_guess_history"]
+          .doc("Number of previous solutions to extrapolate for the initial guess. "
+               "0 uses the guess passed to solve")
+          .withDefault(0);
+  if (initial_guess_history < 0) {
+    throw BoutException("LaplaceXZpetsc: initial_guess_history must be >= 0, got %d",
+                        initial_guess_history);
+  }
+  history = SolutionHistory<Field3D>(initial_guess_history);
+
   // Convergence Parameters. Solution is considered converged if |r_k| < max( rtol * |b| , atol )
   // where r_k = b - Ax_k. The solution is considered diverged if |r_k| > dtol * |b|.
 
@@ -609,6 +620,10 @@ Field3D LaplaceXZpetsc::solve(const Field3D &bin, const Field3D &x0in) {
   Field3D b = bin;
   Field3D x0 = x0in;
 
+  // Initial guess for the inner points, possibly extrapolated from previous
+  // solutions. Boundary conditions are still set from x0
+  const Field3D guess = history.empty() ? x0 : history.extrapolate();
+
   Field3D result{emptyFrom(bin)};
 
   for (auto &it : slice) {
@@ -685,7 +700,7 @@ Field3D LaplaceXZpetsc::solve(const Field3D &bin, const Field3D &x0in) {
     // Set the inner points
     for(int x=localmesh->xstart;x<= localmesh->xend;x++) {
       for(int z=0; z < localmesh->LocalNz; z++) {
-        PetscScalar val = x0(x,y,z);
+        PetscScalar val = guess(x,y,z);
         VecSetValues( xs, 1, &ind, &val, INSERT_VALUES );
 
         val = b(x,y,z);
@@ -777,6 +792,10 @@ Field3D LaplaceXZpetsc::solve(const Field3D &bin, const Field3D &x0in) {
       throw BoutException("LaplaceXZ failed to converge. Reason %d", reason);
     }
 
+    int iterations;
+    KSPGetIterationNumber(it.ksp, &iterations);
+    performance.record(iterations);
+
     //////////////////////////
     // Copy data into result
 
@@ -812,6 +831,8 @@ Field3D LaplaceXZpetsc::solve(const Field3D &bin, const Field3D &x0in) {
     ASSERT1(ind == Iend); // Reached end of range
   }
 
+  history.push(result);
+
   return result;
 }
 
@@ -34,6 +34,7 @@ private:
 #else // BOUT_HAS_PETSC
 
 #include <bout/petsclib.hxx>
+#include <bout/invert/solution_history.hxx>
 
 class LaplaceXZpetsc : public LaplaceXZ {
 public:
@@ -80,6 +81,9 @@ private:
   int reuse_count; ///< How many times has it been reused?
 
   bool coefs_set; ///< Have coefficients been set?
+
+  /// Previous solutions, extrapolated to give the initial guess
+  SolutionHistory<Field3D> history;
   
   #if CHECK > 0
     // Currently implemented flags
@@ -47,7 +47,9 @@
 
 #include <bout/surfaceiter.hxx>
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 InvertParCR::InvertParCR(Options *opt, CELL_LOC location, Mesh *mesh_in)
   : InvertPar(opt, location, mesh_in), A(1.0), B(0.0), C(0.0), D(0.0), E(0.0) {
@@ -58,180 +60,251 @@ InvertParCR::InvertParCR(Options *opt, CELL_LOC location, Mesh *mesh_in)
   sg = DDY(1. / sg) / sg;
 }
 
+namespace {
+/// A flux surface (x index) to be solved by InvertParCR
+struct Surface {
+  int x;             ///< X index
+  bool closed;       ///< Closed field-lines?
+  BoutReal ts;       ///< Twist-shift angle if closed
+  MPI_Comm comm;     ///< Communicator along Y
+  int y0;            ///< Row of the first point in the domain
+  int local_ystart;  ///< First Y index in the rows
+  int size;          ///< Number of rows
+  bool firstY;       ///< Contains the lower boundary?
+  bool lastY;        ///< Contains the upper boundary?
+};
+} // namespace
+
 const Field3D InvertParCR::solve(const Field3D &f) {
-  TRACE("InvertParCR::solve(Field3D)");
-  ASSERT1(localmesh == f.getMesh());
-  ASSERT1(location == f.getLocation());
+  return solve(std::vector<Field3D>{f}, {Coefficients{A, B, C, D, E}})[0];
+}
 
-  Field3D result = emptyFrom(f).setDirectionY(YDirectionType::Aligned);
-  
-  Coordinates *coord = f.getCoordinates();
+std::vector<Field3D> InvertParCR::solve(const std::vector<Field3D> &f,
+                                        const std::vector<Coefficients> &coefs) {
+  TRACE("InvertParCR::solve(vector<Field3D>)");
 
-  Field3D alignedField = toFieldAligned(f, "RGN_NOX");
+  if (f.size() != coefs.size()) {
+    throw BoutException("InvertParCR::solve: %d right hand sides but %d sets of coefficients",
+                        static_cast<int>(f.size()), static_cast<int>(coefs.size()));
+  }
 
-  // Create cyclic reduction object
-  auto cr = bout::utils::make_unique<CyclicReduce<dcomplex>>();
+  const int nset = f.size(); // Number of systems for each surface
+
+  std::vector<Field3D> result;
+  std::vector<Field3D> alignedField;
+  for (int i = 0; i < nset; i++) {
+    ASSERT1(localmesh == f[i].getMesh());
+    ASSERT1(location == f[i].getLocation());
+    result.push_back(emptyFrom(f[i]).setDirectionY(YDirectionType::Aligned));
+    alignedField.push_back(toFieldAligned(f[i], "RGN_NOX"));
+  }
+  if (nset == 0) {
+    return result;
+  }
 
-  // Find out if we are on a boundary
-  int size = localmesh->LocalNy - 2 * localmesh->ystart;
+  Coordinates *coord = f[0].getCoordinates();
+
+  // Find the rows for each flux surface, and whether it is on a boundary
+  std::vector<Surface> surfaces;
   SurfaceIter surf(localmesh);
   for (surf.first(); !surf.isDone(); surf.next()) {
-    int n = localmesh->LocalNy - 2 * localmesh->ystart;
-    if (!surf.closed()) {
-      // Open field line
-      if (surf.firstY()) {
+    Surface s;
+    s.x = surf.xpos;
+    s.closed = surf.closed(s.ts);
+    s.comm = surf.communicator();
+    s.firstY = surf.firstY();
+    s.lastY = surf.lastY();
+
+    // Number of rows
+    s.y0 = 0;
+    s.local_ystart = localmesh->ystart;
+    s.size = localmesh->LocalNy - 2 * localmesh->ystart; // If no boundaries
+    if (!s.closed) {
+      if (s.firstY) {
         if (location == CELL_YLOW) {
           // The 'boundary' includes the grid point at mesh->ystart
-          n += localmesh->ystart - 1;
+          s.y0 += localmesh->ystart;
+          s.size += localmesh->ystart - 1;
+          s.local_ystart = localmesh->ystart + 1;
         } else {
-          n += localmesh->ystart;
+          s.y0 += localmesh->ystart;
+          s.size += localmesh->ystart;
         }
       }
-      if (surf.lastY()) {
-        n += localmesh->ystart;
+      if (s.lastY) {
+        s.size += localmesh->ystart;
       }
+    }
+    surfaces.push_back(s);
+  }
 
-      if (n > size)
-        size = n; // Maximum size
+  // Group the surfaces which can be solved together: those with the
+  // same Y communicator and the same rows. All processors in a
+  // communicator have the same X range, so find the same groups
+  std::vector<std::vector<Surface>> groups;
+  for (const auto& s : surfaces) {
+    auto group = std::find_if(groups.begin(), groups.end(),
+                              [&s](const std::vector<Surface>& g) {
+                                return g[0].comm == s.comm && g[0].closed == s.closed
+                                       && g[0].y0 == s.y0
+                                       && g[0].local_ystart == s.local_ystart
+                                       && g[0].size == s.size;
+                              });
+    if (group == groups.end()) {
+      groups.push_back({s});
+    } else {
+      group->push_back(s);
     }
   }
 
-  auto rhs = Matrix<dcomplex>(localmesh->LocalNy, nsys);
-  auto rhsk = Matrix<dcomplex>(nsys, size);
-  auto xk = Matrix<dcomplex>(nsys, size);
-  auto a = Matrix<dcomplex>(nsys, size);
-  auto b = Matrix<dcomplex>(nsys, size);
-  auto c = Matrix<dcomplex>(nsys, size);
+  // Create cyclic reduction object
+  auto cr = bout::utils::make_unique<CyclicReduce<dcomplex>>();
 
-  // Loop over flux-surfaces
-  for (surf.first(); !surf.isDone(); surf.next()) {
-    int x = surf.xpos;
-    
-    // Test if open or closed field-lines
-    BoutReal ts;
-    bool closed = surf.closed(ts);
+  // Solve each group of flux-surfaces in one cyclic reduction, so the
+  // messages along Y are shared. Row (s * nset + i) * nsys + k is mode k
+  // of system i on surface s
+  for (const auto& group : groups) {
+    const int nsurf = group.size();
+    const int nrows = nsurf * nset * nsys;
+    const bool closed = group[0].closed;
+    const int y0 = group[0].y0;
+    const int local_ystart = group[0].local_ystart;
+    const int size = group[0].size;
+    const int ny = localmesh->LocalNy - localmesh->ystart - local_ystart; // Points in domain
 
-    // Number of rows
-    int y0 = 0;
-    int local_ystart = localmesh->ystart;
-    size = localmesh->LocalNy - 2 * localmesh->ystart; // If no boundaries
-    if (!closed) {
-      if (surf.firstY()) {
-        if (location == CELL_YLOW) {
-          // The 'boundary' includes the grid point at mesh->ystart
-          y0 += localmesh->ystart;
-          size += localmesh->ystart - 1;
-          local_ystart = localmesh->ystart + 1;
-        } else {
-          y0 += localmesh->ystart;
-          size += localmesh->ystart;
-        }
-      }
-      if (surf.lastY()) {
-        size += localmesh->ystart;
-      }
-    }
+    auto rhsk = Matrix<dcomplex>(nrows, size);
+    auto xk = Matrix<dcomplex>(nrows, size);
+    auto a = Matrix<dcomplex>(nrows, size);
+    auto b = Matrix<dcomplex>(nrows, size);
+    auto c = Matrix<dcomplex>(nrows, size);
 
-    // Setup CyclicReduce object
-    cr->setup(surf.communicator(), size);
-    cr->setPeriodic(closed);
-    
-    // Take Fourier transform
-    for (int y = 0; y < localmesh->LocalNy - localmesh->ystart - local_ystart; y++)
-      rfft(alignedField(x, y + local_ystart), localmesh->LocalNz, &rhs(y + y0, 0));
-
-    // Set up tridiagonal system
-    for (int k = 0; k < nsys; k++) {
-      BoutReal kwave=k*2.0*PI/coord->zlength(); // wave number is 1/length
-      for (int y = 0; y < localmesh->LocalNy - localmesh->ystart - local_ystart; y++) {
-
-        BoutReal acoef = A(x, y + local_ystart);                       // Constant
-        BoutReal bcoef =
-            B(x, y + local_ystart) / coord->g_22(x, y + local_ystart); // d2dy2
-        BoutReal ccoef = C(x, y + local_ystart);                       // d2dydz
-        BoutReal dcoef = D(x, y + local_ystart);                       // d2dz2
-        BoutReal ecoef =
-            E(x, y + local_ystart)
-            + sg(x, y + local_ystart)*B(x, y + local_ystart);          // ddy
-
-        if (coord->non_uniform) {
-          ecoef += bcoef * coord->d1_dy(x, y + local_ystart);
-        }
+    // Rank in the Y communicator, needed for twist-shift
+    int rank, np;
+    MPI_Comm_rank(group[0].comm, &rank);
+    MPI_Comm_size(group[0].comm, &np);
 
-        bcoef /= SQ(coord->dy(x, y + local_ystart));
-        ccoef /= coord->dy(x, y + local_ystart);
-        ecoef /= coord->dy(x, y + local_ystart);
+    BOUT_OMP(parallel) {
+      auto rhs = Array<dcomplex>(nsys); // FFT of one Y point
 
-        //           const       d2dy2        d2dydz              d2dz2           ddy
-        //           -----       -----        ------              -----           ---
-        a(k, y + y0) =           bcoef - 0.5 * Im * kwave * ccoef          - 0.5 * ecoef;
-        b(k, y + y0) = acoef - 2. * bcoef           - SQ(kwave) * dcoef;
-        c(k, y + y0) =           bcoef + 0.5 * Im * kwave * ccoef          + 0.5 * ecoef;
+      BOUT_OMP(for)
+      for (int ind = 0; ind < nsurf * nset; ind++) {
+        // ind = s * nset + i
+        const int s = ind / nset;
+        const int i = ind % nset;
+        const int x = group[s].x;
+        const Coefficients& coef = coefs[i];
 
-        rhsk(k, y + y0) = rhs(y + y0, k); // Transpose
-      }
-    }
+        // Set up tridiagonal system
+        for (int y = 0; y < ny; y++) {
+          // Take Fourier transform
+          rfft(alignedField[i](x, y + local_ystart), localmesh->LocalNz, std::begin(rhs));
 
-    if (closed) {
-      // Twist-shift
-      int rank, np;
-      MPI_Comm_rank(surf.communicator(), &rank);
-      MPI_Comm_size(surf.communicator(), &np);
-      if (rank == 0) {
-        for (int k = 0; k < nsys; k++) {
-          BoutReal kwave=k*2.0*PI/coord->zlength(); // wave number is 1/[rad]
-          dcomplex phase(cos(kwave*ts) , -sin(kwave*ts));
-          a(k, 0) *= phase;
-        }
-      }
-      if (rank == np - 1) {
-        for (int k = 0; k < nsys; k++) {
-          BoutReal kwave=k*2.0*PI/coord->zlength(); // wave number is 1/[rad]
-          dcomplex phase(cos(kwave*ts) , sin(kwave*ts));
-          c(k, localmesh->LocalNy - 2 * localmesh->ystart - 1) *= phase;
-        }
-      }
-    } else {
-      // Open surface, so may have boundaries
-      if (surf.firstY()) {
-        for (int k = 0; k < nsys; k++) {
-          for (int y = 0; y < localmesh->ystart; y++) {
-            a(k, y) = 0.;
-            b(k, y) = 1.;
-            c(k, y) = -1.;
-
-            rhsk(k, y) = 0.;
+          BoutReal acoef = coef.A(x, y + local_ystart);                       // Constant
+          BoutReal bcoef =
+              coef.B(x, y + local_ystart) / coord->g_22(x, y + local_ystart); // d2dy2
+          BoutReal ccoef = coef.C(x, y + local_ystart);                       // d2dydz
+          BoutReal dcoef = coef.D(x, y + local_ystart);                       // d2dz2
+          BoutReal ecoef =
+              coef.E(x, y + local_ystart)
+              + sg(x, y + local_ystart)*coef.B(x, y + local_ystart);          // ddy
+
+          if (coord->non_uniform) {
+            ecoef += bcoef * coord->d1_dy(x, y + local_ystart);
+          }
+
+          bcoef /= SQ(coord->dy(x, y + local_ystart));
+          ccoef /= coord->dy(x, y + local_ystart);
+          ecoef /= coord->dy(x, y + local_ystart);
+
+          for (int k = 0; k < nsys; k++) {
+            BoutReal kwave=k*2.0*PI/coord->zlength(); // wave number is 1/length
+            const int row = ind * nsys + k;
+
+            //           const       d2dy2        d2dydz              d2dz2           ddy
+            //           -----       -----        ------              -----           ---
+            a(row, y + y0) =           bcoef - 0.5 * Im * kwave * ccoef          - 0.5 * ecoef;
+            b(row, y + y0) = acoef - 2. * bcoef           - SQ(kwave) * dcoef;
+            c(row, y + y0) =           bcoef + 0.5 * Im * kwave * ccoef          + 0.5 * ecoef;
+
+            rhsk(row, y + y0) = rhs[k]; // Transpose
           }
         }
-      }
-      if (surf.lastY()) {
-        for (int k = 0; k < nsys; k++) {
-          for (int y = size - localmesh->ystart; y < size; y++) {
-            a(k, y) = -1.;
-            b(k, y) = 1.;
-            c(k, y) = 0.;
-
-            rhsk(k, y) = 0.;
+
+        if (closed) {
+          // Twist-shift
+          const BoutReal ts = group[s].ts;
+          if (rank == 0) {
+            for (int k = 0; k < nsys; k++) {
+              BoutReal kwave=k*2.0*PI/coord->zlength(); // wave number is 1/[rad]
+              dcomplex phase(cos(kwave*ts) , -sin(kwave*ts));
+              a(ind * nsys + k, 0) *= phase;
+            }
+          }
+          if (rank == np - 1) {
+            for (int k = 0; k < nsys; k++) {
+              BoutReal kwave=k*2.0*PI/coord->zlength(); // wave number is 1/[rad]
+              dcomplex phase(cos(kwave*ts) , sin(kwave*ts));
+              c(ind * nsys + k, localmesh->LocalNy - 2 * localmesh->ystart - 1) *= phase;
+            }
+          }
+        } else {
+          // Open surface, so may have boundaries
+          if (group[s].firstY) {
+            for (int k = 0; k < nsys; k++) {
+              for (int y = 0; y < localmesh->ystart; y++) {
+                a(ind * nsys + k, y) = 0.;
+                b(ind * nsys + k, y) = 1.;
+                c(ind * nsys + k, y) = -1.;
+
+                rhsk(ind * nsys + k, y) = 0.;
+              }
+            }
+          }
+          if (group[s].lastY) {
+            for (int k = 0; k < nsys; k++) {
+              for (int y = size - localmesh->ystart; y < size; y++) {
+                a(ind * nsys + k, y) = -1.;
+                b(ind * nsys + k, y) = 1.;
+                c(ind * nsys + k, y) = 0.;
+
+                rhsk(ind * nsys + k, y) = 0.;
+              }
+            }
           }
         }
       }
     }
 
-    // Solve cyclic tridiagonal system for each k
+    // Solve cyclic tridiagonal system for each surface, system and k
+    cr->setup(group[0].comm, size);
+    cr->setPeriodic(closed);
     cr->setCoefs(a, b, c);
     cr->solve(rhsk, xk);
 
-    // Put back into rhs array
-    for (int k = 0; k < nsys; k++) {
-      for (int y = 0; y < size; y++)
-        rhs(y, k) = xk(k, y);
-    }
+    BOUT_OMP(parallel) {
+      auto rhs = Array<dcomplex>(nsys);
 
-    // Inverse Fourier transform
-    for (int y = 0; y < size; y++)
-      irfft(&rhs(y, 0), localmesh->LocalNz, result(x, y + local_ystart - y0));
+      BOUT_OMP(for)
+      for (int ind = 0; ind < nsurf * nset; ind++) {
+        const int s = ind / nset;
+        const int i = ind % nset;
+
+        // Inverse Fourier transform
+        for (int y = 0; y < size; y++) {
+          for (int k = 0; k < nsys; k++) {
+            rhs[k] = xk(ind * nsys + k, y);
+          }
+          irfft(std::begin(rhs), localmesh->LocalNz,
+                result[i](group[s].x, y + local_ystart - y0));
+        }
+      }
+    }
   }
 
-  return fromFieldAligned(result, "RGN_NOBNDRY");
+  std::vector<Field3D> solution;
+  solution.reserve(nset);
+  for (const auto& field : result) {
+    solution.push_back(fromFieldAligned(field, "RGN_NOBNDRY"));
+  }
+  return solution;
 }
-
@@ -55,6 +55,11 @@ public:
   using InvertPar::solve;
   const Field3D solve(const Field3D &f) override;
 
+  /// All the systems are solved in one cyclic reduction for each
+  /// group of flux surfaces, so share the communication along Y
+  std::vector<Field3D> solve(const std::vector<Field3D> &f,
+                             const std::vector<Coefficients> &coefs) override;
+
   using InvertPar::setCoefA;
   void setCoefA(const Field2D &f) override {
     ASSERT1(localmesh == f.getMesh());
@@ -28,6 +28,7 @@
  ************************************************************************/
 
 #include <invert_parderiv.hxx>
+#include <boutexception.hxx>
 
 InvertPar* InvertPar::Create(Mesh* mesh_in) {
   return ParDerivFactory::getInstance()->createInvertPar(CELL_CENTRE, mesh_in);
@@ -41,3 +42,23 @@ const Field2D InvertPar::solve(const Field2D &f) {
 }
 
   
+
+std::vector<Field3D> InvertPar::solve(const std::vector<Field3D> &f,
+                                      const std::vector<Coefficients> &coefs) {
+  if (f.size() != coefs.size()) {
+    throw BoutException("InvertPar::solve: %d right hand sides but %d sets of coefficients",
+                        static_cast<int>(f.size()), static_cast<int>(coefs.size()));
+  }
+
+  std::vector<Field3D> result;
+  result.reserve(f.size());
+  for (std::size_t i = 0; i < f.size(); i++) {
+    setCoefA(coefs[i].A);
+    setCoefB(coefs[i].B);
+    setCoefC(coefs[i].C);
+    setCoefD(coefs[i].D);
+    setCoefE(coefs[i].E);
+    result.push_back(solve(f[i]));
+  }
+  return result;
+}
@@ -1190,8 +1190,14 @@ void Coordinates::setParallelTransform(Options* options) {
 
     fixZShiftGuards(zShift);
 
+    const auto zshift_method =
+        (*options)["zshift_method"]
+            .doc("How to shift in Z: fft, or interpolate with lagrange4pt, "
+                 "lagrange6pt or hermitespline")
+            .withDefault(ZShiftMethod::fft);
+
     transform = bout::utils::make_unique<ShiftedMetric>(*localmesh, location, zShift,
-        zlength());
+        zlength(), zshift_method);
 
   } else if (ptstr == "fci") {
 
@@ -1201,7 +1207,23 @@ void Coordinates::setParallelTransform(Options* options) {
 
     // Flux Coordinate Independent method
     const bool fci_zperiodic = Options::root()["fci"]["z_periodic"].withDefault(true);
-    transform = bout::utils::make_unique<FCITransform>(*localmesh, fci_zperiodic);
+    const bool fci_sparse =
+        Options::root()["fci"]["sparse_interpolation"]
+            .doc("Fold the interpolation into a sparse matrix when the maps are created")
+            .withDefault(false);
+    const bool fci_cache =
+        Options::root()["fci"]["cache"]
+            .doc("Read the FCI maps from a cache file if it matches the grid and "
+                 "processors, otherwise write it")
+            .withDefault(false);
+    const std::string fci_cache_file =
+        Options::root()["fci"]["cache_file"]
+            .doc("Name of the FCI map cache files, which have the processor number "
+                 "appended")
+            .withDefault(Options::root()["datadir"].withDefault<std::string>("data")
+                         + "/BOUT.fci_cache");
+    transform = bout::utils::make_unique<FCITransform>(
+        *localmesh, dy, fci_zperiodic, fci_sparse, fci_cache ? fci_cache_file : "");
 
   } else {
     throw BoutException(_("Unrecognised paralleltransform option.\n"
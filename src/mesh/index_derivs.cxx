@@ -21,11 +21,18 @@
  **************************************************************************/
 
 #include "bout/traits.hxx"
+#include <bout/coordinates.hxx>
 #include <bout/index_derivs.hxx>
 #include <bout/mesh.hxx>
+#include <bout/paralleltransform.hxx>
+#include <cyclic_reduction.hxx>
 #include <msg_stack.hxx>
 #include <unused.hxx>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 /*******************************************************************************
  * Helper routines
  *******************************************************************************/
@@ -544,6 +551,435 @@ produceCombinations<Set<WRAP_ENUM(DIRECTION, Z)>, Set<WRAP_ENUM(STAGGER, None)>,
     registerFFTDerivative(registerMethod{});
 #endif
 
+/////////////////////////////////////////////////////////////////////////////////////
+/// Compact (Padé) finite differences. These are implicit in the derivative, so
+/// each line in the derivative direction requires the solution of a tridiagonal
+/// system:
+///
+///   alpha * f'[i-1] + f'[i] + alpha * f'[i+1]
+///      = a * (f[i+1] - f[i-1]) / 2 + b * (f[i+2] - f[i-2]) / 4
+///
+/// and similarly for the second derivative. Coefficients are those of Lele,
+/// J. Comput. Phys. 103 (1992). All lines on this processor are batched into a
+/// single CyclicReduce solve, so lines split between processors are only
+/// coupled by one set of messages per derivative. The coefficients only depend
+/// on the layout of the lines, so the factorised solvers are kept and reused.
+///
+/// The first and last rows of each global line are closed with the explicit
+/// fourth-order central stencil, unless the line is periodic (X if
+/// Mesh::periodicX is set, closed flux surfaces in Y). Periodic lines in Y
+/// are joined with the twist-shift angle from Mesh::periodicY: field-aligned
+/// values at the end of the line are those at the start shifted in Z, so
+/// where the angle is non-zero the lines are solved for each Fourier mode in
+/// Z, with the phase shift in the coefficients which join the ends.
+///
+/// Fields with parallel slices (DIRECTION::YOrthogonal) are transformed to
+/// field-aligned coordinates and differentiated in Y, since every point on a
+/// line is coupled. This is not possible with FCI.
+/// Only X and Y are supported, as Z derivatives are better done with FFTs.
+/////////////////////////////////////////////////////////////////////////////////////
+
+template <DERIV derivType, int order>
+class CompactDerivativeType {
+public:
+  static_assert(derivType == DERIV::Standard || derivType == DERIV::StandardSecond,
+                "Compact derivatives only implemented for first and second derivatives");
+  static_assert(order == 4 || order == 6,
+                "Compact derivatives only implemented for 4th and 6th order");
+
+  template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
+  void standard(const T& var, T& result, const std::string& region) const {
+    AUTO_TRACE();
+    ASSERT2(meta.derivType == DERIV::Standard || meta.derivType == DERIV::StandardSecond);
+    ASSERT2(var.getMesh()->getNguard(direction) >= nGuards);
+    ASSERT2(direction == DIRECTION::X || direction == DIRECTION::Y
+            || direction == DIRECTION::YOrthogonal);
+    ASSERT2(stagger == STAGGER::None); // Staggering not currently supported
+
+    if (direction == DIRECTION::YOrthogonal) {
+      standardYOrthogonal<nGuards>(var, result, region);
+      return;
+    }
+
+    auto* theMesh = var.getMesh();
+
+    // Only allow regions which don't include guard cells in the derivative direction
+    const bool isX = (direction == DIRECTION::X);
+    if (!(region == "RGN_NOBNDRY" || region == (isX ? "RGN_NOX" : "RGN_NOY"))) {
+      throw BoutException("Compact derivative %s in direction %s does not support "
+                          "region %s",
+                          meta.key, toString(direction).c_str(), region.c_str());
+    }
+    // Transverse (x or y) range. Include guard cells unless excluded by the region
+    const bool transverseGuards = (region != "RGN_NOBNDRY");
+
+    const int nz = var.getNz();
+
+    if (isX) {
+      const int ylow = transverseGuards ? 0 : theMesh->ystart;
+      const int yhigh = transverseGuards ? theMesh->LocalNy - 1 : theMesh->yend;
+      solveLines<direction>(var, result, theMesh->getXcomm(), ylow, yhigh, nz,
+                            theMesh->xstart, theMesh->xend, theMesh->periodicX,
+                            std::vector<BoutReal>(yhigh - ylow + 1, 0.0));
+      return;
+    }
+
+    const int xlow = transverseGuards ? 0 : theMesh->xstart;
+    const int xhigh = transverseGuards ? theMesh->LocalNx - 1 : theMesh->xend;
+
+    // Y communicators depend on x (core/SOL/PF), so batch together runs of x
+    // which share the same communicator and periodicity
+    int x0 = xlow;
+    while (x0 <= xhigh) {
+      const MPI_Comm comm = theMesh->getYcomm(x0);
+      BoutReal ts = 0.0;
+      const bool periodic = theMesh->periodicY(x0, ts);
+      std::vector<BoutReal> twist{ts};
+      int x1 = x0;
+      while ((x1 < xhigh) && (theMesh->getYcomm(x1 + 1) == comm)) {
+        ts = 0.0;
+        if (theMesh->periodicY(x1 + 1, ts) != periodic) {
+          break;
+        }
+        twist.push_back(ts);
+        ++x1;
+      }
+      solveLines<direction>(var, result, comm, x0, x1, nz, theMesh->ystart,
+                            theMesh->yend, periodic, twist);
+      x0 = x1 + 1;
+    }
+  }
+
+  template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
+  void upwindOrFlux(const T& UNUSED(vel), const T& UNUSED(var), T& UNUSED(result),
+                    const std::string& UNUSED(region)) const {
+    AUTO_TRACE();
+    throw BoutException("The compact methods aren't available in upwind/Flux");
+  }
+
+  metaData meta{order == 4 ? "CP4" : "CP6", 2, derivType};
+
+private:
+  /// Off-diagonal coefficient of the implicit (left-hand) side
+  BoutReal alpha() const {
+    if (derivType == DERIV::Standard) {
+      return order == 4 ? 1. / 4. : 1. / 3.;
+    }
+    return order == 4 ? 1. / 10. : 2. / 11.;
+  }
+
+  /// Explicit (right-hand) side of the compact scheme
+  BoutReal compactRHS(const stencil& f) const {
+    if (derivType == DERIV::Standard) {
+      if (order == 4) {
+        return 1.5 * 0.5 * (f.p - f.m);
+      }
+      return (14. / 9.) * 0.5 * (f.p - f.m) + (1. / 9.) * 0.25 * (f.pp - f.mm);
+    }
+    if (order == 4) {
+      return 1.2 * (f.p - 2. * f.c + f.m);
+    }
+    return (12. / 11.) * (f.p - 2. * f.c + f.m)
+           + (3. / 11.) * 0.25 * (f.pp - 2. * f.c + f.mm);
+  }
+
+  /// Explicit 4th-order closure used at the ends of the global lines
+  BoutReal closureRHS(const stencil& f) const {
+    if (derivType == DERIV::Standard) {
+      return (8. * f.p - 8. * f.m + f.mm - f.pp) / 12.;
+    }
+    return (-f.pp + 16. * f.p - 30. * f.c + 16. * f.m - f.mm) / 12.;
+  }
+
+  /// Field2D has no variation in Z, so is already field-aligned
+  template <int nGuards>
+  void standardYOrthogonal(const Field2D& var, Field2D& result,
+                           const std::string& region) const {
+    standard<DIRECTION::Y, STAGGER::None, nGuards>(var, result, region);
+  }
+
+  /// Differentiate a field with parallel slices in field-aligned coordinates
+  template <int nGuards>
+  void standardYOrthogonal(const Field3D& var, Field3D& result,
+                           const std::string& region) const {
+    if (!var.getCoordinates()->getParallelTransform().canToFromFieldAligned()) {
+      throw BoutException("Compact derivative %s in Y needs field-aligned fields, so "
+                          "can't be used with FCI",
+                          meta.key);
+    }
+    Field3D var_noslices = var;
+    var_noslices.clearParallelSlices();
+    const Field3D var_aligned = toFieldAligned(var_noslices, "RGN_NOX");
+
+    Field3D result_aligned = emptyFrom(var_aligned);
+    standard<DIRECTION::Y, STAGGER::None, nGuards>(var_aligned, result_aligned, region);
+    result = fromFieldAligned(result_aligned, region);
+  }
+
+  /// Element of \p f on the line labelled by transverse index \p jt and \p jz,
+  /// at index \p i in the derivative direction
+  template <DIRECTION direction, typename T>
+  static BoutReal& element(T& f, int jt, int i, int jz) {
+    return (direction == DIRECTION::X) ? f(i, jt, jz) : f(jt, i, jz);
+  }
+  template <DIRECTION direction, typename T>
+  static const BoutReal& element(const T& f, int jt, int i, int jz) {
+    return (direction == DIRECTION::X) ? f(i, jt, jz) : f(jt, i, jz);
+  }
+
+  /// A factorised solver, and the layout of the lines it was made for
+  template <typename U>
+  struct CachedSolver {
+    int nrows;
+    bool periodic;
+    /// Coefficients joining the ends of periodic lines
+    std::vector<U> lower, upper;
+    std::shared_ptr<CyclicReduce<U>> cr;
+  };
+
+  /// The solvers made for one communicator, oldest first
+  template <typename U>
+  using SolverCache = std::vector<CachedSolver<U>>;
+
+  /// Most solvers kept for each communicator. Each layout of lines
+  /// (direction, region, twist) needs its own
+  static constexpr int max_cached_solvers = 16;
+
+  /// Free the solvers of a communicator when it is freed
+  template <typename U>
+  static int deleteSolverCache(MPI_Comm UNUSED(comm), int UNUSED(keyval),
+                               void* attribute, void* UNUSED(extra_state)) {
+    delete static_cast<SolverCache<U>*>(attribute);
+    return MPI_SUCCESS;
+  }
+
+  /// Key of the SolverCache attribute of communicators
+  template <typename U>
+  static int solverCacheKeyval() {
+    static const int keyval = [] {
+      int key;
+      MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, deleteSolverCache<U>, &key,
+                             nullptr);
+      return key;
+    }();
+    return keyval;
+  }
+
+  /// Get a solver for lines of \p nrows on this processor, coupled along
+  /// \p comm. If \p periodic, the first row of each line is coupled to the
+  /// last with coefficient \p lower, and the last to the first with \p upper.
+  /// Solvers are factorised once, and reused while the lines are unchanged.
+  /// They are stored as an attribute of \p comm, so they are freed with it
+  template <typename U>
+  std::shared_ptr<CyclicReduce<U>> getSolver(MPI_Comm comm, int nrows, bool periodic,
+                                             const std::vector<U>& lower,
+                                             const std::vector<U>& upper) const {
+    std::shared_ptr<CyclicReduce<U>> cached;
+    BOUT_OMP(critical(CompactDerivative_getSolver))
+    {
+      SolverCache<U>* solvers;
+      int found;
+      MPI_Comm_get_attr(comm, solverCacheKeyval<U>(), &solvers, &found);
+      if (found) {
+        for (const auto& solver : *solvers) {
+          if ((solver.nrows == nrows) && (solver.periodic == periodic)
+              && (solver.lower == lower) && (solver.upper == upper)) {
+            cached = solver.cr;
+            break;
+          }
+        }
+      }
+    }
+    if (cached) {
+      return cached;
+    }
+
+    int myproc, nprocs;
+    MPI_Comm_rank(comm, &myproc);
+    MPI_Comm_size(comm, &nprocs);
+
+    // Rows at the ends of non-periodic global lines use the explicit closure
+    const bool closeFirst = !periodic && (myproc == 0);
+    const bool closeLast = !periodic && (myproc == nprocs - 1);
+
+    const int nsys = lower.size();
+    const BoutReal alph = alpha();
+    Matrix<U> acoef(nsys, nrows), bcoef(nsys, nrows), ccoef(nsys, nrows);
+
+    BOUT_OMP(parallel for)
+    for (int sys = 0; sys < nsys; ++sys) {
+      for (int row = 0; row < nrows; ++row) {
+        bcoef(sys, row) = 1.0;
+        if ((closeFirst && (row == 0)) || (closeLast && (row == nrows - 1))) {
+          acoef(sys, row) = 0.0;
+          ccoef(sys, row) = 0.0;
+        } else {
+          acoef(sys, row) = alph;
+          ccoef(sys, row) = alph;
+        }
+      }
+      if (periodic && (myproc == 0)) {
+        acoef(sys, 0) = lower[sys];
+      }
+      if (periodic && (myproc == nprocs - 1)) {
+        ccoef(sys, nrows - 1) = upper[sys];
+      }
+    }
+
+    auto cr = std::make_shared<CyclicReduce<U>>(comm, nrows);
+    cr->setPeriodic(periodic);
+    cr->setCoefs(acoef, bcoef, ccoef);
+
+    BOUT_OMP(critical(CompactDerivative_getSolver))
+    {
+      SolverCache<U>* solvers;
+      int found;
+      MPI_Comm_get_attr(comm, solverCacheKeyval<U>(), &solvers, &found);
+      if (!found) {
+        solvers = new SolverCache<U>;
+        MPI_Comm_set_attr(comm, solverCacheKeyval<U>(), solvers);
+      }
+      if (static_cast<int>(solvers->size()) == max_cached_solvers) {
+        solvers->erase(solvers->begin());
+      }
+      solvers->push_back({nrows, periodic, lower, upper, cr});
+    }
+    return cr;
+  }
+
+  /// Solve the compact system on all lines with transverse index in
+  /// [tlow, thigh] and z index in [0, nz), over the rows [first, last]
+  /// of this processor. If \p periodic, the ends of each line are joined,
+  /// with a shift in Z by the angle in \p twist (one per transverse index)
+  template <DIRECTION direction, typename T>
+  void solveLines(const T& var, T& result, MPI_Comm comm, int tlow, int thigh, int nz,
+                  int first, int last, bool periodic,
+                  const std::vector<BoutReal>& twist) const {
+    const int nrows = last - first + 1;
+    if (nrows < 2) {
+      throw BoutException("Compact derivative %s needs at least two points per "
+                          "processor in direction %s",
+                          meta.key, toString(direction).c_str());
+    }
+    const int nt = thigh - tlow + 1;
+    ASSERT1(static_cast<int>(twist.size()) == nt);
+
+    int myproc, nprocs;
+    MPI_Comm_rank(comm, &myproc);
+    MPI_Comm_size(comm, &nprocs);
+
+    // Rows at the ends of non-periodic global lines use the explicit closure
+    const bool closeFirst = !periodic && (myproc == 0);
+    const bool closeLast = !periodic && (myproc == nprocs - 1);
+
+    Matrix<BoutReal> rhs(nt * nz, nrows);
+
+    BOUT_OMP(parallel for)
+    for (int sys = 0; sys < nt * nz; ++sys) {
+      const int jt = tlow + sys / nz;
+      const int jz = sys % nz;
+      for (int row = 0; row < nrows; ++row) {
+        const int i = first + row;
+        stencil s;
+        s.mm = element<direction>(var, jt, i - 2, jz);
+        s.m = element<direction>(var, jt, i - 1, jz);
+        s.c = element<direction>(var, jt, i, jz);
+        s.p = element<direction>(var, jt, i + 1, jz);
+        s.pp = element<direction>(var, jt, i + 2, jz);
+
+        if ((closeFirst && (row == 0)) || (closeLast && (row == nrows - 1))) {
+          rhs(sys, row) = closureRHS(s);
+        } else {
+          rhs(sys, row) = compactRHS(s);
+        }
+      }
+    }
+
+    const bool twisted =
+        periodic && (nz > 1)
+        && std::any_of(twist.begin(), twist.end(), [](BoutReal ts) { return ts != 0.0; });
+
+    if (!twisted) {
+      const std::vector<BoutReal> corner(nt * nz, periodic ? alpha() : 0.0);
+      Matrix<BoutReal> x(nt * nz, nrows);
+      getSolver<BoutReal>(comm, nrows, periodic, corner, corner)->solve(rhs, x);
+
+      BOUT_OMP(parallel for)
+      for (int sys = 0; sys < nt * nz; ++sys) {
+        const int jt = tlow + sys / nz;
+        const int jz = sys % nz;
+        for (int row = 0; row < nrows; ++row) {
+          element<direction>(result, jt, first + row, jz) = x(sys, row);
+        }
+      }
+      return;
+    }
+
+    // Solve for each Fourier mode in Z, so that the shift across the ends
+    // of the lines is a phase
+    const int nmodes = nz / 2 + 1;
+    const BoutReal kwaveFac = TWOPI / var.getCoordinates()->zlength();
+
+    Matrix<BoutReal> zlines(nt * nrows, nz);
+    BOUT_OMP(parallel for)
+    for (int sys = 0; sys < nt * nz; ++sys) {
+      const int it = sys / nz;
+      const int jz = sys % nz;
+      for (int row = 0; row < nrows; ++row) {
+        zlines(it * nrows + row, jz) = rhs(sys, row);
+      }
+    }
+    Matrix<dcomplex> zmodes(nt * nrows, nmodes);
+    bout::fft::rfft(&zlines(0, 0), nz, nt * nrows, &zmodes(0, 0));
+
+    Matrix<dcomplex> crhs(nt * nmodes, nrows), cx(nt * nmodes, nrows);
+    std::vector<dcomplex> lower(nt * nmodes), upper(nt * nmodes);
+    BOUT_OMP(parallel for)
+    for (int sys = 0; sys < nt * nmodes; ++sys) {
+      const int it = sys / nmodes;
+      const int kz = sys % nmodes;
+      for (int row = 0; row < nrows; ++row) {
+        crhs(sys, row) = zmodes(it * nrows + row, kz);
+      }
+      const BoutReal phase = kz * kwaveFac * twist[it];
+      lower[sys] = alpha() * dcomplex(cos(phase), -sin(phase));
+      upper[sys] = alpha() * dcomplex(cos(phase), sin(phase));
+    }
+
+    getSolver<dcomplex>(comm, nrows, periodic, lower, upper)->solve(crhs, cx);
+
+    BOUT_OMP(parallel for)
+    for (int sys = 0; sys < nt * nmodes; ++sys) {
+      const int it = sys / nmodes;
+      const int kz = sys % nmodes;
+      for (int row = 0; row < nrows; ++row) {
+        zmodes(it * nrows + row, kz) = cx(sys, row);
+      }
+    }
+    bout::fft::irfft(&zmodes(0, 0), nz, nt * nrows, &zlines(0, 0));
+
+    BOUT_OMP(parallel for)
+    for (int sys = 0; sys < nt * nz; ++sys) {
+      const int it = sys / nz;
+      const int jz = sys % nz;
+      for (int row = 0; row < nrows; ++row) {
+        element<direction>(result, tlow + it, first + row, jz) =
+            zlines(it * nrows + row, jz);
+      }
+    }
+  }
+};
+
+produceCombinations<Set<WRAP_ENUM(DIRECTION, X), WRAP_ENUM(DIRECTION, Y),
+                        WRAP_ENUM(DIRECTION, YOrthogonal)>,
+                    Set<WRAP_ENUM(STAGGER, None)>,
+                    Set<TypeContainer<Field3D>, TypeContainer<Field2D>>,
+                    Set<CompactDerivativeType<DERIV::Standard, 4>,
+                        CompactDerivativeType<DERIV::Standard, 6>,
+                        CompactDerivativeType<DERIV::StandardSecond, 4>,
+                        CompactDerivativeType<DERIV::StandardSecond, 6>>>
+    registerCompactDerivative(registerMethod{});
+
 class SplitFluxDerivativeType {
 public:
   template <DIRECTION direction, STAGGER stagger, int nGuards, typename T>
@@ -23,12 +23,16 @@
  *
  **************************************************************************/
 
+#include <bout/mesh.hxx>
 #include <globals.hxx>
 #include <interpolation.hxx>
 #include <msg_stack.hxx>
 #include <output.hxx>
 #include <unused.hxx>
 
+#include <istream>
+#include <ostream>
+
 void printLocation(const Field3D& var) {
   output << toString(var.getLocation());
 }
@@ -87,3 +91,35 @@ const Field3D interpolate(const Field2D &f, const Field3D &delta_x) {
   }
   return result;
 }
+
+void Interpolation::writeData(std::ostream& out,
+                              const std::vector<const Tensor<int>*>& indices,
+                              const std::vector<const Field3D*>& weights) {
+  for (const auto* tensor : indices) {
+    out.write(reinterpret_cast<const char*>(tensor->begin()),
+              tensor->getData().size() * sizeof(int));
+  }
+  for (const auto* field : weights) {
+    ASSERT1(field->isAllocated());
+    const Mesh* mesh = field->getMesh();
+    out.write(reinterpret_cast<const char*>(&(*field)(0, 0, 0)),
+              mesh->LocalNx * mesh->LocalNy * mesh->LocalNz * sizeof(BoutReal));
+  }
+}
+
+void Interpolation::readData(std::istream& in, const std::vector<Tensor<int>*>& indices,
+                             const std::vector<Field3D*>& weights) {
+  for (auto* tensor : indices) {
+    in.read(reinterpret_cast<char*>(tensor->begin()),
+            tensor->getData().size() * sizeof(int));
+  }
+  for (auto* field : weights) {
+    field->allocate();
+    const Mesh* mesh = field->getMesh();
+    in.read(reinterpret_cast<char*>(&(*field)(0, 0, 0)),
+            mesh->LocalNx * mesh->LocalNy * mesh->LocalNz * sizeof(BoutReal));
+  }
+  if (!in) {
+    throw BoutException("Interpolation: ran out of data reading the weights");
+  }
+}
@@ -22,9 +22,13 @@
 
 #include "globals.hxx"
 #include "interpolation.hxx"
+#include "bout/deriv_store.hxx"
+#include "bout/fieldgroup.hxx"
 #include "bout/index_derivs_interface.hxx"
 #include "bout/mesh.hxx"
+#include "bout/openmpwrap.hxx"
 
+#include <algorithm>
 #include <vector>
 
 HermiteSpline::HermiteSpline(int y_offset, Mesh *mesh)
@@ -49,61 +53,87 @@ HermiteSpline::HermiteSpline(int y_offset, Mesh *mesh)
 
 void HermiteSpline::calcWeights(const Field3D &delta_x, const Field3D &delta_z) {
 
-  BoutReal t_x, t_z;
+  const int xstart = localmesh->xstart;
+  const int xend = localmesh->xend;
+  const int ncz = localmesh->LocalNz;
+
+  // The corner of the cell containing the point at index i, and the
+  // normalised coordinates t_x, t_z within the cell
+  const auto findCorner = [&](const Ind3D& i, int& ic, int& kc, BoutReal& t_x,
+                              BoutReal& t_z) {
+    // The integer part of xt_prime, zt_prime are the indices of the cell
+    // containing the field line end-point
+    ic = static_cast<int>(floor(delta_x[i]));
+    kc = static_cast<int>(floor(delta_z[i]));
+
+    // t_x, t_z are the normalised coordinates \in [0,1) within the cell
+    // calculated by taking the remainder of the floating point index
+    t_x = delta_x[i] - static_cast<BoutReal>(ic);
+    t_z = delta_z[i] - static_cast<BoutReal>(kc);
+
+    // NOTE: A (small) hack to avoid one-sided differences
+    if (ic >= xend) {
+      ic = xend - 1;
+      t_x = 1.0;
+    }
+    if (ic < xstart) {
+      ic = xstart;
+      t_x = 0.0;
+    }
+  };
 
-  for (int x = localmesh->xstart; x <= localmesh->xend; x++) {
-    for (int y = localmesh->ystart; y <= localmesh->yend; y++) {
-      for (int z = 0; z < localmesh->LocalNz; z++) {
+  int* i_corner_data = i_corner.begin();
+  int* k_corner_data = k_corner.begin();
 
-        if (skip_mask(x, y, z))
-          continue;
+  // Can't throw inside the parallel loop, so remember the first point
+  // out of range and throw afterwards
+  int first_bad = -1;
 
-        // The integer part of xt_prime, zt_prime are the indices of the cell
-        // containing the field line end-point
-        i_corner(x, y, z) = static_cast<int>(floor(delta_x(x, y, z)));
-        k_corner(x, y, z) = static_cast<int>(floor(delta_z(x, y, z)));
+  BOUT_FOR(i, localmesh->getRegion3D("RGN_NOBNDRY")) {
+    if (skip_mask[i])
+      continue;
 
-        // t_x, t_z are the normalised coordinates \in [0,1) within the cell
-        // calculated by taking the remainder of the floating point index
-        t_x = delta_x(x, y, z) - static_cast<BoutReal>(i_corner(x, y, z));
-        t_z = delta_z(x, y, z) - static_cast<BoutReal>(k_corner(x, y, z));
+    int ic, kc;
+    BoutReal t_x, t_z;
+    findCorner(i, ic, kc, t_x, t_z);
 
-        // NOTE: A (small) hack to avoid one-sided differences
-        if (i_corner(x, y, z) >= localmesh->xend) {
-          i_corner(x, y, z) = localmesh->xend - 1;
-          t_x = 1.0;
-        }
-        if (i_corner(x, y, z) < localmesh->xstart) {
-          i_corner(x, y, z) = localmesh->xstart;
-          t_x = 0.0;
-        }
+    // Check that t_x and t_z are in range
+    if ((t_x < 0.0) || (t_x > 1.0) || (t_z < 0.0) || (t_z > 1.0)) {
+      BOUT_OMP(critical(HermiteSpline_calcWeights))
+      if ((first_bad < 0) || (i.ind < first_bad)) {
+        first_bad = i.ind;
+      }
+      continue;
+    }
 
-        // Check that t_x and t_z are in range
-        if ((t_x < 0.0) || (t_x > 1.0)) {
-          throw BoutException(
-              "t_x=%e out of range at (%d,%d,%d) (delta_x=%e, i_corner=%d)", t_x, x, y,
-              z, delta_x(x, y, z), i_corner(x, y, z));
-        }
+    i_corner_data[i.ind] = ic;
+    // z is periodic, so wrap the corner here rather than in interpolate
+    k_corner_data[i.ind] = ((kc % ncz) + ncz) % ncz;
 
-        if ((t_z < 0.0) || (t_z > 1.0)) {
-          throw BoutException(
-              "t_z=%e out of range at (%d,%d,%d) (delta_z=%e, k_corner=%d)", t_z, x, y,
-              z, delta_z(x, y, z), k_corner(x, y, z));
-        }
+    h00_x[i] = (2. * t_x * t_x * t_x) - (3. * t_x * t_x) + 1.;
+    h00_z[i] = (2. * t_z * t_z * t_z) - (3. * t_z * t_z) + 1.;
 
-        h00_x(x, y, z) = (2. * t_x * t_x * t_x) - (3. * t_x * t_x) + 1.;
-        h00_z(x, y, z) = (2. * t_z * t_z * t_z) - (3. * t_z * t_z) + 1.;
+    h01_x[i] = (-2. * t_x * t_x * t_x) + (3. * t_x * t_x);
+    h01_z[i] = (-2. * t_z * t_z * t_z) + (3. * t_z * t_z);
 
-        h01_x(x, y, z) = (-2. * t_x * t_x * t_x) + (3. * t_x * t_x);
-        h01_z(x, y, z) = (-2. * t_z * t_z * t_z) + (3. * t_z * t_z);
+    h10_x[i] = t_x * (1. - t_x) * (1. - t_x);
+    h10_z[i] = t_z * (1. - t_z) * (1. - t_z);
 
-        h10_x(x, y, z) = t_x * (1. - t_x) * (1. - t_x);
-        h10_z(x, y, z) = t_z * (1. - t_z) * (1. - t_z);
+    h11_x[i] = (t_x * t_x * t_x) - (t_x * t_x);
+    h11_z[i] = (t_z * t_z * t_z) - (t_z * t_z);
+  }
 
-        h11_x(x, y, z) = (t_x * t_x * t_x) - (t_x * t_x);
-        h11_z(x, y, z) = (t_z * t_z * t_z) - (t_z * t_z);
-      }
+  if (first_bad >= 0) {
+    const Ind3D i{first_bad, localmesh->LocalNy, ncz};
+    int ic, kc;
+    BoutReal t_x, t_z;
+    findCorner(i, ic, kc, t_x, t_z);
+    if ((t_x < 0.0) || (t_x > 1.0)) {
+      throw BoutException("t_x=%e out of range at (%d,%d,%d) (delta_x=%e, i_corner=%d)",
+                          t_x, i.x(), i.y(), i.z(), delta_x[i], ic);
     }
+    throw BoutException("t_z=%e out of range at (%d,%d,%d) (delta_z=%e, k_corner=%d)",
+                        t_z, i.x(), i.y(), i.z(), delta_z[i], kc);
   }
 }
 
@@ -113,67 +143,100 @@ void HermiteSpline::calcWeights(const Field3D &delta_x, const Field3D &delta_z,
 }
 
 Field3D HermiteSpline::interpolate(const Field3D &f) const {
+  // Not virtual: MonotonicHermiteSpline overrides interpolateFields
+  return HermiteSpline::interpolateFields({&f})[0];
+}
 
-  ASSERT1(f.getMesh() == localmesh);
-  Field3D f_interp{emptyFrom(f)};
-
-  // Derivatives are used for tension and need to be on dimensionless
-  // coordinates
-  Field3D fx = bout::derivatives::index::DDX(f, CELL_DEFAULT, "DEFAULT");
-  localmesh->communicateXZ(fx);
-  Field3D fz = bout::derivatives::index::DDZ(f, CELL_DEFAULT, "DEFAULT", "RGN_ALL");
-  localmesh->communicateXZ(fz);
-  Field3D fxz = bout::derivatives::index::DDX(fz, CELL_DEFAULT, "DEFAULT");
-  localmesh->communicateXZ(fxz);
-
-  for (int x = localmesh->xstart; x <= localmesh->xend; x++) {
-    for (int y = localmesh->ystart; y <= localmesh->yend; y++) {
-      for (int z = 0; z < localmesh->LocalNz; z++) {
+std::vector<Field3D>
+HermiteSpline::interpolateFields(const std::vector<const Field3D*>& fields) const {
+  const int nfields = fields.size();
+
+  // Derivatives of all the fields, as in interpolate(f), so that the
+  // communications can be combined
+  std::vector<Field3D> fx, fz, fxz;
+  fx.reserve(nfields);
+  fz.reserve(nfields);
+  fxz.reserve(nfields);
+  FieldGroup first_derivatives;
+  for (const auto* f : fields) {
+    ASSERT1(f->getMesh() == localmesh);
+    fx.push_back(bout::derivatives::index::DDX(*f, CELL_DEFAULT, "DEFAULT"));
+    fz.push_back(bout::derivatives::index::DDZ(*f, CELL_DEFAULT, "DEFAULT", "RGN_ALL"));
+    first_derivatives.add(fx.back(), fz.back());
+  }
+  localmesh->communicateXZ(first_derivatives);
 
-        if (skip_mask(x, y, z))
-          continue;
+  FieldGroup cross_derivatives;
+  for (const auto& f : fz) {
+    fxz.push_back(bout::derivatives::index::DDX(f, CELL_DEFAULT, "DEFAULT"));
+    cross_derivatives.add(fxz.back());
+  }
+  localmesh->communicateXZ(cross_derivatives);
+
+  std::vector<Field3D> result;
+  result.reserve(nfields);
+  std::vector<const BoutReal*> f_data(nfields), fx_data(nfields), fz_data(nfields),
+      fxz_data(nfields);
+  std::vector<BoutReal*> result_data(nfields);
+  for (int n = 0; n < nfields; ++n) {
+    result.push_back(emptyFrom(*fields[n]));
+    f_data[n] = &(*fields[n])(0, 0, 0);
+    fx_data[n] = &fx[n](0, 0, 0);
+    fz_data[n] = &fz[n](0, 0, 0);
+    fxz_data[n] = &fxz[n](0, 0, 0);
+    result_data[n] = &result[n](0, 0, 0);
+  }
 
-        // Due to lack of guard cells in z-direction, we need to ensure z-index
-        // wraps around
-        int ncz = localmesh->LocalNz;
-        int z_mod = ((k_corner(x, y, z) % ncz) + ncz) % ncz;
-        int z_mod_p1 = (z_mod + 1) % ncz;
-
-        int y_next = y + y_offset;
-
-        // Interpolate f in X at Z
-        BoutReal f_z = f(i_corner(x, y, z), y_next, z_mod) * h00_x(x, y, z) +
-                       f(i_corner(x, y, z) + 1, y_next, z_mod) * h01_x(x, y, z) +
-                       fx(i_corner(x, y, z), y_next, z_mod) * h10_x(x, y, z) +
-                       fx(i_corner(x, y, z) + 1, y_next, z_mod) * h11_x(x, y, z);
-
-        // Interpolate f in X at Z+1
-        BoutReal f_zp1 = f(i_corner(x, y, z), y_next, z_mod_p1) * h00_x(x, y, z) +
-                         f(i_corner(x, y, z) + 1, y_next, z_mod_p1) * h01_x(x, y, z) +
-                         fx(i_corner(x, y, z), y_next, z_mod_p1) * h10_x(x, y, z) +
-                         fx(i_corner(x, y, z) + 1, y_next, z_mod_p1) * h11_x(x, y, z);
-
-        // Interpolate fz in X at Z
-        BoutReal fz_z = fz(i_corner(x, y, z), y_next, z_mod) * h00_x(x, y, z) +
-                        fz(i_corner(x, y, z) + 1, y_next, z_mod) * h01_x(x, y, z) +
-                        fxz(i_corner(x, y, z), y_next, z_mod) * h10_x(x, y, z) +
-                        fxz(i_corner(x, y, z) + 1, y_next, z_mod) * h11_x(x, y, z);
-
-        // Interpolate fz in X at Z+1
-        BoutReal fz_zp1 = fz(i_corner(x, y, z), y_next, z_mod_p1) * h00_x(x, y, z) +
-                          fz(i_corner(x, y, z) + 1, y_next, z_mod_p1) * h01_x(x, y, z) +
-                          fxz(i_corner(x, y, z), y_next, z_mod_p1) * h10_x(x, y, z) +
-                          fxz(i_corner(x, y, z) + 1, y_next, z_mod_p1) * h11_x(x, y, z);
-
-        // Interpolate in Z
-        f_interp(x, y_next, z) = +f_z * h00_z(x, y, z) + f_zp1 * h01_z(x, y, z) +
-                                 fz_z * h10_z(x, y, z) + fz_zp1 * h11_z(x, y, z);
-
-        ASSERT2(finite(f_interp(x, y_next, z)));
-      }
+  const int ny = localmesh->LocalNy;
+  const int ncz = localmesh->LocalNz;
+  // Offsets of the next corner in X, and of the result from the point
+  const int x_stride = ny * ncz;
+  const int y_stride = y_offset * ncz;
+
+  const int* i_corner_data = i_corner.begin();
+  const int* k_corner_data = k_corner.begin();
+
+  // Read the indices and weights of each point once, and apply them to all fields
+  BOUT_FOR(i, localmesh->getRegion3D("RGN_NOBNDRY")) {
+    if (skip_mask[i])
+      continue;
+
+    // Flat indices of the corners. k_corner is already wrapped into [0, ncz)
+    const int z_mod = k_corner_data[i.ind];
+    const int z_mod_p1 = (z_mod + 1 == ncz) ? 0 : z_mod + 1;
+    const int ic = (i_corner_data[i.ind] * ny + i.y()) * ncz + y_stride;
+    const int i_z = ic + z_mod, i_zp1 = ic + z_mod_p1;
+    const int ip1_z = i_z + x_stride, ip1_zp1 = i_zp1 + x_stride;
+    const int i_result = i.ind + y_stride;
+
+    const BoutReal w00_x = h00_x[i], w01_x = h01_x[i];
+    const BoutReal w10_x = h10_x[i], w11_x = h11_x[i];
+    const BoutReal w00_z = h00_z[i], w01_z = h01_z[i];
+    const BoutReal w10_z = h10_z[i], w11_z = h11_z[i];
+
+    for (int n = 0; n < nfields; ++n) {
+      const BoutReal* f = f_data[n];
+      const BoutReal* f_x = fx_data[n];
+      const BoutReal* f_z = fz_data[n];
+      const BoutReal* f_xz = fxz_data[n];
+
+      // Interpolate in X at Z and Z+1, then in Z
+      const BoutReal f_at_z =
+          f[i_z] * w00_x + f[ip1_z] * w01_x + f_x[i_z] * w10_x + f_x[ip1_z] * w11_x;
+      const BoutReal f_at_zp1 = f[i_zp1] * w00_x + f[ip1_zp1] * w01_x
+                                + f_x[i_zp1] * w10_x + f_x[ip1_zp1] * w11_x;
+      const BoutReal fz_at_z = f_z[i_z] * w00_x + f_z[ip1_z] * w01_x
+                               + f_xz[i_z] * w10_x + f_xz[ip1_z] * w11_x;
+      const BoutReal fz_at_zp1 = f_z[i_zp1] * w00_x + f_z[ip1_zp1] * w01_x
+                                 + f_xz[i_zp1] * w10_x + f_xz[ip1_zp1] * w11_x;
+
+      result_data[n][i_result] =
+          +f_at_z * w00_z + f_at_zp1 * w01_z + fz_at_z * w10_z + fz_at_zp1 * w11_z;
+
+      ASSERT2(finite(result_data[n][i_result]));
     }
   }
-  return f_interp;
+  return result;
 }
 
 Field3D HermiteSpline::interpolate(const Field3D& f, const Field3D &delta_x, const Field3D &delta_z) {
@@ -185,3 +248,96 @@ Field3D HermiteSpline::interpolate(const Field3D& f, const Field3D &delta_x, con
   calcWeights(delta_x, delta_z, mask);
   return interpolate(f);
 }
+
+namespace {
+/// Weights of the first derivative \p method, which must be linear,
+/// at offsets from -half width to +half width
+std::vector<BoutReal> derivativeWeights(const std::string& method) {
+  if (method == "C2") {
+    return {-0.5, 0., 0.5};
+  }
+  if (method == "C4") {
+    return {1. / 12., -8. / 12., 0., 8. / 12., -1. / 12.};
+  }
+  throw BoutException("HermiteSpline::getMatrix needs the default first derivatives to "
+                      "be C2 or C4, not %s",
+                      method.c_str());
+}
+
+/// Weights of a 1D cubic Hermite spline with basis functions \p h00,
+/// \p h01, \p h10, \p h11, where the derivatives are calculated
+/// with \p deriv. \p weights are for offsets from (-half width) to
+/// (1 + half width) from the corner
+void splineWeights(BoutReal h00, BoutReal h01, BoutReal h10, BoutReal h11,
+                   const std::vector<BoutReal>& deriv, std::vector<BoutReal>& weights) {
+  const int half_width = deriv.size() / 2;
+
+  std::fill(weights.begin(), weights.end(), 0.0);
+  weights[half_width] += h00;
+  weights[half_width + 1] += h01;
+  for (std::size_t j = 0; j < deriv.size(); ++j) {
+    weights[j] += h10 * deriv[j];
+    weights[j + 1] += h11 * deriv[j];
+  }
+}
+} // namespace
+
+InterpolationMatrix HermiteSpline::getMatrix() const {
+  TRACE("HermiteSpline::getMatrix");
+
+  // The interpolation is separable: the weights are the product of
+  // the 1D spline weights in X and Z, which include the derivatives
+  const auto& store = DerivativeStore<Field3D>::getInstance();
+  const auto deriv_x = derivativeWeights(store.getDefaultMethod(DIRECTION::X));
+  const auto deriv_z = derivativeWeights(store.getDefaultMethod(DIRECTION::Z));
+  const int half_x = deriv_x.size() / 2;
+  const int half_z = deriv_z.size() / 2;
+
+  std::vector<BoutReal> weights_x(deriv_x.size() + 1), weights_z(deriv_z.size() + 1);
+  const int width = weights_x.size() * weights_z.size();
+  std::vector<int> columns(width);
+  std::vector<BoutReal> weights(width);
+
+  InterpolationMatrix result(width);
+
+  const int ny = localmesh->LocalNy;
+  const int nz = localmesh->LocalNz;
+
+  for (int x = localmesh->xstart; x <= localmesh->xend; x++) {
+    for (int y = localmesh->ystart; y <= localmesh->yend; y++) {
+      for (int z = 0; z < nz; z++) {
+
+        if (skip_mask(x, y, z))
+          continue;
+
+        const int i = i_corner(x, y, z);
+        if ((i - half_x < 0) || (i + 1 + half_x >= localmesh->LocalNx)) {
+          throw BoutException("HermiteSpline::getMatrix: not enough X guard cells for "
+                              "the derivatives at (%d,%d,%d)",
+                              x, y, z);
+        }
+        const int k = ((k_corner(x, y, z) % nz) + nz) % nz;
+        const int y_next = y + y_offset;
+
+        splineWeights(h00_x(x, y, z), h01_x(x, y, z), h10_x(x, y, z), h11_x(x, y, z),
+                      deriv_x, weights_x);
+        splineWeights(h00_z(x, y, z), h01_z(x, y, z), h10_z(x, y, z), h11_z(x, y, z),
+                      deriv_z, weights_z);
+
+        int n = 0;
+        for (std::size_t a = 0; a < weights_x.size(); ++a) {
+          const int x_col = i - half_x + a;
+          for (std::size_t b = 0; b < weights_z.size(); ++b) {
+            // z is periodic, so wrap around
+            const int z_col = (((k - half_z + static_cast<int>(b)) % nz) + nz) % nz;
+            columns[n] = (x_col * ny + y_next) * nz + z_col;
+            weights[n] = weights_x[a] * weights_z[b];
+            ++n;
+          }
+        }
+        result.addRow((x * ny + y_next) * nz + z, columns.data(), weights.data());
+      }
+    }
+  }
+  return result;
+}
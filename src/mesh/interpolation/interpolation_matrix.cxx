@@ -0,0 +1,98 @@
+/**************************************************************************
+ * Sparse matrix form of linear interpolations
+ *
+ **************************************************************************
+ * This file is part of BOUT++.
+ *
+ * BOUT++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * BOUT++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with BOUT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **************************************************************************/
+
+#include "interpolation.hxx"
+#include "msg_stack.hxx"
+#include "bout/openmpwrap.hxx"
+
+void InterpolationMatrix::addRow(int index, const int* row_columns,
+                                 const BoutReal* row_weights) {
+  rows.push_back(index);
+  columns.insert(columns.end(), row_columns, row_columns + width);
+  weights.insert(weights.end(), row_weights, row_weights + width);
+}
+
+Field3D InterpolationMatrix::apply(const Field3D& f) const {
+  TRACE("InterpolationMatrix::apply");
+
+  ASSERT1(f.isAllocated());
+
+  Field3D result{emptyFrom(f)};
+
+  const BoutReal* in = &f(0, 0, 0);
+  BoutReal* out = &result(0, 0, 0);
+
+  const int nrows = size();
+  const int* row_columns = columns.data();
+  const BoutReal* row_weights = weights.data();
+
+  BOUT_OMP(parallel for schedule(static))
+  for (int row = 0; row < nrows; ++row) {
+    const int* col = row_columns + row * width;
+    const BoutReal* w = row_weights + row * width;
+
+    BoutReal sum = 0.0;
+    for (int j = 0; j < width; ++j) {
+      sum += w[j] * in[col[j]];
+    }
+    out[rows[row]] = sum;
+  }
+
+  return result;
+}
+
+std::vector<Field3D>
+InterpolationMatrix::apply(const std::vector<const Field3D*>& fields) const {
+  TRACE("InterpolationMatrix::apply");
+
+  const int nfields = fields.size();
+  std::vector<Field3D> result;
+  result.reserve(nfields);
+  std::vector<const BoutReal*> in(nfields);
+  std::vector<BoutReal*> out(nfields);
+  for (int n = 0; n < nfields; ++n) {
+    ASSERT1(fields[n]->isAllocated());
+    result.push_back(emptyFrom(*fields[n]));
+    in[n] = &(*fields[n])(0, 0, 0);
+    out[n] = &result[n](0, 0, 0);
+  }
+
+  const int nrows = size();
+  const int* row_columns = columns.data();
+  const BoutReal* row_weights = weights.data();
+
+  BOUT_OMP(parallel for schedule(static))
+  for (int row = 0; row < nrows; ++row) {
+    const int* col = row_columns + row * width;
+    const BoutReal* w = row_weights + row * width;
+
+    for (int n = 0; n < nfields; ++n) {
+      const BoutReal* f = in[n];
+      BoutReal sum = 0.0;
+      for (int j = 0; j < width; ++j) {
+        sum += w[j] * f[col[j]];
+      }
+      out[n][rows[row]] = sum;
+    }
+  }
+
+  return result;
+}
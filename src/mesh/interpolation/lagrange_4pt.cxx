@@ -23,6 +23,7 @@
 #include "bout/mesh.hxx"
 #include "globals.hxx"
 #include "interpolation.hxx"
+#include "bout/openmpwrap.hxx"
 
 #include <vector>
 
@@ -39,42 +40,72 @@ Lagrange4pt::Lagrange4pt(int y_offset, Mesh *mesh)
 
 void Lagrange4pt::calcWeights(const Field3D &delta_x, const Field3D &delta_z) {
 
-  for (int x = localmesh->xstart; x <= localmesh->xend; x++) {
-    for (int y = localmesh->ystart; y <= localmesh->yend; y++) {
-      for (int z = 0; z < localmesh->LocalNz; z++) {
-
-        if (skip_mask(x, y, z))
-          continue;
-
-        // The integer part of xt_prime, zt_prime are the indices of the cell
-        // containing the field line end-point
-        i_corner(x, y, z) = static_cast<int>(floor(delta_x(x, y, z)));
-        k_corner(x, y, z) = static_cast<int>(floor(delta_z(x, y, z)));
-
-        // t_x, t_z are the normalised coordinates \in [0,1) within the cell
-        // calculated by taking the remainder of the floating point index
-        t_x(x, y, z) = delta_x(x, y, z) - static_cast<BoutReal>(i_corner(x, y, z));
-        t_z(x, y, z) = delta_z(x, y, z) - static_cast<BoutReal>(k_corner(x, y, z));
-
-        // NOTE: A (small) hack to avoid one-sided differences
-        if (i_corner(x, y, z) == localmesh->xend) {
-          i_corner(x, y, z) -= 1;
-          t_x(x, y, z) = 1.0;
-        }
-
-        // Check that t_x and t_z are in range
-        if ((t_x(x, y, z) < 0.0) || (t_x(x, y, z) > 1.0)) {
-          throw BoutException(
-            "t_x=%e out of range at (%d,%d,%d) (delta_x=%e, i_corner=%d)", t_x(x, y, z), x, y,
-              z, delta_x(x, y, z), i_corner(x, y, z));
-        }
-        if ((t_z(x, y, z) < 0.0) || (t_z(x, y, z) > 1.0)) {
-          throw BoutException(
-            "t_z=%e out of range at (%d,%d,%d) (delta_z=%e, k_corner=%d)", t_z(x, y, z), x, y,
-              z, delta_z(x, y, z), k_corner(x, y, z));
-        }
+  const int xend = localmesh->xend;
+  const int ncz = localmesh->LocalNz;
+
+  // The corner of the cell containing the point at index i, and the
+  // normalised coordinates t_x, t_z within the cell
+  const auto findCorner = [&](const Ind3D& i, int& ic, int& kc, BoutReal& tx,
+                              BoutReal& tz) {
+    // The integer part of xt_prime, zt_prime are the indices of the cell
+    // containing the field line end-point
+    ic = static_cast<int>(floor(delta_x[i]));
+    kc = static_cast<int>(floor(delta_z[i]));
+
+    // t_x, t_z are the normalised coordinates \in [0,1) within the cell
+    // calculated by taking the remainder of the floating point index
+    tx = delta_x[i] - static_cast<BoutReal>(ic);
+    tz = delta_z[i] - static_cast<BoutReal>(kc);
+
+    // NOTE: A (small) hack to avoid one-sided differences
+    if (ic == xend) {
+      ic -= 1;
+      tx = 1.0;
+    }
+  };
+
+  int* i_corner_data = i_corner.begin();
+  int* k_corner_data = k_corner.begin();
+
+  // Can't throw inside the parallel loop, so remember the first point
+  // out of range and throw afterwards
+  int first_bad = -1;
+
+  BOUT_FOR(i, localmesh->getRegion3D("RGN_NOBNDRY")) {
+    if (skip_mask[i])
+      continue;
+
+    int ic, kc;
+    BoutReal tx, tz;
+    findCorner(i, ic, kc, tx, tz);
+
+    // Check that t_x and t_z are in range
+    if ((tx < 0.0) || (tx > 1.0) || (tz < 0.0) || (tz > 1.0)) {
+      BOUT_OMP(critical(Lagrange4pt_calcWeights))
+      if ((first_bad < 0) || (i.ind < first_bad)) {
+        first_bad = i.ind;
       }
+      continue;
     }
+
+    i_corner_data[i.ind] = ic;
+    // z is periodic, so wrap the corner here rather than in interpolate
+    k_corner_data[i.ind] = ((kc % ncz) + ncz) % ncz;
+    t_x[i] = tx;
+    t_z[i] = tz;
+  }
+
+  if (first_bad >= 0) {
+    const Ind3D i{first_bad, localmesh->LocalNy, ncz};
+    int ic, kc;
+    BoutReal tx, tz;
+    findCorner(i, ic, kc, tx, tz);
+    if ((tx < 0.0) || (tx > 1.0)) {
+      throw BoutException("t_x=%e out of range at (%d,%d,%d) (delta_x=%e, i_corner=%d)",
+                          tx, i.x(), i.y(), i.z(), delta_x[i], ic);
+    }
+    throw BoutException("t_z=%e out of range at (%d,%d,%d) (delta_z=%e, k_corner=%d)",
+                        tz, i.x(), i.y(), i.z(), delta_z[i], kc);
   }
 }
 
@@ -89,52 +120,46 @@ Field3D Lagrange4pt::interpolate(const Field3D &f) const {
   ASSERT1(f.getMesh() == localmesh);
   Field3D f_interp{emptyFrom(f)};
 
-  for (int x = localmesh->xstart; x <= localmesh->xend; x++) {
-    for (int y = localmesh->ystart; y <= localmesh->yend; y++) {
-      for (int z = 0; z < localmesh->LocalNz; z++) {
-
-        if (skip_mask(x, y, z))
-          continue;
-
-        int jx = i_corner(x, y, z);
-        int jx2mnew = (jx == 0) ? 0 : (jx - 1);
-        int jxpnew = jx + 1;
-        int jx2pnew = (jx == (localmesh->LocalNx - 2)) ? jxpnew : (jxpnew + 1);
-
-        int ncz = localmesh->LocalNz;
-
-        // Get the 4 Z points
-        int jz = ((k_corner(x, y, z) % ncz) + ncz) % ncz;
-
-        int jzpnew = (jz + 1) % ncz;
-        int jz2pnew = (jz + 2) % ncz;
-        int jz2mnew = (jz - 1 + ncz) % ncz;
-
-        // Interpolate in Z first
-        BoutReal xvals[4];
-
-        int y_next = y + y_offset;
-
-        xvals[0] = lagrange_4pt(f(jx2mnew, y_next, jz2mnew), f(jx2mnew, y_next, jz),
-                                f(jx2mnew, y_next, jzpnew), f(jx2mnew, y_next, jz2pnew),
-                                t_z(x, y, z));
-
-        xvals[1] =
-            lagrange_4pt(f(jx, y_next, jz2mnew), f(jx, y_next, jz), f(jx, y_next, jzpnew),
-                         f(jx, y_next, jz2pnew), t_z(x, y, z));
-
-        xvals[2] = lagrange_4pt(f(jxpnew, y_next, jz2mnew), f(jxpnew, y_next, jz),
-                                f(jxpnew, y_next, jzpnew), f(jxpnew, y_next, jz2pnew),
-                                t_z(x, y, z));
-
-        xvals[3] = lagrange_4pt(f(jx2pnew, y_next, jz2mnew), f(jx2pnew, y_next, jz),
-                                f(jx2pnew, y_next, jzpnew), f(jx2pnew, y_next, jz2pnew),
-                                t_z(x, y, z));
-
-        // Then in X
-        f_interp(x, y_next, z) = lagrange_4pt(xvals, t_x(x, y, z));
-      }
+  const int nx = localmesh->LocalNx;
+  const int ny = localmesh->LocalNy;
+  const int ncz = localmesh->LocalNz;
+  const int y_stride = y_offset * ncz;
+
+  const int* i_corner_data = i_corner.begin();
+  const int* k_corner_data = k_corner.begin();
+  const BoutReal* f_data = &f(0, 0, 0);
+  BoutReal* result_data = &f_interp(0, 0, 0);
+
+  BOUT_FOR(i, localmesh->getRegion3D("RGN_NOBNDRY")) {
+    if (skip_mask[i])
+      continue;
+
+    // Start of the four X columns at the next y, as flat indices
+    const int jx = i_corner_data[i.ind];
+    const int jx2mnew = (jx == 0) ? 0 : (jx - 1);
+    const int jxpnew = jx + 1;
+    const int jx2pnew = (jx == (nx - 2)) ? jxpnew : (jxpnew + 1);
+
+    const int y_next = i.y() * ncz + y_stride;
+    const int columns[4] = {jx2mnew * ny * ncz + y_next, jx * ny * ncz + y_next,
+                            jxpnew * ny * ncz + y_next, jx2pnew * ny * ncz + y_next};
+
+    // Get the 4 Z points. k_corner is already wrapped into [0, ncz)
+    const int jz = k_corner_data[i.ind];
+    const int jzpnew = (jz + 1) % ncz;
+    const int jz2pnew = (jz + 2) % ncz;
+    const int jz2mnew = (jz - 1 + ncz) % ncz;
+
+    // Interpolate in Z first
+    BoutReal xvals[4];
+    for (int n = 0; n < 4; n++) {
+      const BoutReal* column = f_data + columns[n];
+      xvals[n] = lagrange_4pt(column[jz2mnew], column[jz], column[jzpnew],
+                              column[jz2pnew], t_z[i]);
     }
+
+    // Then in X
+    result_data[i.ind + y_stride] = lagrange_4pt(xvals, t_x[i]);
   }
   return f_interp;
 }
@@ -42,81 +42,75 @@ Field3D MonotonicHermiteSpline::interpolate(const Field3D &f) const {
   Field3D fxz = bout::derivatives::index::DDX(fz, CELL_DEFAULT, "DEFAULT");
   localmesh->communicateXZ(fxz);
 
-  for (int x = localmesh->xstart; x <= localmesh->xend; x++) {
-    for (int y = localmesh->ystart; y <= localmesh->yend; y++) {
-      for (int z = 0; z < localmesh->LocalNz; z++) {
-
-        if (skip_mask(x, y, z))
-          continue;
-
-        // Due to lack of guard cells in z-direction, we need to ensure z-index
-        // wraps around
-        int ncz = localmesh->LocalNz;
-        int z_mod = ((k_corner(x, y, z) % ncz) + ncz) % ncz;
-        int z_mod_p1 = (z_mod + 1) % ncz;
-
-        int y_next = y + y_offset;
-
-        // Interpolate f in X at Z
-        BoutReal f_z = f(i_corner(x, y, z), y_next, z_mod) * h00_x(x, y, z) +
-                       f(i_corner(x, y, z) + 1, y_next, z_mod) * h01_x(x, y, z) +
-                       fx(i_corner(x, y, z), y_next, z_mod) * h10_x(x, y, z) +
-                       fx(i_corner(x, y, z) + 1, y_next, z_mod) * h11_x(x, y, z);
-
-        // Interpolate f in X at Z+1
-        BoutReal f_zp1 = f(i_corner(x, y, z), y_next, z_mod_p1) * h00_x(x, y, z) +
-                         f(i_corner(x, y, z) + 1, y_next, z_mod_p1) * h01_x(x, y, z) +
-                         fx(i_corner(x, y, z), y_next, z_mod_p1) * h10_x(x, y, z) +
-                         fx(i_corner(x, y, z) + 1, y_next, z_mod_p1) * h11_x(x, y, z);
-
-        // Interpolate fz in X at Z
-        BoutReal fz_z = fz(i_corner(x, y, z), y_next, z_mod) * h00_x(x, y, z) +
-                        fz(i_corner(x, y, z) + 1, y_next, z_mod) * h01_x(x, y, z) +
-                        fxz(i_corner(x, y, z), y_next, z_mod) * h10_x(x, y, z) +
-                        fxz(i_corner(x, y, z) + 1, y_next, z_mod) * h11_x(x, y, z);
-
-        // Interpolate fz in X at Z+1
-        BoutReal fz_zp1 = fz(i_corner(x, y, z), y_next, z_mod_p1) * h00_x(x, y, z) +
-                          fz(i_corner(x, y, z) + 1, y_next, z_mod_p1) * h01_x(x, y, z) +
-                          fxz(i_corner(x, y, z), y_next, z_mod_p1) * h10_x(x, y, z) +
-                          fxz(i_corner(x, y, z) + 1, y_next, z_mod_p1) * h11_x(x, y, z);
-
-        // Interpolate in Z
-        BoutReal result = +f_z * h00_z(x, y, z) + f_zp1 * h01_z(x, y, z) +
-                           fz_z * h10_z(x, y, z) + fz_zp1 * h11_z(x, y, z);
-
-        ASSERT2(finite(result));
-
-        // Monotonicity
-        // Force the interpolated result to be in the range of the
-        // neighbouring cell values. This prevents unphysical overshoots,
-        // but also degrades accuracy near maxima and minima.
-        // Perhaps should only impose near boundaries, since that is where
-        // problems most obviously occur.
-        BoutReal localmax = BOUTMAX(f(i_corner(x, y, z), y_next, z_mod),
-                                    f(i_corner(x, y, z)+1, y_next, z_mod),
-                                    f(i_corner(x, y, z), y_next, z_mod_p1),
-                                    f(i_corner(x, y, z)+1, y_next, z_mod_p1));
-
-        BoutReal localmin = BOUTMIN(f(i_corner(x, y, z), y_next, z_mod),
-                                    f(i_corner(x, y, z)+1, y_next, z_mod),
-                                    f(i_corner(x, y, z), y_next, z_mod_p1),
-                                    f(i_corner(x, y, z)+1, y_next, z_mod_p1));
-
-        ASSERT2(finite(localmax));
-        ASSERT2(finite(localmin));
-        
-        if (result > localmax) {
-          result = localmax;
-        }
-        if (result < localmin) {
-          result = localmin;
-        }
-
-        f_interp(x, y_next, z) = result;
-        
-      }
+  const int ny = localmesh->LocalNy;
+  const int ncz = localmesh->LocalNz;
+  const int x_stride = ny * ncz;
+  const int y_stride = y_offset * ncz;
+
+  const int* i_corner_data = i_corner.begin();
+  const int* k_corner_data = k_corner.begin();
+  const BoutReal* f_data = &f(0, 0, 0);
+  const BoutReal* fx_data = &fx(0, 0, 0);
+  const BoutReal* fz_data = &fz(0, 0, 0);
+  const BoutReal* fxz_data = &fxz(0, 0, 0);
+  BoutReal* result_data = &f_interp(0, 0, 0);
+
+  BOUT_FOR(i, localmesh->getRegion3D("RGN_NOBNDRY")) {
+    if (skip_mask[i])
+      continue;
+
+    // Flat indices of the corners. k_corner is already wrapped into [0, ncz)
+    const int z_mod = k_corner_data[i.ind];
+    const int z_mod_p1 = (z_mod + 1 == ncz) ? 0 : z_mod + 1;
+    const int ic = (i_corner_data[i.ind] * ny + i.y()) * ncz + y_stride;
+    const int i_z = ic + z_mod, i_zp1 = ic + z_mod_p1;
+    const int ip1_z = i_z + x_stride, ip1_zp1 = i_zp1 + x_stride;
+
+    // Interpolate f in X at Z
+    BoutReal f_z = f_data[i_z] * h00_x[i] + f_data[ip1_z] * h01_x[i]
+                   + fx_data[i_z] * h10_x[i] + fx_data[ip1_z] * h11_x[i];
+
+    // Interpolate f in X at Z+1
+    BoutReal f_zp1 = f_data[i_zp1] * h00_x[i] + f_data[ip1_zp1] * h01_x[i]
+                     + fx_data[i_zp1] * h10_x[i] + fx_data[ip1_zp1] * h11_x[i];
+
+    // Interpolate fz in X at Z
+    BoutReal fz_z = fz_data[i_z] * h00_x[i] + fz_data[ip1_z] * h01_x[i]
+                    + fxz_data[i_z] * h10_x[i] + fxz_data[ip1_z] * h11_x[i];
+
+    // Interpolate fz in X at Z+1
+    BoutReal fz_zp1 = fz_data[i_zp1] * h00_x[i] + fz_data[ip1_zp1] * h01_x[i]
+                      + fxz_data[i_zp1] * h10_x[i] + fxz_data[ip1_zp1] * h11_x[i];
+
+    // Interpolate in Z
+    BoutReal result =
+        +f_z * h00_z[i] + f_zp1 * h01_z[i] + fz_z * h10_z[i] + fz_zp1 * h11_z[i];
+
+    ASSERT2(finite(result));
+
+    // Monotonicity
+    // Force the interpolated result to be in the range of the
+    // neighbouring cell values. This prevents unphysical overshoots,
+    // but also degrades accuracy near maxima and minima.
+    // Perhaps should only impose near boundaries, since that is where
+    // problems most obviously occur.
+    BoutReal localmax =
+        BOUTMAX(f_data[i_z], f_data[ip1_z], f_data[i_zp1], f_data[ip1_zp1]);
+
+    BoutReal localmin =
+        BOUTMIN(f_data[i_z], f_data[ip1_z], f_data[i_zp1], f_data[ip1_zp1]);
+
+    ASSERT2(finite(localmax));
+    ASSERT2(finite(localmin));
+
+    if (result > localmax) {
+      result = localmax;
     }
+    if (result < localmin) {
+      result = localmin;
+    }
+
+    result_data[i.ind + y_stride] = result;
   }
   return f_interp;
 }
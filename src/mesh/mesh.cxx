@@ -7,6 +7,7 @@
 #include <msg_stack.hxx>
 
 #include <cmath>
+#include <map>
 
 #include "meshfactory.hxx"
 
@@ -30,6 +31,8 @@ Mesh::Mesh(GridDataSource *s, Options* opt) : source(s), options(opt) {
   OPTION(options, StaggerGrids,   false); // Stagger grids
   OPTION(options, maxregionblocksize, MAXREGIONBLOCKSIZE);
   OPTION(options, calcParallelSlices_on_communicate, true);
+  OPTION(options, lazy_parallel_slices, false);
+  OPTION(options, parallel_slices_group_size, 4);
   // Initialise derivatives
   derivs_init(options);  // in index_derivs.cxx for now
 }
@@ -242,6 +245,11 @@ void Mesh::communicateXZ(FieldGroup &g) {
 
   // Wait for data from other processors
   wait(h);
+
+  // The guard cells have changed
+  for (const auto& fptr : g.field3d()) {
+    fptr->clearFieldAlignedCache();
+  }
 }
 
 void Mesh::communicate(FieldGroup &g) {
@@ -253,10 +261,39 @@ void Mesh::communicate(FieldGroup &g) {
   // Wait for data from other processors
   wait(h);
 
-  // Calculate yup and ydown fields for 3D fields
+  // The guard cells have changed
+  for (const auto& fptr : g.field3d()) {
+    fptr->clearFieldAlignedCache();
+  }
+
+  // Calculate yup and ydown fields for 3D fields, or mark them to be
+  // calculated when first used
   if (calcParallelSlices_on_communicate) {
+    std::vector<Field3D*> to_calculate;
     for(const auto& fptr : g.field3d()) {
-      fptr->calcParallelSlices();
+      if (!fptr->parallelSlicesOnCommunicate()) {
+        continue;
+      }
+      if (lazy_parallel_slices) {
+        fptr->invalidateParallelSlices();
+      } else {
+        to_calculate.push_back(fptr);
+      }
+    }
+
+    if (static_cast<int>(to_calculate.size()) >= parallel_slices_group_size) {
+      // Fields with the same transform can share the work, e.g. reading the maps
+      std::map<ParallelTransform*, std::vector<Field3D*>> by_transform;
+      for (const auto& fptr : to_calculate) {
+        by_transform[&fptr->getCoordinates()->getParallelTransform()].push_back(fptr);
+      }
+      for (const auto& group : by_transform) {
+        group.first->calcParallelSlicesGroup(group.second);
+      }
+    } else {
+      for (const auto& fptr : to_calculate) {
+        fptr->calcParallelSlices();
+      }
     }
   }
 }
@@ -43,17 +43,66 @@
 #include <bout/constants.hxx>
 #include <bout/mesh.hxx>
 #include <bout_types.hxx>
+#include <boutcomm.hxx>
 #include <msg_stack.hxx>
+#include <output.hxx>
 #include <utils.hxx>
 
+#include <cstdint>
+#include <fstream>
+#include <sstream>
 #include <string>
 
-FCIMap::FCIMap(Mesh& mesh, int offset_, BoundaryRegionPar* boundary, bool zperiodic)
-    : map_mesh(mesh), offset(offset_), boundary_mask(map_mesh),
-      corner_boundary_mask(map_mesh) {
+namespace {
+/// Increase when the layout of the cache files changes
+constexpr int fci_cache_version = 1;
 
-  TRACE("Creating FCIMAP for direction %d", offset);
+template <typename T>
+void writeRaw(std::ostream& out, const T* data, std::size_t count) {
+  out.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+}
+
+template <typename T>
+void readRaw(std::istream& in, T* data, std::size_t count) {
+  in.read(reinterpret_cast<char*>(data), count * sizeof(T));
+  if (!in) {
+    throw BoutException("FCIMap: ran out of data reading the cache");
+  }
+}
 
+/// Starting value of an FNV-1a hash
+constexpr std::uint64_t fnv_offset_basis = 14695981039346656037ULL;
+
+/// Add \p size bytes from \p data to the FNV-1a hash \p hash
+void hashBytes(std::uint64_t& hash, const void* data, std::size_t size) {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+/// FNV-1a hash of the contents of \p filename, calculated on one
+/// processor and shared with the others. Zero if the file can't be read
+std::uint64_t fileHash(const std::string& filename) {
+  std::uint64_t hash = 0;
+  if (BoutComm::rank() == 0) {
+    std::ifstream file(filename, std::ios::binary);
+    if (file) {
+      hash = fnv_offset_basis;
+      std::vector<char> buffer(1 << 20);
+      while (file) {
+        file.read(buffer.data(), buffer.size());
+        hashBytes(hash, buffer.data(), file.gcount());
+      }
+    }
+  }
+  MPI_Bcast(&hash, 1, MPI_UINT64_T, 0, BoutComm::get());
+  return hash;
+}
+} // namespace
+
+void FCIMap::createInterpolations() {
   if (offset == 0) {
     throw BoutException("FCIMap called with offset = 0; You probably didn't mean to do that");
   }
@@ -65,6 +114,22 @@ FCIMap::FCIMap(Mesh& mesh, int offset_, BoundaryRegionPar* boundary, bool zperio
   interp_corner =
       std::unique_ptr<Interpolation>(InterpolationFactory::getInstance()->create(&map_mesh));
   interp_corner->setYOffset(offset);
+}
+
+void FCIMap::addBoundaryPoint(BoundaryRegionPar* boundary, const BoundaryPoint& point) {
+  boundary->add_point(point.x, point.y, point.z, point.s_x, point.s_y, point.s_z,
+                      point.length, point.angle);
+  boundary_points.push_back(point);
+}
+
+FCIMap::FCIMap(Mesh& mesh, const Field2D& dy, int offset_, BoundaryRegionPar* boundary,
+               bool zperiodic, bool use_matrix)
+    : use_matrix(use_matrix), map_mesh(mesh), offset(offset_), boundary_mask(map_mesh),
+      corner_boundary_mask(map_mesh) {
+
+  TRACE("Creating FCIMAP for direction %d", offset);
+
+  createInterpolations();
 
   // Index arrays contain guard cells in order to get subscripts right
   // x-index of bottom-left grid point
@@ -162,8 +227,6 @@ FCIMap::FCIMap(Mesh& mesh, int offset_, BoundaryRegionPar* boundary, bool zperio
 
   BoutReal t_x, t_z;
 
-  Coordinates &coord = *(map_mesh.getCoordinates());
-
   for (int x = map_mesh.xstart; x <= map_mesh.xend; x++) {
     for (int y = map_mesh.ystart; y <= map_mesh.yend; y++) {
       for (int z = 0; z < ncz; z++) {
@@ -252,17 +315,78 @@ FCIMap::FCIMap(Mesh& mesh, int offset_, BoundaryRegionPar* boundary, bool zperio
           // Invert 2x2 matrix to get change in index
           BoutReal dx = (dZ_dz * dR - dR_dz * dZ) / det;
           BoutReal dz = (dR_dx * dZ - dZ_dx * dR) / det;
-          boundary->add_point(x, y, z,
-                              x + dx, y + 0.5*offset, z + dz,  // Intersection point in local index space
-                              0.5*coord.dy(x,y), //sqrt( SQ(dR) + SQ(dZ) ),  // Distance to intersection
-                              PI   // Right-angle intersection
-                              );
+          addBoundaryPoint(boundary,
+                           {x, y, z,
+                            x + dx, y + 0.5*offset, z + dz,  // Intersection point in local index space
+                            0.5*dy(x,y), //sqrt( SQ(dR) + SQ(dZ) ),  // Distance to intersection
+                            PI   // Right-angle intersection
+                           });
         }
       }
     }
   }
 
   interp->setMask(boundary_mask);
+
+  if (use_matrix) {
+    TRACE("FCImap: calculating interpolation matrix");
+    interp_matrix = interp->getMatrix();
+  }
+}
+
+FCIMap::FCIMap(Mesh& mesh, int offset_, BoundaryRegionPar* boundary, std::istream& cache,
+               bool use_matrix)
+    : use_matrix(use_matrix), map_mesh(mesh), offset(offset_), boundary_mask(map_mesh),
+      corner_boundary_mask(map_mesh) {
+
+  TRACE("Reading FCIMAP for direction %d", offset);
+
+  createInterpolations();
+
+  int cache_offset;
+  readRaw(cache, &cache_offset, 1);
+  if (cache_offset != offset) {
+    throw BoutException("FCIMap: expected the map for offset %d in the cache, found %d",
+                        offset, cache_offset);
+  }
+
+  readRaw(cache, boundary_mask.getData().begin(), boundary_mask.getData().getData().size());
+  readRaw(cache, corner_boundary_mask.getData().begin(),
+          corner_boundary_mask.getData().getData().size());
+
+  interp_corner->readWeights(cache);
+  interp_corner->setMask(corner_boundary_mask);
+
+  interp->readWeights(cache);
+  interp->setMask(boundary_mask);
+
+  int npoints;
+  readRaw(cache, &npoints, 1);
+  std::vector<BoundaryPoint> points(npoints);
+  readRaw(cache, points.data(), points.size());
+  for (const auto& point : points) {
+    addBoundaryPoint(boundary, point);
+  }
+
+  if (use_matrix) {
+    TRACE("FCImap: calculating interpolation matrix");
+    interp_matrix = interp->getMatrix();
+  }
+}
+
+void FCIMap::writeCache(std::ostream& out) const {
+  writeRaw(out, &offset, 1);
+
+  writeRaw(out, boundary_mask.getData().begin(), boundary_mask.getData().getData().size());
+  writeRaw(out, corner_boundary_mask.getData().begin(),
+           corner_boundary_mask.getData().getData().size());
+
+  interp_corner->writeWeights(out);
+  interp->writeWeights(out);
+
+  const int npoints = boundary_points.size();
+  writeRaw(out, &npoints, 1);
+  writeRaw(out, boundary_points.data(), boundary_points.size());
 }
 
 Field3D FCIMap::integrate(Field3D &f) const {
@@ -272,7 +396,7 @@ Field3D FCIMap::integrate(Field3D &f) const {
   ASSERT1(&map_mesh == f.getMesh());
 
   // Cell centre values
-  Field3D centre = interp->interpolate(f);
+  Field3D centre = interpolate(f);
 
   // Cell corner values (x+1/2, z+1/2)
   Field3D corner = interp_corner->interpolate(f);
@@ -324,6 +448,109 @@ Field3D FCIMap::integrate(Field3D &f) const {
   return result;
 }
 
+FCITransform::FCITransform(Mesh& mesh, const Field2D& dy, bool zperiodic,
+                           bool sparse_interpolation, const std::string& cache_file)
+    : ParallelTransform(mesh) {
+
+  // check the coordinate system used for the grid data source
+  FCITransform::checkInputGrid();
+
+  auto forward_boundary = new BoundaryRegionPar("FCI_forward", BNDRY_PAR_FWD, +1, &mesh);
+  auto backward_boundary = new BoundaryRegionPar("FCI_backward", BNDRY_PAR_BKWD, -1, &mesh);
+
+  // Add the boundary region to the mesh's vector of parallel boundaries
+  mesh.addBoundaryPar(forward_boundary);
+  mesh.addBoundaryPar(backward_boundary);
+
+  // The cache can only be checked against a grid file
+  std::string key;
+  if (not cache_file.empty()) {
+    if (mesh.isDataSourceGridFile()) {
+      key = cacheKey(mesh, dy, zperiodic);
+    } else {
+      output_warn.write("\tFCI maps can only be cached for grid files. Not caching\n");
+    }
+  }
+  const std::string filename = cache_file + "." + std::to_string(BoutComm::rank());
+
+  std::ifstream cache;
+  bool read_cache = false;
+  if (not key.empty()) {
+    cache.open(filename, std::ios::binary);
+    read_cache = cache and readCacheKey(cache, key);
+  }
+  // All processors read the cache, or all calculate the maps
+  int local = read_cache ? 1 : 0, global;
+  MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_MIN, BoutComm::get());
+  read_cache = (global == 1);
+
+  field_line_maps.reserve(mesh.ystart * 2);
+  for (int offset = 1; offset < mesh.ystart + 1; ++offset) {
+    if (read_cache) {
+      field_line_maps.emplace_back(mesh, offset, forward_boundary, cache,
+                                   sparse_interpolation);
+      field_line_maps.emplace_back(mesh, -offset, backward_boundary, cache,
+                                   sparse_interpolation);
+    } else {
+      field_line_maps.emplace_back(mesh, dy, offset, forward_boundary, zperiodic,
+                                   sparse_interpolation);
+      field_line_maps.emplace_back(mesh, dy, -offset, backward_boundary, zperiodic,
+                                   sparse_interpolation);
+    }
+  }
+
+  if (key.empty()) {
+    return;
+  }
+  if (read_cache) {
+    output_info.write("\tRead FCI maps from %s\n", filename.c_str());
+    return;
+  }
+
+  std::ofstream out(filename, std::ios::binary);
+  writeCacheKey(out, key);
+  for (const auto& map : field_line_maps) {
+    map.writeCache(out);
+  }
+  if (out) {
+    output_info.write("\tWrote FCI maps to %s\n", filename.c_str());
+  } else {
+    output_warn.write("\tCould not write FCI maps to %s\n", filename.c_str());
+  }
+}
+
+std::string FCITransform::cacheKey(Mesh& mesh, const Field2D& dy, bool zperiodic) {
+  // dy may be set in the input file rather than the grid, so hash its values
+  std::uint64_t dy_hash = fnv_offset_basis;
+  for (const auto& i : dy.getRegion("RGN_ALL")) {
+    const BoutReal value = dy[i];
+    hashBytes(dy_hash, &value, sizeof(value));
+  }
+
+  std::stringstream key;
+  key << "BOUT++ FCI maps v" << fci_cache_version << ":grid "
+      << Options::root()["grid"].withDefault<std::string>("") << " " << std::hex
+      << fileHash(Options::root()["grid"].withDefault<std::string>("")) << std::dec
+      << ":processor " << BoutComm::rank() << " of " << mesh.getNXPE() << "x"
+      << mesh.getNYPE() << ":local " << mesh.LocalNx << "x" << mesh.LocalNy << "x"
+      << mesh.LocalNz << ":guards " << mesh.xstart << "x" << mesh.ystart
+      << ":interpolation "
+      << Options::root()["interpolation"]["type"].withDefault<std::string>(
+             InterpolationFactory::getInstance()->getDefaultInterpType())
+      << ":z_periodic " << zperiodic << ":dy " << std::hex << dy_hash;
+  return key.str();
+}
+
+bool FCITransform::readCacheKey(std::istream& cache, const std::string& key) {
+  std::string cache_key;
+  std::getline(cache, cache_key, '\0');
+  return cache and (cache_key == key);
+}
+
+void FCITransform::writeCacheKey(std::ostream& out, const std::string& key) {
+  out << key << '\0';
+}
+
 void FCITransform::checkInputGrid() {
   std::string parallel_transform;
   if (mesh.isDataSourceGridFile() && !mesh.get(parallel_transform, "parallel_transform")) {
@@ -353,6 +580,28 @@ void FCITransform::calcParallelSlices(Field3D& f) {
   }
 }
 
+void FCITransform::calcParallelSlicesGroup(const std::vector<Field3D*>& fields) {
+  TRACE("FCITransform::calcParallelSlicesGroup");
+
+  const std::vector<const Field3D*> inputs(fields.begin(), fields.end());
+
+  for (auto* f : fields) {
+    ASSERT1(f->getDirectionY() == YDirectionType::Standard);
+    ASSERT1(f->getLocation() == CELL_CENTRE);
+    ASSERT1(&mesh == f->getMesh());
+
+    // Ensure that yup and ydown are different fields
+    f->splitParallelSlices();
+  }
+
+  for (const auto& map : field_line_maps) {
+    auto slices = map.interpolate(inputs);
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+      fields[i]->ynext(map.offset) = slices[i];
+    }
+  }
+}
+
 void FCITransform::integrateParallelSlices(Field3D& f) {
   TRACE("FCITransform::integrateParallelSlices");
 
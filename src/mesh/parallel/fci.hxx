@@ -32,7 +32,9 @@
 #include <parallel_boundary_region.hxx>
 #include <unused.hxx>
 
+#include <iosfwd>
 #include <memory>
+#include <string>
 #include <vector>
 
 
@@ -42,9 +44,40 @@ class FCIMap {
   std::unique_ptr<Interpolation> interp;        // Cell centre
   std::unique_ptr<Interpolation> interp_corner; // Cell corner at (x+1, z+1)
 
+  /// Use interp_matrix rather than interp for cell centre values?
+  bool use_matrix;
+  /// Cell centre interpolation folded into a sparse matrix
+  InterpolationMatrix interp_matrix;
+
+  /// A point added to the parallel boundary by this map
+  struct BoundaryPoint {
+    int x, y, z;
+    BoutReal s_x, s_y, s_z;
+    BoutReal length, angle;
+  };
+  /// The points added to the boundary, kept so they can be written to a cache
+  std::vector<BoundaryPoint> boundary_points;
+
+  /// Create the interpolation objects, before calculating or reading the weights
+  void createInterpolations();
+  /// Add \p point to \p boundary, and remember it
+  void addBoundaryPoint(BoundaryRegionPar* boundary, const BoundaryPoint& point);
+
 public:
   FCIMap() = delete;
-  FCIMap(Mesh& mesh, int offset, BoundaryRegionPar* boundary, bool zperiodic);
+  /// If \p use_matrix is true, fold the cell centre interpolation
+  /// into a sparse matrix, which is faster to apply. \p dy is needed
+  /// because the maps are created before the mesh's Coordinates
+  FCIMap(Mesh& mesh, const Field2D& dy, int offset, BoundaryRegionPar* boundary,
+         bool zperiodic, bool use_matrix = false);
+  /// Read a map written by writeCache, rather than calculating it
+  /// from the grid
+  FCIMap(Mesh& mesh, int offset, BoundaryRegionPar* boundary, std::istream& cache,
+         bool use_matrix = false);
+
+  /// Write the interpolation weights, masks and boundary points, so
+  /// that the map can be read back by the constructor above
+  void writeCache(std::ostream& out) const;
 
   // The mesh this map was created on
   Mesh& map_mesh;
@@ -59,9 +92,20 @@ public:
   
   Field3D interpolate(Field3D& f) const {
     ASSERT1(&map_mesh == f.getMesh());
+    if (use_matrix) {
+      return interp_matrix.apply(f);
+    }
     return interp->interpolate(f);
   }
 
+  /// Interpolate all of \p fields, reading the map once
+  std::vector<Field3D> interpolate(const std::vector<const Field3D*>& fields) const {
+    if (use_matrix) {
+      return interp_matrix.apply(fields);
+    }
+    return interp->interpolateFields(fields);
+  }
+
   Field3D integrate(Field3D &f) const;
 };
 
@@ -70,26 +114,19 @@ public:
 class FCITransform : public ParallelTransform {
 public:
   FCITransform() = delete;
-  FCITransform(Mesh& mesh, bool zperiodic = true) : ParallelTransform(mesh) {
-
-    // check the coordinate system used for the grid data source
-    FCITransform::checkInputGrid();
-
-    auto forward_boundary = new BoundaryRegionPar("FCI_forward", BNDRY_PAR_FWD, +1, &mesh);
-    auto backward_boundary = new BoundaryRegionPar("FCI_backward", BNDRY_PAR_BKWD, -1, &mesh);
-
-    // Add the boundary region to the mesh's vector of parallel boundaries
-    mesh.addBoundaryPar(forward_boundary);
-    mesh.addBoundaryPar(backward_boundary);
-
-    field_line_maps.reserve(mesh.ystart * 2);
-    for (int offset = 1; offset < mesh.ystart + 1; ++offset) {
-      field_line_maps.emplace_back(mesh, offset, forward_boundary, zperiodic);
-      field_line_maps.emplace_back(mesh, -offset, backward_boundary, zperiodic);
-    }
-  }
+  /// If \p sparse_interpolation is true, fold the interpolations
+  /// into sparse matrices when the maps are created.
+  ///
+  /// If \p cache_file is not empty, the maps are read from
+  /// "<cache_file>.<processor>" if it was written for the same grid
+  /// file and decomposition, and otherwise calculated and written there
+  FCITransform(Mesh& mesh, const Field2D& dy, bool zperiodic = true,
+               bool sparse_interpolation = false, const std::string& cache_file = "");
 
   void calcParallelSlices(Field3D &f) override;
+
+  /// Interpolate all the fields together, so each map is read once
+  void calcParallelSlicesGroup(const std::vector<Field3D*>& fields) override;
   
   void integrateParallelSlices(Field3D &f) override;
   
@@ -116,6 +153,17 @@ public:
     return false;
   }
 
+  /// Identifies the grid file, decomposition, \p dy and methods used
+  /// to calculate the maps on this processor, so stale caches aren't
+  /// read. All processors must call this together
+  static std::string cacheKey(Mesh& mesh, const Field2D& dy, bool zperiodic);
+
+  /// Read the key at the start of \p cache. True if it is \p key, in
+  /// which case the maps can be read from \p cache next
+  static bool readCacheKey(std::istream& cache, const std::string& key);
+  /// Write \p key at the start of a cache, before the maps
+  static void writeCacheKey(std::ostream& out, const std::string& key);
+
 protected:
   void checkInputGrid() override;
 
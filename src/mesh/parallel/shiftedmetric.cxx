@@ -8,17 +8,116 @@
 
 #include <bout/constants.hxx>
 #include <bout/mesh.hxx>
+#include <bout/openmpwrap.hxx>
 #include "bout/paralleltransform.hxx"
 #include <fft.hxx>
 
+#include <algorithm>
 #include <cmath>
 
 #include <output.hxx>
 
+namespace {
+/// Multiply modes 1 to nmodes-1 of \p in by \p phase, storing them in
+/// \p out, which may be the same as \p in. Mode 0 is not changed.
+///
+/// Written out in real arithmetic so that it vectorises: multiplying
+/// std::complex values has to check for infinities and NaNs
+void applyPhase(const dcomplex* in, const dcomplex* phase, dcomplex* out, int nmodes) {
+  const auto* in_data = reinterpret_cast<const BoutReal*>(in);
+  const auto* phase_data = reinterpret_cast<const BoutReal*>(phase);
+  auto* out_data = reinterpret_cast<BoutReal*>(out);
+
+  out[0] = in[0];
+  for (int jz = 1; jz < nmodes; jz++) {
+    const BoutReal re = in_data[2 * jz], im = in_data[2 * jz + 1];
+    const BoutReal phase_re = phase_data[2 * jz], phase_im = phase_data[2 * jz + 1];
+    out_data[2 * jz] = re * phase_re - im * phase_im;
+    out_data[2 * jz + 1] = re * phase_im + im * phase_re;
+  }
+}
+
+/// Number of points in the interpolation stencils of \p method
+int stencilWidth(ZShiftMethod method) {
+  switch (method) {
+  case ZShiftMethod::fft:
+    return 0;
+  case ZShiftMethod::lagrange4pt:
+  case ZShiftMethod::hermitespline:
+    return 4;
+  case ZShiftMethod::lagrange6pt:
+    return 6;
+  }
+  throw BoutException("Unhandled ZShiftMethod %d", static_cast<int>(method));
+}
+
+/// Set the \p width \p weights which interpolate to a distance \p t
+/// (0 <= t < 1) past stencil point width/2 - 1
+void stencilWeights(ZShiftMethod method, int width, BoutReal t, BoutReal* weights) {
+  if (method == ZShiftMethod::hermitespline) {
+    // Cubic Hermite spline between points 1 and 2, with the
+    // derivatives there from central differences
+    const BoutReal t2 = t * t, t3 = t2 * t;
+    weights[0] = 0.5 * (-t3 + 2. * t2 - t);
+    weights[1] = 0.5 * (3. * t3 - 5. * t2 + 2.);
+    weights[2] = 0.5 * (-3. * t3 + 4. * t2 + t);
+    weights[3] = 0.5 * (t3 - t2);
+    return;
+  }
+
+  // Lagrange polynomial through all the points
+  const int first = -(width / 2 - 1);
+  for (int n = 0; n < width; ++n) {
+    BoutReal weight = 1.0;
+    for (int m = 0; m < width; ++m) {
+      if (m != n) {
+        weight *= (t - (first + m)) / static_cast<BoutReal>(n - m);
+      }
+    }
+    weights[n] = weight;
+  }
+}
+
+/// Interpolate the periodic column \p in of \p nz points with \p
+/// weights, starting \p start points along, into \p out. \p buffer
+/// must have space for nz + width - 1 points
+template <int width>
+void applyStencil(const BoutReal* in, int nz, int start, const BoutReal* weights,
+                  BoutReal* buffer, BoutReal* out) {
+  // Unwrap the column, so the stencils don't need periodic indices
+  std::copy(in + start, in + nz, buffer);
+  std::copy(in, in + start, buffer + nz - start);
+  for (int jz = nz; jz < nz + width - 1; ++jz) {
+    buffer[jz] = buffer[jz - nz];
+  }
+
+  for (int jz = 0; jz < nz; ++jz) {
+    BoutReal value = 0.0;
+    for (int n = 0; n < width; ++n) {
+      value += weights[n] * buffer[jz + n];
+    }
+    out[jz] = value;
+  }
+}
+
+void applyStencil(int width, const BoutReal* in, int nz, int start,
+                  const BoutReal* weights, BoutReal* buffer, BoutReal* out) {
+  switch (width) {
+  case 4:
+    applyStencil<4>(in, nz, start, weights, buffer, out);
+    return;
+  case 6:
+    applyStencil<6>(in, nz, start, weights, buffer, out);
+    return;
+  }
+  throw BoutException("ShiftedMetric: no %d point interpolation stencil", width);
+}
+} // namespace
+
 ShiftedMetric::ShiftedMetric(Mesh& m, CELL_LOC location_in, Field2D zShift_,
-    BoutReal zlength_in)
+                             BoutReal zlength_in, ZShiftMethod method_in)
     : ParallelTransform(m), location(location_in), zShift(std::move(zShift_)),
-      zlength(zlength_in) {
+      zlength(zlength_in), method(method_in), stencil_width(stencilWidth(method)) {
   ASSERT1(zShift.getLocation() == location);
   // check the coordinate system used for the grid data source
   ShiftedMetric::checkInputGrid();
@@ -57,14 +156,28 @@ void ShiftedMetric::cachePhases() {
   // phases used in transformations
   nmodes = mesh.LocalNz / 2 + 1;
 
-  // Allocate storage for our 3d phase information.
-  fromAlignedPhs = Tensor<dcomplex>(mesh.LocalNx, mesh.LocalNy, nmodes);
-  toAlignedPhs = Tensor<dcomplex>(mesh.LocalNx, mesh.LocalNy, nmodes);
+  const bool use_fft = method == ZShiftMethod::fft;
+
+  if (use_fft) {
+    // Allocate storage for our 3d phase information.
+    fromAlignedPhs = Tensor<dcomplex>(mesh.LocalNx, mesh.LocalNy, nmodes);
+    toAlignedPhs = Tensor<dcomplex>(mesh.LocalNx, mesh.LocalNy, nmodes);
+  } else {
+    toAlignedStencil = {Matrix<int>(mesh.LocalNx, mesh.LocalNy),
+                        Tensor<BoutReal>(mesh.LocalNx, mesh.LocalNy, stencil_width)};
+    fromAlignedStencil = {Matrix<int>(mesh.LocalNx, mesh.LocalNy),
+                          Tensor<BoutReal>(mesh.LocalNx, mesh.LocalNy, stencil_width)};
+  }
 
   // To/From field aligned phases
   BOUT_FOR(i, mesh.getRegion2D("RGN_ALL")) {
     int ix = i.x();
     int iy = i.y();
+    if (not use_fft) {
+      setStencil(toAlignedStencil, ix, iy, zShift[i]);
+      setStencil(fromAlignedStencil, ix, iy, -zShift[i]);
+      continue;
+    }
     for (int jz = 0; jz < nmodes; jz++) {
       BoutReal kwave = jz * 2.0 * PI / zlength; // wave number is 1/[rad]
       fromAlignedPhs(ix, iy, jz) =
@@ -85,18 +198,19 @@ void ShiftedMetric::cachePhases() {
   // stores its phase and offset, so we don't need to faff about after
   // this
   for (int i = 0; i < mesh.ystart; ++i) {
-    // NOTE: std::vector constructor here takes a **copy** of the
-    // Array! We *must* call `Array::ensureUnique` on each element
-    // before using it!
-    parallel_slice_phases[i].phase_shift =
-        Tensor<dcomplex>(mesh.LocalNx, mesh.LocalNy, nmodes);
     parallel_slice_phases[i].y_offset = i + 1;
 
     // Backwards parallel slices
-    parallel_slice_phases[mesh.ystart + i].phase_shift =
-        Tensor<dcomplex>(mesh.LocalNx, mesh.LocalNy, nmodes);
     parallel_slice_phases[mesh.ystart + i].y_offset = -(i + 1);
   }
+  for (auto& slice : parallel_slice_phases) {
+    if (use_fft) {
+      slice.phase_shift = Tensor<dcomplex>(mesh.LocalNx, mesh.LocalNy, nmodes);
+    } else {
+      slice.stencil = {Matrix<int>(mesh.LocalNx, mesh.LocalNy),
+                       Tensor<BoutReal>(mesh.LocalNx, mesh.LocalNy, stencil_width)};
+    }
+  }
 
   // Parallel slice phases -- note we don't shift in the boundaries/guards
   for (auto& slice : parallel_slice_phases) {
@@ -106,6 +220,11 @@ void ShiftedMetric::cachePhases() {
       int iy = i.y();
       BoutReal slice_shift = zShift[i] - zShift[i.yp(slice.y_offset)];
 
+      if (not use_fft) {
+        setStencil(slice.stencil, ix, iy, -slice_shift);
+        continue;
+      }
+
       for (int jz = 0; jz < nmodes; jz++) {
         // wave number is 1/[rad]
         BoutReal kwave = jz * 2.0 * PI / zlength;
@@ -117,12 +236,34 @@ void ShiftedMetric::cachePhases() {
   }
 }
 
+void ShiftedMetric::setStencil(ShiftStencil& stencil, int x, int y,
+                               BoutReal shift) const {
+  const int nz = mesh.LocalNz;
+
+  // Position in grid points, relative to each point
+  const BoutReal position = shift * nz / zlength;
+  const BoutReal lower = std::floor(position);
+
+  // Stencils start width/2 - 1 points below the point before the position
+  int start = static_cast<int>(lower) - (stencil_width / 2 - 1);
+  start %= nz;
+  if (start < 0) {
+    start += nz;
+  }
+  stencil.start(x, y) = start;
+
+  stencilWeights(method, stencil_width, position - lower, &stencil.weights(x, y, 0));
+}
+
 /*!
  * Shift the field so that X-Z is not orthogonal,
  * and Y is then field aligned.
  */
 const Field3D ShiftedMetric::toFieldAligned(const Field3D& f, const std::string& region) {
   ASSERT2(f.getDirectionY() == YDirectionType::Standard);
+  if (method != ZShiftMethod::fft) {
+    return shiftZ(f, toAlignedStencil, YDirectionType::Aligned, region);
+  }
   return shiftZ(f, toAlignedPhs, YDirectionType::Aligned, region);
 }
 const FieldPerp ShiftedMetric::toFieldAligned(const FieldPerp& f,
@@ -130,6 +271,9 @@ const FieldPerp ShiftedMetric::toFieldAligned(const FieldPerp& f,
   ASSERT2(f.getDirectionY() == YDirectionType::Standard);
   // In principle, other regions are possible, but not yet implemented
   ASSERT2(region == "RGN_NOX");
+  if (method != ZShiftMethod::fft) {
+    return shiftZ(f, toAlignedStencil, YDirectionType::Aligned, region);
+  }
   return shiftZ(f, toAlignedPhs, YDirectionType::Aligned, region);
 }
 
@@ -140,6 +284,9 @@ const FieldPerp ShiftedMetric::toFieldAligned(const FieldPerp& f,
 const Field3D ShiftedMetric::fromFieldAligned(const Field3D& f,
                                               const std::string& region) {
   ASSERT2(f.getDirectionY() == YDirectionType::Aligned);
+  if (method != ZShiftMethod::fft) {
+    return shiftZ(f, fromAlignedStencil, YDirectionType::Standard, region);
+  }
   return shiftZ(f, fromAlignedPhs, YDirectionType::Standard, region);
 }
 const FieldPerp ShiftedMetric::fromFieldAligned(const FieldPerp& f,
@@ -147,31 +294,169 @@ const FieldPerp ShiftedMetric::fromFieldAligned(const FieldPerp& f,
   ASSERT2(f.getDirectionY() == YDirectionType::Aligned);
   // In principle, other regions are possible, but not yet implemented
   ASSERT2(region == "RGN_NOX");
+  if (method != ZShiftMethod::fft) {
+    return shiftZ(f, fromAlignedStencil, YDirectionType::Standard, region);
+  }
   return shiftZ(f, fromAlignedPhs, YDirectionType::Standard, region);
 }
 
+std::vector<Field3D> ShiftedMetric::toFieldAlignedGroup(const std::vector<Field3D>& fields,
+                                                        const std::string& region) {
+  for (const auto& f : fields) {
+    ASSERT2(f.getDirectionY() == YDirectionType::Standard);
+  }
+  if (method != ZShiftMethod::fft) {
+    return shiftZ(fields, toAlignedStencil, YDirectionType::Aligned, region);
+  }
+  return shiftZ(fields, toAlignedPhs, YDirectionType::Aligned, region);
+}
+
+std::vector<Field3D>
+ShiftedMetric::fromFieldAlignedGroup(const std::vector<Field3D>& fields,
+                                     const std::string& region) {
+  for (const auto& f : fields) {
+    ASSERT2(f.getDirectionY() == YDirectionType::Aligned);
+  }
+  if (method != ZShiftMethod::fft) {
+    return shiftZ(fields, fromAlignedStencil, YDirectionType::Standard, region);
+  }
+  return shiftZ(fields, fromAlignedPhs, YDirectionType::Standard, region);
+}
+
 const Field3D ShiftedMetric::shiftZ(const Field3D& f, const Tensor<dcomplex>& phs,
                                     const YDirectionType y_direction_out,
                                     const std::string& region) const {
-  ASSERT1(f.getMesh() == &mesh);
-  ASSERT1(f.getLocation() == location);
+  return shiftZ(std::vector<Field3D>{f}, phs, y_direction_out, region)[0];
+}
 
-  if (mesh.LocalNz == 1) {
-    // Shifting does not change the array values
-    Field3D result = copy(f).setDirectionY(y_direction_out);
-    return result;
+std::vector<Field3D> ShiftedMetric::shiftZ(const std::vector<Field3D>& fields,
+                                           const Tensor<dcomplex>& phs,
+                                           const YDirectionType y_direction_out,
+                                           const std::string& region) const {
+  auto results = emptyShifted(fields, y_direction_out);
+
+  if (mesh.LocalNz == 1 or fields.empty()) {
+    return results;
   }
 
-  Field3D result{emptyFrom(f).setDirectionY(y_direction_out)};
+  const int nz = mesh.LocalNz;
+  const int nfields = fields.size();
 
-  BOUT_FOR(i, mesh.getRegion2D(toString(region))) {
-    shiftZ(&f(i, 0), &phs(i.x(), i.y(), 0), &result(i, 0));
+  // The columns of each block are contiguous, so can be transformed together
+  const auto& blocks = mesh.getRegion2D(region).getBlocks();
+  const int nblocks = blocks.size();
+  int max_columns = 0;
+  for (const auto& block : blocks) {
+    max_columns = std::max(max_columns, block.second.ind - block.first.ind);
   }
 
-  return result;
+  std::vector<const BoutReal*> in(nfields);
+  std::vector<BoutReal*> out(nfields);
+  for (int n = 0; n < nfields; ++n) {
+    in[n] = &fields[n](0, 0, 0);
+    out[n] = &results[n](0, 0, 0);
+  }
+
+  BOUT_OMP(parallel) {
+    // Modes of every column in a block, for each field
+    Array<dcomplex> modes(nfields * max_columns * nmodes);
+
+    BOUT_OMP(for schedule(static))
+    for (int b = 0; b < nblocks; ++b) {
+      const int start = blocks[b].first.ind;
+      const int ncolumns = blocks[b].second.ind - start;
+
+      for (int n = 0; n < nfields; ++n) {
+        bout::fft::rfft(in[n] + start * nz, nz, ncolumns,
+                        &modes[n * max_columns * nmodes]);
+      }
+
+      for (int column = 0; column < ncolumns; ++column) {
+        const dcomplex* phase = phs.begin() + (start + column) * nmodes;
+        for (int n = 0; n < nfields; ++n) {
+          dcomplex* column_modes = &modes[(n * max_columns + column) * nmodes];
+          applyPhase(column_modes, phase, column_modes, nmodes);
+        }
+      }
+
+      for (int n = 0; n < nfields; ++n) {
+        bout::fft::irfft(&modes[n * max_columns * nmodes], nz, ncolumns,
+                         out[n] + start * nz);
+      }
+    }
+  }
+
+  return results;
 }
 
-const FieldPerp ShiftedMetric::shiftZ(const FieldPerp& f, const Tensor<dcomplex>& phs,
+std::vector<Field3D>
+ShiftedMetric::emptyShifted(const std::vector<Field3D>& fields,
+                            const YDirectionType y_direction_out) const {
+  std::vector<Field3D> results;
+  results.reserve(fields.size());
+  for (const auto& f : fields) {
+    ASSERT1(f.getMesh() == &mesh);
+    ASSERT1(f.getLocation() == location);
+
+    if (mesh.LocalNz == 1) {
+      // Shifting does not change the array values
+      results.push_back(copy(f).setDirectionY(y_direction_out));
+    } else {
+      results.push_back(emptyFrom(f).setDirectionY(y_direction_out));
+    }
+  }
+  return results;
+}
+
+const Field3D ShiftedMetric::shiftZ(const Field3D& f, const ShiftStencil& stencil,
+                                    const YDirectionType y_direction_out,
+                                    const std::string& region) const {
+  return shiftZ(std::vector<Field3D>{f}, stencil, y_direction_out, region)[0];
+}
+
+std::vector<Field3D> ShiftedMetric::shiftZ(const std::vector<Field3D>& fields,
+                                           const ShiftStencil& stencil,
+                                           const YDirectionType y_direction_out,
+                                           const std::string& region) const {
+  auto results = emptyShifted(fields, y_direction_out);
+
+  if (mesh.LocalNz == 1 or fields.empty()) {
+    return results;
+  }
+
+  const int nz = mesh.LocalNz;
+  const int nfields = fields.size();
+
+  const auto& blocks = mesh.getRegion2D(region).getBlocks();
+  const int nblocks = blocks.size();
+
+  std::vector<const BoutReal*> in(nfields);
+  std::vector<BoutReal*> out(nfields);
+  for (int n = 0; n < nfields; ++n) {
+    in[n] = &fields[n](0, 0, 0);
+    out[n] = &results[n](0, 0, 0);
+  }
+
+  BOUT_OMP(parallel) {
+    Array<BoutReal> buffer(nz + stencil_width - 1);
+
+    BOUT_OMP(for schedule(static))
+    for (int b = 0; b < nblocks; ++b) {
+      for (int column = blocks[b].first.ind; column < blocks[b].second.ind; ++column) {
+        const int start = stencil.start.begin()[column];
+        const BoutReal* weights = stencil.weights.begin() + column * stencil_width;
+        for (int n = 0; n < nfields; ++n) {
+          applyStencil(stencil_width, in[n] + column * nz, nz, start, weights,
+                       std::begin(buffer), out[n] + column * nz);
+        }
+      }
+    }
+  }
+
+  return results;
+}
+
+const FieldPerp ShiftedMetric::shiftZ(const FieldPerp& f, const ShiftStencil& stencil,
                                       const YDirectionType y_direction_out,
                                       const std::string& UNUSED(region)) const {
   ASSERT1(f.getMesh() == &mesh);
@@ -185,31 +470,46 @@ const FieldPerp ShiftedMetric::shiftZ(const FieldPerp& f, const Tensor<dcomplex>
 
   FieldPerp result{emptyFrom(f).setDirectionY(y_direction_out)};
 
-  int y = f.getIndex();
-  // Note that this loop is essentially hardcoded to be RGN_NOX
-  for (int i=mesh.xstart; i<=mesh.xend; ++i) {
-    shiftZ(&f(i, 0), &phs(i, y, 0), &result(i, 0));
+  const int y = f.getIndex();
+  Array<BoutReal> buffer(mesh.LocalNz + stencil_width - 1);
+
+  // Note that this is essentially hardcoded to be RGN_NOX
+  for (int x = mesh.xstart; x <= mesh.xend; ++x) {
+    applyStencil(stencil_width, &f(x, 0), mesh.LocalNz, stencil.start(x, y),
+                 &stencil.weights(x, y, 0), std::begin(buffer), &result(x, 0));
   }
 
   return result;
 }
 
-void ShiftedMetric::shiftZ(const BoutReal* in, const dcomplex* phs, BoutReal* out) const {
-  Array<dcomplex> cmplx(nmodes);
+const FieldPerp ShiftedMetric::shiftZ(const FieldPerp& f, const Tensor<dcomplex>& phs,
+                                      const YDirectionType y_direction_out,
+                                      const std::string& UNUSED(region)) const {
+  ASSERT1(f.getMesh() == &mesh);
+  ASSERT1(f.getLocation() == location);
+
+  if (mesh.LocalNz == 1) {
+    // Shifting does not change the array values
+    FieldPerp result = copy(f).setDirectionY(y_direction_out);
+    return result;
+  }
 
-  // Take forward FFT
-  rfft(in, mesh.LocalNz, &cmplx[0]);
+  FieldPerp result{emptyFrom(f).setDirectionY(y_direction_out)};
 
-  // Following is an algorithm approach to write a = a*b where a and b are
-  // vectors of dcomplex.
-  //  std::transform(cmplxOneOff.begin(),cmplxOneOff.end(), ptr.begin(),
-  //		 cmplxOneOff.begin(), std::multiplies<dcomplex>());
+  const int y = f.getIndex();
+  // Note that this is essentially hardcoded to be RGN_NOX. The columns
+  // at each x are contiguous, so are transformed together
+  const int ncolumns = mesh.xend - mesh.xstart + 1;
+  Array<dcomplex> modes(ncolumns * nmodes);
 
-  for (int jz = 1; jz < nmodes; jz++) {
-    cmplx[jz] *= phs[jz];
+  bout::fft::rfft(&f(mesh.xstart, 0), mesh.LocalNz, ncolumns, std::begin(modes));
+  for (int i = 0; i < ncolumns; ++i) {
+    dcomplex* column_modes = &modes[i * nmodes];
+    applyPhase(column_modes, &phs(mesh.xstart + i, y, 0), column_modes, nmodes);
   }
+  bout::fft::irfft(std::begin(modes), mesh.LocalNz, ncolumns, &result(mesh.xstart, 0));
 
-  irfft(&cmplx[0], mesh.LocalNz, out); // Reverse FFT
+  return result;
 }
 
 void ShiftedMetric::calcParallelSlices(Field3D& f) {
@@ -221,17 +521,15 @@ void ShiftedMetric::calcParallelSlices(Field3D& f) {
 
   f.splitParallelSlices();
 
+  std::vector<Field3D*> slices;
+  slices.reserve(parallel_slice_phases.size());
   for (const auto& phase : parallel_slice_phases) {
     auto& f_slice = f.ynext(phase.y_offset);
     f_slice.allocate();
-    BOUT_FOR(i, mesh.getRegion2D("RGN_NOY")) {
-      const int ix = i.x();
-      const int iy = i.y();
-      const int iy_offset = iy + phase.y_offset;
-      shiftZ(&(f(ix, iy_offset, 0)), &(phase.phase_shift(ix, iy, 0)),
-             &(f_slice(ix, iy_offset, 0)));
-    }
+    slices.push_back(&f_slice);
   }
+
+  shiftZ(f, parallel_slice_phases, slices);
 }
 
 std::vector<Field3D>
@@ -241,46 +539,80 @@ ShiftedMetric::shiftZ(const Field3D& f,
   ASSERT1(f.getLocation() == location);
   ASSERT1(f.getDirectionY() == YDirectionType::Standard);
 
-  const int nmodes = mesh.LocalNz / 2 + 1;
+  std::vector<Field3D> results{};
+  results.reserve(phases.size());
+  for (std::size_t i = 0; i < phases.size(); ++i) {
+    results.emplace_back(&mesh);
+    results.back().allocate();
+    results.back().setLocation(f.getLocation());
+  }
 
-  // FFT in Z of input field at each (x, y) point
-  Matrix<Array<dcomplex>> f_fft(mesh.LocalNx, mesh.LocalNy);
-  f_fft = Array<dcomplex>(nmodes);
+  std::vector<Field3D*> result_ptrs;
+  for (auto& result : results) {
+    result_ptrs.push_back(&result);
+  }
 
-  BOUT_FOR(i, mesh.getRegion2D("RGN_ALL")) {
-    int ix = i.x();
-    int iy = i.y();
-    f_fft(ix, iy).ensureUnique();
-    rfft(&f(i, 0), mesh.LocalNz, f_fft(ix, iy).begin());
+  shiftZ(f, phases, result_ptrs);
+
+  return results;
+}
+
+void ShiftedMetric::shiftZ(const Field3D& f,
+                           const std::vector<ParallelSlicePhase>& phases,
+                           const std::vector<Field3D*>& results) const {
+  ASSERT1(phases.size() == results.size());
+
+  const int nz = mesh.LocalNz;
+  const int ny = mesh.LocalNy;
+  // The slices are set in RGN_NOY
+  const int ny_slice = mesh.yend - mesh.ystart + 1;
+
+  if (method != ZShiftMethod::fft) {
+    BOUT_OMP(parallel) {
+      Array<BoutReal> buffer(nz + stencil_width - 1);
+
+      BOUT_OMP(for)
+      for (int ix = 0; ix < mesh.LocalNx; ix++) {
+        for (std::size_t i = 0; i < phases.size(); ++i) {
+          const auto& stencil = phases[i].stencil;
+          const int y_offset = phases[i].y_offset;
+
+          for (int iy = mesh.ystart; iy <= mesh.yend; iy++) {
+            applyStencil(stencil_width, &f(ix, iy + y_offset, 0), nz,
+                         stencil.start(ix, iy), &stencil.weights(ix, iy, 0),
+                         std::begin(buffer), &(*results[i])(ix, iy + y_offset, 0));
+          }
+        }
+      }
+    }
+    return;
   }
 
-  std::vector<Field3D> results{};
+  BOUT_OMP(parallel) {
+    // Modes of every column at one x, and of one slice after the shift
+    Array<dcomplex> f_fft(ny * nmodes);
+    Array<dcomplex> shifted(ny_slice * nmodes);
 
-  for (auto& phase : phases) {
-    // In C++17 std::vector::emplace_back returns a reference, which
-    // would be very useful here!
-    results.emplace_back(&mesh);
-    auto& current_result = results.back();
-    current_result.allocate();
-    current_result.setLocation(f.getLocation());
+    BOUT_OMP(for)
+    for (int ix = 0; ix < mesh.LocalNx; ix++) {
+      // Columns are contiguous, so all those at this x are transformed
+      // together, once, and then used for every slice
+      bout::fft::rfft(&f(ix, 0, 0), nz, ny, std::begin(f_fft));
 
-    BOUT_FOR(i, mesh.getRegion2D("RGN_NOY")) {
-      // Deep copy the FFT'd field
-      int ix = i.x();
-      int iy = i.y();
+      for (std::size_t i = 0; i < phases.size(); ++i) {
+        const auto& phase = phases[i];
 
-      Array<dcomplex> shifted_temp(f_fft(ix, iy + phase.y_offset));
-      shifted_temp.ensureUnique();
+        for (int iy = mesh.ystart; iy <= mesh.yend; iy++) {
+          applyPhase(&f_fft[(iy + phase.y_offset) * nmodes],
+                     &phase.phase_shift(ix, iy, 0), &shifted[(iy - mesh.ystart) * nmodes],
+                     nmodes);
+        }
 
-      for (int jz = 1; jz < nmodes; ++jz) {
-        shifted_temp[jz] *= phase.phase_shift(ix, iy, jz);
+        bout::fft::irfft(std::begin(shifted), nz, ny_slice,
+                         &(*results[i])(ix, mesh.ystart + phase.y_offset, 0));
       }
-
-      irfft(shifted_temp.begin(), mesh.LocalNz, &current_result(i.yp(phase.y_offset), 0));
     }
   }
-
-  return results;
 }
 
 // Old approach retained so we can still specify a general zShift
@@ -4,6 +4,9 @@
 #include "globals.hxx"
 #include "output.hxx"
 #include "parallel_boundary_op.hxx"
+#include <bout/openmpwrap.hxx>
+
+#include <algorithm>
 
 BoutReal BoundaryOpPar::getValue(int x, int y, int z, BoutReal t) {
 
@@ -64,6 +67,53 @@ BoutReal BoundaryOpPar::getValue(const BoundaryRegionPar &bndry, BoutReal t) {
 
 }
 
+const std::vector<BoutReal>& BoundaryOpPar::getValues(BoutReal t, bool at_intersection) {
+  const auto& points = bndry->points();
+  const int npoints = bndry->size();
+
+  if (values_fixed and static_cast<int>(values.size()) == npoints) {
+    return values;
+  }
+  values.resize(npoints);
+
+  Mesh* mesh = bndry->localmesh;
+
+  switch (value_type) {
+  case ValueType::GEN:
+    for (int i = 0; i < npoints; i++) {
+      BoutReal xnorm, ynorm, znorm;
+      if (at_intersection) {
+        xnorm = mesh->GlobalX(points.s_x[i]);
+        ynorm = mesh->GlobalY(points.s_y[i]);
+        znorm = points.s_z[i] / (mesh->LocalNz);
+      } else {
+        // The value at the grid point, as in getValue(x, y, z, t)
+        xnorm = mesh->GlobalX(points.x[i]);
+        ynorm = mesh->GlobalY(points.y[i]);
+        znorm = static_cast<BoutReal>(points.z[i]) / (mesh->LocalNz);
+      }
+      values[i] = gen_values->generate(xnorm, TWOPI * ynorm, TWOPI * znorm, t);
+    }
+    values_fixed = not gen_values->isTimeDependent();
+    break;
+  case ValueType::FIELD:
+    // The field may change between calls
+    for (int i = 0; i < npoints; i++) {
+      values[i] = (*field_values)(points.x[i], points.y[i], points.z[i]);
+    }
+    values_fixed = false;
+    break;
+  case ValueType::REAL:
+    std::fill(values.begin(), values.end(), real_value);
+    values_fixed = true;
+    break;
+  default:
+    throw BoutException("Invalid value_type encountered in BoundaryOpPar::getValues");
+  }
+
+  return values;
+}
+
 //////////////////////////////////////////
 // Dirichlet boundary
 
@@ -92,20 +142,32 @@ void BoundaryOpPar_dirichlet::apply(Field3D &f, BoutReal t) {
 
   Coordinates& coord = *(f.getCoordinates());
 
+  const auto& points = bndry->points();
+  const int npoints = bndry->size();
+  if (npoints == 0) {
+    return;
+  }
+  const auto& value = getValues(t);
+
+  // Flat indices into the fields, with the next point dir * nz along
+  const int ny = f.getNy(), nz = f.getNz();
+  const int next_offset = bndry->dir * nz;
+  const BoutReal* f_data = &f(0, 0, 0);
+  BoutReal* f_next_data = &f_next(0, 0, 0);
+  const BoutReal* dy = &coord.dy(0, 0);
+
   // Loop over grid points If point is in boundary, then fill in
   // f_next such that the field would be VALUE on the boundary
-  for (bndry->first(); !bndry->isDone(); bndry->next()) {
-    // temp variables for convenience
-    int x = bndry->x; int y = bndry->y; int z = bndry->z;
-
-    // Generate the boundary value
-    BoutReal value = getValue(*bndry, t);
+  BOUT_OMP(parallel for)
+  for (int n = 0; n < npoints; n++) {
+    const int i2d = points.x[n] * ny + points.y[n];
+    const int i = i2d * nz + points.z[n];
 
     // Scale the field and normalise to the desired value
-    BoutReal y_prime = bndry->length;
-    BoutReal f2 = (f(x,y,z) - value) * (coord.dy(x, y) - y_prime) / y_prime;
+    const BoutReal y_prime = points.length[n];
+    const BoutReal f2 = (f_data[i] - value[n]) * (dy[i2d] - y_prime) / y_prime;
 
-    f_next(x, y+bndry->dir, z) = value - f2;
+    f_next_data[i + next_offset] = value[n] - f2;
   }
 }
 
@@ -138,26 +200,41 @@ void BoundaryOpPar_dirichlet_O3::apply(Field3D &f, BoutReal t) {
 
   Coordinates& coord = *(f.getCoordinates());
 
+  const auto& points = bndry->points();
+  const int npoints = bndry->size();
+  if (npoints == 0) {
+    return;
+  }
+  const auto& value = getValues(t);
+
+  // Flat indices into the fields, with the next point dir * nz along
+  const int ny = f.getNy(), nz = f.getNz();
+  const int next_offset = bndry->dir * nz;
+  const BoutReal* f_data = &f(0, 0, 0);
+  const BoutReal* f_prev_data = &f_prev(0, 0, 0);
+  BoutReal* f_next_data = &f_next(0, 0, 0);
+  const BoutReal* dy = &coord.dy(0, 0);
+
   // Loop over grid points If point is in boundary, then fill in
   // f_next such that the field would be VALUE on the boundary
-  for (bndry->first(); !bndry->isDone(); bndry->next()) {
-    // temp variables for convenience
-    int x = bndry->x; int y = bndry->y; int z = bndry->z;
-
-    // Generate the boundary value
-    BoutReal fb = getValue(*bndry, t);
-    BoutReal f1 = f_prev(x, y-bndry->dir, z);
-    BoutReal f2 = f(x,y,z);
-    BoutReal l1 = coord.dy(x, y);
-    BoutReal l2 = bndry->length;
-    BoutReal l3 = coord.dy(x, y) - l2;
-
-    BoutReal denom = (l1*l1*l2 + l1*l2*l2);
-    BoutReal term1 = (l2*l2*l3 + l2*l3*l3);
-    BoutReal term2 = l1*(l1+l2+l3)*(l2+l3);
-    BoutReal term3 = l3*((l1+l2)*l3 + (l1+l2)*(l1+l2));
-
-    f_next(x, y+bndry->dir, z) = (term1*f1 + term2*fb - term3*f2)/denom;
+  BOUT_OMP(parallel for)
+  for (int n = 0; n < npoints; n++) {
+    const int i2d = points.x[n] * ny + points.y[n];
+    const int i = i2d * nz + points.z[n];
+
+    const BoutReal fb = value[n];
+    const BoutReal f1 = f_prev_data[i - next_offset];
+    const BoutReal f2 = f_data[i];
+    const BoutReal l1 = dy[i2d];
+    const BoutReal l2 = points.length[n];
+    const BoutReal l3 = dy[i2d] - l2;
+
+    const BoutReal denom = (l1*l1*l2 + l1*l2*l2);
+    const BoutReal term1 = (l2*l2*l3 + l2*l3*l3);
+    const BoutReal term2 = l1*(l1+l2+l3)*(l2+l3);
+    const BoutReal term3 = l3*((l1+l2)*l3 + (l1+l2)*(l1+l2));
+
+    f_next_data[i + next_offset] = (term1*f1 + term2*fb - term3*f2)/denom;
   }
 }
 
@@ -190,21 +267,36 @@ void BoundaryOpPar_dirichlet_interp::apply(Field3D &f, BoutReal t) {
 
   Coordinates& coord = *(f.getCoordinates());
 
+  const auto& points = bndry->points();
+  const int npoints = bndry->size();
+  if (npoints == 0) {
+    return;
+  }
+  const auto& value = getValues(t);
+
+  // Flat indices into the fields, with the next point dir * nz along
+  const int ny = f.getNy(), nz = f.getNz();
+  const int next_offset = bndry->dir * nz;
+  const BoutReal* f_data = &f(0, 0, 0);
+  const BoutReal* f_prev_data = &f_prev(0, 0, 0);
+  BoutReal* f_next_data = &f_next(0, 0, 0);
+  const BoutReal* dy_data = &coord.dy(0, 0);
+
   // Loop over grid points If point is in boundary, then fill in
   // f_next such that the field would be VALUE on the boundary
-  for (bndry->first(); !bndry->isDone(); bndry->next()) {
-    // temp variables for convenience
-    int x = bndry->x; int y = bndry->y; int z = bndry->z;
+  BOUT_OMP(parallel for)
+  for (int n = 0; n < npoints; n++) {
+    const int i2d = points.x[n] * ny + points.y[n];
+    const int i = i2d * nz + points.z[n];
 
-    // Generate the boundary value
-    BoutReal fs = getValue(*bndry, t);
+    const BoutReal fs = value[n];
 
     // Scale the field and normalise to the desired value
-    BoutReal dy = coord.dy(x, y);
-    BoutReal s = bndry->length*dy;
+    const BoutReal dy = dy_data[i2d];
+    const BoutReal s = points.length[n]*dy;
 
-    f_next(x, y+bndry->dir, z) = f_prev(x, y-bndry->dir, z)*(1.-(2.*s/(dy+s)))
-      + 2.*f(x, y, z)*((s-dy)/s)
+    f_next_data[i + next_offset] = f_prev_data[i - next_offset]*(1.-(2.*s/(dy+s)))
+      + 2.*f_data[i]*((s-dy)/s)
       + fs*(dy/s - (2./s + 1.));
   }
 
@@ -240,17 +332,30 @@ void BoundaryOpPar_neumann::apply(Field3D &f, BoutReal t) {
   
   Coordinates& coord = *(f.getCoordinates());
 
+  const auto& points = bndry->points();
+  const int npoints = bndry->size();
+  if (npoints == 0) {
+    return;
+  }
+  // Values at the grid points
+  const auto& value = getValues(t, false);
+
+  // Flat indices into the fields, with the next point dir * nz along
+  const int ny = f.getNy(), nz = f.getNz();
+  const int dir = bndry->dir;
+  const int next_offset = dir * nz;
+  const BoutReal* f_data = &f(0, 0, 0);
+  BoutReal* f_next_data = &f_next(0, 0, 0);
+  const BoutReal* dy = &coord.dy(0, 0);
+
   // If point is in boundary, then fill in f_next such that the derivative
   // would be VALUE on the boundary
-  for (bndry->first(); !bndry->isDone(); bndry->next()) {
-    // temp variables for convience
-    int x = bndry->x; int y = bndry->y; int z = bndry->z;
-
-    // Generate the boundary value
-    BoutReal value = getValue(x, y, z, t);
-    BoutReal dy = coord.dy(x, y);
+  BOUT_OMP(parallel for)
+  for (int n = 0; n < npoints; n++) {
+    const int i2d = points.x[n] * ny + points.y[n];
+    const int i = i2d * nz + points.z[n];
 
-    f_next(x, y+bndry->dir, z) = f(x, y, z) + bndry->dir*value*dy;
+    f_next_data[i + next_offset] = f_data[i] + dir*value[n]*dy[i2d];
   }
 
 }
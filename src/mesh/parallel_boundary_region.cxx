@@ -3,38 +3,39 @@
 void BoundaryRegionPar::add_point(const int jx, const int jy, const int jz,
                                   const BoutReal x, const BoutReal y, const BoutReal z,
                                   const BoutReal length, const BoutReal angle) {
-  bndry_points.push_back({{jx, jy, jz}, {x, y, z}, length, angle});
+  bndry_points.x.push_back(jx);
+  bndry_points.y.push_back(jy);
+  bndry_points.z.push_back(jz);
+  bndry_points.s_x.push_back(x);
+  bndry_points.s_y.push_back(y);
+  bndry_points.s_z.push_back(z);
+  bndry_points.length.push_back(length);
+  bndry_points.angle.push_back(angle);
 }
 
-void BoundaryRegionPar::first() {
-  bndry_position = begin(bndry_points);
+void BoundaryRegionPar::setPosition() {
   if (!isDone()) {
-    x      = bndry_position->index.jx;
-    y      = bndry_position->index.jy;
-    z      = bndry_position->index.jz;
-    s_x    = bndry_position->intersection.s_x;
-    s_y    = bndry_position->intersection.s_y;
-    s_z    = bndry_position->intersection.s_z;
-    length = bndry_position->length;
-    angle  = bndry_position->angle;
+    x      = bndry_points.x[bndry_position];
+    y      = bndry_points.y[bndry_position];
+    z      = bndry_points.z[bndry_position];
+    s_x    = bndry_points.s_x[bndry_position];
+    s_y    = bndry_points.s_y[bndry_position];
+    s_z    = bndry_points.s_z[bndry_position];
+    length = bndry_points.length[bndry_position];
+    angle  = bndry_points.angle[bndry_position];
   }
 }
 
+void BoundaryRegionPar::first() {
+  bndry_position = 0;
+  setPosition();
+}
+
 void BoundaryRegionPar::next() {
   ++bndry_position;
-  if (!isDone()) {
-    x      = bndry_position->index.jx;
-    y      = bndry_position->index.jy;
-    z      = bndry_position->index.jz;
-    s_x    = bndry_position->intersection.s_x;
-    s_y    = bndry_position->intersection.s_y;
-    s_z    = bndry_position->intersection.s_z;
-    length = bndry_position->length;
-    angle  = bndry_position->angle;
-  }
+  setPosition();
 }
 
 bool BoundaryRegionPar::isDone() {
-  return (bndry_position == end(bndry_points));
+  return (bndry_position == bndry_points.x.size());
 }
-
@@ -6,6 +6,8 @@
 #include "bout/constants.hxx"
 #include "bout/fv_ops.hxx"
 
+#include <vector>
+
 namespace bout {
 
 Field3D HeatFluxSNB::divHeatFlux(const Field3D& Te, const Field3D& Ne,
@@ -47,29 +49,51 @@ Field3D HeatFluxSNB::divHeatFlux(const Field3D& Te, const Field3D& Ne,
 
   Field3D Div_Q = Div_Q_SH; // Divergence of heat flux. Corrections added for each group
 
+  if (batch_groups) {
+    // Set up all groups, then solve them together
+    std::vector<BoutReal> weights(ngroups);
+    std::vector<Field3D> lambda_g_ee(ngroups);
+    std::vector<Field3D> rhs(ngroups);
+    std::vector<InvertPar::Coefficients> coefs(ngroups);
+
+    for (int i = 0; i < ngroups; i++) {
+      BoutReal beta = beta_last + dbeta;
+      EnergyGroup group =
+          energyGroup(beta_last, beta, lambda_ee_Tprime, lambda_ei_Tprime, coord);
+
+      weights[i] = group.weight;
+      lambda_g_ee[i] = group.lambda_g_ee;
+      coefs[i] = group.coefs;
+      rhs[i] = (-weights[i]) * Div_Q_SH;
+
+      beta_last = beta;
+    }
+
+    // Solve to get H_g for all groups
+    std::vector<Field3D> H_g = invertpar->solve(rhs, coefs);
+
+    for (int i = 0; i < ngroups; i++) {
+      Div_Q -= weights[i] * Div_Q_SH + H_g[i] / lambda_g_ee[i];
+    }
+    return Div_Q;
+  }
+
   for (int i = 0; i < ngroups; i++) {
     BoutReal beta = beta_last + dbeta;
-    BoutReal weight = groupWeight(beta_last, beta);
-
-    // Mean free paths for this group
-    Field3D lambda_g_ee = SQ(beta) * lambda_ee_Tprime;
-    Field3D lambda_g_ei = SQ(beta) * lambda_ei_Tprime;
+    EnergyGroup group =
+        energyGroup(beta_last, beta, lambda_ee_Tprime, lambda_ei_Tprime, coord);
 
     // Update coefficients in solver
-    invertpar->setCoefA(1. / lambda_g_ee); // Constant term
-
-    // The divergence term is implemented as a second derivative and first derivative
-    // correction
-    Field3D coefB = (-1. / 3) * lambda_g_ei;
-    invertpar->setCoefB(coefB);                                          // Grad2_par2
-    invertpar->setCoefE(DDY(coefB * coord->J / coord->g_22) / coord->J); // DDY
+    invertpar->setCoefA(group.coefs.A);
+    invertpar->setCoefB(group.coefs.B);
+    invertpar->setCoefE(group.coefs.E);
 
     // Solve to get H_g
-    Field3D H_g = invertpar->solve((-weight) * Div_Q_SH);
+    Field3D H_g = invertpar->solve((-group.weight) * Div_Q_SH);
 
     // Add correction to divergence of heat flux
     // Note: The sum of weight over all groups approaches 1 as beta_max -> infinity
-    Div_Q -= weight * Div_Q_SH + H_g / lambda_g_ee;
+    Div_Q -= group.weight * Div_Q_SH + H_g / group.lambda_g_ee;
 
     // move to next group, updating lower limit
     beta_last = beta;
@@ -78,4 +102,25 @@ Field3D HeatFluxSNB::divHeatFlux(const Field3D& Te, const Field3D& Ne,
   return Div_Q;
 }
 
+HeatFluxSNB::EnergyGroup HeatFluxSNB::energyGroup(BoutReal beta_min, BoutReal beta,
+                                                  const Field3D& lambda_ee_Tprime,
+                                                  const Field3D& lambda_ei_Tprime,
+                                                  Coordinates* coord) {
+  EnergyGroup group;
+  group.weight = groupWeight(beta_min, beta);
+
+  // Mean free paths for this group
+  group.lambda_g_ee = SQ(beta) * lambda_ee_Tprime;
+  Field3D lambda_g_ei = SQ(beta) * lambda_ei_Tprime;
+
+  group.coefs.A = DC(1. / group.lambda_g_ee); // Constant term
+
+  // The divergence term is implemented as a second derivative and first derivative
+  // correction
+  Field3D coefB = (-1. / 3) * lambda_g_ei;
+  group.coefs.B = DC(coefB);                                          // Grad2_par2
+  group.coefs.E = DC(DDY(coefB * coord->J / coord->g_22) / coord->J); // DDY
+  return group;
+}
+
 } // namespace bout
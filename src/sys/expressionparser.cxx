@@ -46,6 +46,7 @@ public:
     return x;
   }
   std::string str() const override { return std::string("x"); }
+  bool isTimeDependent() const override { return false; }
 };
 
 class FieldY : public FieldGenerator {
@@ -58,6 +59,7 @@ public:
     return y;
   }
   std::string str() const override { return std::string("y"); }
+  bool isTimeDependent() const override { return false; }
 };
 
 class FieldZ : public FieldGenerator {
@@ -70,6 +72,7 @@ public:
     return z;
   }
   std::string str() const override { return std::string("z"); }
+  bool isTimeDependent() const override { return false; }
 };
 
 class FieldT : public FieldGenerator {
@@ -11,6 +11,7 @@
 #include <string>
 
 #include "bout.hxx"
+#include "boutcomm.hxx"
 #include "bout/constants.hxx"
 #include "field_factory.hxx"
 #include "interpolation_factory.hxx"
@@ -92,6 +93,28 @@ int main(int argc, char **argv) {
   b_interp = interp->interpolate(b, deltax, deltaz);
   c_interp = interp->interpolate(c, deltax, deltaz);
 
+  // Optionally time the weights calculation and the interpolation
+  const int repeats = Options::root()["benchmark_repeats"]
+                          .doc("Number of timed calls of calcWeights and interpolate. "
+                               "Zero to skip the benchmark")
+                          .withDefault(0);
+  if (repeats > 0) {
+    BoutReal start = MPI_Wtime();
+    for (int i = 0; i < repeats; i++) {
+      interp->calcWeights(deltax, deltaz);
+    }
+    const BoutReal weights_time = (MPI_Wtime() - start) / repeats;
+
+    start = MPI_Wtime();
+    for (int i = 0; i < repeats; i++) {
+      a_interp = interp->interpolate(a);
+    }
+    const BoutReal interp_time = (MPI_Wtime() - start) / repeats;
+
+    output.write("Benchmark: calcWeights %e s, interpolate %e s\n", weights_time,
+                 interp_time);
+  }
+
   SAVE_ONCE3(a, a_interp, a_solution);
   SAVE_ONCE3(b, b_interp, b_solution);
   SAVE_ONCE3(c, c_interp, c_solution);
@@ -9,6 +9,8 @@
 #include <field_factory.hxx>
 #include <utils.hxx>
 
+#include <vector>
+
 int main(int argc, char **argv) {
 
   // Initialise BOUT++, setting up mesh
@@ -67,6 +69,41 @@ int main(int argc, char **argv) {
     }
   }
 
+  // Solving several systems together gives the same results as
+  // solving each of them in turn
+  std::vector<InvertPar::Coefficients> coefs(2);
+  coefs[0].A = A;
+  coefs[0].B = B;
+  coefs[0].C = C;
+  coefs[0].D = D;
+  coefs[0].E = E;
+  coefs[1].A = 2.0 * A + 0.5;
+  coefs[1].B = 0.5 * B;
+  coefs[1].C = C;
+  coefs[1].D = D;
+  coefs[1].E = E;
+  const std::vector<Field3D> inputs = {input, 1.0 + 2.0 * input};
+
+  const std::vector<Field3D> results = inv->solve(inputs, coefs);
+
+  for (std::size_t i = 0; i < inputs.size(); i++) {
+    inv->setCoefA(coefs[i].A);
+    inv->setCoefB(coefs[i].B);
+    inv->setCoefC(coefs[i].C);
+    inv->setCoefD(coefs[i].D);
+    inv->setCoefE(coefs[i].E);
+    const Field3D single = inv->solve(inputs[i]);
+
+    for (const auto& index : single.getRegion("RGN_NOBNDRY")) {
+      if (abs(results[i][index] - single[index])
+          > 1e-12 * (abs(results[i][index]) + abs(single[index])) + 1e-14) {
+        output.write("system %d: solved together %e, alone %e\n", static_cast<int>(i),
+                     results[i][index], single[index]);
+        passed = 0;
+      }
+    }
+  }
+
   int allpassed;
   MPI_Allreduce(&passed, &allpassed, 1, MPI_INT, MPI_MIN, BoutComm::get());
 
@@ -0,0 +1,44 @@
+/*
+ * Compare the PDD Laplacian solver against the cyclic solver, on a
+ * diagonally dominant problem where the terms PDD neglects are small
+ *
+ */
+
+#include <bout.hxx>
+#include <field_factory.hxx>
+#include <invert_laplace.hxx>
+
+int main(int argc, char** argv) {
+  BoutInitialise(argc, argv);
+
+  FieldFactory factory(mesh);
+  const Field3D input =
+      factory.create3D("(1-gauss(x-0.5,0.2))*gauss(y-pi)*gauss(z-pi) + 0.1*sin(3*z)");
+  const Field2D a = factory.create2D("-2e4 * (1 + gauss(x) * sin(y)^2)");
+  const Field2D c = factory.create2D("1 + 0.1 * sin(x) * gauss(y-pi)");
+
+  auto* pdd = Laplacian::create(Options::getRoot()->getSection("laplace"));
+  auto* reference = Laplacian::create(Options::getRoot()->getSection("reference"));
+
+  for (auto* lap : {pdd, reference}) {
+    lap->setCoefA(a);
+    lap->setCoefC(c);
+  }
+
+  const Field3D result = pdd->solve(input);
+  const Field3D expected = reference->solve(input);
+
+  // Relative to the size of the solution
+  BoutReal error = max(abs(result - expected), true) / max(abs(expected), true);
+  output.write("Relative error: %e\n", error);
+  SAVE_ONCE(error);
+
+  delete pdd;
+  delete reference;
+
+  dump.write();
+  dump.close();
+
+  BoutFinalise();
+  return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Laplacian solvers may keep their matrix, preconditioner or
+ * factorisation between solves while the coefficients are unchanged.
+ * Check that solves which do this agree with a new solver, and that
+ * changing a coefficient makes the solver start again.
+ */
+
+#include <bout.hxx>
+#include <boutexception.hxx>
+#include <field_factory.hxx>
+#include <invert_laplace.hxx>
+#include <output.hxx>
+
+#include <memory>
+
+// Convert __LINE__ to string S__LINE__
+#define S(x) #x
+#define S_(x) S(x)
+#define S__LINE__ S_(__LINE__)
+
+#define EXPECT_TRUE(expr)                                                       \
+  if (!expr) {                                                                  \
+    throw BoutException("Line " S__LINE__ " Expected true, got false: " #expr); \
+  }
+
+#define EXPECT_FALSE(expr)                                                      \
+  if (expr) {                                                                   \
+    throw BoutException("Line " S__LINE__ " Expected false, got true: " #expr); \
+  }
+
+/// Is \p field equal to \p reference, with a tolerance of \p tolerance?
+template <class T, class U>
+bool IsFieldEqual(const T& field, const U& reference,
+                  const std::string& region = "RGN_ALL", BoutReal tolerance = 1e-10) {
+  for (auto i : field.getRegion(region)) {
+    if (fabs(field[i] - reference[i]) > tolerance) {
+      output.write("Field: %e, reference: %e, tolerance: %e\n", field[i], reference[i],
+                   tolerance);
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Solve with a new solver, with options \p options and coefficients
+/// \p a and \p c
+Field3D solveWithNewSolver(Options& options, const Field2D& a, const Field2D& c,
+                           const Field3D& input) {
+  std::unique_ptr<Laplacian> solver{Laplacian::create(&options)};
+  solver->setCoefA(a);
+  solver->setCoefC(c);
+  return solver->solve(input);
+}
+
+int main(int argc, char** argv) {
+  BoutInitialise(argc, argv);
+
+  FieldFactory factory;
+  auto& options = Options::root()["laplace"];
+
+  const Field3D input1 = factory.create3D("(1-gauss(x-0.5,0.2))*gauss(z-pi)");
+  const Field3D input2 = factory.create3D("sin(2*pi*x)*cos(z)");
+  const Field2D a = factory.create2D("1 + gauss(x)");
+  const Field2D a_changed = factory.create2D("2 + x");
+  const Field2D c = factory.create2D("1 + 0.5*sin(x)");
+
+  // Agreement expected between two converged solves
+  const BoutReal tolerance = 1e-8;
+
+  std::unique_ptr<Laplacian> solver{Laplacian::create(&options)};
+  solver->setCoefA(a);
+  solver->setCoefC(c);
+
+  // The first solve sets up the matrix, the second reuses it
+  Field3D result1 = solver->solve(input1);
+  Field3D result2 = solver->solve(input2);
+
+  EXPECT_TRUE(IsFieldEqual(result1, solveWithNewSolver(options, a, c, input1),
+                           "RGN_NOBNDRY", tolerance));
+  EXPECT_TRUE(IsFieldEqual(result2, solveWithNewSolver(options, a, c, input2),
+                           "RGN_NOBNDRY", tolerance));
+
+  // Changing a coefficient must rebuild the matrix, which is then reused
+  solver->setCoefA(a_changed);
+  Field3D result3 = solver->solve(input1);
+  Field3D result4 = solver->solve(input2);
+
+  EXPECT_TRUE(IsFieldEqual(result3, solveWithNewSolver(options, a_changed, c, input1),
+                           "RGN_NOBNDRY", tolerance));
+  EXPECT_TRUE(IsFieldEqual(result4, solveWithNewSolver(options, a_changed, c, input2),
+                           "RGN_NOBNDRY", tolerance));
+
+  // The changed coefficient must make a difference
+  EXPECT_FALSE(IsFieldEqual(result3, result1, "RGN_NOBNDRY", tolerance));
+
+  BoutFinalise();
+
+  output << "All tests passed\n";
+
+  return 0;
+}
@@ -48,6 +48,7 @@ int main(int argc, char** argv) {
   Field3D f1,a1,b1,c1,d1,sol1,bcheck1;
   Field3D absolute_error1;
   BoutReal max_error1; //Output of test
+  BoutReal iterations1; // Mean number of iterations
 
   dump.add(mesh->getCoordinates()->G1,"G1");
   dump.add(mesh->getCoordinates()->G3,"G3");
@@ -86,7 +87,8 @@ int main(int argc, char** argv) {
 
   output<<endl<<"Test 1: zero Dirichlet"<<endl;
   output<<"Magnitude of maximum absolute error is "<<max_error1<<endl;
-  output<<"Solver took "<<invert.getMeanIterations()<<" iterations to converge"<<endl;
+  iterations1 = invert.getMeanIterations();
+  output<<"Solver took "<<iterations1<<" iterations to converge"<<endl;
 
   dump.add(a1,"a1");
   dump.add(b1,"b1");
@@ -97,6 +99,7 @@ int main(int argc, char** argv) {
   dump.add(bcheck1,"bcheck1");
   dump.add(absolute_error1,"absolute_error1");
   dump.add(max_error1,"max_error1");
+  dump.add(iterations1,"iterations1");
 
   ////////////////////////////////////////////////////////////////////////////////
 
@@ -104,6 +107,7 @@ int main(int argc, char** argv) {
   Field3D f2,a2,b2,c2,d2,sol2,bcheck2;
   Field3D absolute_error2;
   BoutReal max_error2; //Output of test
+  BoutReal iterations2; // Mean number of iterations
   // Test 2: zero-value Neumann boundaries
   f2 = FieldFactory::get()->create3D("f2:function", Options::getRoot(), mesh);
   d2 = FieldFactory::get()->create3D("d2:function", Options::getRoot(), mesh);
@@ -136,7 +140,8 @@ int main(int argc, char** argv) {
 
   output<<endl<<"Test 2: zero Neumann"<<endl;
   output<<"Magnitude of maximum absolute error is "<<max_error2<<endl;
-  output<<"Solver took "<<invert.getMeanIterations()<<" iterations to converge"<<endl;
+  iterations2 = invert.getMeanIterations();
+  output<<"Solver took "<<iterations2<<" iterations to converge"<<endl;
 
   dump.add(a2,"a2");
   dump.add(b2,"b2");
@@ -147,6 +152,7 @@ int main(int argc, char** argv) {
   dump.add(bcheck2,"bcheck2");
   dump.add(absolute_error2,"absolute_error2");
   dump.add(max_error2,"max_error2");
+  dump.add(iterations2,"iterations2");
 
   ////////////////////////////////////////////////////////////////////////////////
 
@@ -154,6 +160,7 @@ int main(int argc, char** argv) {
   Field3D f3,a3,b3,c3,d3,sol3,bcheck3;
   Field3D absolute_error3;
   BoutReal max_error3; //Output of test
+  BoutReal iterations3; // Mean number of iterations
   // Test 3: set-value Dirichlet boundaries
   f3 = FieldFactory::get()->create3D("f3:function", Options::getRoot(), mesh);
   d3 = FieldFactory::get()->create3D("d3:function", Options::getRoot(), mesh);
@@ -195,7 +202,8 @@ int main(int argc, char** argv) {
 
   output<<endl<<"Test 3: set Dirichlet"<<endl;
   output<<"Magnitude of maximum absolute error is "<<max_error3<<endl;
-  output<<"Solver took "<<invert.getMeanIterations()<<" iterations to converge"<<endl;
+  iterations3 = invert.getMeanIterations();
+  output<<"Solver took "<<iterations3<<" iterations to converge"<<endl;
 
   dump.add(a3,"a3");
   dump.add(b3,"b3");
@@ -206,6 +214,7 @@ int main(int argc, char** argv) {
   dump.add(bcheck3,"bcheck3");
   dump.add(absolute_error3,"absolute_error3");
   dump.add(max_error3,"max_error3");
+  dump.add(iterations3,"iterations3");
 
   ////////////////////////////////////////////////////////////////////////////////
 
@@ -213,6 +222,7 @@ int main(int argc, char** argv) {
   Field3D f4,a4,b4,c4,d4,sol4,bcheck4;
   Field3D absolute_error4;
   BoutReal max_error4; //Output of test
+  BoutReal iterations4; // Mean number of iterations
   // Test 4: set-value Neumann boundaries
   f4 = FieldFactory::get()->create3D("f4:function", Options::getRoot(), mesh);
   d4 = FieldFactory::get()->create3D("d4:function", Options::getRoot(), mesh);
@@ -258,7 +268,8 @@ int main(int argc, char** argv) {
 
   output<<endl<<"Test 4: set Neumann"<<endl;
   output<<"Magnitude of maximum absolute error is "<<max_error4<<endl;
-  output<<"Solver took "<<invert.getMeanIterations()<<" iterations to converge"<<endl;
+  iterations4 = invert.getMeanIterations();
+  output<<"Solver took "<<iterations4<<" iterations to converge"<<endl;
 
   dump.add(a4,"a4");
   dump.add(b4,"b4");
@@ -269,6 +280,7 @@ int main(int argc, char** argv) {
   dump.add(bcheck4,"bcheck4");
   dump.add(absolute_error4,"absolute_error4");
   dump.add(max_error4,"max_error4");
+  dump.add(iterations4,"iterations4");
 
   ////////////////////////////////////////////////////////////////////////////////
 
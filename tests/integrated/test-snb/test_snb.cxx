@@ -181,6 +181,35 @@ int main(int argc, char** argv) {
     }
   }
 
+  ///////////////////////////////////////////////////////////
+  // Solving all the energy groups together gives the same fluxes as
+  // solving them in turn
+
+  {
+    FieldFactory factory;
+    auto Te = factory.create3D("10 + 0.01*sin(y)");
+    auto Ne = factory.create3D("1e19 * (1 + 0.5*sin(y))");
+    mesh->communicate(Te, Ne);
+
+    Options sequential_options;
+    sequential_options["batch_groups"] = false;
+    HeatFluxSNB snb_sequential(sequential_options);
+
+    Options batched_options;
+    batched_options["batch_groups"] = true;
+    HeatFluxSNB snb_batched(batched_options);
+
+    Field3D Div_q_SH_sequential;
+    Field3D Div_q_sequential = snb_sequential.divHeatFlux(Te, Ne, &Div_q_SH_sequential);
+
+    Field3D Div_q_SH_batched;
+    Field3D Div_q_batched = snb_batched.divHeatFlux(Te, Ne, &Div_q_SH_batched);
+
+    // Check that the fluxes agree to rounding
+    EXPECT_TRUE(IsFieldClose(Div_q_SH_batched, Div_q_SH_sequential, "RGN_NOBNDRY", 1e-12));
+    EXPECT_TRUE(IsFieldClose(Div_q_batched, Div_q_sequential, "RGN_NOBNDRY", 1e-12));
+  }
+
   BoutFinalise();
 
   output << "All tests passed\n";
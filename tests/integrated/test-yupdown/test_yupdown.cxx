@@ -1,8 +1,12 @@
 #include <bout.hxx>
 
 #include <bout/paralleltransform.hxx>
+#include <boutcomm.hxx>
 #include <derivs.hxx>
 
+#include <string>
+#include <vector>
+
 // Y derivative using yup() and ydown() fields
 const Field3D DDY_yud(const Field3D& f) {
   Field3D result = emptyFrom(f);
@@ -27,6 +31,15 @@ const Field3D DDY_aligned(const Field3D& f) {
   return result;
 }
 
+// Average time for a round trip to field-aligned coordinates and back
+BoutReal timeRoundTrip(ShiftedMetric& transform, const Field3D& f, int repeats) {
+  const BoutReal start = MPI_Wtime();
+  for (int i = 0; i < repeats; i++) {
+    Field3D round_trip = transform.fromFieldAligned(transform.toFieldAligned(f));
+  }
+  return (MPI_Wtime() - start) / repeats;
+}
+
 int main(int argc, char** argv) {
 
   BoutInitialise(argc, argv);
@@ -64,6 +77,46 @@ int main(int argc, char** argv) {
   ddy_check = fromFieldAligned(ddy_check);
 
   SAVE_ONCE3(ddy, ddy2, ddy_check);
+
+  // Compare interpolating in z with the FFTs, using the same zShift
+  const int repeats =
+      Options::root()["repeats"]
+          .doc("Number of round trips to field-aligned and back to time")
+          .withDefault(10);
+  const BoutReal zlength = mesh->getCoordinates()->zlength();
+
+  output.write("\n%-14s %-14s %-14s %-14s\n", "method", "time", "slices error",
+               "aligned error");
+  output.write("%-14s %-14e %-14s %-14s\n", "fft", timeRoundTrip(s, var2, repeats), "-",
+               "-");
+
+  const std::vector<ZShiftMethod> methods = {
+      ZShiftMethod::lagrange4pt, ZShiftMethod::lagrange6pt, ZShiftMethod::hermitespline};
+  // Sized here, as the output keeps pointers to the fields
+  std::vector<Field3D> ddy_interp(methods.size());
+  std::vector<Field3D> ddy_interp_aligned(methods.size());
+
+  for (std::size_t i = 0; i < methods.size(); i++) {
+    ShiftedMetric s_interp(*mesh, CELL_CENTRE, zShift, zlength, methods[i]);
+
+    // d/dy using parallel slices
+    Field3D var_interp = copy(var2);
+    s_interp.calcParallelSlices(var_interp);
+    ddy_interp[i] = DDY_yud(var_interp);
+
+    // d/dy by transforming to field-aligned coordinates
+    ddy_interp_aligned[i] =
+        s_interp.fromFieldAligned(DDY_aligned(s_interp.toFieldAligned(var2)));
+
+    const std::string name = toString(methods[i]);
+    dump.addOnce(ddy_interp[i], "ddy_" + name);
+    dump.addOnce(ddy_interp_aligned[i], "ddy_aligned_" + name);
+
+    output.write("%-14s %-14e %-14e %-14e\n", name.c_str(),
+                 timeRoundTrip(s_interp, var2, repeats),
+                 max(abs(ddy_interp[i] - ddy_check), true, "RGN_NOBNDRY"),
+                 max(abs(ddy_interp_aligned[i] - ddy_check), true, "RGN_NOBNDRY"));
+  }
   dump.write();
 
   BoutFinalise();
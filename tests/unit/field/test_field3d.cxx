@@ -319,6 +319,311 @@ TEST_F(Field3DTest, ConstYnext) {
 #endif
 }
 
+TEST_F(Field3DTest, InvalidateParallelSlices) {
+  Field3D field{1.0};
+
+  field.splitParallelSlices();
+  field.yup() = 2.0;
+
+  field.invalidateParallelSlices();
+
+  EXPECT_TRUE(field.parallelSlicesPending());
+  EXPECT_TRUE(field.hasParallelSlices());
+
+  // Calculated with the identity transform on first use, through a const reference
+  const Field3D& field2 = field;
+  EXPECT_TRUE(IsFieldEqual(field2.yup(), 1.0));
+  EXPECT_FALSE(field.parallelSlicesPending());
+  EXPECT_TRUE(IsFieldEqual(field2.ydown(), 1.0));
+  EXPECT_TRUE(IsFieldEqual(field2.ynext(1), 1.0));
+}
+
+TEST_F(Field3DTest, InvalidateParallelSlicesThenWrite) {
+  Field3D field{1.0};
+
+  field.invalidateParallelSlices();
+  field = 2.0;
+
+  EXPECT_FALSE(field.parallelSlicesPending());
+  EXPECT_FALSE(field.hasParallelSlices());
+
+  field.invalidateParallelSlices();
+  field += 1.0;
+
+  EXPECT_FALSE(field.parallelSlicesPending());
+  EXPECT_FALSE(field.hasParallelSlices());
+
+  field.invalidateParallelSlices();
+  field.clearParallelSlices();
+
+  EXPECT_FALSE(field.parallelSlicesPending());
+  EXPECT_FALSE(field.hasParallelSlices());
+}
+
+TEST_F(Field3DTest, InvalidateParallelSlicesCopy) {
+  Field3D field{1.0};
+
+  field.invalidateParallelSlices();
+
+  // Parallel slices are not copied, pending or not
+  Field3D field2{field};
+  EXPECT_FALSE(field2.hasParallelSlices());
+
+  Field3D field3{std::move(field)};
+  EXPECT_TRUE(field3.parallelSlicesPending());
+}
+
+TEST_F(Field3DTest, CommunicateParallelSlices) {
+  Field3D field{1.0};
+
+  mesh->communicate(field);
+
+  // Not lazy by default
+  EXPECT_FALSE(field.parallelSlicesPending());
+  EXPECT_TRUE(field.hasParallelSlices());
+  EXPECT_TRUE(IsFieldEqual(field.yup(), 1.0));
+
+  Field3D field2{1.0};
+  field2.setParallelSlicesOnCommunicate(false);
+  EXPECT_FALSE(field2.parallelSlicesOnCommunicate());
+
+  mesh->communicate(field2);
+
+  EXPECT_FALSE(field2.parallelSlicesPending());
+  EXPECT_FALSE(field2.hasParallelSlices());
+
+  // Assignment doesn't change the setting
+  field2 = field;
+  EXPECT_FALSE(field2.parallelSlicesOnCommunicate());
+}
+
+TEST_F(Field3DTest, CommunicateParallelSlicesLazy) {
+  static_cast<FakeMesh*>(mesh)->setLazyParallelSlices(true);
+
+  Field3D field{1.0};
+
+  mesh->communicate(field);
+
+  EXPECT_TRUE(field.parallelSlicesPending());
+  EXPECT_TRUE(IsFieldEqual(field.yup(), 1.0));
+  EXPECT_FALSE(field.parallelSlicesPending());
+
+  static_cast<FakeMesh*>(mesh)->setLazyParallelSlices(false);
+
+  mesh->communicate(field);
+
+  EXPECT_FALSE(field.parallelSlicesPending());
+  EXPECT_TRUE(field.hasParallelSlices());
+}
+
+namespace {
+/// Identity transform, except that the parallel slices are new fields
+/// rather than sharing the data of the field
+class CopyParallelTransform : public ParallelTransformIdentity {
+public:
+  using ParallelTransformIdentity::ParallelTransformIdentity;
+  void calcParallelSlices(Field3D& f) override {
+    f.splitParallelSlices();
+    for (int i = 0; i < f.getMesh()->ystart; ++i) {
+      f.yup(i) = f + 1.0;
+      f.ydown(i) = f - 1.0;
+    }
+  }
+};
+} // namespace
+
+TEST_F(Field3DTest, CommunicateParallelSlicesThenWrite) {
+  mesh->getCoordinates()->setParallelTransform(
+      bout::utils::make_unique<CopyParallelTransform>(*mesh));
+
+  for (bool lazy : {false, true}) {
+    static_cast<FakeMesh*>(mesh)->setLazyParallelSlices(lazy);
+
+    Field3D field{1.0};
+    mesh->communicate(field);
+
+    // Changing points after communicating, as a boundary condition
+    // would, doesn't change the slices, lazy or not
+    field(0, 0, 0) = 5.0;
+    field[Ind3D{1}] = 5.0;
+
+    EXPECT_DOUBLE_EQ(field.yup()(0, 0, 0), 2.0) << "lazy = " << lazy;
+    EXPECT_DOUBLE_EQ(field.ydown()(0, 0, 0), 0.0) << "lazy = " << lazy;
+    EXPECT_DOUBLE_EQ(field.yup()[Ind3D{1}], 2.0) << "lazy = " << lazy;
+  }
+
+  static_cast<FakeMesh*>(mesh)->setLazyParallelSlices(false);
+}
+
+TEST_F(Field3DTest, InvalidateParallelSlicesThreads) {
+  Field3D field{1.0};
+
+  field.invalidateParallelSlices();
+
+  const Field3D& field2 = field;
+  int errors = 0;
+  BOUT_OMP(parallel for reduction(+:errors))
+  for (int i = 0; i < 16; ++i) {
+    if (field2.yup()(0, 0, 0) != 1.0) {
+      ++errors;
+    }
+  }
+
+  EXPECT_EQ(errors, 0);
+  EXPECT_FALSE(field.parallelSlicesPending());
+}
+
+TEST_F(Field3DTest, FieldAlignedCache) {
+  Field3D field{1.0};
+  field.setCacheFieldAligned(true);
+  EXPECT_TRUE(field.cacheFieldAligned());
+
+  Field3D::resetFieldAlignedCacheStats();
+
+  const Field3D aligned = toFieldAligned(field);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().misses, 1);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 0);
+
+  const Field3D aligned2 = toFieldAligned(field);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().misses, 1);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 1);
+
+  EXPECT_TRUE(IsFieldEqual(aligned2, 1.0));
+  EXPECT_TRUE(aligned2.getDirectionY() == YDirectionType::Aligned);
+
+  // Copies share the data and the setting, so use the same cache
+  Field3D field2{field};
+  EXPECT_TRUE(field2.cacheFieldAligned());
+  toFieldAligned(field2);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 2);
+
+  // Assignment keeps the setting of the field assigned to
+  Field3D field3{0.0};
+  field3 = field;
+  EXPECT_FALSE(field3.cacheFieldAligned());
+  toFieldAligned(field3);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 2);
+
+  Field3D field4{0.0};
+  field4.setCacheFieldAligned(true);
+  field4 = field;
+  toFieldAligned(field4);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 3);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().misses, 1);
+}
+
+TEST_F(Field3DTest, FieldAlignedCacheRegion) {
+  Field3D field{1.0};
+  field.setCacheFieldAligned(true);
+
+  Field3D::resetFieldAlignedCacheStats();
+
+  toFieldAligned(field, "RGN_NOX");
+  toFieldAligned(field, "RGN_NOX");
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().misses, 1);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 1);
+
+  // Not covered by RGN_NOX
+  toFieldAligned(field, "RGN_ALL");
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().misses, 2);
+
+  // RGN_ALL covers everything
+  toFieldAligned(field, "RGN_NOY");
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().misses, 2);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 2);
+}
+
+TEST_F(Field3DTest, FieldAlignedCacheWrite) {
+  Field3D field{1.0};
+  field.setCacheFieldAligned(true);
+
+  Field3D::resetFieldAlignedCacheStats();
+
+  toFieldAligned(field);
+  field = 2.0;
+  EXPECT_TRUE(IsFieldEqual(toFieldAligned(field), 2.0));
+
+  field += 1.0;
+  EXPECT_TRUE(IsFieldEqual(toFieldAligned(field), 3.0));
+
+  field.allocate();
+  toFieldAligned(field);
+
+  mesh->communicate(field);
+  toFieldAligned(field);
+
+  field.applyBoundary("dirichlet");
+  toFieldAligned(field);
+
+  field.clearFieldAlignedCache();
+  toFieldAligned(field);
+
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().misses, 7);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 0);
+}
+
+TEST_F(Field3DTest, FieldAlignedCacheElementWrite) {
+  Field3D field{1.0};
+  field.setCacheFieldAligned(true);
+
+  Field3D::resetFieldAlignedCacheStats();
+
+  toFieldAligned(field);
+  field(1, 1, 1) = 2.0;
+
+  const Field3D aligned = toFieldAligned(field);
+  EXPECT_DOUBLE_EQ(aligned(1, 1, 1), 2.0);
+
+  // Reading, even through a non-const reference, leaves the cache valid
+  EXPECT_DOUBLE_EQ(field(1, 1, 1), 2.0);
+  toFieldAligned(field);
+
+  // Writes through the other non-const accessors
+  field[Ind3D{0}] = 3.0;
+  toFieldAligned(field);
+  field(1, 1)[0] = 4.0;
+  toFieldAligned(field);
+
+  // Writing the value which is already there changes nothing
+  field(1, 1, 1) = 2.0;
+  toFieldAligned(field);
+
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().misses, 4);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 2);
+}
+
+TEST_F(Field3DTest, FieldAlignedCacheCopiesResult) {
+  Field3D field{1.0};
+  field.setCacheFieldAligned(true);
+
+  Field3D::resetFieldAlignedCacheStats();
+
+  // Writing to the results, even without allocate, doesn't change the cache
+  Field3D aligned = toFieldAligned(field);
+  aligned(1, 1, 1) = 2.0;
+  Field3D aligned2 = toFieldAligned(field);
+  aligned2(1, 1, 1) = 3.0;
+
+  EXPECT_TRUE(IsFieldEqual(toFieldAligned(field), 1.0));
+  EXPECT_TRUE(IsFieldEqual(field, 1.0));
+
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().misses, 1);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 2);
+}
+
+TEST_F(Field3DTest, FieldAlignedCacheOff) {
+  Field3D field{1.0};
+  EXPECT_FALSE(field.cacheFieldAligned());
+
+  Field3D::resetFieldAlignedCacheStats();
+
+  toFieldAligned(field);
+  toFieldAligned(field);
+
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().misses, 0);
+  EXPECT_EQ(Field3D::fieldAlignedCacheStats().hits, 0);
+}
+
 TEST_F(Field3DTest, GetGlobalMesh) {
   Field3D field;
 
@@ -625,6 +625,31 @@ TEST_F(FieldFactoryTest, ParseSelfReference) {
   EXPECT_THROW(factory.parse("a", &options), BoutException);
 }
 
+TEST_F(FieldFactoryTest, IsTimeDependent) {
+  for (const auto& expression :
+       {"1 + x", "pi * sin(y) / cos(z)", "tanh(x)", "gauss(x)", "gauss(x, 2)",
+        "max(x, y, z)", "atan(x, y)", "power(x, 2)", "tanhhat(x, 1, 0.5, 10)"}) {
+    EXPECT_FALSE(factory.parse(expression)->isTimeDependent())
+        << "Expression " << expression;
+  }
+
+  for (const auto& expression :
+       {"t", "x + t", "sin(t)", "tanh(x * t)", "gauss(x, t)", "max(x, y, t)",
+        "atan(x, t)", "power(t, 2)", "tanhhat(x, 1, 0.5, t)", "mixmode(t)"}) {
+    EXPECT_TRUE(factory.parse(expression)->isTimeDependent())
+        << "Expression " << expression;
+  }
+}
+
+TEST_F(FieldFactoryTest, IsTimeDependentThroughOption) {
+  auto options = Options{};
+  options["a"] = "2 * t";
+  options["b"] = "2 * x";
+
+  EXPECT_TRUE(factory.parse("x + a", &options)->isTimeDependent());
+  EXPECT_FALSE(factory.parse("x + b", &options)->isTimeDependent());
+}
+
 TEST_F(FieldFactoryTest, SinArgs) {
   EXPECT_THROW(factory.parse("sin()"), ParseException);
   EXPECT_THROW(factory.parse("sin(x, x)"), ParseException);
@@ -6,6 +6,7 @@
 #include "bout/array.hxx"
 
 #include <algorithm>
+#include <cmath>
 #include <vector>
 
 namespace bout {
@@ -107,3 +108,148 @@ TEST(CyclicReduction, SerialSolveDoubleMatrix) {
   EXPECT_NEAR(x(1, 3), 0.8, CyclicReduceTolerance);
   EXPECT_NEAR(x(1, 4), 6.6, CyclicReduceTolerance);
 }
+
+TEST(CyclicReduction, SerialSolveRepeated) {
+  using namespace bout::testing;
+  CyclicReduce<BoutReal> reduce{BoutComm::get(), reduction_size};
+
+  auto a = makeArrayFromVector({0., 1., 1., 1., 1.});
+  auto b = makeArrayFromVector({5., 4., 3., 2., 1.});
+  auto c = makeArrayFromVector({2., 2., 2., 2., 0.});
+
+  reduce.setCoefs(a, b, c);
+
+  auto rhs = makeArrayFromVector({0., 1., 2., 2., 3.});
+  Array<BoutReal> x{reduction_size};
+
+  reduce.solve(rhs, x);
+
+  // Second solve reuses the factorisation from setCoefs
+  auto rhs2 = makeArrayFromVector({0., 2., 4., 4., 6.});
+  reduce.solve(rhs2, x);
+
+  EXPECT_NEAR(x[0], -2., CyclicReduceTolerance);
+  EXPECT_NEAR(x[1], 5., CyclicReduceTolerance);
+  EXPECT_NEAR(x[2], -8., CyclicReduceTolerance);
+  EXPECT_NEAR(x[3], 11.5, CyclicReduceTolerance);
+  EXPECT_NEAR(x[4], -5.5, CyclicReduceTolerance);
+}
+
+TEST(CyclicReduction, SerialSolveMultipleRHS) {
+  using namespace bout::testing;
+  CyclicReduce<BoutReal> reduce{BoutComm::get(), reduction_size};
+
+  auto a = makeMatrixFromVector({{0., 1., 1., 1., 1.}, {0., -2., -2., -2., -2.}});
+  auto b = makeMatrixFromVector({{5., 4., 3., 2., 1.}, {1., 1., 1., 1., 1.}});
+  auto c = makeMatrixFromVector({{2., 2., 2., 2., 0.}, {2., 2., 2., 2., 0.}});
+
+  reduce.setCoefs(a, b, c);
+
+  // Two RHS for each of the two systems
+  auto rhs = makeMatrixFromVector({{0., 1., 2., 2., 3.},
+                                   {5., 4., 5., 4., 5.},
+                                   {0., 2., 4., 4., 6.},
+                                   {10., 8., 10., 8., 10.}});
+  Matrix<BoutReal> x{4, reduction_size};
+
+  reduce.solve(rhs, x);
+
+  const std::vector<BoutReal> expected0{-1., 2.5, -4., 5.75, -2.75};
+  const std::vector<BoutReal> expected1{3.4, 0.8, 5., 0.8, 6.6};
+  for (int i = 0; i < reduction_size; i++) {
+    EXPECT_NEAR(x(0, i), expected0[i], CyclicReduceTolerance);
+    EXPECT_NEAR(x(1, i), expected1[i], CyclicReduceTolerance);
+    EXPECT_NEAR(x(2, i), 2. * expected0[i], CyclicReduceTolerance);
+    EXPECT_NEAR(x(3, i), 2. * expected1[i], CyclicReduceTolerance);
+  }
+}
+
+TEST(CyclicReduction, PeriodicSolveMultipleRHS) {
+  using namespace bout::testing;
+  CyclicReduce<BoutReal> reduce{BoutComm::get(), reduction_size};
+  reduce.setPeriodic();
+
+  auto a = makeMatrixFromVector({{1., 1., 1., 1., 1.}, {-1., -1., -1., -1., -1.}});
+  auto b = makeMatrixFromVector({{5., 4., 3., 4., 5.}, {4., 4., 4., 4., 4.}});
+  auto c = makeMatrixFromVector({{2., 2., 2., 2., 2.}, {1., 1., 1., 1., 1.}});
+
+  reduce.setCoefs(a, b, c);
+
+  const std::vector<std::vector<BoutReal>> rhs_values{{0., 1., 2., 2., 3.},
+                                                      {5., 4., 5., 4., 5.},
+                                                      {1., -1., 0., 3., 2.},
+                                                      {-2., 0., 1., 1., 4.}};
+  Matrix<BoutReal> x{4, reduction_size};
+  reduce.solve(makeMatrixFromVector(rhs_values), x);
+
+  // Each RHS must give the same result as solving it on its own
+  for (int r = 0; r < 4; r++) {
+    const int sys = r % 2;
+    CyclicReduce<BoutReal> single{BoutComm::get(), reduction_size};
+    single.setPeriodic();
+    single.setCoefs(makeMatrixFromVector({{a(sys, 0), a(sys, 1), a(sys, 2), a(sys, 3),
+                                           a(sys, 4)}}),
+                    makeMatrixFromVector({{b(sys, 0), b(sys, 1), b(sys, 2), b(sys, 3),
+                                           b(sys, 4)}}),
+                    makeMatrixFromVector({{c(sys, 0), c(sys, 1), c(sys, 2), c(sys, 3),
+                                           c(sys, 4)}}));
+    Matrix<BoutReal> expected{1, reduction_size};
+    single.solve(makeMatrixFromVector({rhs_values[r]}), expected);
+
+    for (int i = 0; i < reduction_size; i++) {
+      EXPECT_NEAR(x(r, i), expected(0, i), CyclicReduceTolerance);
+    }
+  }
+}
+
+TEST(CyclicReduction, WrongNumberOfRHS) {
+  using namespace bout::testing;
+  CyclicReduce<BoutReal> reduce{BoutComm::get(), reduction_size};
+
+  auto a = makeMatrixFromVector({{0., 1., 1., 1., 1.}, {0., -2., -2., -2., -2.}});
+  auto b = makeMatrixFromVector({{5., 4., 3., 2., 1.}, {1., 1., 1., 1., 1.}});
+  auto c = makeMatrixFromVector({{2., 2., 2., 2., 0.}, {2., 2., 2., 2., 0.}});
+
+  reduce.setCoefs(a, b, c);
+
+  auto rhs = makeMatrixFromVector(
+      {{0., 1., 2., 2., 3.}, {5., 4., 5., 4., 5.}, {0., 2., 4., 4., 6.}});
+  Matrix<BoutReal> x{3, reduction_size};
+
+  EXPECT_THROW(reduce.solve(rhs, x), BoutException);
+}
+
+TEST(CyclicReduction, SerialZeroPivot) {
+  using namespace bout::testing;
+  CyclicReduce<BoutReal> reduce{BoutComm::get(), reduction_size};
+
+  // Eliminating the first row leaves a zero on the diagonal of the second
+  auto a = makeArrayFromVector({0., 1., 1., 1., 1.});
+  auto b = makeArrayFromVector({1., 1., 3., 2., 1.});
+  auto c = makeArrayFromVector({1., 2., 2., 2., 0.});
+
+  EXPECT_THROW(reduce.setCoefs(a, b, c), BoutException);
+}
+
+TEST(CyclicReduction, PeriodicZeroPivot) {
+  using namespace bout::testing;
+  CyclicReduce<BoutReal> reduce{BoutComm::get(), reduction_size};
+  reduce.setPeriodic();
+
+  auto a = makeArrayFromVector({1., 1., 1., 1., 1.});
+  auto b = makeArrayFromVector({0., 0., 0., 0., 0.});
+  auto c = makeArrayFromVector({1., 1., 1., 1., 1.});
+
+  EXPECT_THROW(reduce.setCoefs(a, b, c), BoutException);
+}
+
+TEST(CyclicReduction, SerialNaNPivot) {
+  using namespace bout::testing;
+  CyclicReduce<BoutReal> reduce{BoutComm::get(), reduction_size};
+
+  auto a = makeArrayFromVector({0., 1., 1., 1., 1.});
+  auto b = makeArrayFromVector({5., 4., std::nan(""), 2., 1.});
+  auto c = makeArrayFromVector({2., 2., 2., 2., 0.});
+
+  EXPECT_THROW(reduce.setCoefs(a, b, c), BoutException);
+}
@@ -178,6 +178,17 @@ auto getMethodsForDirection(DERIV derivative_order, DIRECTION direction)
                    return std::make_tuple(direction, derivative_order, method);
                  });
 
+  // The compact methods solve along whole lines, which are periodic
+  // in Y on FakeMesh, so they are tested with CompactDerivativesTest
+  if (direction == DIRECTION::Y) {
+    methods.erase(std::remove_if(std::begin(methods), std::end(methods),
+                                 [](const std::tuple<DIRECTION, DERIV, std::string>& m) {
+                                   return (std::get<2>(m) == "CP4")
+                                          or (std::get<2>(m) == "CP6");
+                                 }),
+                  std::end(methods));
+  }
+
   return methods;
 };
 
@@ -488,3 +499,132 @@ TEST_P(FluxDerivativesInterfaceTest, Sanity) {
 
   EXPECT_TRUE(IsFieldEqual(result, expected, "RGN_NOBNDRY", derivatives_tolerance));
 }
+
+/////////////////////////////////////////////////////////////////////
+// The compact methods couple all the points along a line, so check
+// they work through the parallel slices and across a twist-shift
+
+namespace {
+/// FakeMesh with a twist-shift angle at the ends of the periodic Y domain
+class TwistShiftMesh : public FakeMesh {
+public:
+  TwistShiftMesh(int nx, int ny, int nz, BoutReal twist)
+      : FakeMesh(nx, ny, nz), twist(twist) {}
+  bool periodicY(int UNUSED(jx), BoutReal& ts) const override {
+    ts = twist;
+    return true;
+  }
+
+private:
+  BoutReal twist;
+};
+} // namespace
+
+class CompactDerivativesTest : public ::testing::Test {
+public:
+  ~CompactDerivativesTest() override {
+    delete mesh;
+    mesh = nullptr;
+  }
+
+  /// Make the global mesh, with two guard cells in Y and none in X
+  void makeMesh(BoutReal twist) {
+    WithQuietOutput quiet_info{output_info};
+    WithQuietOutput quiet_warn{output_warn};
+
+    mesh = new TwistShiftMesh(nx, ny_interior + 4, nz, twist);
+    mesh->xstart = 0;
+    mesh->xend = nx - 1;
+    mesh->ystart = 2;
+    mesh->yend = ny_interior + 1;
+    mesh->createDefaultRegions();
+
+    static_cast<FakeMesh*>(mesh)->setCoordinates(nullptr);
+    auto coords = std::make_shared<Coordinates>(
+        mesh, Field2D{1.0}, Field2D{1.0}, BoutReal{1.0}, Field2D{1.0}, Field2D{0.0},
+        Field2D{1.0}, Field2D{1.0}, Field2D{1.0}, Field2D{0.0}, Field2D{0.0},
+        Field2D{0.0}, Field2D{1.0}, Field2D{1.0}, Field2D{1.0}, Field2D{0.0},
+        Field2D{0.0}, Field2D{0.0}, Field2D{0.0}, Field2D{0.0}, false);
+    static_cast<FakeMesh*>(mesh)->setCoordinates(coords);
+    coords->setParallelTransform(
+        bout::utils::make_unique<ParallelTransformIdentity>(*mesh));
+  }
+
+  static constexpr int nx{2};
+  static constexpr int ny_interior{32};
+  static constexpr int nz{8};
+};
+
+TEST_F(CompactDerivativesTest, DDYWithParallelSlices) {
+  makeMesh(0.0);
+
+  const BoutReal kwave = 2. * TWOPI / ny_interior;
+  Field3D input = makeField<Field3D>(
+      [&](Field3D::ind_type& i) { return std::sin(i.y() * kwave); }, mesh);
+  const Field3D expected = makeField<Field3D>(
+      [&](Field3D::ind_type& i) { return kwave * std::cos(i.y() * kwave); }, mesh);
+
+  ParallelTransformIdentity identity{*mesh};
+  identity.calcParallelSlices(input);
+  ASSERT_TRUE(input.hasParallelSlices());
+
+  const Field3D result = bout::derivatives::index::DDY(input, CELL_DEFAULT, "CP4");
+
+  EXPECT_TRUE(IsFieldEqual(result, expected, "RGN_NOBNDRY", 1.e-4));
+}
+
+TEST_F(CompactDerivativesTest, PeriodicY) {
+  makeMesh(0.0);
+
+  const BoutReal kwave = TWOPI / ny_interior;
+  const Field3D input = makeField<Field3D>(
+      [&](Field3D::ind_type& i) { return std::sin(i.y() * kwave); }, mesh);
+  const Field3D first = makeField<Field3D>(
+      [&](Field3D::ind_type& i) { return kwave * std::cos(i.y() * kwave); }, mesh);
+  const Field3D second = makeField<Field3D>(
+      [&](Field3D::ind_type& i) { return -kwave * kwave * std::sin(i.y() * kwave); },
+      mesh);
+
+  for (const std::string method : {"CP4", "CP6"}) {
+    for (const DERIV order : {DERIV::Standard, DERIV::StandardSecond}) {
+      auto derivative = DerivativeStore<Field3D>::getInstance().getStandardDerivative(
+          method, DIRECTION::Y, STAGGER::None, order);
+
+      Field3D result{mesh};
+      result.allocate();
+      derivative(input, result, "RGN_NOY");
+
+      EXPECT_TRUE(IsFieldEqual(result, (order == DERIV::Standard) ? first : second,
+                               "RGN_NOBNDRY", 1.e-5))
+          << method << " " << toString(order);
+    }
+  }
+}
+
+// The twist-shift is applied with FFTs
+#ifdef BOUT_HAS_FFTW
+TEST_F(CompactDerivativesTest, PeriodicWithTwistShift) {
+  // Field-aligned values at the end of the domain are those at the
+  // start, shifted in Z by the twist-shift angle. With dz = 1, the
+  // angle is in units of Z index
+  const BoutReal kwave = 0.4;
+  const BoutReal kz = TWOPI / nz;
+  makeMesh(kwave * ny_interior / kz);
+
+  const Field3D input = makeField<Field3D>(
+      [&](Field3D::ind_type& i) { return std::sin(i.y() * kwave + i.z() * kz); }, mesh);
+  const Field3D expected = makeField<Field3D>(
+      [&](Field3D::ind_type& i) { return kwave * std::cos(i.y() * kwave + i.z() * kz); },
+      mesh);
+
+  auto derivative = DerivativeStore<Field3D>::getInstance().getStandardDerivative(
+      "CP6", DIRECTION::Y, STAGGER::None, DERIV::Standard);
+
+  Field3D result{mesh};
+  result.allocate();
+  derivative(input, result, "RGN_NOY");
+
+  // Closing the ends with the explicit C4 stencil would give errors of ~3e-4
+  EXPECT_TRUE(IsFieldEqual(result, expected, "RGN_NOBNDRY", 1.e-5));
+}
+#endif // BOUT_HAS_FFTW
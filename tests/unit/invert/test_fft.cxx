@@ -109,4 +109,53 @@ TEST_P(FFTTest, RoundTrip) {
     EXPECT_NEAR(output[i], real_signal[i], FFTTolerance);
   }
 }
+
+TEST_P(FFTTest, rfftBatched) {
+  // Three copies of the signal, scaled differently
+  constexpr int howmany = 3;
+  Array<BoutReal> input{size * howmany};
+  for (int j = 0; j < howmany; ++j) {
+    for (int i = 0; i < size; ++i) {
+      input[j * size + i] = (j + 1) * real_signal[i];
+    }
+  }
+
+  Array<dcomplex> output{nmodes * howmany};
+  bout::fft::rfft(input.begin(), size, howmany, output.begin());
+
+  for (int j = 0; j < howmany; ++j) {
+    for (int i = 0; i < nmodes; ++i) {
+      EXPECT_NEAR(real(output[j * nmodes + i]), (j + 1) * real(fft_signal[i]),
+                  FFTTolerance);
+      EXPECT_NEAR(imag(output[j * nmodes + i]), (j + 1) * imag(fft_signal[i]),
+                  FFTTolerance);
+    }
+  }
+}
+
+TEST_P(FFTTest, irfftBatched) {
+  constexpr int howmany = 3;
+  Array<dcomplex> input{nmodes * howmany};
+  for (int j = 0; j < howmany; ++j) {
+    for (int i = 0; i < nmodes; ++i) {
+      input[j * nmodes + i] = static_cast<BoutReal>(j + 1) * fft_signal[i];
+    }
+  }
+  Array<dcomplex> input_copy{nmodes * howmany};
+  std::copy(input.begin(), input.end(), input_copy.begin());
+
+  Array<BoutReal> output{size * howmany};
+  bout::fft::irfft(input.begin(), size, howmany, output.begin());
+
+  for (int j = 0; j < howmany; ++j) {
+    for (int i = 0; i < size; ++i) {
+      EXPECT_NEAR(output[j * size + i], (j + 1) * real_signal[i], FFTTolerance);
+    }
+  }
+
+  // The input is not modified
+  for (int i = 0; i < nmodes * howmany; ++i) {
+    EXPECT_EQ(input[i], input_copy[i]);
+  }
+}
 #endif
@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+
+#include "bout/invertable_operator.hxx"
+#include "field2d.hxx"
+#include "field3d.hxx"
+#include "fieldperp.hxx"
+#include "test_extras.hxx"
+
+// These test the built-in Krylov solvers, used when PETSc is not available
+#ifndef BOUT_HAS_PETSC
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+using bout::inversion::InvertableOperator;
+
+class InvertableOperatorTest : public FakeMeshFixture,
+                               public testing::WithParamInterface<std::string> {
+public:
+  InvertableOperatorTest() {
+    options["ksptype"] = GetParam();
+    options["rtol"] = 1e-12;
+  }
+  Options options;
+};
+
+INSTANTIATE_TEST_SUITE_P(KrylovMethods, InvertableOperatorTest,
+                         testing::Values("gmres", "bicgstab", "cg"));
+
+namespace {
+/// Symmetric positive definite operator, coupling neighbours in z
+Field3D symmetricOperator(const Field3D& f) {
+  Field3D result{emptyFrom(f)};
+  BOUT_FOR(i, f.getRegion("RGN_ALL")) {
+    result[i] = (3.0 + i.x()) * f[i] - 0.5 * (f[i.zp()] + f[i.zm()]);
+  }
+  return result;
+}
+
+/// A solution which varies in all directions
+Field3D makeSolution() {
+  Field3D result{0.0, mesh};
+  BOUT_FOR(i, result.getRegion("RGN_ALL")) {
+    result[i] = 1.0 + i.x() + 0.1 * i.y() * i.z();
+  }
+  return result;
+}
+
+/// Compare values in the region solved by InvertableOperator
+template <typename T>
+void expectSolution(const T& expected, const T& actual) {
+  BOUT_FOR(i, expected.getRegion("RGN_WITHBNDRIES")) {
+    EXPECT_NEAR(expected[i], actual[i], 1e-8);
+  }
+}
+} // namespace
+
+TEST_P(InvertableOperatorTest, Field3DSymmetric) {
+  InvertableOperator<Field3D> op(symmetricOperator, &options, mesh);
+  op.setup();
+
+  const Field3D expected = makeSolution();
+  const Field3D rhs = op(expected);
+
+  expectSolution(expected, op.invert(rhs));
+}
+
+TEST_P(InvertableOperatorTest, Field3DPreconditioned) {
+  InvertableOperator<Field3D> op(symmetricOperator, &options, mesh);
+  // Jacobi preconditioner
+  op.setPreconditionerFunction(
+      [](const Field3D& f) -> Field3D {
+        Field3D result{emptyFrom(f)};
+        BOUT_FOR(i, f.getRegion("RGN_ALL")) { result[i] = f[i] / (3.0 + i.x()); }
+        return result;
+      });
+  op.setup();
+
+  const Field3D expected = makeSolution();
+  const Field3D rhs = op(expected);
+
+  expectSolution(expected, op.invert(rhs, Field3D{1.0}));
+}
+
+TEST_P(InvertableOperatorTest, Field2D) {
+  InvertableOperator<Field2D> op(
+      [](const Field2D& f) -> Field2D { return 2.0 * f; }, &options, mesh);
+  op.setup();
+
+  const Field2D rhs{4.0, mesh};
+
+  expectSolution(Field2D{2.0, mesh}, op.invert(rhs));
+}
+
+TEST_P(InvertableOperatorTest, FieldPerp) {
+  InvertableOperator<FieldPerp> op([](const FieldPerp& f) -> FieldPerp { return 4.0 * f; },
+                                   &options, mesh);
+  op.setup();
+
+  FieldPerp rhs{2.0, mesh};
+  rhs.setIndex(2);
+
+  const FieldPerp result = op.invert(rhs);
+  EXPECT_EQ(result.getIndex(), 2);
+  expectSolution(FieldPerp{0.5, mesh}, result);
+}
+
+TEST_P(InvertableOperatorTest, Verify) {
+  InvertableOperator<Field3D> op(symmetricOperator, &options, mesh);
+  op.setup();
+
+  EXPECT_TRUE(op.verify(makeSolution()));
+}
+
+using InvertableOperatorOptionsTest = FakeMeshFixture;
+
+TEST_F(InvertableOperatorOptionsTest, NonSymmetricGMRES) {
+  Options options;
+  options["rtol"] = 1e-12;
+  options["gmres_restart"] = 3;
+
+  InvertableOperator<Field3D> op(
+      [](const Field3D& f) -> Field3D {
+        Field3D result{emptyFrom(f)};
+        BOUT_FOR(i, f.getRegion("RGN_ALL")) { result[i] = 3.0 * f[i] + f[i.zp()]; }
+        return result;
+      },
+      &options, mesh);
+  op.setup();
+
+  const Field3D expected = makeSolution();
+  const Field3D rhs = op(expected);
+
+  expectSolution(expected, op.invert(rhs));
+}
+
+TEST_F(InvertableOperatorOptionsTest, UnknownMethod) {
+  Options options;
+  options["ksptype"] = "not_a_method";
+
+  InvertableOperator<Field3D> op(symmetricOperator, &options, mesh);
+  EXPECT_THROW(op.setup(), BoutException);
+}
+
+TEST_F(InvertableOperatorOptionsTest, TooFewIterations) {
+  Options options;
+  options["rtol"] = 1e-12;
+  options["maxits"] = 1;
+
+  InvertableOperator<Field3D> op(symmetricOperator, &options, mesh);
+  op.setup();
+
+  EXPECT_THROW(op.invert(makeSolution()), BoutException);
+}
+
+TEST_F(InvertableOperatorOptionsTest, InvertBeforeSetup) {
+  InvertableOperator<Field3D> op(symmetricOperator, nullptr, mesh);
+  EXPECT_THROW(op.invert(Field3D{1.0}), BoutException);
+}
+
+#endif // BOUT_HAS_PETSC
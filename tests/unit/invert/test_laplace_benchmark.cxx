@@ -0,0 +1,242 @@
+#include "gtest/gtest.h"
+
+#include "bout/invert/laplace_benchmark.hxx"
+#include "test_extras.hxx"
+#include "../src/invert/laplace/impls/auto/auto_laplace.hxx"
+
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+using Result = LaplaceBenchmark::Result;
+
+namespace {
+Result makeResult(const std::string& type, bool valid, BoutReal solve_time) {
+  Result result;
+  result.type = type;
+  result.valid = valid;
+  result.first_time = 2 * solve_time;
+  result.solve_time = solve_time;
+  return result;
+}
+} // namespace
+
+TEST(LaplaceBenchmarkTest, FastestValid) {
+  const std::vector<Result> results{makeResult("cyclic", true, 2.0),
+                                    makeResult("pdd", false, 0.5),
+                                    makeResult("multigrid", true, 1.0),
+                                    makeResult("naulin", true, 3.0)};
+
+  EXPECT_EQ(LaplaceBenchmark::fastest(results), "multigrid");
+}
+
+TEST(LaplaceBenchmarkTest, FastestNoneValid) {
+  const std::vector<Result> results{makeResult("cyclic", false, 2.0)};
+
+  EXPECT_EQ(LaplaceBenchmark::fastest(results), "");
+  EXPECT_EQ(LaplaceBenchmark::fastest({}), "");
+}
+
+TEST(LaplaceBenchmarkTest, Print) {
+  auto failed = makeResult("spt", false, 0.0);
+  failed.reason = "Parallel only";
+  const std::vector<Result> results{makeResult("cyclic", true, 2.0), failed};
+
+  std::stringstream table;
+  LaplaceBenchmark::print(results, table);
+
+  EXPECT_NE(table.str().find("cyclic"), std::string::npos);
+  EXPECT_NE(table.str().find("Parallel only"), std::string::npos);
+}
+
+TEST(LaplaceBenchmarkTest, UserOptions) {
+  Options options;
+  options["laplace"]["rtol"] = 1e-8;
+  options["laplace"]["maxits"].withDefault(100);
+  options["laplace"]["sub"]["flag"] = true;
+
+  Options copy = LaplaceBenchmark::userOptions(options["laplace"]);
+
+  EXPECT_DOUBLE_EQ(copy["rtol"].as<BoutReal>(), 1e-8);
+  EXPECT_FALSE(copy.isSet("maxits"));
+  EXPECT_TRUE(copy["sub"]["flag"].as<bool>());
+
+  // A different default can now be given without an error
+  EXPECT_EQ(copy["maxits"].withDefault(50), 50);
+
+  // The original is unchanged
+  copy["rtol"].force(1e-3);
+  EXPECT_DOUBLE_EQ(options["laplace"]["rtol"].as<BoutReal>(), 1e-8);
+}
+
+namespace {
+/// Returns the right-hand side, after waiting for \p factorise_ms
+/// if the coefficients changed and then for \p solve_ms
+class FakeLaplacian : public Laplacian {
+public:
+  FakeLaplacian(Options* opt, CELL_LOC loc, Mesh* mesh_in, int factorise_ms, int solve_ms)
+      : Laplacian(opt, loc, mesh_in), factorise_ms(factorise_ms), solve_ms(solve_ms) {}
+
+  void setCoefA(const Field2D&) override { coefficientsChanged(); }
+  void setCoefC(const Field2D&) override { coefficientsChanged(); }
+  void setCoefD(const Field2D&) override { coefficientsChanged(); }
+  void setCoefEx(const Field2D&) override { coefficientsChanged(); }
+  void setCoefEz(const Field2D&) override { coefficientsChanged(); }
+
+  using Laplacian::solve;
+  FieldPerp solve(const FieldPerp& b) override {
+    int delay = solve_ms;
+    if (not factorisationValid(version)) {
+      delay += factorise_ms;
+      version = coef_version;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    return b;
+  }
+
+private:
+  int factorise_ms, solve_ms;
+  int version{-1};
+};
+
+/// "caching" is slow whenever the coefficients change and then free,
+/// "steady" always takes the same time
+Laplacian* createFake(Options* opt, CELL_LOC loc, Mesh* mesh_in) {
+  if ((*opt)["type"].as<std::string>() == "caching") {
+    return new FakeLaplacian(opt, loc, mesh_in, 20, 0);
+  }
+  return new FakeLaplacian(opt, loc, mesh_in, 0, 5);
+}
+} // namespace
+
+using LaplaceBenchmarkRunTest = FakeMeshFixture;
+
+TEST_F(LaplaceBenchmarkRunTest, CoefsChange) {
+  Options options;
+  options["benchmark_types"] = "caching, steady";
+  options["benchmark_reference"] = "steady";
+  options["benchmark_repeats"] = 2;
+
+  WithQuietOutput quiet{output};
+  WithQuietOutput quiet_info{output_info};
+
+  LaplaceBenchmark benchmark(&options, CELL_CENTRE, mesh);
+  benchmark.setCreator(createFake);
+
+  FieldPerp b{1.0, mesh};
+  b.setIndex(mesh->ystart);
+
+  const auto results =
+      benchmark.run([](Laplacian& solver) { solver.setCoefA(1.0); }, b, b);
+
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(results[0].type, "steady");
+  EXPECT_EQ(results[1].type, "caching");
+  EXPECT_TRUE(results[0].valid);
+  EXPECT_TRUE(results[1].valid);
+  EXPECT_GT(results[1].solve_time, results[0].solve_time);
+
+  EXPECT_EQ(LaplaceBenchmark::fastest(results), "steady");
+}
+
+TEST_F(LaplaceBenchmarkRunTest, CoefsFixed) {
+  Options options;
+  options["benchmark_types"] = "caching, steady";
+  options["benchmark_reference"] = "steady";
+  options["benchmark_repeats"] = 2;
+  options["benchmark_coefs_change"] = false;
+
+  WithQuietOutput quiet{output};
+  WithQuietOutput quiet_info{output_info};
+
+  LaplaceBenchmark benchmark(&options, CELL_CENTRE, mesh);
+  benchmark.setCreator(createFake);
+
+  FieldPerp b{1.0, mesh};
+  b.setIndex(mesh->ystart);
+
+  const auto results =
+      benchmark.run([](Laplacian& solver) { solver.setCoefA(1.0); }, b, b);
+
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_TRUE(results[1].valid);
+  // Only the first solve has to factorise
+  EXPECT_GT(results[1].first_time, results[0].first_time);
+
+  EXPECT_EQ(LaplaceBenchmark::fastest(results), "caching");
+}
+
+class LaplaceAutoTest : public FakeMeshFixture {
+public:
+  LaplaceAutoTest() {
+    // Keep BOUT.laplace_auto in a new data directory
+    mkdir(datadir.c_str(), 0700);
+    Options::root()["datadir"] = datadir;
+
+    options["benchmark_types"] = "caching, steady";
+    options["benchmark_reference"] = "steady";
+    options["benchmark_repeats"] = 2;
+  }
+  ~LaplaceAutoTest() override {
+    std::remove((datadir + "/BOUT.laplace_auto").c_str());
+    std::remove(datadir.c_str());
+    Options::cleanup();
+  }
+
+  /// Solve once with a new LaplaceAuto, returning the chosen type
+  std::string chooseType() {
+    LaplaceAuto solver(&options, CELL_CENTRE, mesh);
+    solver.setCreator([this](Options* opt, CELL_LOC loc, Mesh* mesh_in) {
+      ++created;
+      return createFake(opt, loc, mesh_in);
+    });
+    solver.setCoefA(1.0);
+
+    FieldPerp b{1.0, mesh};
+    b.setIndex(mesh->ystart);
+    solver.solve(b);
+
+    return solver.getType();
+  }
+
+  std::string datadir{std::tmpnam(nullptr)};
+  Options options;
+  int created{0}; ///< Number of solvers made by chooseType
+  WithQuietOutput quiet{output};
+  WithQuietOutput quiet_info{output_info};
+};
+
+TEST_F(LaplaceAutoTest, CalibrateOnce) {
+  const auto type = chooseType();
+  EXPECT_EQ(type, "steady");
+  // One solver of each type for the benchmark, then the chosen one
+  EXPECT_EQ(created, 3);
+
+  // The second solver reads the choice from BOUT.laplace_auto, so
+  // only makes the chosen solver
+  created = 0;
+  EXPECT_EQ(chooseType(), type);
+  EXPECT_EQ(created, 1);
+}
+
+TEST_F(LaplaceAutoTest, Recalibrate) {
+  chooseType();
+
+  created = 0;
+  options["auto_recalibrate"] = true;
+  chooseType();
+  EXPECT_EQ(created, 3);
+}
@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+
+#include "bout/invert/solution_history.hxx"
+#include "field3d.hxx"
+#include "test_extras.hxx"
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+using SolutionHistoryTest = FakeMeshFixture;
+
+TEST_F(SolutionHistoryTest, Coefficients) {
+  using History = SolutionHistory<Field3D>;
+
+  EXPECT_DOUBLE_EQ(History::coefficient(1, 0), 1.0);
+
+  EXPECT_DOUBLE_EQ(History::coefficient(2, 0), -1.0);
+  EXPECT_DOUBLE_EQ(History::coefficient(2, 1), 2.0);
+
+  EXPECT_DOUBLE_EQ(History::coefficient(3, 0), 1.0);
+  EXPECT_DOUBLE_EQ(History::coefficient(3, 1), -3.0);
+  EXPECT_DOUBLE_EQ(History::coefficient(3, 2), 3.0);
+
+  // Coefficients always sum to one, so constants are preserved
+  for (int n = 1; n < 6; ++n) {
+    BoutReal sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+      sum += History::coefficient(n, i);
+    }
+    EXPECT_DOUBLE_EQ(sum, 1.0);
+  }
+}
+
+TEST_F(SolutionHistoryTest, DepthZeroStoresNothing) {
+  SolutionHistory<Field3D> history;
+
+  history.push(Field3D{1.0});
+
+  EXPECT_TRUE(history.empty());
+}
+
+TEST_F(SolutionHistoryTest, KeepsLatestSolutions) {
+  SolutionHistory<Field3D> history(2);
+
+  history.push(Field3D{1.0});
+  history.push(Field3D{2.0});
+  history.push(Field3D{4.0});
+
+  EXPECT_EQ(history.size(), 2);
+  // 2 * 4 - 2
+  EXPECT_TRUE(IsFieldEqual(history.extrapolate(), 6.0));
+
+  history.clear();
+  EXPECT_TRUE(history.empty());
+}
+
+TEST_F(SolutionHistoryTest, ExtrapolateQuadratic) {
+  SolutionHistory<Field3D> history(3);
+
+  // Solutions x(t) = t^2 at t = 1, 2, 3
+  for (int t = 1; t <= 3; ++t) {
+    history.push(Field3D{static_cast<BoutReal>(t * t)});
+  }
+
+  EXPECT_TRUE(IsFieldEqual(history.extrapolate(), 16.0));
+}
+
+TEST_F(SolutionHistoryTest, StoresCopy) {
+  SolutionHistory<Field3D> history(1);
+
+  Field3D solution{1.0};
+  history.push(solution);
+  solution(0, 0, 0) = 5.0;
+
+  EXPECT_TRUE(IsFieldEqual(history.extrapolate(), 1.0));
+}
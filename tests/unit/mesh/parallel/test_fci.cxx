@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include "../src/mesh/parallel/fci.hxx"
+#include "options.hxx"
+#include "output.hxx"
+#include "test_extras.hxx"
+#include "bout/griddata.hxx"
+#include "bout/mesh.hxx"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+class FCIMapTest : public FakeMeshFixture {
+public:
+  FCIMapTest() : FakeMeshFixture() {
+    // Grid points at (R, Z) = (x, z). Forward field lines land inside
+    // the domain, backward ones all leave it
+    grid["R"] = "x";
+    grid["Z"] = "z";
+    grid["forward_xt_prime"] = "1.25";
+    grid["forward_zt_prime"] = "z * 7 / (2 * pi) + 0.5";
+    grid["forward_R"] = "x";
+    grid["forward_Z"] = "z";
+    grid["backward_xt_prime"] = "-1";
+    grid["backward_zt_prime"] = "0";
+    grid["backward_R"] = "x - 0.5";
+    grid["backward_Z"] = "z";
+
+    static_cast<FakeMesh*>(mesh)->setGridDataSource(new GridFromOptions(&grid));
+  }
+
+  Options grid;
+  WithQuietOutput quiet_info{output_info};
+  WithQuietOutput quiet_warn{output_warn};
+};
+
+TEST_F(FCIMapTest, WriteThenReadCache) {
+  const Field2D dy{0.5};
+
+  BoundaryRegionPar forward_boundary("FCI_forward", BNDRY_PAR_FWD, +1, mesh);
+  BoundaryRegionPar backward_boundary("FCI_backward", BNDRY_PAR_BKWD, -1, mesh);
+
+  FCIMap forward{*mesh, dy, +1, &forward_boundary, true};
+  FCIMap backward{*mesh, dy, -1, &backward_boundary, true};
+
+  std::stringstream cache;
+  forward.writeCache(cache);
+  backward.writeCache(cache);
+
+  BoundaryRegionPar forward_read_boundary("FCI_forward", BNDRY_PAR_FWD, +1, mesh);
+  BoundaryRegionPar backward_read_boundary("FCI_backward", BNDRY_PAR_BKWD, -1, mesh);
+
+  FCIMap forward_read{*mesh, +1, &forward_read_boundary, cache};
+  FCIMap backward_read{*mesh, -1, &backward_read_boundary, cache};
+
+  // Writing the maps which were read gives the same cache, so the
+  // weights, masks and boundary points all survived
+  std::stringstream cache_again;
+  forward_read.writeCache(cache_again);
+  backward_read.writeCache(cache_again);
+  EXPECT_EQ(cache_again.str(), cache.str());
+
+  Field3D f = makeField<Field3D>([](Field3D::ind_type& i) {
+    return i.x() + 0.1 * i.y() + 0.01 * i.z();
+  });
+  // The interpolated values are at the next Y point, and only set
+  // there for field lines starting in the domain
+  const Field3D forward_result = forward.interpolate(f);
+  const Field3D forward_read_result = forward_read.interpolate(f);
+  BOUT_FOR_SERIAL(i, f.getRegion("RGN_NOBNDRY")) {
+    EXPECT_EQ(forward_read_result[i.yp()], forward_result[i.yp()]);
+  }
+
+  // Every backward point left the domain, with the boundary at half dy
+  EXPECT_TRUE(backward_read.boundary_mask(mesh->xstart, mesh->ystart, 0));
+  backward_read_boundary.first();
+  ASSERT_FALSE(backward_read_boundary.isDone());
+  EXPECT_DOUBLE_EQ(backward_read_boundary.length, 0.25);
+
+  // The maps must be read in the order they were written
+  std::stringstream cache_reversed{cache.str()};
+  EXPECT_THROW(FCIMap(*mesh, -1, &backward_read_boundary, cache_reversed), BoutException);
+}
+
+TEST_F(FCIMapTest, CacheKey) {
+  const std::string key = FCITransform::cacheKey(*mesh, Field2D{0.5}, true);
+
+  EXPECT_EQ(FCITransform::cacheKey(*mesh, Field2D{0.5}, true), key);
+  EXPECT_NE(FCITransform::cacheKey(*mesh, Field2D{0.25}, true), key);
+  EXPECT_NE(FCITransform::cacheKey(*mesh, Field2D{0.5}, false), key);
+}
+
+TEST_F(FCIMapTest, ReadCacheKey) {
+  const std::string key = FCITransform::cacheKey(*mesh, Field2D{0.5}, true);
+
+  std::stringstream cache;
+  FCITransform::writeCacheKey(cache, key);
+  cache << "maps";
+
+  EXPECT_TRUE(FCITransform::readCacheKey(cache, key));
+  // The maps follow the key
+  std::string rest;
+  cache >> rest;
+  EXPECT_EQ(rest, "maps");
+
+  // A cache written with a different dy is rejected
+  std::stringstream stale;
+  FCITransform::writeCacheKey(stale, FCITransform::cacheKey(*mesh, Field2D{0.25}, true));
+  EXPECT_FALSE(FCITransform::readCacheKey(stale, key));
+
+  std::stringstream empty;
+  EXPECT_FALSE(FCITransform::readCacheKey(empty, key));
+}
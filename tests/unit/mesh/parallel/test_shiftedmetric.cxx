@@ -184,6 +184,33 @@ TEST_F(ShiftedMetricTest, ToFromFieldAligned) {
                            FFTTolerance));
 }
 
+TEST_F(ShiftedMetricTest, ToFieldAlignedGroup) {
+  const Field3D input2 = input * input + 1.0;
+
+  const auto result = toFieldAligned({input, input2});
+
+  ASSERT_EQ(result.size(), 2);
+  EXPECT_TRUE(IsFieldEqual(result[0], toFieldAligned(input), "RGN_ALL", FFTTolerance));
+  EXPECT_TRUE(IsFieldEqual(result[1], toFieldAligned(input2), "RGN_ALL", FFTTolerance));
+  EXPECT_TRUE(result[0].getDirectionY() == YDirectionType::Aligned);
+  EXPECT_TRUE(result[1].getDirectionY() == YDirectionType::Aligned);
+}
+
+TEST_F(ShiftedMetricTest, FromFieldAlignedGroup) {
+  input.setDirectionY(YDirectionType::Aligned);
+  Field3D input2 = input * input + 1.0;
+  input2.setDirectionY(YDirectionType::Aligned);
+
+  const auto result = fromFieldAligned({input, input2}, "RGN_NOY");
+
+  ASSERT_EQ(result.size(), 2);
+  EXPECT_TRUE(IsFieldEqual(result[0], fromFieldAligned(input, "RGN_NOY"), "RGN_NOY",
+                           FFTTolerance));
+  EXPECT_TRUE(IsFieldEqual(result[1], fromFieldAligned(input2, "RGN_NOY"), "RGN_NOY",
+                           FFTTolerance));
+  EXPECT_TRUE(result[0].getDirectionY() == YDirectionType::Standard);
+}
+
 TEST_F(ShiftedMetricTest, ToFieldAlignedFieldPerp) {
   Field3D expected{mesh};
   expected.setDirectionY(YDirectionType::Aligned);
@@ -422,4 +449,41 @@ TEST_F(ShiftedMetricTest, CalcParallelSlices) {
   EXPECT_TRUE(IsFieldEqual(input.ynext(-1), expected_down_1, "RGN_YDOWN", FFTTolerance));
   EXPECT_TRUE(IsFieldEqual(input.ynext(-2), expected_down2, "RGN_YDOWN2", FFTTolerance));
 }
+
+TEST_F(ShiftedMetricTest, InterpolationWholeGridShifts) {
+  // zShift is a whole number of grid points everywhere, so the
+  // interpolation should give the same answers as the FFTs
+  output_info.disable();
+  mesh->addRegion3D("RGN_YUP",
+                    Region<Ind3D>(0, mesh->LocalNx - 1, mesh->ystart + 1, mesh->yend + 1,
+                                  0, mesh->LocalNz - 1, mesh->LocalNy, mesh->LocalNz));
+  mesh->addRegion3D("RGN_YDOWN2",
+                    Region<Ind3D>(0, mesh->LocalNx - 1, mesh->ystart - 2, mesh->yend - 2,
+                                  0, mesh->LocalNz - 1, mesh->LocalNy, mesh->LocalNz));
+  output_info.enable();
+
+  Field3D expected = copy(input);
+  expected.getCoordinates()->getParallelTransform().calcParallelSlices(expected);
+
+  Field3D aligned = copy(input);
+  aligned.setDirectionY(YDirectionType::Aligned);
+
+  for (const auto method : {ZShiftMethod::lagrange4pt, ZShiftMethod::lagrange6pt,
+                            ZShiftMethod::hermitespline}) {
+    ShiftedMetric transform(*mesh, CELL_CENTRE, zShift,
+                            mesh->getCoordinates()->zlength(), method);
+
+    EXPECT_TRUE(IsFieldEqual(transform.toFieldAligned(input), toFieldAligned(input),
+                             "RGN_ALL", FFTTolerance));
+    EXPECT_TRUE(IsFieldEqual(transform.fromFieldAligned(aligned),
+                             fromFieldAligned(aligned), "RGN_ALL", FFTTolerance));
+
+    Field3D result = copy(input);
+    transform.calcParallelSlices(result);
+    EXPECT_TRUE(
+        IsFieldEqual(result.ynext(1), expected.ynext(1), "RGN_YUP", FFTTolerance));
+    EXPECT_TRUE(
+        IsFieldEqual(result.ynext(-2), expected.ynext(-2), "RGN_YDOWN2", FFTTolerance));
+  }
+}
 #endif
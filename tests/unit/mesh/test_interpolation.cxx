@@ -5,6 +5,7 @@
 #include "interpolation.hxx"
 #include "output.hxx"
 #include "test_extras.hxx"
+#include "bout/deriv_store.hxx"
 
 ////// delete these
 #include "bout/constants.hxx"
@@ -15,6 +16,7 @@
 #include "utils.hxx"
 #include <cmath>
 #include <set>
+#include <sstream>
 #include <vector>
 ///////
 
@@ -426,3 +428,187 @@ TEST_F(Field2DInterpToTest, CellYlowToCentreNoBndry) {
   EXPECT_TRUE(output.getLocation() == CELL_CENTRE);
   EXPECT_NEAR(output(2, 2), 2.525, 1.e-15);
 }
+
+/// Compare the interpolation matrices with the interpolations they
+/// are made from
+class InterpolationMatrixTest : public ::testing::Test {
+protected:
+  InterpolationMatrixTest() {
+    WithQuietOutput quiet_info{output_info};
+    WithQuietOutput quiet_warn{output_warn};
+
+    test_mesh.xstart = 2;
+    test_mesh.xend = nx - 3;
+    test_mesh.ystart = 1;
+    test_mesh.yend = ny - 2;
+    test_mesh.setCoordinates(nullptr);
+    test_mesh.createDefaultRegions();
+
+    f = makeField<Field3D>(
+        [](Field3D::ind_type& i) {
+          return std::sin(0.7 * i.x()) * std::cos(1.3 * i.z()) + 0.1 * i.y();
+        },
+        &test_mesh);
+
+    // Field line end points, spread over the interior and wrapping around in z
+    delta_x = makeField<Field3D>(
+        [](Field3D::ind_type& i) {
+          return 2.0 + std::fmod(0.37 * (i.x() + 3 * i.z()), nx - 5.0);
+        },
+        &test_mesh);
+    delta_z = makeField<Field3D>(
+        [](Field3D::ind_type& i) { return i.z() + 1.0 + 0.29 * i.x() - 0.5 * i.y(); },
+        &test_mesh);
+  }
+
+  ~InterpolationMatrixTest() override {
+    // Put back the default methods. Can't use reset(), as that also
+    // removes the registered methods
+    WithQuietOutput quiet_info{output_info};
+    Options options;
+    options["ddx"]["first"] = "C2";
+    options["ddz"]["first"] = "C2";
+    DerivativeStore<Field3D>::getInstance().initialise(&options);
+  }
+
+  static constexpr int nx = 10;
+  static constexpr int ny = 3;
+  static constexpr int nz = 6;
+
+  FakeMesh test_mesh{nx, ny, nz};
+  Field3D f, delta_x, delta_z;
+
+  void expectMatrixMatches(const Interpolation& interp, const BoutMask& mask) {
+    const auto matrix = interp.getMatrix();
+    const Field3D expected = interp.interpolate(f);
+    const Field3D actual = matrix.apply(f);
+
+    int points = 0;
+    BOUT_FOR_SERIAL(i, f.getRegion("RGN_NOBNDRY")) {
+      if (mask(i.x(), i.y(), i.z())) {
+        continue;
+      }
+      EXPECT_NEAR(actual[i], expected[i], 1e-13) << " at " << i.x() << ", " << i.y()
+                                                 << ", " << i.z();
+      ++points;
+    }
+    EXPECT_EQ(matrix.size(), points);
+  }
+};
+
+constexpr int InterpolationMatrixTest::nx;
+constexpr int InterpolationMatrixTest::ny;
+constexpr int InterpolationMatrixTest::nz;
+
+TEST_F(InterpolationMatrixTest, HermiteSpline) {
+  HermiteSpline interp{0, &test_mesh};
+  interp.calcWeights(delta_x, delta_z);
+
+  const auto matrix = interp.getMatrix();
+  EXPECT_EQ(matrix.getWidth(), 16);
+
+  expectMatrixMatches(interp, BoutMask{test_mesh, false});
+}
+
+TEST_F(InterpolationMatrixTest, HermiteSplineMask) {
+  BoutMask mask{test_mesh, false};
+  mask(3, 1, 2) = true;
+  mask(4, 1, 5) = true;
+
+  HermiteSpline interp{0, &test_mesh};
+  interp.calcWeights(delta_x, delta_z, mask);
+
+  expectMatrixMatches(interp, mask);
+}
+
+TEST_F(InterpolationMatrixTest, HermiteSplineC4) {
+  WithQuietOutput quiet_info{output_info};
+  Options options;
+  options["ddx"]["first"] = "C4";
+  options["ddz"]["first"] = "C4";
+  DerivativeStore<Field3D>::getInstance().initialise(&options);
+
+  HermiteSpline interp{0, &test_mesh};
+  interp.calcWeights(delta_x, delta_z);
+
+  EXPECT_EQ(interp.getMatrix().getWidth(), 36);
+
+  expectMatrixMatches(interp, BoutMask{test_mesh, false});
+}
+
+TEST_F(InterpolationMatrixTest, HermiteSplineFields) {
+  HermiteSpline interp{0, &test_mesh};
+  interp.calcWeights(delta_x, delta_z);
+
+  const Field3D g = f * f;
+  const auto results = interp.interpolateFields({&f, &g});
+  ASSERT_EQ(results.size(), 2);
+
+  const auto matrix_results = interp.getMatrix().apply({&f, &g});
+  ASSERT_EQ(matrix_results.size(), 2);
+
+  const Field3D expected_f = interp.interpolate(f);
+  const Field3D expected_g = interp.interpolate(g);
+
+  EXPECT_TRUE(IsFieldEqual(results[0], expected_f, "RGN_NOBNDRY"));
+  EXPECT_TRUE(IsFieldEqual(results[1], expected_g, "RGN_NOBNDRY"));
+  EXPECT_TRUE(IsFieldEqual(matrix_results[0], expected_f, "RGN_NOBNDRY", 1e-13));
+  EXPECT_TRUE(IsFieldEqual(matrix_results[1], expected_g, "RGN_NOBNDRY", 1e-13));
+}
+
+TEST_F(InterpolationMatrixTest, HermiteSplineNonlinearDerivative) {
+  WithQuietOutput quiet_info{output_info};
+  Options options;
+  options["ddx"]["first"] = "W2";
+  DerivativeStore<Field3D>::getInstance().initialise(&options);
+
+  HermiteSpline interp{0, &test_mesh};
+  interp.calcWeights(delta_x, delta_z);
+
+  EXPECT_THROW(interp.getMatrix(), BoutException);
+}
+
+TEST_F(InterpolationMatrixTest, MonotonicHermiteSpline) {
+  MonotonicHermiteSpline interp{0, &test_mesh};
+  interp.calcWeights(delta_x, delta_z);
+
+  EXPECT_THROW(interp.getMatrix(), BoutException);
+}
+
+TEST_F(InterpolationMatrixTest, HermiteSplineWriteReadWeights) {
+  HermiteSpline interp{0, &test_mesh};
+  interp.calcWeights(delta_x, delta_z);
+
+  std::stringstream cache;
+  interp.writeWeights(cache);
+
+  HermiteSpline cached{0, &test_mesh};
+  cached.readWeights(cache);
+
+  EXPECT_TRUE(IsFieldEqual(cached.interpolate(f), interp.interpolate(f), "RGN_NOBNDRY"));
+}
+
+TEST_F(InterpolationMatrixTest, Lagrange4ptWriteReadWeights) {
+  Lagrange4pt interp{0, &test_mesh};
+  interp.calcWeights(delta_x, delta_z);
+
+  std::stringstream cache;
+  interp.writeWeights(cache);
+
+  Lagrange4pt cached{0, &test_mesh};
+  cached.readWeights(cache);
+
+  EXPECT_TRUE(IsFieldEqual(cached.interpolate(f), interp.interpolate(f), "RGN_NOBNDRY"));
+}
+
+TEST_F(InterpolationMatrixTest, ReadTruncatedWeights) {
+  HermiteSpline interp{0, &test_mesh};
+  interp.calcWeights(delta_x, delta_z);
+
+  std::stringstream cache;
+  interp.writeWeights(cache);
+  std::stringstream truncated{cache.str().substr(0, cache.str().size() / 2)};
+
+  HermiteSpline cached{0, &test_mesh};
+  EXPECT_THROW(cached.readWeights(truncated), BoutException);
+}
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include "parallel_boundary_op.hxx"
+#include "parallel_boundary_region.hxx"
+
+#include "test_extras.hxx"
+
+/// Global mesh
+namespace bout{
+namespace globals{
+extern Mesh *mesh;
+} // namespace globals
+} // namespace bout
+
+// The unit tests use the global mesh
+using namespace bout::globals;
+
+namespace {
+/// Generates x + y + z, and counts how many values it has generated
+class CountingGenerator : public FieldGenerator {
+public:
+  CountingGenerator(bool time_dependent) : time_dependent(time_dependent) {}
+  double generate(double x, double y, double z, double UNUSED(t)) override {
+    ++count;
+    return x + y + z;
+  }
+  bool isTimeDependent() const override { return time_dependent; }
+
+  int count{0};
+
+private:
+  bool time_dependent;
+};
+} // namespace
+
+class ParallelBoundaryTest : public FakeMeshFixture {
+public:
+  ParallelBoundaryTest() : region("test", BNDRY_PAR_FWD, +1, mesh) {
+    region.add_point(1, 1, 2, 1.5, 1.5, 2.0, 0.5, 0.1);
+    region.add_point(2, 3, 4, 2.5, 3.5, 4.0, 0.25, 0.2);
+
+    field = 1.0;
+    field.splitParallelSlices();
+    field.yup() = 0.0;
+    field.ydown() = 0.0;
+  }
+
+  BoundaryRegionPar region;
+  Field3D field;
+};
+
+TEST_F(ParallelBoundaryTest, Points) {
+  ASSERT_EQ(region.size(), 2);
+
+  const auto& points = region.points();
+  EXPECT_EQ(points.x[1], 2);
+  EXPECT_EQ(points.y[1], 3);
+  EXPECT_EQ(points.z[1], 4);
+  EXPECT_DOUBLE_EQ(points.s_x[1], 2.5);
+  EXPECT_DOUBLE_EQ(points.s_y[1], 3.5);
+  EXPECT_DOUBLE_EQ(points.s_z[1], 4.0);
+  EXPECT_DOUBLE_EQ(points.length[1], 0.25);
+  EXPECT_DOUBLE_EQ(points.angle[1], 0.2);
+}
+
+TEST_F(ParallelBoundaryTest, Iterate) {
+  int count = 0;
+  for (region.first(); !region.isDone(); region.next()) {
+    EXPECT_EQ(region.x, region.points().x[count]);
+    EXPECT_EQ(region.y, region.points().y[count]);
+    EXPECT_EQ(region.z, region.points().z[count]);
+    EXPECT_DOUBLE_EQ(region.length, region.points().length[count]);
+    ++count;
+  }
+  EXPECT_EQ(count, 2);
+}
+
+TEST_F(ParallelBoundaryTest, Dirichlet) {
+  BoundaryOpPar_dirichlet op(&region, 2.0);
+  op.apply(field);
+
+  // dy = 1, so f_next = value - (f - value) * (1 - length) / length
+  EXPECT_DOUBLE_EQ(field.yup()(1, 2, 2), 3.0);
+  EXPECT_DOUBLE_EQ(field.yup()(2, 4, 4), 5.0);
+  EXPECT_DOUBLE_EQ(field.yup()(1, 1, 2), 0.0);
+}
+
+TEST_F(ParallelBoundaryTest, Neumann) {
+  BoundaryOpPar_neumann op(&region, 2.0);
+  op.apply(field);
+
+  EXPECT_DOUBLE_EQ(field.yup()(1, 2, 2), 3.0);
+  EXPECT_DOUBLE_EQ(field.yup()(2, 4, 4), 3.0);
+}
+
+TEST_F(ParallelBoundaryTest, GeneratedValuesFixed) {
+  auto generator = std::make_shared<CountingGenerator>(false);
+  BoundaryOpPar_dirichlet op(&region, generator);
+
+  op.apply(field, 0.0);
+  const BoutReal first = field.yup()(1, 2, 2);
+  op.apply(field, 1.0);
+
+  // Doesn't depend on t, so only generated once
+  EXPECT_EQ(generator->count, 2);
+  EXPECT_DOUBLE_EQ(field.yup()(1, 2, 2), first);
+}
+
+TEST_F(ParallelBoundaryTest, GeneratedValuesTimeDependent) {
+  auto generator = std::make_shared<CountingGenerator>(true);
+  BoundaryOpPar_dirichlet op(&region, generator);
+
+  op.apply(field, 0.0);
+  op.apply(field, 1.0);
+
+  EXPECT_EQ(generator->count, 4);
+}
@@ -40,6 +40,59 @@ TEST_F(ParallelTransformTest, IdentityCalcTwoParallelSlices) {
   EXPECT_TRUE(IsFieldEqual(field.ydown(1), 1.0));
 }
 
+TEST_F(ParallelTransformTest, IdentityCalcParallelSlicesGroup) {
+
+  ParallelTransformIdentity transform{*bout::globals::mesh};
+
+  Field3D field1{1.0}, field2{2.0};
+
+  transform.calcParallelSlicesGroup({&field1, &field2});
+
+  EXPECT_TRUE(IsFieldEqual(field1.yup(), 1.0));
+  EXPECT_TRUE(IsFieldEqual(field1.ydown(), 1.0));
+  EXPECT_TRUE(IsFieldEqual(field2.yup(), 2.0));
+  EXPECT_TRUE(IsFieldEqual(field2.ydown(), 2.0));
+}
+
+namespace {
+/// Counts the calls to calcParallelSlicesGroup
+class CountingParallelTransform : public ParallelTransformIdentity {
+public:
+  CountingParallelTransform(Mesh& mesh, int& group_calls)
+      : ParallelTransformIdentity(mesh), group_calls(group_calls) {}
+
+  void calcParallelSlicesGroup(const std::vector<Field3D*>& fields) override {
+    ++group_calls;
+    ParallelTransformIdentity::calcParallelSlicesGroup(fields);
+  }
+
+private:
+  int& group_calls;
+};
+} // namespace
+
+TEST_F(ParallelTransformTest, CommunicateCalcParallelSlicesGroup) {
+  int group_calls = 0;
+  bout::globals::mesh->getCoordinates()->setParallelTransform(
+      bout::utils::make_unique<CountingParallelTransform>(*bout::globals::mesh,
+                                                          group_calls));
+
+  Field3D field1{1.0}, field2{2.0}, field3{3.0}, field4{4.0};
+
+  // Enough fields to be calculated together, straight away by default
+  bout::globals::mesh->communicate(field1, field2, field3, field4);
+
+  EXPECT_EQ(group_calls, 1);
+  EXPECT_FALSE(field1.parallelSlicesPending());
+  EXPECT_TRUE(IsFieldEqual(field4.yup(), 4.0));
+
+  // Too few fields to be worth grouping
+  bout::globals::mesh->communicate(field1, field2);
+
+  EXPECT_EQ(group_calls, 1);
+  EXPECT_TRUE(IsFieldEqual(field2.ydown(), 2.0));
+}
+
 TEST_F(ParallelTransformTest, IdentityToFieldAligned) {
 
   ParallelTransformIdentity transform{*bout::globals::mesh};
@@ -52,6 +105,21 @@ TEST_F(ParallelTransformTest, IdentityToFieldAligned) {
   EXPECT_TRUE(result.getDirectionY() == YDirectionType::Aligned);
 }
 
+TEST_F(ParallelTransformTest, IdentityToFieldAlignedGroup) {
+
+  ParallelTransformIdentity transform{*bout::globals::mesh};
+
+  Field3D field1{1.0}, field2{2.0};
+
+  auto result = transform.toFieldAlignedGroup({field1, field2}, "RGN_ALL");
+
+  ASSERT_EQ(result.size(), 2);
+  EXPECT_TRUE(IsFieldEqual(result[0], 1.0));
+  EXPECT_TRUE(IsFieldEqual(result[1], 2.0));
+  EXPECT_TRUE(result[0].getDirectionY() == YDirectionType::Aligned);
+  EXPECT_TRUE(result[1].getDirectionY() == YDirectionType::Aligned);
+}
+
 TEST_F(ParallelTransformTest, IdentityFromFieldAligned) {
 
   ParallelTransformIdentity transform{*bout::globals::mesh};
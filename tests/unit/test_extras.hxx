@@ -183,6 +183,8 @@ public:
     source = source_in;
   }
 
+  void setLazyParallelSlices(bool lazy) { lazy_parallel_slices = lazy; }
+
   // Use this if the FakeMesh needs x- and y-boundaries
   void createBoundaries() {
     addBoundary(new BoundaryRegionXIn("core", ystart, yend, this));